@@ -0,0 +1,68 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include "regression.h"
+
+/*
+ * Every problem is solved without options, and then with each option in turn (preprocessing is on).
+ * A run fails if its result differs from that of the run without options,
+ * or if it has not been completed within the time limit (in seconds) given as the only argument.
+ * The test also fails if root restarts have been switched on but no run has been restarted.
+ */
+static bool solve(int type, int seed, int opt, int timeLimit, bool &bSol, double &objVal, double &solTime, int &restartNum)
+{
+	std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+	Cregression prob("regression",type,seed,opt);
+	prob.setTimeLimit(timeLimit);
+	prob.model();
+	solTime=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+	if ((bSol=prob.isSolution()))
+		objVal=prob.getObjective();
+	restartNum=prob.getRestartNum();
+	return (solTime <= timeLimit)? true: false;
+}
+
+int main(int argc, const char *argv[])
+{
+	const char* typeName[]={"GAP","bin packing","GAP blocks","knapsack"};
+	int timeLimit=(argc > 1)? atoi(argv[1]): 60, failNum=0, restartNum, totalRestartNum=0;
+	try {
+		for (int type=0; type < 4; ++type) {
+			for (int seed=1; seed <= 4; ++seed) {
+				bool bSol0, bSol;
+				double objVal0=0.0, objVal=0.0, solTime;
+				if (!solve(type,seed,0,timeLimit,bSol0,objVal0,solTime,restartNum))
+					++failNum;
+				for (int opt=1; opt < Cregression::getOptionNum(); ++opt) {
+					bool bOk=solve(type,seed,opt,timeLimit,bSol,objVal,solTime,restartNum);
+					totalRestartNum+=restartNum;
+					if (bSol != bSol0 || (bSol && fabs(objVal-objVal0) > 1.0e-6))
+						bOk=false;
+					std::cout << std::setw(10) << typeName[type] << " " << seed << " "
+						<< std::setw(22) << Cregression::getOptionName(opt) << " ";
+					if (bSol)
+						std::cout << std::setw(8) << objVal;
+					else
+						std::cout << std::setw(8) << "none";
+					std::cout << std::setw(8) << std::fixed << std::setprecision(2) << solTime
+						<< std::defaultfloat << std::setprecision(6) << ((bOk)? "  ok": "  FAILED") << std::endl;
+					if (!bOk)
+						++failNum;
+				}
+			}
+		}
+	}
+	catch(CException* pe) {
+		std::cerr << pe->what() << std::endl;
+		delete pe;
+		return 1;
+	}
+	if (!totalRestartNum) {
+		std::cout << "no run has been restarted" << std::endl;
+		++failNum;
+	}
+	std::cout << failNum << " runs failed" << std::endl;
+	return (failNum)? 1: 0;
+}
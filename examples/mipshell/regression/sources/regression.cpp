@@ -0,0 +1,162 @@
+#include <cstdlib>
+#include "regression.h"
+
+static const char* optionName[]={"none","reliability branching","root racing","feasibility pump",
+	"LNS heuristics","diving portfolio","heuristic scheduling","parallel probing","activity propagation",
+	"symmetry breaking","root restart","solution pool","decomposition","cut pool","cut selection",
+	"cut aging","cut statistics","mod-2 cuts","zero-half cuts","clique cuts","conflict analysis",
+	"lift-and-project cuts"};
+
+Cregression::Cregression(const char* name, int type, int seed, int opt): CProblem(name)
+{
+	this->type=type;
+	this->opt=opt;
+	makeData(seed);
+}
+
+#ifndef __ONE_THREAD_
+Cregression::Cregression(const Cregression &other, int thread): CProblem(other,thread)
+{
+	type=other.type;
+	opt=other.opt;
+} // end of Cregression::Cregression(Cregression &other, int thread)
+
+CMIP* Cregression::clone(const CMIP *pMip, int thread)
+{
+	return static_cast<CMIP*>(new Cregression(*static_cast<Cregression*>(const_cast<CMIP*>(pMip)),thread));
+}
+#endif
+
+Cregression::~Cregression()
+{
+}
+
+//////////////////// implementation
+void Cregression::makeData(int seed)
+{
+	int i, j, k, m, n, a, s;
+	srand(seed);
+	if (type == 1) { // 14 items are packed into at most 8 bins
+		n=14;
+		binNum=8;
+		C=60;
+		w.setDim(n);
+		for (i=0; i < n; ++i)
+			w(i)=10+rand()%41;
+	}
+	else if (type == 3) { // 40 items are packed into a knapsack with 5 constraints
+		m=5;
+		n=40;
+		v.setDim(n);
+		A.setDim(m,n);
+		b.setDim(m);
+		for (j=0; j < n; ++j)
+			v(j)=10+rand()%90;
+		for (i=0; i < m; ++i) {
+			for (s=j=0; j < n; ++j)
+				s+=(A(i,j)=1+rand()%100);
+			b(i)=s/4;
+		}
+	}
+	else { // 25 jobs are assigned to 5 agents, or 3 independent problems, each with 8 jobs and 3 agents
+		blkNum=(type == 2)? 3: 1;
+		m=(type == 2)? 9: 5;
+		n=(type == 2)? 8: 25;
+		a=m/blkNum;
+		c.setDim(m,n);
+		p.setDim(m,n);
+		l.setDim(m);
+		for (k=0; k < blkNum; ++k) {
+			for (i=k*a; i < (k+1)*a; ++i) {
+				for (j=0; j < n; ++j) {
+					c(i,j)=10+rand()%41;
+					p(i,j)=5+rand()%21;
+				}
+			}
+			for (i=k*a; i < (k+1)*a; ++i) {
+				for (s=j=0; j < n; ++j)
+					s+=p(i,j);
+				l(i)=(8*s)/(10*a); // capacities are tight enough for presolve to fix variables
+			}
+		}
+	}
+} // end of Cregression::makeData
+
+void Cregression::setOption()
+{
+	beSilent();
+	switch (opt) {
+		case 1: setReliabilityBranching(); break;
+		case 2: setRootRacing(); break;
+		case 3: setFeasibilityPump(); break;
+		case 4: setLnsHeuristics(); break;
+		case 5: setDivingPortfolio(1); break;
+		case 6: setFeasibilityPump(); setLnsHeuristics(); setDivingPortfolio(1); setHeuristicScheduling(); break;
+		case 7: setParallelProbing(2); break;
+		case 8: setActivityPropagation(); break;
+		case 9: setSymmetryBreaking(); break;
+		case 10: // the problems are small, and only a few variables are fixed at the root
+			setRootRestart(0.01);
+			if (type == 3) // restarts are done only without preprocessing, which is too slow for the other problems
+				preprocOff();
+			break;
+		case 11: setSolutionPool(); break;
+		case 12: setDecomposition(); break;
+		case 13: setCutPool(); break;
+		case 14: setCutSelection(); break;
+		case 15: setCutAging(); break;
+		case 16: setCutStatistics(); break;
+		case 17: setMod2Cuts(); break;
+		case 18: setZeroHalfCuts(); break;
+		case 19: setCliqueCuts(); break;
+		case 20: setConflictAnalysis(); break;
+		case 21: setLiftProjectCuts(); break;
+	}
+} // end of Cregression::setOption
+
+void Cregression::setGreedyStart(VAR_VECTOR &x)
+{
+	int i, j, k, m=A.getSize(0), n=A.getSize(1);
+	double r, rMax;
+	INT_VECTOR rest(m), used(n);
+	for (i=0; i < m; ++i)
+		rest(i)=b(i);
+	for (j=0; j < n; ++j)
+		used(j)=0;
+	setMipStart();
+	for (;;) { // the item with the greatest ratio of its value to its relative weight is packed if it fits
+		for (rMax=0.0, k=-1, j=0; j < n; ++j) {
+			if (!used(j)) {
+				for (r=0.0, i=0; i < m; ++i)
+					r+=static_cast<double>(A(i,j))/b(i);
+				if ((r=v(j)/r) > rMax) {
+					rMax=r;
+					k=j;
+				}
+			}
+		}
+		if (k < 0)
+			break;
+		used(k)=1;
+		for (i=0; i < m && A(i,k) <= rest(i); ++i);
+		if (i == m) {
+			for (i=0; i < m; ++i)
+				rest(i)-=A(i,k);
+			setMipStartValue(x(k),1.0);
+		}
+		else
+			setMipStartValue(x(k),0.0);
+	}
+} // end of Cregression::setGreedyStart
+
+int Cregression::getOptionNum()
+{
+	return static_cast<int>(sizeof(optionName)/sizeof(optionName[0]));
+}
+
+const char* Cregression::getOptionName(int opt)
+{
+	return optionName[opt];
+}
+
+#include "regression.aux"
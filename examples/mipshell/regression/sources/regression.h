@@ -0,0 +1,32 @@
+#include <mipshell.h>
+
+class Cregression: public CProblem
+{
+	int type; // 0 - generalized assignment, 1 - bin packing, 2 - blocks of generalized assignment problems, 3 - multidimensional knapsack
+	int opt; // option to be tested, 0 - no option
+	int blkNum; // number of blocks
+	INT_VECTOR c; // assignment costs
+	INT_VECTOR p; // processing times
+	INT_VECTOR l; // agent capacities
+	INT_VECTOR w; // item weights
+	int binNum; // number of bins
+	int C; // bin capacity
+	INT_VECTOR v; // item values
+	INT_VECTOR A; // knapsack constraint matrix
+	INT_VECTOR b; // knapsack capacities
+public:
+	Cregression(const char* name, int type, int seed, int opt);
+#ifndef __ONE_THREAD_
+	Cregression(const Cregression &other, int thread);
+	CMIP* clone(const CMIP *pMip, int thread);
+#endif
+	virtual ~Cregression();
+
+// implementation
+	int model();
+	void makeData(int seed);
+	void setOption();
+	void setGreedyStart(VAR_VECTOR &x);
+	static int getOptionNum();
+	static const char* getOptionName(int opt);
+};
@@ -0,0 +1,55 @@
+int Cregression::model()
+{
+	int i, j, k, m, n, a;
+
+	if (type == 1) {
+		n=w.getSize();
+		m=binNum;
+		VAR_VECTOR x("x",BIN,n,m), y("y",BIN,m);
+
+		minimize(sum(k in [0,m)) y(k));
+
+		forall(i in [0,n))
+			sum(k in [0,m)) x(i,k) == 1;
+
+		forall(k in [0,m))
+			sum(i in [0,n)) w(i)*x(i,k) <= C*y(k);
+
+		setOption();
+		optimize();
+	}
+	else if (type == 3) {
+		m=A.getSize(0);
+		n=A.getSize(1);
+		VAR_VECTOR x("x",BIN,n);
+
+		maximize(sum(j in [0,n)) v(j)*x(j));
+
+		forall(i in [0,m))
+			sum(j in [0,n)) A(i,j)*x(j) <= b(i);
+
+		setOption();
+		if (opt == 10) // without preprocessing, variables are fixed at the root only if a good record is known
+			setGreedyStart(x);
+		optimize();
+	}
+	else {
+		m=c.getSize(0);
+		n=c.getSize(1);
+		a=m/blkNum;
+		VAR_VECTOR x("x",BIN,m,n);
+
+		minimize(sum(i in [0,m), j in [0,n)) c(i,j)*x(i,j));
+
+		forall(k in [0,blkNum), j in [0,n))
+			sum(i in [k*a,(k+1)*a)) x(i,j) == 1;
+
+		forall(i in [0,m))
+			sum(j in [0,n)) p(i,j)*x(i,j) <= l(i);
+
+		setOption();
+		optimize();
+	}
+
+	return 0;
+} // end of Cregression::model
@@ -0,0 +1,201 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Checkpoint.h interface for `CCheckpoint` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CHECKPOINT__H
+#define __CHECKPOINT__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <ctime>
+#include <thread.h>
+#include "MatrixCopy.h"
+
+/**
+ * `CCheckpoint` periodically writes the state of a running branch-and-cut procedure to a file,
+ *  so that a restarted process can resume from the last written state.
+ *
+ * A checkpoint (_snapshot_) stores
+ *   - the fingerprint of the problem: the numbers of rows and columns, and a hash of
+ *     the objective, bounds, and matrix of the original (not preprocessed) problem;
+ *   - the record solution (in variable handles) and its objective value;
+ *   - the upper (for maximization) bound on the optimal objective value;
+ *   - pseudocost tables of reliability branching (if it is on).
+ *
+ * The solver threads never write files. When a checkpoint is due,
+ * the thread which noticed this packs the state into a new memory image,
+ * and passes it to the writer thread. The writer thread stores the image into
+ * the file `<name>.tmp`, and then renames it to `<name>`; so, the checkpoint file is always complete.
+ * In single-threaded builds the image is written by the calling thread.
+ *
+ * A checkpoint file is accepted only if its fingerprint matches the problem being solved,
+ * and its record solution is used only if it satisfies all bounds, integrality conditions,
+ * and constraints of the problem. The file is deleted when the solution procedure completes
+ * (it is kept only if the procedure has been stopped by the time limit).
+ */
+class MIPSHELL_API CCheckpoint
+{
+	friend class CProblem;
+
+	char* m_strFileName; ///< name of checkpoint file.
+	int m_iInterval; ///< checkpoints are taken every `m_iInterval` seconds.
+	time_t m_tLast; ///< time when last checkpoint was taken.
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	unsigned long long m_uHash; ///< hash of `m_copy` (used to verify that a checkpoint file matches the problem).
+
+	bool m_bRec; ///< `true` if record solution is stored in `m_dpRecX` and `m_ipRecHd`.
+	double m_dRecObj; ///< objective value of record solution.
+	int m_iRecNum; ///< number of components in record solution.
+	double *m_dpRecX; ///< `m_dpRecX[i]` is value of variable with handle `m_ipRecHd[i]` in record solution.
+	int *m_ipRecHd; ///< handles of record solution components.
+
+	int m_iPcSize; ///< size of `m_dpPc`.
+	double *m_dpPc; ///< pseudocost tables read from checkpoint file.
+	double m_dObjBound; ///< bound on optimal objective value read from checkpoint file.
+	bool m_bResume; ///< `true` if a checkpoint file has been read and its record solution not yet sent to the solver.
+
+	char* m_cpImage; ///< memory image waiting to be written by the writer thread.
+	int m_iImageSize; ///< size (in bytes) of `m_cpImage`.
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< Locks record solution and `m_cpImage`.
+	_THREAD m_thread; ///< writer thread.
+	bool m_bRunning; ///< `true` if writer thread has been started.
+	volatile bool m_bStop; ///< writer thread stops when this flag is set.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] fileName name of checkpoint file;
+	 * \param[in] interval checkpoints are taken every `interval` seconds.
+	 * \throws CMemoryException lack of memory.
+	 */
+	CCheckpoint(const char* fileName, int interval);
+	virtual ~CCheckpoint(); ///< The destructor.
+
+	const char* getFileName() const
+		{return m_strFileName;} ///< \return name of checkpoint file.
+
+	/**
+	 * \return `true` if `m_iInterval` seconds passed since last checkpoint has been taken.
+	 */
+	bool isTime() const
+		{return (time(0)-m_tLast >= m_iInterval)? true: false;}
+
+	/**
+	 * The function computes the fingerprint of the problem;
+	 * it must be called after the problem has been copied to `m_copy`.
+	 */
+	void init();
+
+	/**
+	 * The function stores a copy of a new record solution.
+	 * \param[in] objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setRecord(double objVal, int n, const double* dpX, const int* ipHd);
+
+	/**
+	 * The function packs the current state into a memory image and passes it to the writer thread.
+	 * \param[in] objBound bound on optimal objective value;
+	 * \param[in] pcSize,dpPc pseudocost tables, `dpPc` is array of size `pcSize`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void takeSnapshot(double objBound, int pcSize, const double* dpPc);
+
+	/**
+	 * The function reads the checkpoint file, if it exists.
+	 * The record solution read is written as a dense vector, in which component `j` is value of variable with handle `j`;
+	 * it is dropped if it is not a feasible solution of `m_copy`.
+	 * \return `true` if the file has been read, and its fingerprint matches the problem being solved.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool read();
+
+	/**
+	 * The function starts the writer thread.
+	 */
+	void start();
+
+	/**
+	 * The function writes the last snapshot (if any) and stops the writer thread.
+	 */
+	void stop();
+
+	/**
+	 * The function deletes the checkpoint file; it must be called after `stop()`.
+	 */
+	void remove();
+
+private:
+	/**
+	 * The function checks the record solution read from checkpoint file against `m_copy`,
+	 * and writes it as a dense vector.
+	 * \return `true` if the record solution satisfies all bounds, integrality conditions, and constraints of `m_copy`,
+	 *  and its objective value is equal to the stored one.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool checkRecord();
+
+
+	/**
+	 * The function writes a memory image to the checkpoint file.
+	 * \param[in] cpImage,size memory image of `size` bytes.
+	 * \return `true` in case of success.
+	 */
+	bool write(const char* cpImage, int size);
+
+	void writer(); ///< The main loop of the writer thread.
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of the writer thread.
+	 * \param[in] param pointer to `CCheckpoint` object.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+};
+
+#endif // #ifndef __CHECKPOINT__H
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file CliqueSep.h interface for `CCliqueSep` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CLIQUESEP__H
+#define __CLIQUESEP__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include "Separator.h"
+#include "CliqueTable.h"
+
+/**
+ * `CCliqueSep` separates clique inequalities using the persistent clique table.
+ *
+ * Each literal is weighted by its value in the solution being separated
+ * (\f$x^*_j\f$ for literal `2*j`, and \f$1-x^*_j\f$ for literal `2*j+1`).
+ * Starting from literals of fractional variables in non-increasing order of their weights,
+ * a clique of large weight is built greedily from the neighbours of the start literal;
+ * if its weight is greater than one, the clique is extended by neighbours of zero weight,
+ * and the inequality \f$\sum_{l \in C} l \le 1\f$ is written.
+ * Literals of variables removed from the LP by preprocessing are never used, as their values are not known.
+ */
+class MIPSHELL_API CCliqueSep: public CSeparator
+{
+	friend class CProblem;
+
+	CCliqueTable m_table; ///< clique table.
+	int m_iMaxCutNum; ///< maximum number of cuts generated in one call.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxCutNum maximum number of cuts generated in one call.
+	 */
+	CCliqueSep(int maxCutNum=64);
+	virtual ~CCliqueSep(); ///< The destructor.
+
+	/**
+	 * \return name of separator.
+	 */
+	virtual const char* getName() const
+		{return "clique";}
+
+	/**
+	 * \return reference to clique table.
+	 */
+	CCliqueTable& getTable()
+		{return m_table;}
+
+	/**
+	 * The function separates a given solution by clique inequalities.
+	 * \param[in] hdNum number of variables;
+	 * \param[in] dpX solution, `dpX[j]` is value of variable with handle `j`;
+	 * \param[in] ipHdToCol `ipHdToCol[j]` is column of variable with handle `j`, or `-1` if the variable has been removed by preprocessing;
+	 * \param[in,out] cuts cut buffer.
+	 * \return number of cuts written.
+	 * \throws CMemoryException lack of memory.
+	 */
+	virtual int separate(int hdNum, const double* dpX, const int* ipHdToCol, CCutSelector& cuts);
+};
+
+#endif // #ifndef __CLIQUESEP__H
@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file CliqueTable.h interface for `CCliqueTable` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CLIQUETABLE__H
+#define __CLIQUETABLE__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <thread.h>
+
+class CMatrixCopy;
+
+/**
+ * `CCliqueTable` is a persistent table of cliques of the conflict graph of binary variables.
+ *
+ * The nodes of the conflict graph are _literals_: literal `2*j` stands for \f$x_j\f$,
+ * and literal `2*j+1` stands for its complement \f$1-x_j\f$, where `j` is the handle of a binary variable.
+ * Two literals are adjacent if they cannot both be equal to one.
+ *
+ * The table is built once from the packing and knapsack rows of the original problem.
+ * The cliques are stored compactly, one after another, and for each literal the sorted list of cliques
+ * containing it is kept; if the number of literals is small, the adjacency matrix is also stored as bitsets.
+ * New cliques (e.g., implications found during probing) can be added at any time; they are kept in a list of
+ * pending cliques, and the per-literal lists are rebuilt only when that list becomes long.
+ * So, memory is linear in the total size of all cliques.
+ *
+ * Any number of threads may read the table at the same time; adding a clique locks the table for writing.
+ */
+class MIPSHELL_API CCliqueTable
+{
+	int m_iColNum; ///< number of variables; literals are `0,...,2*m_iColNum-1`.
+	int m_iCliqueNum; ///< number of cliques.
+	int m_iMaxCliqueNum; ///< size of memory allocated for cliques.
+	int m_iLitNum; ///< total size of all cliques.
+	int m_iMaxLitNum; ///< size of memory allocated for `m_ipLit`.
+	int *m_ipCliqueBeg; ///< clique `k` is stored in positions `m_ipCliqueBeg[k],...,m_ipCliqueBeg[k+1]-1` of `m_ipLit`.
+	int *m_ipLit; ///< literals of all cliques.
+	int m_iIndexedNum; ///< cliques `0,...,m_iIndexedNum-1` are in per-literal lists, all other cliques are pending.
+	int *m_ipLitBeg; ///< literal `l` is in cliques `m_ipLitClique[m_ipLitBeg[l]],...,m_ipLitClique[m_ipLitBeg[l+1]-1]`.
+	int *m_ipLitClique; ///< per-literal lists of cliques.
+	int m_iAdjWordNum; ///< number of 64-bit words in row of `m_ulpAdj`, or `0` if the adjacency matrix is not stored.
+	unsigned long long *m_ulpAdj; ///< adjacency matrix of conflict graph stored row by row as bitsets.
+#ifndef __ONE_THREAD_
+	mutable _RWLOCK m_rwLock; ///< read-write lock.
+#endif
+
+public:
+	CCliqueTable(); ///< The constructor.
+	virtual ~CCliqueTable(); ///< The destructor.
+
+	/**
+	 * The function builds the table from the rows of a given problem which variables are all binary.
+	 * For a row \f$\sum_j a_jx_j \le b\f$ (with negative coefficients complemented),
+	 * the largest coefficients such that any two of them sum up to more than \f$b\f$ form a clique,
+	 * and each other variable conflicting with some of those gives one more clique.
+	 * \param[in] copy problem.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void build(const CMatrixCopy& copy);
+
+	/**
+	 * The function adds a clique.
+	 * \param[in] sz,ipLit list of `sz` pairwise conflicting literals.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void addClique(int sz, const int* ipLit);
+
+	/**
+	 * The function adds an implication, which is a clique of two literals.
+	 * \param[in] lit1,lit2 literals that cannot both be equal to one.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void addConflict(int lit1, int lit2)
+		{int ipLit[2]={lit1,lit2}; addClique(2,ipLit);}
+
+	/**
+	 * \return number of variables.
+	 */
+	int getColNum() const
+		{return m_iColNum;}
+
+	/**
+	 * \return number of cliques.
+	 */
+	int getCliqueNum() const
+		{return m_iCliqueNum;}
+
+	/**
+	 * \return total size of all cliques.
+	 */
+	int getLitNum() const
+		{return m_iLitNum;}
+
+	/**
+	 * \param[in] lit literal.
+	 * \return `true` if literal `lit` belongs to at least one clique.
+	 */
+	bool hasConflicts(int lit) const;
+
+	/**
+	 * \param[in] lit1,lit2 literals.
+	 * \return `true` if literals `lit1` and `lit2` are adjacent in conflict graph.
+	 */
+	bool isAdjacent(int lit1, int lit2) const;
+
+	/**
+	 * The function lists the neighbours of a given literal.
+	 * \param[in] lit literal;
+	 * \param[in] maxNum size of `ipNbr`;
+	 * \param[out] ipNbr sorted list of neighbours of `lit`; if there are more than `maxNum` of them, the list is truncated.
+	 * \return number of neighbours written.
+	 */
+	int getNeighbors(int lit, int maxNum, int* ipNbr) const;
+
+	/**
+	 * The function locks the table for reading; it must be called before reading the table
+	 * if other threads may add cliques at the same time.
+	 */
+	void lockRead() const
+	{
+#ifndef __ONE_THREAD_
+		_RWLOCK_RDLOCK(&m_rwLock)
+#endif
+	}
+
+	/**
+	 * The function unlocks the table locked by `lockRead()`.
+	 */
+	void unlockRead() const
+	{
+#ifndef __ONE_THREAD_
+		_RWLOCK_UNLOCK_RDLOCK(&m_rwLock)
+#endif
+	}
+
+private:
+	void reset(); ///< deletes all cliques.
+	void allocMem(int cliqueNum, int litNum); ///< \throws CMemoryException lack of memory.
+	void appendClique(int sz, const int* ipLit); ///< adds a clique without locking the table; \throws CMemoryException lack of memory.
+	void buildIndex(); ///< builds per-literal lists of cliques; \throws CMemoryException lack of memory.
+	bool isPendingEdge(int lit1, int lit2) const; ///< \return `true` if `lit1` and `lit2` are in the same pending clique.
+};
+
+#endif // #ifndef __CLIQUETABLE__H
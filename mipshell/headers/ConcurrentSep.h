@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file ConcurrentSep.h interface for `CConcurrentSep` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CONCURRENTSEP__H
+#define __CONCURRENTSEP__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <iostream>
+#include <thread.h>
+
+class CSeparator;
+class CCutSelector;
+class CException;
+
+/**
+ * `CConcurrentSep` runs independent separators at the same time.
+ *
+ * All the separators read the same solution, which is not changed until they are finished,
+ * and each thread writes cuts into its own buffer (a `CCutSelector` object without the selection done).
+ * When all the separators have been run, the buffers are merged into the cut selector of the solver thread,
+ * and the selector chooses the cuts to be sent to the solver.
+ *
+ * The separation is done in two steps: `start()` creates the worker threads,
+ * and `finish()` lets the calling thread join them and waits until all the separators have been run.
+ * Between these two calls, the calling thread may do its own work,
+ * e.g., `CProblem::separate()` is called there.
+ *
+ * Every solver thread has its own object; the list of separators is shared by all of them.
+ */
+class MIPSHELL_API CConcurrentSep
+{
+	bool m_bOwner; ///< `true` if this object owns the separators.
+	int m_iSepNum; ///< number of separators.
+	int m_iMaxSepNum; ///< size of `m_ppSep`.
+	CSeparator** m_ppSep; ///< list of separators.
+	int m_iThreadNum; ///< maximum number of threads; if `0`, the number of threads used by the solver is taken.
+
+// separation round
+	int m_iHdNum; ///< number of variables.
+	const double* m_dpX; ///< solution being separated.
+	const int* m_ipHdToCol; ///< map of variable handles to LP columns (see `CSeparator::separate()`).
+	int m_iNextSep; ///< next separator to be run.
+	int m_iNextBuf; ///< next free cut buffer.
+	int m_iBufNum; ///< number of cut buffers.
+	CCutSelector** m_ppBuf; ///< `m_ppBuf[t]` is cut buffer of thread `t`.
+	int m_iCutNum; ///< number of cuts generated in current round.
+	CException* m_pErr; ///< first exception thrown by a separator in current round, or `0`.
+#ifndef __ONE_THREAD_
+	int m_iWorkerNum; ///< number of worker threads started by `start()`.
+	_THREAD* m_pThreads; ///< worker threads.
+	_MUTEX m_mutex; ///< Locks `m_iNextSep`, `m_iNextBuf`, `m_iCutNum`, and `m_pErr`.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] threadNum maximum number of threads; if `threadNum=0`, the number of threads used by the solver is taken.
+	 */
+	CConcurrentSep(int threadNum);
+
+	/**
+	 * The clone constructor: the list of separators is shared with `other`.
+	 * \param[in] other object to be cloned.
+	 */
+	CConcurrentSep(const CConcurrentSep &other);
+
+	virtual ~CConcurrentSep(); ///< The destructor.
+
+	/**
+	 * The function adds a separator, which will be destroyed by this object.
+	 * \param[in] pSep pointer to separator.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void addSeparator(CSeparator* pSep);
+
+	/**
+	 * \return number of separators.
+	 */
+	int getSeparatorNum() const
+		{return m_iSepNum;}
+
+	/**
+	 * The function starts the worker threads which run separators.
+	 * \param[in] hdNum number of variables;
+	 * \param[in] dpX solution, `dpX[j]` is value of variable with handle `j`;
+	 *  it must not be changed until `finish()` returns;
+	 * \param[in] ipHdToCol `ipHdToCol[j]` is column of variable with handle `j`, or `-1` if the variable has been removed by preprocessing;
+	 *  it must not be changed until `finish()` returns;
+	 * \param[in] sel cut selector of calling thread; cut buffers are cloned from it;
+	 * \param[in] threadNum number of threads used by the solver.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void start(int hdNum, const double* dpX, const int* ipHdToCol, const CCutSelector& sel, int threadNum);
+
+	/**
+	 * The function runs the remaining separators in the calling thread, waits for the worker threads,
+	 * and merges all cut buffers into a given selector.
+	 * \param[in,out] sel cut selector of calling thread.
+	 * \return number of cuts generated by all separators.
+	 * \throws CException first exception thrown by any separator.
+	 */
+	int finish(CCutSelector& sel);
+
+	/**
+	 * The function prints for each separator its number of calls, number of cuts, and running time.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	void runSeparators(); ///< runs separators which indices are taken from `m_iNextSep`.
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of threads created in `start()`.
+	 * \param[in] param pointer to `CConcurrentSep` object.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+};
+
+#endif // #ifndef __CONCURRENTSEP__H
@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Conflict.h interface for `CConflict` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CONFLICT__H
+#define __CONFLICT__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <iostream>
+
+class CMatrixCopy;
+
+/**
+ * `CConflict` analyses infeasible nodes of the search tree and derives _nogoods_ (conflict constraints) from them.
+ *
+ * The rows of the original problem (each row \f$l \le a^Tx \le u\f$ is split into \f$a^Tx \le u\f$ and \f$-a^Tx \le -l\f$),
+ * and the objective bound \f$c^Tx \ge z^*\f$ (\f$c^Tx \le z^*\f$ for minimization), where \f$z^*\f$ is the record,
+ * are propagated over the bounds of the node being processed.
+ * Every bound change is written onto a _trail_ together with its _reason_,
+ * which is the row that implied it, or `-1` for the bounds the node was given by branching and by the solver.
+ * When the minimum activity of a row exceeds its right hand side, the node is infeasible;
+ * bound changes that are responsible for the infeasibility are traced back through their reasons
+ * until only bounds of the node are left. At each step, only the largest contributions to the activity
+ * are kept that are still sufficient for the violation (or for the implied bound), which keeps the conflict short.
+ * If all the remaining bounds are fixings of binary variables, say \f$x_j=1\f$ for \f$j \in J_1\f$ and
+ * \f$x_j=0\f$ for \f$j \in J_0\f$, then the nogood
+ * \f[
+ *    \sum_{j \in J_0} x_j - \sum_{j \in J_1} x_j \ge 1-|J_1|
+ * \f]
+ * is valid for all solutions that are not worse than the record.
+ */
+class MIPSHELL_API CConflict
+{
+	int m_iColNum; ///< number of columns.
+	int m_iRowNum; ///< number of rows (less-than-or-equal-to inequalities), not counting the objective row.
+	bool m_bSense; ///< `true` for maximization, and `false` for minimization.
+	double *m_dpD; ///< `m_dpD[2*j]` and `m_dpD[2*j+1]` are global lower and upper bounds of column `j`.
+	char *m_cpInt; ///< `m_cpInt[j]` is `1` if column `j` is integer, `2` if it is binary, and `0` otherwise.
+	double *m_dpRhs; ///< `m_dpRhs[i]` is right hand side of row `i`.
+	int *m_ipBeg; ///< row `i` is stored in positions `m_ipBeg[i],...,m_ipBeg[i+1]-1` of `m_dpVal` and `m_ipCol`; row `m_iRowNum` is the objective.
+	double *m_dpVal; ///< row coefficients.
+	int *m_ipCol; ///< column indices of row coefficients.
+	int *m_ipColBeg; ///< rows containing column `j` are listed in positions `m_ipColBeg[j],...,m_ipColBeg[j+1]-1` of `m_ipColRow`.
+	int *m_ipColRow; ///< row indices.
+	int m_iMaxLen; ///< nogoods of more than `m_iMaxLen` literals are not written.
+	long long m_lMaxWork; ///< maximum number of row entries scanned in one call to `analyze()`.
+
+	std::atomic<int> m_iCallNum; ///< number of calls to `analyze()`.
+	std::atomic<int> m_iInfNum; ///< number of infeasible nodes detected.
+	std::atomic<int> m_iNogoodNum; ///< number of nogoods derived.
+	std::atomic<long long> m_lLitNum; ///< total number of literals in all derived nogoods.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxLen nogoods of more than `maxLen` literals are not written.
+	 */
+	CConflict(int maxLen=16);
+	virtual ~CConflict(); ///< The destructor.
+
+	/**
+	 * The function builds the rows and the column index; it must be called before `analyze()`.
+	 * \param[in] copy copy of the original problem.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void init(const CMatrixCopy& copy);
+
+	/**
+	 * \return number of columns.
+	 */
+	int getColNum() const
+		{return m_iColNum;}
+
+	/**
+	 * \param[in] j column index.
+	 * \return global lower bound of column `j`.
+	 */
+	double getLoBound(int j) const
+		{return m_dpD[j<<1];}
+
+	/**
+	 * \param[in] j column index.
+	 * \return global upper bound of column `j`.
+	 */
+	double getUpBound(int j) const
+		{return m_dpD[(j<<1)+1];}
+
+	/**
+	 * The function replaces the global bounds of a column with tighter ones, e.g., with the bounds valid at the root node.
+	 * It must not be called while other threads are calling `analyze()`.
+	 * \param[in] j column index;
+	 * \param[in] l,u new lower and upper bounds; only those of them are taken that are tighter than the current bounds.
+	 */
+	void tightenBounds(int j, double l, double u);
+
+	/**
+	 * The function propagates the bounds of a node, and, if the node is infeasible, derives a nogood.
+	 * Different threads may call the function simultaneously.
+	 * \param[in,out] dpD array of size `2*getColNum()`, `dpD[2*j]` and `dpD[2*j+1]` are lower and upper bounds
+	 *  of column `j` at the node; on return, the bounds are tightened;
+	 * \param[in] record objective value of the record solution, or `CLP::INF` (`-CLP::INF` for maximization) if there is none;
+	 * \param[out] sz,dpVal,ipHd nogood \f$\sum_{i=0}^{sz-1} dpVal[i]x_{ipHd[i]} \ge b\f$; `sz=0` if no nogood has been derived;
+	 *   `dpVal` and `ipHd` must be of size at least `getColNum()`;
+	 * \param[out] b right hand side of the nogood.
+	 * \return `true` if the node has been proven to be infeasible.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool analyze(double* dpD, double record, int& sz, double* dpVal, int* ipHd, double& b);
+
+	/**
+	 * The function prints the numbers of infeasible nodes detected and nogoods derived.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	/**
+	 * The function marks the trail entries that imply a given bound on the activity of a given row.
+	 * The bounds taken are those that were valid before trail position `pos`;
+	 * of them, only bounds giving the largest contributions to the minimum activity are marked
+	 * which are sufficient for the minimum activity to exceed `thr`.
+	 * \param[in] r row index;
+	 * \param[in] skip column not taken into account, or `-1`;
+	 * \param[in] thr threshold;
+	 * \param[in] pos trail position;
+	 * \param[in] ipLast `ipLast[2*j]` (resp., `ipLast[2*j+1]`) is last trail entry changing lower (resp., upper) bound of column `j`, or `-1`;
+	 * \param[in] ipPrev `ipPrev[t]` is previous trail entry changing the same bound as entry `t`, or `-1`;
+	 * \param[in] dpNew `dpNew[t]` is bound set by trail entry `t`;
+	 * \param[in,out] cpMark `cpMark[t]` is set to `1` for every trail entry `t` marked;
+	 * \param ipInd,dpDelta working arrays of sizes `2*getColNum()` and `getColNum()`.
+	 */
+	void explain(int r, int skip, double thr, int pos, const int* ipLast, const int* ipPrev,
+			const double* dpNew, char* cpMark, int* ipInd, double* dpDelta) const;
+};
+
+#endif // #ifndef __CONFLICT__H
@@ -746,8 +746,13 @@ public:
 	void setLocal()
 		{m_iHd=-1;} ///< marks this constraint as being local.
 
+	/**
+	 * \return `true` if this constraint is global, and `false` if it has been marked as local by `setLocal()`.
+	 * \attention Earlier versions returned the opposite value, and therefore all cuts generated by `separate()`
+	 *  and `gencut()` were added as local ones; code that used `!isGlobal()` to recognize global cuts must be changed.
+	 */
 	bool isGlobal()
-		{return (m_iHd >= 0)? false: true;} ///< \return `true` if this constraint is global.
+		{return (m_iHd >= 0)? true: false;}
 
 	/**
 	 * The function sets the value of left hand side of this constraint.
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file CutAging.h interface for `CCutAging` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CUTAGING__H
+#define __CUTAGING__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <iostream>
+
+#define CUTAGING_TOL 1.0e-6 ///< a cut is binding if its slack is not greater than `CUTAGING_TOL` (relative).
+
+/**
+ * `CCutAging` keeps ages of the cuts in the node LPs of one thread.
+ *
+ * The _age_ of a cut is the number of consecutive LP solutions for which the cut is not binding.
+ * Since the solver renumbers rows when it deletes them, cuts are identified by hash values of their rows.
+ * At every round, the ages of the cuts present in the LP are written into a new hash table,
+ * and the table of the previous round is dropped.
+ * Cuts which ages reach a _threshold_ are to be evicted from the LP. The threshold is adaptive:
+ * it is halved when the number of cuts in the LP exceeds a given target,
+ * and it is increased by one (up to its initial value) when the LP holds less than half the target.
+ */
+class MIPSHELL_API CCutAging
+{
+	friend class CProblem;
+
+	/// Statistics shared by all the threads.
+	struct tagStat {
+		std::atomic<int> roundNum; ///< number of rounds.
+		std::atomic<int> evictNum; ///< number of cuts evicted.
+		std::atomic<int> maxRowNum; ///< maximum number of cuts in an LP.
+		tagStat(): roundNum(0), evictNum(0), maxRowNum(0) {} ///< The constructor.
+	};
+
+	tagStat* m_pStat; ///< statistics (owned by the object created by `CCutAging(int,int)`).
+	bool m_bOwner; ///< `true` if `m_pStat` is owned by this object.
+	int m_iMaxAge; ///< initial (and maximum) value of the threshold.
+	int m_iAge; ///< current threshold.
+	int m_iMaxRowNum; ///< target number of cuts in an LP; if `0`, the target is set by `CProblem`.
+
+	int m_iTableSize; ///< size of hash table of the previous round, a power of 2.
+	int m_iMaxTableSize; ///< size of memory allocated for `m_ulpKey` and `m_ipAge`.
+	unsigned long long *m_ulpKey; ///< keys of the previous round, `0` marks free entries.
+	int *m_ipAge; ///< `m_ipAge[k]` is age of the cut with key `m_ulpKey[k]`.
+	int m_iNewTableSize; ///< size of hash table of the current round.
+	int m_iMaxNewTableSize; ///< size of memory allocated for `m_ulpNewKey` and `m_ipNewAge`.
+	unsigned long long *m_ulpNewKey; ///< keys of the current round.
+	int *m_ipNewAge; ///< ages of the current round.
+
+	int m_iMaxColNum; ///< size of `m_dpVal` and `m_ipCol`.
+	double *m_dpVal; ///< working array to store row coefficients.
+	int *m_ipCol; ///< working array to store row columns or handles.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxAge initial (and maximum) value of the threshold;
+	 * \param[in] maxRowNum target number of cuts in an LP; if `maxRowNum=0`, the target is set by the solver.
+	 */
+	CCutAging(int maxAge, int maxRowNum);
+
+	/**
+	 * The clone constructor creates an object for another thread; statistics are shared with `other`.
+	 * \param[in] other object to be cloned.
+	 */
+	CCutAging(const CCutAging &other);
+
+	virtual ~CCutAging(); ///< The destructor.
+
+	/**
+	 * The function makes working arrays large enough for rows of `n` entries.
+	 * \param[in] n number of columns.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void allocMemForRows(int n);
+
+	/**
+	 * \param[in] sz,dpVal,ipCol row coefficients;
+	 * \param[in] lhs,rhs left and right hand sides.
+	 * \return hash value (never `0`) of the row.
+	 */
+	static unsigned long long hashRow(int sz, const double* dpVal, const int* ipCol, double lhs, double rhs);
+
+	/**
+	 * The function starts a new round.
+	 * \param[in] rowNum number of cuts in the LP.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void startRound(int rowNum);
+
+	/**
+	 * The function computes the age of a cut in the current round.
+	 * \param[in] key hash value of the cut;
+	 * \param[in] binding `true` if the cut is binding for the current LP solution.
+	 * \return age of the cut.
+	 */
+	int update(unsigned long long key, bool binding);
+
+	/**
+	 * \return current threshold; cuts of this age and older are to be evicted.
+	 */
+	int getThreshold() const
+		{return m_iAge;}
+
+	/**
+	 * The function finishes the current round and adapts the threshold.
+	 * \param[in] rowNum number of cuts in the LP;
+	 * \param[in] evictNum number of cuts evicted.
+	 */
+	void finishRound(int rowNum, int evictNum);
+
+	/**
+	 * The function prints the numbers of rounds and evicted cuts.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+};
+
+#endif // #ifndef __CUTAGING__H
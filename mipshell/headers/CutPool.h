@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file CutPool.h interface for `CCutPool` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CUTPOOL__H
+#define __CUTPOOL__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <thread.h>
+
+#define CUTPOOL_BATCH 256 ///< cuts are checked for violation in batches of `CUTPOOL_BATCH` cuts.
+#define CUTPOOL_TOL 1.0e-6 ///< a normalized cut is violated if one of its sides is violated by more than `CUTPOOL_TOL`.
+#define CUTPOOL_PAR_NZ 65536 ///< the pool is separated by several threads only if it has at least `CUTPOOL_PAR_NZ` entries.
+
+/**
+ * `CCutPool` stores global cuts generated by __MIPshell__ (by `CProblem::separate()`,
+ * `CProblem::gencut()`, and root racers), and separates them from node LP solutions.
+ *
+ * Each cut
+ *  \f$b_1 \le \sum_{i=0}^{sz-1} a_i x_{hd_i} \le b_2\f$
+ * is normalized (divided by \f$\max_i |a_i|\f$, its entries are sorted by handles),
+ * and then is stored as a compressed row in arrays shared by all cuts.
+ * A hash table indexed by hash values of normalized cuts allows to detect duplicates in constant time.
+ *
+ * To separate the pool, cuts are split into batches of `CUTPOOL_BATCH` consecutive cuts,
+ * and the batches are processed by a number of threads.
+ * The pool is shared by all the threads of the branch-and-cut procedure, and is locked by a mutex.
+ */
+class MIPSHELL_API CCutPool
+{
+	int m_iThreadNum; ///< number of threads used to separate the pool; `0` means that this number is chosen by the solver.
+	int m_iHdNum; ///< all cut handles are less than `m_iHdNum`.
+
+	int m_iCutNum; ///< number of cuts in the pool.
+	int m_iMaxCutNum; ///< size of memory allocated for cuts.
+	int m_iNZ; ///< number of entries of all cuts.
+	int m_iMaxNZ; ///< size of memory allocated for entries.
+	double *m_dpB; ///< `m_dpB[2*i]` and `m_dpB[2*i+1]` are left and right hand sides of cut `i`.
+	int *m_ipBeg; ///< cut `i` is stored in positions `m_ipBeg[i],...,m_ipBeg[i+1]-1` of `m_dpVal` and `m_ipHd`.
+	double *m_dpVal; ///< cut coefficients.
+	int *m_ipHd; ///< variable handles of cut coefficients.
+	unsigned long long *m_ulpHash; ///< `m_ulpHash[i]` is hash value of cut `i`.
+
+	int m_iTableSize; ///< size of hash table, a power of 2.
+	int *m_ipTable; ///< hash table, `m_ipTable[k]` is a cut index, or `-1` if entry `k` is free.
+
+	int *m_ipInd; ///< array of size `m_iHdNum` used when sorting cut entries.
+	char *m_cpViolated; ///< `m_cpViolated[i]` is not zero if cut `i` is violated by the solution being separated.
+
+	const double *m_dpX; ///< solution being separated, `m_dpX[j]` is value of variable with handle `j`.
+	double m_dTol; ///< tolerance used to decide whether a cut is violated.
+	int m_iNextBatch; ///< next batch of cuts to be checked.
+
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< Locks the pool.
+	_MUTEX m_batchMutex; ///< Locks `m_iNextBatch`.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] threadNum number of threads used to separate the pool; if `threadNum=0`, this number is chosen by the solver.
+	 */
+	CCutPool(int threadNum=0);
+	virtual ~CCutPool(); ///< The destructor.
+
+	/**
+	 * \return number of threads used to separate the pool; `0` means that this number is chosen by the solver.
+	 */
+	int getThreadNum() const
+		{return m_iThreadNum;}
+
+	/**
+	 * \return number of cuts in the pool.
+	 */
+	int getCutNum() const
+		{return m_iCutNum;}
+
+	/**
+	 * The function empties the pool.
+	 * \param[in] hdNum all cut handles must be less than `hdNum`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void reset(int hdNum);
+
+	/**
+	 * The function adds the cut
+	 * \f$b_1 \le \sum_{i=0}^{sz-1} dpVal[i] x_{ipHd[i]} \le b_2\f$
+	 * to the pool if the pool does not contain the same cut.
+	 * \param[in] b1,b2 left and right hand sides;
+	 * \param[in] sz,dpVal,ipHd cut coefficients.
+	 * \return `true` if the cut has been added, and `false` if it is a duplicate (or it is empty, or it has a handle not less than `m_iHdNum`).
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool add(double b1, double b2, int sz, const double* dpVal, const int* ipHd);
+
+	/**
+	 * The function finds all the cuts from the pool that are violated by a given solution,
+	 * and then calls `sendCut()` for each of them (with the pool being locked).
+	 * \param[in] dpX solution, `dpX[j]` is value of variable with handle `j`;
+	 * \param[in] threadNum number of threads;
+	 * \param[in] tol a cut is violated if one of its sides is violated by more than `tol`;
+	 * \param[in] sendCut function that is called for every violated cut; if `sendCut=0`, violated cuts are only counted;
+	 * \param[in] param first parameter passed to `sendCut()`.
+	 * \return number of violated cuts.
+	 * \throws CMemoryException lack of memory.
+	 */
+	int separate(const double* dpX, int threadNum, double tol,
+		void (*sendCut)(void* param, double b1, double b2, int sz, const double* dpVal, const int* ipHd), void* param);
+
+private:
+	void allocMem(int cutNum, int nz); ///< \throws CMemoryException lack of memory.
+	void rehash(int tableSize); ///< \throws CMemoryException lack of memory.
+
+	/**
+	 * \param[in] i cut index.
+	 * \return hash value of cut `i`.
+	 */
+	unsigned long long hash(int i) const;
+
+	/**
+	 * \param[in] i,k cut indices.
+	 * \return `true` if cuts `i` and `k` are identical.
+	 */
+	bool isEqual(int i, int k) const;
+
+	void checkBatches(); ///< checks batches which indices are taken from `m_iNextBatch`.
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of threads created in `separate()`.
+	 * \param[in] param pointer to `CCutPool` object.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+};
+
+#endif // #ifndef __CUTPOOL__H
@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file CutSelector.h interface for `CCutSelector` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CUTSELECTOR__H
+#define __CUTSELECTOR__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <iostream>
+
+/// Families of cuts generated by __MIPshell__.
+enum enCutFamily {
+	CUT_SEPARATE = 0, ///< cuts generated by `CProblem::separate()`.
+	CUT_GENCUT   = 1, ///< cuts generated by `CProblem::gencut()`.
+	CUT_POOL     = 2, ///< cuts taken from `CCutPool`.
+	CUT_SEPARATOR = 3, ///< cuts generated by separators run concurrently by `CConcurrentSep`.
+	CUT_LIFT_PROJECT = 4, ///< lift-and-project cuts generated by `CLiftProject`.
+	CUT_FAMILY_NUM = 5 ///< number of cut families.
+};
+
+/**
+ * `CCutSelector` chooses a diverse subset of the cuts generated in one separation round.
+ *
+ * For each candidate cut \f$b_1 \le a^Tx \le b_2\f$ and the solution \f$x^*\f$ being separated, it computes
+ *   - _efficacy_, which is the distance from \f$x^*\f$ to the violated hyperplane, \f$(a^Tx^*-b_2)/\|a\|\f$ or \f$(b_1-a^Tx^*)/\|a\|\f$;
+ *   - _objective parallelism_, \f$|c^Ta|/(\|c\|\cdot\|a\|)\f$, where \f$c\f$ is the objective vector;
+ *   - _orthogonality_ to the cuts already selected, \f$1-\max_s |a^Ta_s|/(\|a\|\cdot\|a_s\|)\f$.
+ *
+ * The score of a cut is the weighted sum of its efficacy (divided by the maximum efficacy), parallelism, and orthogonality.
+ * The cuts are selected greedily: the cut of maximum score is taken, the orthogonalities of the remaining cuts are updated,
+ * and the cuts which orthogonality is less than a given threshold are discarded.
+ *
+ * Every thread of the solver has its own selector; the objective vector and statistics are shared by all of them.
+ */
+class MIPSHELL_API CCutSelector
+{
+	bool m_bOwner; ///< `true` if this object has allocated the shared arrays.
+	double m_dEffWeight; ///< weight of efficacy.
+	double m_dOrthoWeight; ///< weight of orthogonality.
+	double m_dParWeight; ///< weight of objective parallelism.
+	double m_dMinOrtho; ///< cuts which orthogonality is less than `m_dMinOrtho` are discarded.
+	int m_iMaxCutNum; ///< maximum number of cuts selected in one round; `0` means no limit.
+
+// shared
+	int m_iHdNum; ///< all cut handles are less than `m_iHdNum`.
+	double *m_dpC; ///< objective vector, `m_dpC[j]` is coefficient of variable with handle `j`.
+	double m_dCNorm; ///< Euclidean norm of `m_dpC`.
+	std::atomic<int> *m_ipGenerated; ///< `m_ipGenerated[f]` is number of cuts of family `f` passed to selectors.
+	std::atomic<int> *m_ipAccepted; ///< `m_ipAccepted[f]` is number of cuts of family `f` accepted by selectors.
+
+// candidates
+	int m_iCandNum; ///< number of candidates.
+	int m_iMaxCandNum; ///< size of memory allocated for candidates.
+	int m_iNZ; ///< number of entries of all candidates.
+	int m_iMaxNZ; ///< size of memory allocated for entries.
+	double *m_dpB; ///< `m_dpB[2*i]` and `m_dpB[2*i+1]` are left and right hand sides of candidate `i`.
+	int *m_ipBeg; ///< candidate `i` is stored in positions `m_ipBeg[i],...,m_ipBeg[i+1]-1` of `m_dpVal` and `m_ipHd`.
+	double *m_dpVal; ///< candidate coefficients.
+	int *m_ipHd; ///< variable handles of candidate coefficients.
+	unsigned *m_ipType; ///< `m_ipType[i]` is type of candidate `i`.
+	int *m_ipFamily; ///< `m_ipFamily[i]` is family of candidate `i`.
+	double *m_dpEff; ///< `m_dpEff[i]` is efficacy of candidate `i`.
+	double *m_dpNorm; ///< `m_dpNorm[i]` is Euclidean norm of candidate `i`.
+	double *m_dpScore; ///< `m_dpScore[i]` is weighted objective parallelism of candidate `i`.
+	double *m_dpOrtho; ///< `m_dpOrtho[i]` is orthogonality of candidate `i` to selected cuts; it is negative for dropped candidates.
+	int *m_ipSelected; ///< list of selected candidates.
+	int m_iSelectedNum; ///< number of selected candidates.
+	double *m_dpDense; ///< array of size `m_iHdNum` used to scatter selected cuts.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] effWeight weight of efficacy;
+	 * \param[in] orthoWeight weight of orthogonality;
+	 * \param[in] parWeight weight of objective parallelism;
+	 * \param[in] minOrtho cuts which orthogonality to selected cuts is less than `minOrtho` are discarded;
+	 * \param[in] maxCutNum maximum number of cuts selected in one round; if `maxCutNum=0`, the number of cuts is not limited.
+	 */
+	CCutSelector(double effWeight, double orthoWeight, double parWeight, double minOrtho, int maxCutNum);
+
+	/**
+	 * The clone constructor: the objective vector and statistics of `other` are shared with the new object.
+	 * \param[in] other object to be cloned.
+	 * \throws CMemoryException lack of memory.
+	 */
+	CCutSelector(const CCutSelector &other);
+
+	virtual ~CCutSelector(); ///< The destructor.
+
+	/**
+	 * The function sets the objective vector and resets statistics.
+	 * \param[in] hdNum all cut handles must be less than `hdNum`;
+	 * \param[in] dpC array of size `hdNum`, `dpC[j]` is objective coefficient of variable with handle `j`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setObjective(int hdNum, const double* dpC);
+
+	/**
+	 * The function adds a candidate cut
+	 * \f$b_1 \le \sum_{i=0}^{sz-1} dpVal[i] x_{ipHd[i]} \le b_2\f$.
+	 * \param[in] family cut family;
+	 * \param[in] type cut type;
+	 * \param[in] b1,b2 left and right hand sides;
+	 * \param[in] sz,dpVal,ipHd cut coefficients.
+	 * \return `false` if the cut has a handle not less than `m_iHdNum`; such cuts are not added.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool addCand(int family, unsigned type, double b1, double b2, int sz, const double* dpVal, const int* ipHd);
+
+	/**
+	 * The function appends all candidates of another selector to the list of candidates of this selector;
+	 * the statistics are not changed, since the candidates have already been counted by `other`.
+	 * \param[in] other selector, usually a per-thread buffer cloned from this selector.
+	 * \return number of candidates appended.
+	 * \throws CMemoryException lack of memory.
+	 */
+	int merge(const CCutSelector &other);
+
+	/**
+	 * \return number of candidates.
+	 */
+	int getCandNum() const
+		{return m_iCandNum;}
+
+	/**
+	 * The function selects candidates to be sent to the solver.
+	 * \param[in] dpX solution being separated, `dpX[j]` is value of variable with handle `j`.
+	 * \return number of selected cuts.
+	 */
+	int select(const double* dpX);
+
+	/**
+	 * The function returns selected cut `k`.
+	 * \param[in] k index in the list of selected cuts, `0 <= k < select()`;
+	 * \param[out] type cut type;
+	 * \param[out] b1,b2 left and right hand sides;
+	 * \param[out] dpVal,ipHd cut coefficients.
+	 * \return number of entries in cut.
+	 */
+	int getSelected(int k, unsigned &type, double &b1, double &b2, const double* &dpVal, const int* &ipHd) const;
+
+	/**
+	 * \param[in] k index in the list of selected cuts, `0 <= k < select()`.
+	 * \return family of selected cut `k`.
+	 */
+	int getSelectedFamily(int k) const
+		{return m_ipFamily[m_ipSelected[k]];}
+
+	/**
+	 * The function removes all candidates.
+	 */
+	void clear()
+		{m_iCandNum=m_iNZ=m_iSelectedNum=0;}
+
+	/**
+	 * The function prints how many cuts of each family were generated and accepted.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	void allocMem(int candNum, int nz); ///< \throws CMemoryException lack of memory.
+	void allocMemForDense(); ///< \throws CMemoryException lack of memory.
+};
+
+#endif // #ifndef __CUTSELECTOR__H
@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file CutStat.h interface for `CCutStat` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __CUTSTAT__H
+#define __CUTSTAT__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <iostream>
+#include "CutSelector.h"
+
+#define CUTSTAT_AUTO CUT_FAMILY_NUM ///< index of statistics of cuts generated by the __MIPCL__ core.
+#define CUTSTAT_NUM (CUT_FAMILY_NUM+1) ///< number of cut families for which statistics is collected.
+#define CUTSTAT_NONE 0xF ///< family of cuts which origin is unknown; they are not accounted for.
+#define CUTSTAT_AGE_NUM 3 ///< cuts are counted when they have been in the LP for 1, 10, and 100 rounds.
+
+/// Statistics of one cut family.
+struct tagCutFamilyStat {
+	double time; ///< wall time (in seconds) spent in cut generating procedures of the family.
+	int callNum; ///< number of calls to cut generating procedures of the family.
+	int cutNum; ///< number of cuts of the family added to node LPs.
+	double boundGain; ///< decrease of LP bounds attributed to cuts of the family.
+	int aliveNum[CUTSTAT_AGE_NUM]; ///< `aliveNum[0]`, `aliveNum[1]`, and `aliveNum[2]` are numbers of cuts that have been in the LP for 1, 10, and 100 rounds.
+};
+
+/**
+ * `CCutStat` measures how profitable each family of cuts (see `enCutFamily`) is.
+ *
+ * For every family, it records the time spent generating cuts, the number of calls,
+ * the number of cuts added to the LP, the improvement of the LP bound,
+ * and how many cuts survive in the LP for 1, 10, and 100 separation rounds.
+ * Cuts generated by the __MIPCL__ core are accounted for as a separate family `CUTSTAT_AUTO`;
+ * since they are added to the LP after `CProblem::separate()` returns,
+ * they are seen only from the next round on, and their time is not measured.
+ *
+ * The bound improvement between two consecutive rounds at the same node
+ * is shared among the families in proportion to the numbers of cuts they added in the earlier round.
+ * As the solver renumbers rows when it deletes them, cuts are identified by hash values of their rows (see `CCutAging::hashRow()`);
+ * at every round, the cuts present in the LP are written into a new hash table, and the table of the previous round is dropped.
+ *
+ * Every thread has its own object; statistics are shared by all of them.
+ */
+class MIPSHELL_API CCutStat
+{
+	friend class CProblem;
+
+	/// Statistics shared by all the threads.
+	struct tagStat {
+		std::atomic<int> roundNum; ///< number of rounds.
+		std::atomic<long long> lpTime[CUTSTAT_NUM]; ///< `lpTime[f]` is time (in microseconds) spent by family `f`.
+		std::atomic<int> callNum[CUTSTAT_NUM]; ///< `callNum[f]` is number of calls of family `f`.
+		std::atomic<int> cutNum[CUTSTAT_NUM]; ///< `cutNum[f]` is number of cuts of family `f` added to LPs.
+		std::atomic<double> gain[CUTSTAT_NUM]; ///< `gain[f]` is bound improvement attributed to family `f`.
+		std::atomic<int> aliveNum[CUTSTAT_NUM][CUTSTAT_AGE_NUM]; ///< `aliveNum[f][k]` is number of cuts of family `f` that reached age `k`-th checkpoint.
+		tagStat(); ///< The constructor.
+	};
+
+	tagStat* m_pStat; ///< statistics (owned by the object created by `CCutStat()`).
+	bool m_bOwner; ///< `true` if `m_pStat` is owned by this object.
+
+	int m_iNode; ///< node of the previous round, or `-1`.
+	bool m_bSameNode; ///< `true` if the previous and current rounds are at the same node.
+	double m_dObj; ///< LP bound at the previous round.
+	int m_ipRoundCutNum[CUTSTAT_NUM]; ///< `m_ipRoundCutNum[f]` is number of cuts of family `f` added at the previous round (cuts of the core are counted when they are found at the current round).
+
+	int m_iTableSize; ///< size of hash table of the previous round, a power of 2.
+	int m_iMaxTableSize; ///< size of memory allocated for `m_ulpKey` and `m_ipInfo`.
+	int m_iKeyNum; ///< number of keys in the table of the previous round.
+	unsigned long long *m_ulpKey; ///< keys of the previous round, `0` marks free entries.
+	int *m_ipInfo; ///< `m_ipInfo[k]` is `(age << 4) | family` for the cut with key `m_ulpKey[k]`; `family=CUTSTAT_NONE` for cuts of unknown origin.
+	int m_iNewTableSize; ///< size of hash table of the current round.
+	int m_iMaxNewTableSize; ///< size of memory allocated for `m_ulpNewKey` and `m_ipNewInfo`.
+	unsigned long long *m_ulpNewKey; ///< keys of the current round.
+	int *m_ipNewInfo; ///< ages and families of the current round.
+
+	int m_iMaxColNum; ///< size of `m_dpVal` and `m_ipCol`.
+	double *m_dpVal; ///< working array to store row coefficients.
+	int *m_ipCol; ///< working array to store row columns.
+
+public:
+	CCutStat(); ///< The constructor.
+
+	/**
+	 * The clone constructor creates an object for another thread; statistics are shared with `other`.
+	 * \param[in] other object to be cloned.
+	 */
+	CCutStat(const CCutStat &other);
+
+	virtual ~CCutStat(); ///< The destructor.
+
+	/**
+	 * The function makes working arrays large enough for rows of `n` entries.
+	 * \param[in] n number of columns.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void allocMemForRows(int n);
+
+	/**
+	 * The function starts a new round.
+	 * \param[in] node index of the node being processed;
+	 * \param[in] rowNum number of cuts in the LP.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void startRound(int node, int rowNum);
+
+	/**
+	 * The function moves a cut present in the LP into the table of the current round, and increases its age;
+	 * cuts that are not in the table of the previous round are attributed to `CUTSTAT_AUTO`
+	 * if the previous round was at the same node.
+	 * \param[in] key hash value of the cut.
+	 */
+	void update(unsigned long long key);
+
+	/**
+	 * The function finishes the current round, and attributes the bound improvement to the cuts added at the previous round.
+	 * \param[in] obj current LP bound (the solver always maximizes).
+	 */
+	void finishRound(double obj);
+
+	/**
+	 * The function registers a cut just added to the LP.
+	 * \param[in] key hash value of the cut;
+	 * \param[in] family cut family.
+	 */
+	void addCut(unsigned long long key, int family);
+
+private:
+	/**
+	 * The function allocates memory for the hash table of the current round.
+	 * \param[in] size table size, a power of 2.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void allocNewTable(int size);
+
+	/**
+	 * The function swaps the tables of the previous and current rounds.
+	 */
+	void swapTables();
+
+public:
+	/**
+	 * The function adds the time of one call of a cut generating procedure.
+	 * \param[in] family cut family;
+	 * \param[in] time time in microseconds.
+	 */
+	void addTime(int family, long long time)
+	{
+		m_pStat->callNum[family].fetch_add(1,std::memory_order_relaxed);
+		m_pStat->lpTime[family].fetch_add(time,std::memory_order_relaxed);
+	}
+
+	/**
+	 * \param[in] family cut family, `0 <= family < CUTSTAT_NUM`;
+	 * \param[out] stat statistics of `family`.
+	 */
+	void getStat(int family, tagCutFamilyStat& stat) const;
+
+	/**
+	 * The function prints statistics of all cut families.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+};
+
+#endif // #ifndef __CUTSTAT__H
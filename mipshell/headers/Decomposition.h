@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Decomposition.h interface for `CDecomposition` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __DECOMPOSITION__H
+#define __DECOMPOSITION__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <thread.h>
+#include "MatrixCopy.h"
+
+/**
+ * `CDecomposition` solves MIPs which matrices are block diagonal.
+ *
+ * Columns of the original problem are split into connected components:
+ * two columns are in the same component if they both have nonzero entries in some row.
+ * If there are at least two components, each component is solved as an independent `CMIP` object,
+ * and different components are solved in parallel.
+ * Columns without nonzero entries are set to their best bounds.
+ * Since the components are linked only by the objective,
+ * the optimal solution of the whole problem is composed of optimal solutions of its components,
+ * and its objective value is the sum of their objective values.
+ */
+class MIPSHELL_API CDecomposition
+{
+	friend class CProblem;
+
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	int m_iThreadNum; ///< number of threads; `0` means that this number is chosen by the solver.
+	int m_iCompThreadNum; ///< number of threads used by the solver of each component.
+
+	int m_iCompNum; ///< number of components.
+	int *m_ipCompColBeg; ///< columns of component `k` are `m_ipCompCol[m_ipCompColBeg[k]],...,m_ipCompCol[m_ipCompColBeg[k+1]-1]`.
+	int *m_ipCompCol; ///< columns sorted by components; columns without nonzero entries are at the end.
+	int *m_ipCompRowBeg; ///< rows of component `k` are `m_ipCompRow[m_ipCompRowBeg[k]],...,m_ipCompRow[m_ipCompRowBeg[k+1]-1]`.
+	int *m_ipCompRow; ///< rows sorted by components.
+	int m_iNextComp; ///< next component to be solved.
+
+	int *m_ipCompState; ///< `m_ipCompState[k]` is `0` if no solution of component `k` has been found, `1` if a solution has been found, and `2` if it is optimal.
+	double *m_dpCompObj; ///< `m_dpCompObj[k]` is optimal objective value of component `k`.
+
+	bool m_bSolved; ///< `true` if all components have been solved to optimality.
+	bool m_bRec; ///< `true` if solutions of all components have been found, but some of them are not optimal.
+	double m_dObjVal; ///< objective value of composed solution.
+	double *m_dpX; ///< composed solution, `m_dpX[j]` is value of variable with handle `j`.
+	int *m_ipHd; ///< `m_ipHd[j]=j`, handles of components of `m_dpX`.
+
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< Locks `m_iNextComp`.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] threadNum number of threads; if `threadNum=0`, this number is chosen by the solver.
+	 */
+	CDecomposition(int threadNum=0);
+	virtual ~CDecomposition(); ///< The destructor.
+
+	/**
+	 * The function computes connected components of the problem stored in `m_copy`.
+	 * Columns without nonzero entries do not belong to any component.
+	 * \return number of components.
+	 * \throws CMemoryException lack of memory.
+	 */
+	int decompose();
+
+	/**
+	 * The function solves all components and composes the solution of the whole problem.
+	 * \param[in] threadNum total number of threads.
+	 * \return `true` if all components have been solved to optimality.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool solve(int threadNum);
+
+	bool isSolved() const
+		{return m_bSolved;} ///< \return `true` if all components have been solved to optimality.
+
+	double getObjVal() const
+		{return m_dObjVal;} ///< \return objective value of composed solution.
+
+	/**
+	 * \return array of size `m_copy.getColNum()`, its `j`-th entry is value of variable with handle `j` in composed solution.
+	 */
+	double* getSolution() const
+		{return m_dpX;}
+
+private:
+	void solveComponents(); ///< solves components which indices are taken from `m_iNextComp`.
+
+	/**
+	 * The function sets all columns without nonzero entries to their best bounds.
+	 * \return `false` if objective is unbounded.
+	 */
+	bool solveIsolatedColumns();
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of threads created in `solve()`.
+	 * \param[in] param pointer to `CDecomposition` object.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+};
+
+#endif // #ifndef __DECOMPOSITION__H
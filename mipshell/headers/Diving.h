@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Diving.h interface for `CDiving` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __DIVING__H
+#define __DIVING__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <iostream>
+#include <thread.h>
+#include "MatrixCopy.h"
+
+class CIncumbent;
+class CLP;
+class CHeurScheduler;
+
+/**
+ * `CDiving` implements a portfolio of diving heuristics.
+ *
+ * A dive starts from the LP relaxation of a copy of the original problem.
+ * At every step, a few fractional integer variables, the best ones for the strategy, are rounded (their bounds are changed),
+ * and the LP is reoptimized. If the LP becomes infeasible, only the best rounding is kept;
+ * if the LP is still infeasible, that rounding is reversed, and the dive is abandoned if this does not help.
+ * A dive stops when the LP solution is integral (a new solution is found), or when the LP objective is not better than the record.
+ * Strategies differ in the choice of the variable to be rounded and the rounding direction:
+ *   - _fractional_ diving rounds the variables which values are closest to integers;
+ *   - _coefficient_ diving rounds in the direction with fewer locks (rows which may become violated);
+ *   - _pseudocost_ diving uses pseudocosts learned from the previous diving steps;
+ *   - _vector length_ diving prefers variables occurring in many rows, rounding them in the direction which worsens the objective least per row;
+ *   - _guided_ diving rounds towards the record solution;
+ *   - _conflict_ diving avoids the directions which led to infeasible LPs in the previous dives.
+ *
+ * After the root node has been processed, dives are run on a number of idle threads,
+ * each of which solves its own copy of the LP.
+ * Every time a thread starts a new dive, it draws a strategy at random,
+ * the probability of each strategy being proportional to its success rate (the share of its dives that found improving solutions);
+ * if a heuristic scheduler is set, the strategy is chosen by the scheduler, and dives are made only within its time budget.
+ * After a number of unsuccessful dives in a row, a thread sleeps for longer and longer time,
+ * and it is woken up when the record solution changes.
+ * Solutions found are stored in `CDiving`, and `CProblem` passes them to the solver (by calling `changeRecord()`)
+ * when the main thread processes the next node or cut round.
+ * In the single-threaded version, every strategy is run once after the root node.
+ */
+class MIPSHELL_API CDiving
+{
+	friend class CProblem;
+public:
+	/// Diving strategies.
+	enum enStrategy {
+		DIVE_FRACTIONAL, ///< fractional diving.
+		DIVE_COEFFICIENT, ///< coefficient diving.
+		DIVE_PSEUDOCOST, ///< pseudocost diving.
+		DIVE_VECTOR_LENGTH, ///< vector length diving.
+		DIVE_GUIDED, ///< guided diving.
+		DIVE_CONFLICT, ///< conflict diving.
+		DIVE_NUM ///< number of strategies.
+	};
+
+private:
+	/// Working data of one diving thread.
+	struct tagDiver {
+		unsigned long long seed; ///< state of random number generator.
+		int failNum; ///< number of unsuccessful dives in a row.
+		double *dpX; ///< LP solution, `dpX[j]` is value of variable `j`.
+		double *dpD; ///< `dpD[2*j]` and `dpD[2*j+1]` are current lower and upper bounds of variable `j`.
+		double *dpRecX; ///< record solution used by guided diving, `dpRecX[j]` is value of variable `j`.
+		double *dpPc; ///< `dpPc[2*j]` (`dpPc[2*j+1]`) is sum of per-unit objective increases observed when rounding variable `j` down (up).
+		int *ipPcNum; ///< `ipPcNum[2*j]` (`ipPcNum[2*j+1]`) is number of observations summed up in `dpPc[2*j]` (`dpPc[2*j+1]`).
+		double dpPcTotal[2]; ///< `dpPcTotal[0]` (`dpPcTotal[1]`) is sum of all down (up) observations, used for variables without their own observations.
+		int ipPcTotal[2]; ///< `ipPcTotal[0]` (`ipPcTotal[1]`) is number of down (up) observations.
+		int *ipConflict; ///< `ipConflict[2*j]` (`ipConflict[2*j+1]`) is number of infeasible LPs obtained after rounding variable `j` down (up).
+		double *dpScore; ///< `dpScore[k]` is score of candidate `ipCand[k]`, the less the better.
+		double *dpBatchX; ///< `dpBatchX[k]` is LP value of variable `ipCand[k]/2` when it was rounded at the last step.
+		double *dpBatchOld; ///< `dpBatchOld[k]` is the bound of variable `ipCand[k]/2` changed at the last step.
+		int *ipFixed; ///< list of variables which bounds have been changed in the current dive.
+		int *ipCand; ///< candidates for rounding, `ipCand[k]=2*j+d`, where `j` is variable, and `d` is `0` (`1`) for rounding down (up);
+			///< the first entries are the candidates rounded at the last step.
+		int *ipHd; ///< working array of size `n`.
+	};
+
+	/// Parameter passed to a diving thread.
+	struct tagThreadParam {
+		CDiving* pDiving; ///< diving object.
+		int thread; ///< thread index.
+	};
+
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	int m_iThreadNum; ///< number of diving threads; `0` means that all idle processors are used.
+	CIncumbent* m_pInc; ///< record solution of the whole problem.
+	CHeurScheduler* m_pSched; ///< if not `0`, strategies are chosen, and their time is accounted, by this scheduler.
+	int m_ipHeur[DIVE_NUM]; ///< `m_ipHeur[k]` is index of strategy `k` in `m_pSched`.
+	std::atomic<bool> m_bStop; ///< when set to `true`, all dives are stopped.
+	bool m_bStarted; ///< `true` if `start()` has been called.
+
+// data shared by all threads
+	int m_iIntNum; ///< number of integer variables.
+	double *m_dpC; ///< objective of minimization problem, `m_dpC[j]` is coefficient of variable `j`.
+	int *m_ipLock; ///< `m_ipLock[2*j]` (`m_ipLock[2*j+1]`) is number of rows which may become violated when variable `j` decreases (increases).
+	int *m_ipColLen; ///< `m_ipColLen[j]` is number of rows containing variable `j`.
+
+// record
+	std::atomic<bool> m_bRec; ///< `true` if a solution has been found and not yet passed to the solver.
+	double m_dRecObj; ///< objective value of best solution found.
+	int m_iRecNum; ///< number of components in `m_dpRecX` and `m_ipRecHd`, `0` if no solution has been found.
+	double *m_dpRecX; ///< `m_dpRecX[i]` is value of variable with handle `m_ipRecHd[i]` in best solution found.
+	int *m_ipRecHd; ///< handles of solution components.
+
+// statistics
+	int m_ipCallNum[DIVE_NUM]; ///< `m_ipCallNum[k]` is number of dives made by strategy `k`.
+	int m_ipSolNum[DIVE_NUM]; ///< `m_ipSolNum[k]` is number of improving solutions found by strategy `k`.
+	int m_ipLpNum[DIVE_NUM]; ///< `m_ipLpNum[k]` is number of LPs solved by strategy `k`.
+	double m_dpTime[DIVE_NUM]; ///< `m_dpTime[k]` is time (in seconds) spent by strategy `k`.
+
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< Locks the record and statistics.
+	_THREAD *m_pThread; ///< diving threads.
+	tagThreadParam *m_pParam; ///< `m_pParam[t]` is parameter passed to thread `m_pThread[t]`.
+	int m_iStartedNum; ///< number of threads created and not joined yet.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] threadNum number of diving threads; if `threadNum=0`, all processors not used by the solver are used.
+	 */
+	CDiving(int threadNum=0);
+	virtual ~CDiving(); ///< The destructor.
+
+	/**
+	 * The function starts diving threads (in the single-threaded version, it makes one dive of every strategy).
+	 * \param[in] pInc record solution of the whole problem;
+	 * \param[in] idleNum number of processors not used by the solver.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void start(CIncumbent* pInc, int idleNum);
+
+	/**
+	 * The function registers all strategies with a heuristic scheduler.
+	 * \param[in] pSched scheduler.
+	 */
+	void setScheduler(CHeurScheduler* pSched);
+
+	/**
+	 * The function stops all dives, and waits until diving threads finish.
+	 */
+	void stop();
+
+	/**
+	 * \return `true` if `start()` has been called.
+	 */
+	bool isStarted() const
+		{return m_bStarted;}
+
+	/**
+	 * The function prints the number of dives, the number of improving solutions found,
+	 * the number of LPs solved, and running time for every strategy.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	/**
+	 * The function computes the data shared by all diving threads.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void prepare();
+
+	/**
+	 * The function makes dives.
+	 * \param[in] thread index of calling thread;
+	 * \param[in] wait if `true`, the function makes dives until `m_bStop` is set;
+	 *  otherwise, it returns after every strategy has been run once.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void run(int thread, bool wait);
+
+	/**
+	 * The function draws a strategy at random with probabilities proportional to success rates of strategies;
+	 * if `m_pSched` is set, the strategy is chosen by the scheduler.
+	 * \param[in] r random number in `[0,1)`;
+	 * \param[in] rec `true` if a record solution is known (otherwise, guided diving cannot be chosen).
+	 * \return strategy (see `enStrategy`).
+	 */
+	int chooseStrategy(double r, bool rec);
+
+	/**
+	 * The function makes one dive.
+	 * \param[in] lp LP relaxation of the problem, which bounds are those of the original problem;
+	 *  on return, the bounds are restored;
+	 * \param[in] strategy diving strategy (see `enStrategy`);
+	 * \param[in] cutoff the dive stops when objective value (of the minimization problem) is not less than `cutoff`;
+	 * \param[in,out] w working data of calling thread;
+	 * \param[out] lpNum number of LPs solved.
+	 * \return `true` if an improving solution has been found.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool dive(CLP& lp, int strategy, double cutoff, tagDiver& w, int& lpNum);
+
+	/**
+	 * The function lists the fractional integer variables of the LP solution, and scores them.
+	 * \param[in] strategy diving strategy (see `enStrategy`);
+	 * \param[in,out] w working data of calling thread, on return `w.ipCand` and `w.dpScore` store the candidates and their scores.
+	 * \return number of candidates, `0` if the LP solution is integral.
+	 */
+	int select(int strategy, tagDiver& w) const;
+
+	/**
+	 * The function gets the best of the record solution of the whole problem and the best solution found by this object.
+	 * \param[out] dpRecX array of size `2*m_copy.getColNum()`, `dpRecX[j]` is value of variable `j` in returned solution;
+	 *  the second half of the array is used as working memory;
+	 * \param[out] objVal objective value of returned solution;
+	 * \param ipHd working array of size `m_copy.getColNum()`.
+	 * \return `false` if no solution is known.
+	 */
+	bool getRecord(double* dpRecX, double& objVal, int* ipHd);
+
+	/**
+	 * The function stores a solution if it is better than the best solution found so far.
+	 * \param[in] objVal objective value (of the original problem);
+	 * \param[in] dpX solution, `dpX[j]` is value of variable `j`.
+	 * \return `true` if the solution has been stored.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool setRecord(double objVal, const double* dpX);
+
+	/**
+	 * \param[in] dpX point.
+	 * \return `true` if `dpX` satisfies all constraints of the original problem.
+	 */
+	bool isFeasible(const double* dpX) const;
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of a diving thread.
+	 * \param[in] param pointer to `tagThreadParam` structure.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+};
+
+#endif // #ifndef __DIVING__H
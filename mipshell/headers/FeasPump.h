@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file FeasPump.h interface for `CFeasPump` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __FEASPUMP__H
+#define __FEASPUMP__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <iostream>
+#include <thread.h>
+#include "MatrixCopy.h"
+
+class CLP;
+class CHeurScheduler;
+
+/**
+ * `CFeasPump` implements the _objective feasibility pump_, a primal heuristic which
+ * looks for a first feasible solution by alternating LP projections with rounding.
+ *
+ * The LP relaxation of a copy of the original problem is solved, and the integer variables of its solution \f$x^*\f$
+ * are rounded to get a point \f$\tilde{x}\f$. Then the LP is reoptimized (the dual simplex method starts from the previous basis)
+ * with the objective changed to
+ * \f[
+ *    (1-\alpha)\Delta(x,\tilde{x}) + \alpha \frac{\sqrt{|I|}}{\|c\|} c^Tx,
+ * \f]
+ * where \f$\Delta(x,\tilde{x})\f$ is the \f$L_1\f$-distance from \f$x\f$ to \f$\tilde{x}\f$ over the integer variables at their bounds
+ * (for general integer variables strictly between their bounds, the distance is linearized at \f$x^*\f$),
+ * \f$c\f$ is the objective written for minimization, and \f$\alpha\f$ is multiplied by `FEASPUMP_ALPHA_FACTOR` at every iteration.
+ * The new LP solution is rounded again, and so on, until the rounded point satisfies all the constraints.
+ *
+ * If rounding reproduces the previous point (a cycle of length one), the integer variables with the largest values of
+ * \f$|x^*_j-\tilde{x}_j|\f$ are flipped; if a point of one of a few previous iterations is reproduced (a longer cycle),
+ * every integer variable is flipped with a probability that grows with \f$|x^*_j-\tilde{x}_j|\f$.
+ *
+ * When the rounded point is feasible, its continuous variables are recomputed by solving the LP with
+ * the integer variables fixed and with the original objective. The solution is stored in `CFeasPump`,
+ * and `CProblem` passes it to the solver (by calling `changeRecord()`) when the main thread processes the next node or cut round.
+ * The pump is run either once before the root node is processed, or on a background thread while branch-and-cut proceeds.
+ */
+class MIPSHELL_API CFeasPump
+{
+	friend class CProblem;
+
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	int m_iMaxIterNum; ///< maximum number of pumping iterations.
+	bool m_bBackground; ///< if `true`, the pump is run on a background thread.
+	std::atomic<bool> m_bStop; ///< when set to `true`, the pump stops at the next iteration.
+	unsigned long long m_uSeed; ///< state of the random number generator.
+	CHeurScheduler* m_pSched; ///< if not `0`, the running time of the pump is accounted by this scheduler.
+	int m_iHeur; ///< index of the pump in `m_pSched`.
+
+// record
+	std::atomic<bool> m_bRec; ///< `true` if a solution has been found and not yet passed to the solver.
+	double m_dRecObj; ///< objective value of found solution.
+	int m_iRecNum; ///< number of components in `m_dpRecX` and `m_ipRecHd`.
+	double *m_dpRecX; ///< `m_dpRecX[i]` is value of variable with handle `m_ipRecHd[i]` in found solution.
+	int *m_ipRecHd; ///< handles of solution components.
+
+// statistics
+	int m_iIterNum; ///< number of pumping iterations done.
+	int m_iFlipNum; ///< number of short cycles broken by flipping variables.
+	int m_iPerturbNum; ///< number of long cycles broken by random perturbation.
+	bool m_bSolved; ///< `true` if the pump has found a feasible solution.
+	double m_dTime; ///< running time (in seconds).
+
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< Locks the record.
+	_THREAD m_thread; ///< background thread.
+	bool m_bThread; ///< `true` if `m_thread` has been created and not joined yet.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxIterNum maximum number of pumping iterations;
+	 * \param[in] background if `true`, the pump is run on a background thread.
+	 */
+	CFeasPump(int maxIterNum=100, bool background=false);
+	virtual ~CFeasPump(); ///< The destructor.
+
+	/**
+	 * The function runs the pump on `m_copy`; if `m_pSched` is set, the pump is run only within the time budget of the scheduler.
+	 * \return `true` if a feasible solution has been found.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool run();
+
+	/**
+	 * The function runs the pump on a background thread if `m_bBackground` is set, or calls `run()` otherwise.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void start();
+
+	/**
+	 * The function asks the background pump to stop, and waits until it finishes.
+	 */
+	void stop();
+
+	/**
+	 * The function registers the pump with a heuristic scheduler.
+	 * \param[in] pSched scheduler.
+	 */
+	void setScheduler(CHeurScheduler* pSched);
+
+	/**
+	 * \return `true` if the pump has found a feasible solution.
+	 */
+	bool isSolved() const
+		{return m_bSolved;}
+
+	/**
+	 * The function prints the number of pumping iterations, cycles broken, and running time.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	/**
+	 * The function builds the LP relaxation of `m_copy` with the objective to be minimized.
+	 * \param[out] lp LP, its matrix must not be opened yet;
+	 * \param[in] dpC objective coefficients (for minimization).
+	 * \throws CMemoryException lack of memory.
+	 */
+	void buildLp(CLP& lp, const double* dpC) const;
+
+	/**
+	 * \param[in] dpX point in the space of `m_copy` columns.
+	 * \return `true` if `dpX` satisfies all rows and column bounds of `m_copy`.
+	 */
+	bool isFeasible(const double* dpX) const;
+
+	/**
+	 * The function stores a found solution.
+	 * \param[in] n number of variables;
+	 * \param[in] dpX solution, `dpX[j]` is value of variable with handle `j`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setRecord(int n, const double* dpX);
+
+	double random(); ///< \return pseudo-random number uniformly distributed in \f$[0,1)\f$.
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of the background thread.
+	 * \param[in] param pointer to `CFeasPump` object.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+};
+
+#endif // #ifndef __FEASPUMP__H
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file HeurScheduler.h interface for `CHeurScheduler` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __HEURSCHEDULER__H
+#define __HEURSCHEDULER__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <chrono>
+#include <iostream>
+#include <thread.h>
+
+#define HEUR_MAX_NUM 16 ///< maximum number of heuristics managed by a scheduler.
+#define HEUR_TIME_PRIOR 0.1 ///< time (in seconds) added to the running time of every heuristic when its success rate is computed.
+
+/**
+ * `CHeurScheduler` decides which heuristics are called, and how much time they may spend.
+ *
+ * Every heuristic (a diving strategy, an LNS neighbourhood, the feasibility pump, ...) registers itself
+ * as an _arm_ of a multi-armed bandit, and reports the time spent and whether an improving solution has been found
+ * after every call. The success rate of a heuristic is the number of improving solutions per second,
+ * with one solution per `HEUR_TIME_PRIOR` seconds assumed a priori.
+ * When several heuristics compete, `select()` picks the one with the largest upper confidence bound (UCB1):
+ * the success rate normalized by the best rate plus `m_dExplore*sqrt(ln(N)/n)`,
+ * where `N` is the number of calls of all competitors, and `n` is the number of calls of the heuristic;
+ * heuristics that have not been called yet are selected first.
+ * A heuristic is admitted by `admit()` only if the total time spent by all heuristics does not exceed
+ * `m_dTimeFraction` of the time elapsed since `start()`; the first call of every heuristic is always admitted.
+ *
+ * Heuristics running on different threads share one scheduler, and its functions are serialized by a mutex.
+ */
+class MIPSHELL_API CHeurScheduler
+{
+	double m_dTimeFraction; ///< fraction of solution time which may be spent in heuristics.
+	double m_dExplore; ///< weight of the exploration term of upper confidence bounds.
+	std::chrono::steady_clock::time_point m_startTime; ///< time when `start()` was called.
+
+	int m_iHeurNum; ///< number of registered heuristics.
+	const char* m_sName[HEUR_MAX_NUM]; ///< `m_sName[k]` is name of heuristic `k`.
+	int m_ipCallNum[HEUR_MAX_NUM]; ///< `m_ipCallNum[k]` is number of calls of heuristic `k`.
+	int m_ipSolNum[HEUR_MAX_NUM]; ///< `m_ipSolNum[k]` is number of improving solutions found by heuristic `k`.
+	int m_ipSkipNum[HEUR_MAX_NUM]; ///< `m_ipSkipNum[k]` is number of calls of heuristic `k` refused by `admit()`.
+	double m_dpTime[HEUR_MAX_NUM]; ///< `m_dpTime[k]` is time (in seconds) spent by heuristic `k`.
+	double m_dTotalTime; ///< time (in seconds) spent by all heuristics.
+
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< serializes access to the statistics.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] timeFraction fraction of solution time which may be spent in heuristics;
+	 * \param[in] explore weight of the exploration term of upper confidence bounds.
+	 */
+	CHeurScheduler(double timeFraction=0.1, double explore=1.0);
+	virtual ~CHeurScheduler(); ///< The destructor.
+
+	/**
+	 * The function registers a heuristic; if a heuristic with the same name is already registered, its index is returned.
+	 * \param[in] name name of the heuristic, the string must not be freed while the scheduler exists.
+	 * \return index of the heuristic, or `-1` if `HEUR_MAX_NUM` heuristics have already been registered.
+	 */
+	int addHeuristic(const char* name);
+
+	/**
+	 * The function starts the clock against which the time budget of heuristics is measured.
+	 */
+	void start();
+
+	/**
+	 * \param[in] heur index of heuristic.
+	 * \return `true` if heuristic `heur` may be called now.
+	 */
+	bool admit(int heur);
+
+	/**
+	 * The function chooses one of competing heuristics.
+	 * \param[in] num number of competitors;
+	 * \param[in] ipHeur list of `num` indices of heuristics.
+	 * \return index (in `ipHeur`) of the chosen heuristic.
+	 */
+	int select(int num, const int* ipHeur);
+
+	/**
+	 * \return time (in seconds) which heuristics may spend until the budget is exhausted; it is negative if the budget is overdrawn.
+	 */
+	double getRemainingTime();
+
+	/**
+	 * The function updates the statistics of a heuristic after it has been called.
+	 * \param[in] heur index of heuristic;
+	 * \param[in] time time (in seconds) spent by the call;
+	 * \param[in] improved `true` if the call has found an improving solution.
+	 */
+	void report(int heur, double time, bool improved);
+
+	/**
+	 * The function prints, for every heuristic, the number of calls (admitted and refused),
+	 * the number of improving solutions, running time, and success rate,
+	 * and then the total time spent in heuristics and the time budget;
+	 * nothing is printed if no heuristic has been registered.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out);
+
+private:
+	double getElapsedTime() const; ///< \return time (in seconds) elapsed since `start()`.
+};
+
+#endif // #ifndef __HEURSCHEDULER__H
@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Incumbent.h interface for `CIncumbent` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __INCUMBENT__H
+#define __INCUMBENT__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <thread.h>
+
+#define INC_CACHE_LINE 64 ///< size (in bytes) of cache line.
+
+class CSolutionPool;
+
+/**
+ * `CIncumbent` publishes the record solution and the global bound on the optimal objective value
+ * to all threads of the branch-and-cut procedure.
+ *
+ * The record objective value, the number of record solutions, and the global bound are atomic values,
+ * each occupying its own cache line; so, any thread can read them without locking,
+ * and reads by one thread do not interfere with writes to the other values.
+ *
+ * The record solution itself is written under a mutex (writers are rare),
+ * and is read by means of a _sequence lock_: a writer increments `m_uVersion` before and after writing,
+ * and a reader repeats copying until it observes the same even version number before and after copying.
+ * A reader may still copy arrays replaced by `publish()`, so these are kept until `reset()` is called.
+ * A reader loads the size of arrays before the arrays themselves, and it never copies more components than this size,
+ * so that it stays within the arrays it has loaded even if they have been replaced meanwhile.
+ */
+class MIPSHELL_API CIncumbent
+{
+	alignas(INC_CACHE_LINE) std::atomic<double> m_dObjVal; ///< objective value of record solution.
+	alignas(INC_CACHE_LINE) std::atomic<double> m_dObjBound; ///< bound on optimal objective value.
+	alignas(INC_CACHE_LINE) std::atomic<int> m_iSolNum; ///< number of record solutions published so far.
+	alignas(INC_CACHE_LINE) std::atomic<unsigned> m_uVersion; ///< version of record solution; odd while solution is being written.
+
+	bool m_bSense; ///< `true` for maximization, and `false` for minimization.
+	std::atomic<int> m_iNum; ///< number of components in record solution.
+	std::atomic<int> m_iMaxNum; ///< size of memory allocated for `m_dpX` and `m_ipHd`; it is stored after the arrays, so it never exceeds the size of arrays loaded after it.
+	std::atomic<double*> m_dpX; ///< `m_dpX[i]` is value of variable with handle `m_ipHd[i]` in record solution.
+	std::atomic<int*> m_ipHd; ///< handles of record solution components.
+	int m_iOldNum; ///< number of arrays replaced by reallocations in `publish()`.
+	int m_iMaxOldNum; ///< size of `m_dppOldX` and `m_ippOldHd`.
+	double **m_dppOldX; ///< arrays that were `m_dpX` before reallocations; they are freed only by `reset()` or the destructor, since readers may still copy them.
+	int **m_ippOldHd; ///< arrays that were `m_ipHd` before reallocations.
+	CSolutionPool* m_pPool; ///< if not `0`, all solutions offered by heuristics are passed to this pool.
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< Serializes writers.
+#endif
+
+public:
+	CIncumbent(); ///< The constructor.
+	virtual ~CIncumbent(); ///< The destructor.
+
+	/**
+	 * The function removes the record solution, sets the optimization direction,
+	 * and allocates memory for solutions, so that `publish()` never reallocates it.
+	 * \param[in] sense `true` for maximization, and `false` for minimization;
+	 * \param[in] maxNum maximum number of components in solutions.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void reset(bool sense, int maxNum=0);
+
+	/**
+	 * \return number of record solutions published so far.
+	 */
+	int getSolNum() const
+		{return m_iSolNum.load(std::memory_order_acquire);}
+
+	/**
+	 * \return `true` if a record solution has been published.
+	 */
+	bool isSolution() const
+		{return (getSolNum() > 0)? true: false;}
+
+	/**
+	 * \return objective value of record solution;
+	 *  if no solution has been published, `-CLP::INF` for maximization, and `CLP::INF` for minimization.
+	 */
+	double getObjVal() const
+		{return m_dObjVal.load(std::memory_order_acquire);}
+
+	/**
+	 * \param[in] objVal objective value.
+	 * \return `true` if `objVal` is strictly better than record objective value.
+	 */
+	bool isBetter(double objVal) const
+		{return (m_bSense)? objVal > getObjVal(): objVal < getObjVal();}
+
+	/**
+	 * \return last published bound on optimal objective value.
+	 */
+	double getObjBound() const
+		{return m_dObjBound.load(std::memory_order_relaxed);}
+
+	/**
+	 * The function publishes a new bound on optimal objective value.
+	 * \param[in] bound bound on optimal objective value.
+	 */
+	void setObjBound(double bound)
+		{m_dObjBound.store(bound,std::memory_order_relaxed);}
+
+	/**
+	 * The function publishes a new solution if it is better than the record one.
+	 * \param[in]  objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`.
+	 * \return `true` if solution has been published.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool publish(double objVal, int n, const double* dpX, const int* ipHd);
+
+	/**
+	 * The function copies the record solution.
+	 * \param[out] objVal objective value of record solution;
+	 * \param[in] maxNum size of `dpX` and `ipHd`;
+	 * \param[out] dpX,ipHd arrays of size `maxNum`; `dpX[i]` is value of variable with handle `ipHd[i]`.
+	 * \return number of solution components, or `0` if no solution has been published;
+	 *  if return value is greater than `maxNum`, nothing is copied, and the call should be repeated with larger arrays.
+	 */
+	int getSolution(double &objVal, int maxNum, double* dpX, int* ipHd) const;
+
+	/**
+	 * \param[in] pPool solution pool, or `0`.
+	 */
+	void setPool(CSolutionPool* pPool)
+		{m_pPool=pPool;}
+
+	/**
+	 * The function passes a feasible solution found by a heuristic to the solution pool (if any),
+	 * whether or not this solution is better than the record one.
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`;
+	 *  if `ipHd=0`, `dpX[j]` is value of variable with handle `j`.
+	 */
+	void offer(int n, const double* dpX, const int* ipHd) const;
+
+private:
+	void freeOldArrays(); ///< The function frees all arrays stored in `m_dppOldX` and `m_ippOldHd`.
+
+	/**
+	 * The function stores `m_dpX` and `m_ipHd` in `m_dppOldX` and `m_ippOldHd`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void keepOldArrays();
+};
+
+#endif // #ifndef __INCUMBENT__H
@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file LiftProject.h interface for `CLiftProject` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIFTPROJECT__H
+#define __LIFTPROJECT__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <iostream>
+
+/**
+ * `CLiftProject` generates lift-and-project cuts from the optimal simplex tableau of a node LP
+ * in the manner of Balas and Perregaard, i.e., without solving cut generating LPs.
+ *
+ * The LP is given by its columns, each of which is either _basic_ or at one of its bounds,
+ * and by the rows that are tight at the LP solution; the numbers of basic columns and tight rows must be equal.
+ * All variables are then written as non-negative variables \f$y\f$: shifted or complemented columns, and slacks of tight rows.
+ * For a basic integer variable \f$x_k\f$ with fractional value \f$x_k^*\f$, the tableau row
+ * \f$x_k = c_0 - \sum_j c_j y_j\f$ and the disjunction \f$x_k \le \lfloor x_k^* \rfloor \vee x_k \ge \lceil x_k^* \rceil\f$
+ * give the cut \f$\sum_j \pi_j y_j \ge 1\f$ with
+ * \f$\pi_j = \max\{c_j/d_1,-c_j/d_2\}\f$, where \f$d_1=c_0-\lfloor x_k^* \rfloor\f$ and \f$d_2=\lceil x_k^* \rceil-c_0\f$;
+ * for integer \f$y_j\f$ the coefficients are strengthened to \f$\pi_j=\min\{\phi_j/d_1,(1-\phi_j)/d_2\}\f$, \f$\phi_j=c_j-\lfloor c_j\rfloor\f$.
+ * Taken alone, the tableau row gives the mixed integer Gomory cut.
+ *
+ * Like a pivot in the Balas-Perregaard procedure, adding \f$\gamma\f$ times the row of another basic variable \f$x_i\f$
+ * turns \f$x_i\f$ into a non-basic variable, and changes the cut. For each candidate row, the values of \f$\gamma\f$ are tried
+ * at which a coefficient of the combined row vanishes, and the combination that most increases the distance
+ * between the LP solution and the cut (in the space of \f$y\f$) is taken. The procedure stops when no combination improves the cut.
+ * Candidate rows are those of basic variables that are closest to their bounds.
+ *
+ * Every thread of the solver has its own object; statistics are shared by all of them.
+ */
+class MIPSHELL_API CLiftProject
+{
+	friend class CProblem;
+
+	/// Statistics shared by all the threads.
+	struct tagStat {
+		std::atomic<int> roundNum; ///< number of rounds.
+		std::atomic<int> cutNum; ///< number of cuts generated.
+		std::atomic<int> pivotNum; ///< number of row combinations that have improved cuts.
+		std::atomic<long long> lTime; ///< time (in microseconds) spent generating cuts.
+		tagStat(): roundNum(0), cutNum(0), pivotNum(0), lTime(0) {} ///< The constructor.
+	};
+
+	tagStat* m_pStat; ///< statistics (owned by the object created by `CLiftProject(int,int,int,int)`).
+	bool m_bOwner; ///< `true` if `m_pStat` is owned by this object.
+	int m_iMaxCutNum; ///< maximum number of cuts generated in one round.
+	int m_iMaxRoundNum; ///< maximum number of rounds at one node.
+	int m_iMaxCutSize; ///< cuts of more than `m_iMaxCutSize` entries are discarded; `0` means no limit.
+	int m_iMaxHeight; ///< cuts are generated only at nodes which heights are not greater than `m_iMaxHeight`.
+
+	int m_iNode; ///< node of the current round.
+	int m_iRoundNum; ///< number of rounds at node `m_iNode`.
+
+// LP
+	int m_iColNum; ///< number of columns.
+	int m_iRowNum; ///< number of tight rows.
+	int m_iMaxColNum; ///< size of memory allocated for columns.
+	int m_iMaxRowNum; ///< size of memory allocated for rows.
+	int m_iMaxNZ; ///< size of memory allocated for row entries.
+	double *m_dpX; ///< `m_dpX[j]` is value of column `j` in the LP solution.
+	double *m_dpL; ///< `m_dpL[j]` is lower bound of column `j`.
+	double *m_dpU; ///< `m_dpU[j]` is upper bound of column `j`.
+	char *m_cpState; ///< `m_cpState[j]` is `0` if column `j` is basic, `-1` if it is at its lower bound, and `1` if it is at its upper bound.
+	char *m_cpInt; ///< `m_cpInt[j]` is `1` if column `j` is integer, and `0` otherwise.
+	double *m_dpB; ///< `m_dpB[t]` is the side of row `t` which is tight.
+	char *m_cpSide; ///< `m_cpSide[t]` is `1` if right hand side of row `t` is tight, `-1` if left hand side is tight, and `0` for equations.
+	int *m_ipBeg; ///< row `t` is stored in positions `m_ipBeg[t],...,m_ipBeg[t+1]-1` of `m_dpVal` and `m_ipCol`.
+	double *m_dpVal; ///< row coefficients.
+	int *m_ipCol; ///< column indices of row coefficients.
+
+// cuts
+	int m_iCutNum; ///< number of cuts generated.
+	int m_iMaxCutNZ; ///< size of memory allocated for cut entries.
+	double *m_dpCutRhs; ///< cut `k` is `m_dpCutRhs[k] <= sum(m_dpCutVal[p]*x[m_ipCutCol[p]]: m_ipCutBeg[k] <= p < m_ipCutBeg[k+1])`.
+	int *m_ipCutBeg; ///< cut `k` is stored in positions `m_ipCutBeg[k],...,m_ipCutBeg[k+1]-1` of `m_dpCutVal` and `m_ipCutCol`.
+	double *m_dpCutVal; ///< cut coefficients.
+	int *m_ipCutCol; ///< column indices of cut coefficients.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxCutNum maximum number of cuts generated in one round;
+	 * \param[in] maxRoundNum maximum number of rounds at one node;
+	 * \param[in] maxCutSize cuts of more than `maxCutSize` entries are discarded; if `maxCutSize=0`, cut sizes are not limited;
+	 * \param[in] maxHeight cuts are generated only at nodes which heights are not greater than `maxHeight`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	CLiftProject(int maxCutNum, int maxRoundNum, int maxCutSize, int maxHeight);
+
+	/**
+	 * The clone constructor creates an object for another thread; statistics are shared with `other`.
+	 * \param[in] other object to be cloned.
+	 */
+	CLiftProject(const CLiftProject &other);
+
+	virtual ~CLiftProject(); ///< The destructor.
+
+	/**
+	 * The function counts rounds at a node.
+	 * \param[in] node index of the node being processed;
+	 * \param[in] height height of the node.
+	 * \return `false` if no more rounds are allowed at the node.
+	 */
+	bool startRound(int node, int height);
+
+	/**
+	 * The function allocates memory for the LP; after the call, the LP has no rows.
+	 * \param[in] n number of columns;
+	 * \param[in] rowNum number of tight rows;
+	 * \param[in] nz total number of entries in tight rows.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void allocMem(int n, int rowNum, int nz);
+
+	/**
+	 * The function sets a column of the LP.
+	 * \param[in] j column index;
+	 * \param[in] x value of column `j` in the LP solution;
+	 * \param[in] l,u lower and upper bounds of column `j`;
+	 * \param[in] isInt `true` if column `j` is integer;
+	 * \param[in] state `0` if column `j` is basic, `-1` if it is at its lower bound, and `1` if it is at its upper bound.
+	 */
+	void setColumn(int j, double x, double l, double u, bool isInt, int state)
+	{
+		m_dpX[j]=x;
+		m_dpL[j]=l;
+		m_dpU[j]=u;
+		m_cpInt[j]=(isInt)? 1: 0;
+		m_cpState[j]=static_cast<char>(state);
+	}
+
+	/**
+	 * \return pointer to the memory where coefficients of the next row are to be written.
+	 */
+	double* getRowVal()
+		{return m_dpVal+m_ipBeg[m_iRowNum];}
+
+	/**
+	 * \return pointer to the memory where column indices of the next row are to be written.
+	 */
+	int* getRowCol()
+		{return m_ipCol+m_ipBeg[m_iRowNum];}
+
+	/**
+	 * The function adds a tight row which entries have been written into `getRowVal()` and `getRowCol()`.
+	 * \param[in] sz number of entries;
+	 * \param[in] b side of the row which is tight;
+	 * \param[in] side `1` if right hand side is tight, `-1` if left hand side is tight, and `0` for equations.
+	 */
+	void addRow(int sz, double b, int side)
+	{
+		m_dpB[m_iRowNum]=b;
+		m_cpSide[m_iRowNum]=static_cast<char>(side);
+		m_ipBeg[m_iRowNum+1]=m_ipBeg[m_iRowNum]+sz;
+		++m_iRowNum;
+	}
+
+	/**
+	 * The function generates cuts for the LP.
+	 * \return number of cuts generated.
+	 * \throws CMemoryException lack of memory.
+	 */
+	int separate();
+
+	/**
+	 * The function returns a cut generated by the last call to `separate()`.
+	 * \param[in] k cut index, `0 <= k < separate()`;
+	 * \param[out] b right hand side of the cut \f$\sum_{i=0}^{sz-1} dpVal[i]x_{ipCol[i]} \ge b\f$;
+	 * \param[out] dpVal,ipCol cut coefficients.
+	 * \return number of entries `sz` in the cut.
+	 */
+	int getCut(int k, double& b, const double* &dpVal, const int* &ipCol) const
+	{
+		b=m_dpCutRhs[k];
+		dpVal=m_dpCutVal+m_ipCutBeg[k];
+		ipCol=m_ipCutCol+m_ipCutBeg[k];
+		return m_ipCutBeg[k+1]-m_ipCutBeg[k];
+	}
+
+	/**
+	 * The function prints the numbers of rounds, cuts, and improving row combinations.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	/**
+	 * The function factors the basic matrix, the submatrix of tight rows and basic columns.
+	 * \param[out] dpLU array of size `m_iRowNum*m_iRowNum`, LU-factorization of basic matrix with row permutation `ipPerm`;
+	 * \param[out] ipPerm row permutation;
+	 * \param[in] ipPos `ipPos[j]` is position of basic column `j` in the basis.
+	 * \return `false` if the basic matrix is singular.
+	 */
+	bool factor(double* dpLU, int* ipPerm, const int* ipPos) const;
+
+	/**
+	 * The function computes the tableau row of a basic column in terms of the variables \f$y\f$,
+	 * where \f$y_j\f$ (\f$0 \le j < n\f$) is non-basic column \f$j\f$ shifted by its bound,
+	 * and \f$y_{n+t}\f$ is slack of tight row \f$t\f$.
+	 * \param[in] q position of the column in the basis;
+	 * \param[in] dpLU,ipPerm factorization of basic matrix;
+	 * \param dpU working array of size `2*m_iRowNum`;
+	 * \param[out] dpRow dense array of size `m_iColNum+m_iRowNum`, `dpRow[j]` is coefficient of \f$y_j\f$;
+	 *   it must be zero on entry, and only entries listed in `ipSupp` are set;
+	 * \param[out] ipSupp list of non-zero entries in `dpRow`;
+	 * \param cpMark working array of size `m_iColNum+m_iRowNum`, it must be zero on entry, and it is zero on return.
+	 * \return number of entries in `ipSupp`.
+	 */
+	int tableauRow(int q, const double* dpLU, const int* ipPerm, double* dpU, double* dpRow, int* ipSupp, char* cpMark) const;
+
+	/**
+	 * The function writes a cut into the list of generated cuts.
+	 * \param[in] sz,dpVal,ipCol cut coefficients;
+	 * \param[in] b right hand side.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void addCut(int sz, const double* dpVal, const int* ipCol, double b);
+};
+
+#endif // #ifndef __LIFTPROJECT__H
@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Lns.h interface for `CLns` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LNS__H
+#define __LNS__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <iostream>
+#include <thread.h>
+#include "MatrixCopy.h"
+
+class CIncumbent;
+class CHeurScheduler;
+
+/**
+ * `CLns` implements _large neighbourhood search_ (LNS) heuristics.
+ *
+ * Each heuristic builds a sub-MIP of a copy of the original problem, and solves it
+ * as an independent `CMIP` object with limits on the number of nodes and solution time:
+ *   - _RENS_ (relaxation enforced neighbourhood search) fixes integer variables which values in the root LP solution are integral,
+ *     and restricts each of the other integer variables to the two integers nearest to its LP value;
+ *   - _RINS_ (relaxation induced neighbourhood search) fixes integer variables which values in the record solution
+ *     and in the root LP solution are equal;
+ *   - _local branching_ restricts the search to the binary solutions that differ from the record solution
+ *     in at most `m_iRadius` variables.
+ *
+ * RENS and RINS are not run if less than `m_dMinFixRate` of integer variables are fixed, since the sub-MIP would be too large.
+ * When a record solution is known, a sub-MIP also contains the constraint that its objective value must be better than the record.
+ * Solutions found are stored in `CLns`, and `CProblem` passes them to the solver (by calling `changeRecord()`)
+ * when the main thread processes the next node or cut round.
+ *
+ * After the root node has been processed, the heuristics are run on a spare thread:
+ * first RENS, and then RINS and local branching every time the record solution changes.
+ * In the single-threaded version, all the heuristics are run once after the root node.
+ *
+ * If a heuristic scheduler is set, a sub-MIP is solved only within the time budget of the scheduler
+ * (its time limit is reduced to the remaining budget, but not below one second),
+ * and, for every new record, the neighbourhood chosen by the scheduler is searched first;
+ * the other one is searched only if the first one has not found an improving solution.
+ */
+class MIPSHELL_API CLns
+{
+	friend class CProblem;
+	friend class CLnsSolver;
+public:
+	/// Neighbourhoods.
+	enum enNeighbourhood {
+		LNS_RENS, ///< relaxation enforced neighbourhood search.
+		LNS_RINS, ///< relaxation induced neighbourhood search.
+		LNS_LOCAL_BRANCHING, ///< local branching.
+		LNS_NUM ///< number of neighbourhoods.
+	};
+
+private:
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	int m_iNodeLimit; ///< maximum number of nodes processed by a sub-MIP solver.
+	int m_iTimeLimit; ///< limit (in seconds) on solution time of a sub-MIP.
+	double m_dMinFixRate; ///< RENS and RINS are run only if at least this fraction of integer variables are fixed.
+	int m_iRadius; ///< radius of local branching neighbourhood.
+	CIncumbent* m_pInc; ///< record solution of the whole problem.
+	CHeurScheduler* m_pSched; ///< if not `0`, neighbourhoods are chosen, and their time is accounted, by this scheduler.
+	int m_ipHeur[LNS_NUM]; ///< `m_ipHeur[k]` is index of neighbourhood `k` in `m_pSched`.
+	std::atomic<bool> m_bStop; ///< when set to `true`, sub-MIP solvers stop at their next nodes.
+	bool m_bStarted; ///< `true` if `start()` has been called.
+
+	bool m_bLp; ///< `true` if `m_dpLpX` has been set.
+	double *m_dpLpX; ///< root LP solution, `m_dpLpX[j]` is value of variable with handle `j`.
+
+// record
+	std::atomic<bool> m_bRec; ///< `true` if a solution has been found and not yet passed to the solver.
+	double m_dRecObj; ///< objective value of best solution found.
+	int m_iRecNum; ///< number of components in `m_dpRecX` and `m_ipRecHd`, `0` if no solution has been found.
+	double *m_dpRecX; ///< `m_dpRecX[i]` is value of variable with handle `m_ipRecHd[i]` in best solution found.
+	int *m_ipRecHd; ///< handles of solution components.
+
+// statistics
+	int m_ipCallNum[LNS_NUM]; ///< `m_ipCallNum[k]` is number of sub-MIPs solved for neighbourhood `k`.
+	int m_ipSolNum[LNS_NUM]; ///< `m_ipSolNum[k]` is number of improving solutions found in neighbourhood `k`.
+	double m_dpTime[LNS_NUM]; ///< `m_dpTime[k]` is time (in seconds) spent in neighbourhood `k`.
+
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< Locks the record.
+	_THREAD m_thread; ///< spare thread.
+	bool m_bThread; ///< `true` if `m_thread` has been created and not joined yet.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] nodeLimit maximum number of nodes processed by a sub-MIP solver;
+	 * \param[in] timeLimit limit (in seconds) on solution time of a sub-MIP;
+	 * \param[in] minFixRate RENS and RINS are run only if at least this fraction of integer variables are fixed;
+	 * \param[in] radius radius of local branching neighbourhood.
+	 */
+	CLns(int nodeLimit=500, int timeLimit=10, double minFixRate=0.3, int radius=10);
+	virtual ~CLns(); ///< The destructor.
+
+	/**
+	 * The function stores the LP solution of the root node.
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd LP solution, `dpX[i]` is value of variable with handle `ipHd[i]`;
+	 *  variables which handles are not less than `m_copy.getColNum()` are skipped.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setLpSolution(int n, const double* dpX, const int* ipHd);
+
+	/**
+	 * The function runs the heuristics on a spare thread (in the single-threaded version, it runs them once).
+	 * \param[in] pInc record solution of the whole problem.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void start(CIncumbent* pInc);
+
+	/**
+	 * The function registers all neighbourhoods with a heuristic scheduler.
+	 * \param[in] pSched scheduler.
+	 */
+	void setScheduler(CHeurScheduler* pSched);
+
+	/**
+	 * The function stops the heuristics, and waits until the spare thread finishes.
+	 */
+	void stop();
+
+	/**
+	 * \return `true` if `start()` has been called.
+	 */
+	bool isStarted() const
+		{return m_bStarted;}
+
+	/**
+	 * The function prints the number of sub-MIPs solved, the number of improving solutions found,
+	 * and running time for every neighbourhood.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	/**
+	 * The function runs the heuristics.
+	 * \param[in] wait if `true`, the function waits for new record solutions until `m_bStop` is set;
+	 *  otherwise, it returns after every heuristic has been run once.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void run(bool wait);
+
+	/**
+	 * The function builds and solves a sub-MIP.
+	 * \param[in] nbh neighbourhood (see `enNeighbourhood`);
+	 * \param[in] dpRecX record solution, `dpRecX[j]` is value of variable with handle `j`, or `0` if there is no record;
+	 * \param[in] recObj objective value of record solution.
+	 * \return `true` if an improving solution has been found;
+	 *  `false` also if the sub-MIP has not been solved since it is too large or the time budget of `m_pSched` is exhausted.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool solveSubMip(int nbh, const double* dpRecX, double recObj);
+
+	/**
+	 * The function returns the better of the record solution of the whole problem and the best solution found by this object.
+	 * \param[out] dpRecX array of size `2*m_copy.getColNum()`, `dpRecX[j]` is value of variable with handle `j` in returned solution;
+	 *  the second half of the array is used as working memory;
+	 * \param[out] objVal objective value of returned solution;
+	 * \param ipHd working array of size `m_copy.getColNum()`.
+	 * \return `false` if no solution is known.
+	 */
+	bool getRecord(double* dpRecX, double& objVal, int* ipHd);
+
+	/**
+	 * The function stores a solution if it is better than the best solution found so far.
+	 * \param[in]  objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setRecord(double objVal, int n, const double* dpX, const int* ipHd);
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of the spare thread.
+	 * \param[in] param pointer to `CLns` object.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+};
+
+#endif // #ifndef __LNS__H
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file MatrixCopy.h interface for `CMatrixCopy` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __MATRIXCOPY__H
+#define __MATRIXCOPY__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+class CMIP;
+
+/**
+ * `CMatrixCopy` stores a copy of the original (not preprocessed) MIP, row by row.
+ * The copy is used to build independent `CMIP` objects which solve either the whole problem
+ * or a subproblem induced by a subset of rows and columns.
+ * Column `j` of the copy has handle `j` in the original problem, and
+ * this handle is assigned to the column built from column `j` in any `CMIP` object;
+ * so, solutions of those objects are written in handles of the original problem.
+ */
+class MIPSHELL_API CMatrixCopy
+{
+	friend class CProblem;
+
+	bool m_bSense; ///< `true` for maximization, and `false` for minimization.
+	int m_iM; ///< number of rows.
+	int m_iN; ///< number of columns.
+	double *m_dpC; ///< objective coefficients.
+	double *m_dpD; ///< `m_dpD[2*j]` and `m_dpD[2*j+1]` are lower and upper bounds of variable `j`.
+	double *m_dpB; ///< `m_dpB[2*i]` and `m_dpB[2*i+1]` are left and right hand sides of row `i`.
+	unsigned *m_ipVarType; ///< variable types.
+	unsigned *m_ipCtrType; ///< constraint types.
+	int *m_ipPri; ///< priorities of integer variables.
+	int *m_ipBeg; ///< row `i` is stored in positions `m_ipBeg[i],...,m_ipBeg[i+1]-1` of `m_dpVal` and `m_ipCol`.
+	double *m_dpVal; ///< matrix coefficients.
+	int *m_ipCol; ///< column indices of matrix coefficients.
+
+public:
+	CMatrixCopy(); ///< The constructor.
+	virtual ~CMatrixCopy(); ///< The destructor.
+
+	/**
+	 * The function allocates memory for a problem.
+	 * \param[in] m,n,nz number of rows, columns, and nonzero entries.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void allocMem(int m, int n, int nz);
+
+	bool getSense() const
+		{return m_bSense;} ///< \return `true` for maximization, and `false` for minimization.
+	int getRowNum() const
+		{return m_iM;} ///< \return number of rows.
+	int getColNum() const
+		{return m_iN;} ///< \return number of columns.
+	double getObjCoeff(int j) const
+		{return m_dpC[j];} ///< \return objective coefficient of column `j`.
+	double getLoBound(int j) const
+		{return m_dpD[j<<1];} ///< \return lower bound of column `j`.
+	double getUpBound(int j) const
+		{return m_dpD[(j<<1)+1];} ///< \return upper bound of column `j`.
+	bool isInteger(int j) const
+		{return (m_ipVarType[j])? true: false;} ///< \return `true` if column `j` is integer.
+	unsigned getVarType(int j) const
+		{return m_ipVarType[j];} ///< \return type of column `j`.
+	int getVarPriority(int j) const
+		{return m_ipPri[j];} ///< \return priority of column `j`, it is defined only for integer columns.
+	unsigned getCtrType(int i) const
+		{return m_ipCtrType[i];} ///< \return type of row `i`.
+	double getRowLoBound(int i) const
+		{return m_dpB[i<<1];} ///< \return left hand side of row `i`.
+	double getRowUpBound(int i) const
+		{return m_dpB[(i<<1)+1];} ///< \return right hand side of row `i`.
+
+	/**
+	 * The function returns row `i`.
+	 * \param[in] i row index;
+	 * \param[out] dpVal,ipCol coefficients and column indices of row `i`.
+	 * \return number of entries in row `i`.
+	 */
+	int getRow(int i, const double* &dpVal, const int* &ipCol) const
+		{dpVal=m_dpVal+m_ipBeg[i]; ipCol=m_ipCol+m_ipBeg[i]; return m_ipBeg[i+1]-m_ipBeg[i];}
+
+	/**
+	 * The function loads the whole problem into a solver.
+	 * \param[in,out] mip solver, its matrix must not be opened yet.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void load(CMIP& mip) const;
+
+	/**
+	 * The function loads a subproblem into a solver.
+	 * \param[in,out] mip solver, its matrix must not be opened yet;
+	 * \param[in] m,ipRow list of `m` rows;
+	 * \param[in] n,ipCol list of `n` columns, every column in rows from `ipRow` must be in this list.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void load(CMIP& mip, int m, const int* ipRow, int n, const int* ipCol) const;
+
+	/**
+	 * The function computes connected components of the graph in which two columns are adjacent
+	 * if they both have nonzero entries in some row.
+	 * \param[out] ipColComp array of size `getColNum()`, `ipColComp[j]` is component of column `j`,
+	 *   or `-1` if column `j` has no nonzero entries;
+	 * \param[out] ipRowComp array of size `getRowNum()`, `ipRowComp[i]` is component of row `i`,
+	 *   or `-1` if row `i` is empty.
+	 * \return number of components.
+	 * \throws CMemoryException lack of memory.
+	 */
+	int getComponents(int* ipColComp, int* ipRowComp) const;
+};
+
+#endif // #ifndef __MATRIXCOPY__H
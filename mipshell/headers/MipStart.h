@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file MipStart.h interface for `CMipStart` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __MIPSTART__H
+#define __MIPSTART__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <iostream>
+#include "MatrixCopy.h"
+
+class CVar;
+
+#define MIP_START_TOL 1.0e-6 ///< feasibility and integrality tolerance.
+
+/**
+ * `CMipStart` stores a start solution given by the user before the problem is solved,
+ * and turns it into an initial record solution.
+ *
+ * Values are given for variables before the problem is loaded, and so variables are identified by their handles
+ * only when the start is processed; not all variables need to have values.
+ *   - If every variable has a value, and the start solution satisfies all bounds, integrality conditions, and constraints
+ *     of a copy of the original problem, it is used as it is.
+ *   - Otherwise, the start is _completed_: the integer variables with given values are fixed at these (rounded) values,
+ *     and the sub-MIP over all the other variables is solved as an independent `CMIP` object
+ *     with limits on the number of nodes and solution time; the best solution of this sub-MIP is used.
+ *     Values of continuous variables are not fixed, since a start solution often violates constraints
+ *     only because its continuous part is slightly inaccurate.
+ *
+ * `CProblem` passes the solution to the solver (by calling `changeRecord()`) when the main thread processes the root node.
+ */
+class MIPSHELL_API CMipStart
+{
+	friend class CProblem;
+	friend class CMipStartSolver;
+public:
+	/// Results of processing a start solution.
+	enum enStatus {
+		START_NONE, ///< the start has not been processed.
+		START_ACCEPTED, ///< the complete start solution is feasible.
+		START_COMPLETED, ///< the start has been completed by solving a sub-MIP.
+		START_FAILED ///< no solution has been found.
+	};
+
+private:
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	int m_iNodeLimit; ///< maximum number of nodes processed by the sub-MIP solver.
+	int m_iTimeLimit; ///< limit (in seconds) on solution time of the sub-MIP.
+
+	int m_iSize; ///< number of given values.
+	int m_iCapacity; ///< size of arrays `m_dpVal` and `m_ppVar`.
+	double *m_dpVal; ///< `m_dpVal[i]` is value of variable `*m_ppVar[i]`.
+	CVar **m_ppVar; ///< variables with given values.
+
+// record
+	bool m_bRec; ///< `true` if a solution has been found and not yet passed to the solver.
+	double m_dRecObj; ///< objective value of the solution.
+	int m_iRecNum; ///< number of components in `m_dpRecX` and `m_ipRecHd`, `0` if no solution has been found.
+	double *m_dpRecX; ///< `m_dpRecX[i]` is value of variable with handle `m_ipRecHd[i]` in the solution.
+	int *m_ipRecHd; ///< handles of solution components.
+
+// statistics
+	int m_iStatus; ///< result of processing the start (see `enStatus`).
+	int m_iGivenNum; ///< number of variables with given values.
+	int m_iFixNum; ///< number of integer variables fixed in the sub-MIP.
+	int m_iNodeNum; ///< number of nodes processed by the sub-MIP solver.
+	double m_dTime; ///< time (in seconds) spent in processing the start.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] nodeLimit maximum number of nodes processed by the sub-MIP solver;
+	 * \param[in] timeLimit limit (in seconds) on solution time of the sub-MIP.
+	 */
+	CMipStart(int nodeLimit=1000, int timeLimit=10);
+	virtual ~CMipStart(); ///< The destructor.
+
+	/**
+	 * The function sets the start value of a variable; if the value has been set before, it is replaced.
+	 * \param[in] pVar pointer to variable;
+	 * \param[in] val value of variable.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setValue(CVar* pVar, double val);
+
+	/**
+	 * The function removes all start values.
+	 */
+	void clear()
+		{m_iSize=0;}
+
+	/**
+	 * \return number of start values.
+	 */
+	int getSize() const
+		{return m_iSize;}
+
+	/**
+	 * The function checks the start solution against `m_copy`, and completes it if necessary;
+	 * it must be called after the problem has been loaded, when handles of variables are known.
+	 * \return `true` if a solution has been found.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool run();
+
+	/**
+	 * The function prints the number of given values, the number of fixed variables, and the result of processing the start.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	/**
+	 * \param[in] dpX solution, `dpX[j]` is value of variable with handle `j`.
+	 * \return `true` if `dpX` satisfies all bounds, integrality conditions, and constraints of `m_copy`.
+	 */
+	bool isFeasible(const double* dpX) const;
+
+	/**
+	 * The function builds and solves the sub-MIP in which integer variables with given values are fixed.
+	 * \param[in] dpX start solution, `dpX[j]` is value of variable with handle `j`;
+	 * \param[in] cpGiven `cpGiven[j]` is `true` if variable with handle `j` has a given value.
+	 * \return `true` if a solution has been found.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool complete(const double* dpX, const bool* cpGiven);
+
+	/**
+	 * The function stores a solution.
+	 * \param[in]  objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`;
+	 *  if `ipHd=0`, `dpX[j]` is value of variable with handle `j`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setRecord(double objVal, int n, const double* dpX, const int* ipHd);
+};
+
+#endif // #ifndef __MIPSTART__H
@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Mod2Sep.h interface for `CMod2Sep` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __MOD2SEP__H
+#define __MOD2SEP__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include "Separator.h"
+#include "MatrixCopy.h"
+
+/**
+ * `CMod2Sep` separates _mod-2 cuts_ (\f$\{0,\frac{1}{2}\}\f$-Chvátal-Gomory cuts).
+ *
+ * Every row \f$a^Tx \le b\f$ of the original problem with integer coefficients and integer variables only
+ * (rows \f$a^Tx \ge b\f$ are multiplied by \f$-1\f$) is a candidate row.
+ * A mod-2 cut is obtained by summing a subset of rows and bound constraints with weight \f$\frac{1}{2}\f$
+ * so that all coefficients of the sum are integer and the right hand side is not, and then rounding the sum down.
+ * Given a solution \f$x^*\f$, variables at their bounds are dropped
+ * (their parities are fixed by bound constraints which slacks are zero),
+ * and rows which slacks are less than one are written into a matrix over GF(2) with
+ * one column for each fractional variable and one column for the right hand side.
+ * Gaussian elimination over GF(2) then finds row subsets with even column parities and odd right hand side.
+ * Variables removed from the LP by preprocessing are treated as constants if they are fixed,
+ * and rows with other removed variables are not used since values of those variables are not known.
+ *
+ * The matrix is stored row by row as 64-bit words; each row is followed by the bitset of original rows it is composed of.
+ * Rows are added by XOR-ing words (with AVX2 instructions if the library is compiled for them).
+ * If the matrix is dense, the _method of four Russians_ is used: pivots are taken in groups,
+ * all combinations of pivots in a group are tabulated, and each other row is reduced by one table lookup.
+ */
+class MIPSHELL_API CMod2Sep: public CSeparator
+{
+	friend class CProblem;
+
+protected:
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	int m_iRowNum; ///< number of candidate rows.
+	int *m_ipRow; ///< `m_ipRow[r]>>1` is index of candidate row `r` in `m_copy`; the row is negated if `m_ipRow[r]&1`.
+	int m_iMaxRowNum; ///< maximum number of rows in GF(2) matrix.
+	int m_iMaxCutNum; ///< maximum number of cuts generated in one call.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxRowNum maximum number of rows in GF(2) matrix; rows of least slacks are taken;
+	 * \param[in] maxCutNum maximum number of cuts generated in one call.
+	 */
+	CMod2Sep(int maxRowNum=8192, int maxCutNum=64);
+	virtual ~CMod2Sep(); ///< The destructor.
+
+	/**
+	 * \return name of separator.
+	 */
+	virtual const char* getName() const
+		{return "mod-2";}
+
+	/**
+	 * The function builds the list of candidate rows; it must be called after `m_copy` is filled.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void init();
+
+	/**
+	 * The function separates a given solution by mod-2 cuts.
+	 * \param[in] hdNum number of variables;
+	 * \param[in] dpSol solution, `dpSol[j]` is value of variable with handle `j`;
+	 * \param[in] ipHdToCol `ipHdToCol[j]` is column of variable with handle `j`, or `-1` if the variable has been removed by preprocessing;
+	 * \param[in,out] cuts cut buffer.
+	 * \return number of cuts written.
+	 * \throws CMemoryException lack of memory.
+	 */
+	virtual int separate(int hdNum, const double* dpSol, const int* ipHdToCol, CCutSelector& cuts);
+
+	/**
+	 * The function performs Gaussian elimination over GF(2) on a bit-packed matrix.
+	 * On return, every row that is not a pivot has zero entries in all columns `0,...,colNum-1`.
+	 * \param[in] rowNum,colNum numbers of rows and columns to be eliminated;
+	 * \param[in] wordNum number of 64-bit words in each row (including words not eliminated);
+	 * \param[in,out] ulpMat matrix, row `r` is stored in words `ulpMat[r*wordNum],...,ulpMat[(r+1)*wordNum-1]`;
+	 * \param[out] cpPivot array of size `rowNum`, `cpPivot[r]` is `1` if row `r` is a pivot, and `0` otherwise.
+	 */
+	static void eliminate(int rowNum, int colNum, int wordNum, unsigned long long* ulpMat, char* cpPivot);
+
+	/**
+	 * The function performs the same elimination as `eliminate()` by the method of four Russians.
+	 * \param[in] rowNum,colNum numbers of rows and columns to be eliminated;
+	 * \param[in] wordNum number of 64-bit words in each row;
+	 * \param[in,out] ulpMat matrix;
+	 * \param[out] cpPivot array of size `rowNum`, `cpPivot[r]` is `1` if row `r` is a pivot, and `0` otherwise.
+	 * \throws CMemoryException lack of memory.
+	 */
+	static void eliminateM4R(int rowNum, int colNum, int wordNum, unsigned long long* ulpMat, char* cpPivot);
+
+protected:
+	/**
+	 * The function writes values of variables to be used in separation.
+	 * \param[in] dpSol solution;
+	 * \param[in] ipHdToCol map of handles to LP columns, `-1` for variables removed by preprocessing;
+	 * \param[out] dpX array of size `m_copy.getColNum()`; `dpX[j]` is `dpSol[j]` for variables in the LP,
+	 *  the bound of a fixed removed variable, and `CLP::INF` for other removed variables.
+	 */
+	void getValues(const double* dpSol, const int* ipHdToCol, double* dpX) const;
+
+	/**
+	 * \param[in] dpX values of variables written by `getValues()`;
+	 * \param[in] r index in `m_ipRow`.
+	 * \return slack of candidate row `r`, or `CLP::INF` if the row includes a variable which value is not known.
+	 */
+	double getSlack(const double* dpX, int r) const;
+
+	/**
+	 * The function builds a mod-2 cut from a subset of candidate rows and writes it into a buffer if it is violated.
+	 * \param[in] dpX values of variables written by `getValues()`;
+	 * \param[in] ipHdToCol map of handles to LP columns; fixed variables removed by preprocessing are moved to the right hand side;
+	 * \param[in] rowNum,ipRow list of rows (indices in `m_ipRow`);
+	 * \param[in,out] cuts cut buffer;
+	 * \param dpCoeff,ipInd,ipPos working arrays of size `m_copy.getColNum()`;
+	 *  all entries of `ipPos` must be `-1`, and they are `-1` on return.
+	 * \return `true` if the cut has been written.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool buildCut(const double* dpX, const int* ipHdToCol, int rowNum, const int* ipRow, CCutSelector& cuts,
+			double* dpCoeff, int* ipInd, int* ipPos) const;
+};
+
+#endif // #ifndef __MOD2SEP__H
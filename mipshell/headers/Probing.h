@@ -0,0 +1,245 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Probing.h interface for `CProbing` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __PROBING__H
+#define __PROBING__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread.h>
+#include "Propagator.h"
+
+/**
+ * `CProbing` implements parallel probing of binary variables.
+ *
+ * Probing a binary variable \f$x_c\f$ means fixing it first to `0` and then to `1`,
+ * and propagating each fixing through row activities (see `CPropagator`). Then
+ *   - if both fixings give contradictions, the problem is infeasible;
+ *   - if one fixing gives a contradiction, \f$x_c\f$ is fixed to the other value,
+ *     and all bounds derived from that value become global bounds;
+ *   - otherwise, the weaker of two bounds derived for a variable from the two fixings is a global bound,
+ *     and every binary variable fixed by one of the fixings gives an _implication_ (a clique of two literals,
+ *     see `CCliqueTable`).
+ *
+ * Probing is done in rounds. At every round, the candidates (not fixed binary variables, and, after the first round,
+ * only the variables sharing a row with variables which bounds changed at the previous round) are distributed
+ * among a number of threads. All threads read the same bounds and row activities, which do not change during a round;
+ * every thread probes its variables against its own propagation state, and writes the results (fixings, bounds, implications)
+ * into its own buffer. Between rounds, the buffers are merged into the global bounds. The result of merging does not depend on
+ * the order in which threads finish, since, for every variable, the tightest of all bounds found is taken, and implications are sorted.
+ *
+ * Probing is done on a copy of the original problem, before the solver preprocesses it;
+ * `CProblem` passes new bounds to the solver, and implications to the clique table (if clique cuts are switched on).
+ */
+class MIPSHELL_API CProbing: public CPropagator
+{
+	friend class CProblem;
+
+	/// Working data and results of one probing thread.
+	struct tagBuffer {
+		CProbing* pProbing; ///< probing object.
+		int thread; ///< thread index.
+		bool failed; ///< `true` if the thread has run out of memory.
+		CPropagator::tagState state; ///< bounds and row activities of the thread.
+		int sideNum; ///< number of variables in `ipSide`.
+		int *ipSide; ///< variables which bounds have been changed by fixing the probed variable to `0`.
+		double *dpSide; ///< bounds of variables from `ipSide` derived from fixing the probed variable to `0`.
+		int *ipSidePos; ///< `ipSidePos[j]` is position of `j` in `ipSide` if `ipSideMark[j]` is the stamp of the current fixing to `0`.
+		int *ipSideMark; ///< see `ipSidePos`.
+		int resNum; ///< number of new bounds in `ipResCol`.
+		int maxResNum; ///< size of memory allocated for `ipResCol`.
+		int *ipResCol; ///< variables which global bounds have been tightened.
+		double *dpResBd; ///< `dpResBd[2*k]` and `dpResBd[2*k+1]` are new bounds of variable `ipResCol[k]`.
+		int implNum; ///< number of implications in `ipImpl`.
+		int maxImplNum; ///< size of memory allocated for `ipImpl` (in implications).
+		int *ipImpl; ///< `ipImpl[2*k]` and `ipImpl[2*k+1]` are two literals which cannot both be equal to one.
+		int probeNum; ///< number of variables probed.
+		bool infeasible; ///< `true` if the problem has been proven infeasible.
+	};
+
+	int m_iThreadNum; ///< number of probing threads; `0` means that the number of solver threads is used.
+	int m_iMaxRoundNum; ///< maximum number of probing rounds.
+	int m_iTimeLimitPerRound; ///< limit (in seconds) on the time of one probing round.
+	bool m_bReplace; ///< if `true`, probing of the solver is reduced to depth one (the solver always probes while preprocessing).
+
+	int m_iCandNum; ///< number of candidates in `m_ipCand`.
+	int *m_ipCand; ///< variables to be probed at the current round.
+	int m_iRoundThreadNum; ///< number of threads probing at the current round; thread `t` probes candidates `t`, `t+m_iRoundThreadNum`, ....
+	std::chrono::steady_clock::time_point m_roundStart; ///< start time of the current round.
+	std::atomic<bool> m_bStop; ///< is set to `true` when the time limit of the current round is exceeded.
+
+// results
+	bool m_bInfeasible; ///< `true` if the problem has been proven infeasible.
+	int m_iImplNum; ///< number of implications in `m_ipImpl`.
+	int m_iMaxImplNum; ///< size of memory allocated for `m_ipImpl` (in implications).
+	int *m_ipImpl; ///< `m_ipImpl[2*k]` and `m_ipImpl[2*k+1]` are two literals which cannot both be equal to one.
+
+// statistics
+	int m_iRoundNum; ///< number of probing rounds.
+	int m_iProbeNum; ///< number of variables probed.
+	int m_iFixNum; ///< number of variables fixed.
+	int m_iBdNum; ///< number of bounds tightened (excluding fixings).
+	double m_dTime; ///< probing time (in seconds).
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] threadNum number of probing threads; if `threadNum=0`, the number of solver threads is used;
+	 * \param[in] maxRoundNum maximum number of probing rounds;
+	 * \param[in] timeLimitPerRound limit (in seconds) on the time of one probing round;
+	 * \param[in] replace if `true`, probing of the solver is reduced to depth one (the solver always probes while preprocessing).
+	 */
+	CProbing(int threadNum=0, int maxRoundNum=3, int timeLimitPerRound=10, bool replace=true);
+	virtual ~CProbing(); ///< The destructor.
+
+	/**
+	 * The function probes binary variables of `m_copy`.
+	 * \param[in] threadNum number of threads used if `m_iThreadNum=0`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void probe(int threadNum);
+
+	/**
+	 * \return `true` if the problem has been proven infeasible.
+	 */
+	bool isInfeasible() const
+		{return m_bInfeasible;}
+
+	/**
+	 * \param[in] j variable.
+	 * \return lower bound of variable `j` derived by probing.
+	 */
+	double getLoBound(int j) const
+		{return m_dpD[j<<1];}
+
+	/**
+	 * \param[in] j variable.
+	 * \return upper bound of variable `j` derived by probing.
+	 */
+	double getUpBound(int j) const
+		{return m_dpD[(j<<1)+1];}
+
+	/**
+	 * The function prints the numbers of rounds, probed variables, fixings, tightened bounds, and implications, and probing time.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	/**
+	 * The function allocates memory for a thread buffer.
+	 * \param[out] b buffer.
+	 * \return `false` if there is not enough memory.
+	 */
+	bool allocBuffer(tagBuffer& b) const;
+
+	/**
+	 * The function frees memory allocated for a thread buffer.
+	 * \param[in,out] b buffer.
+	 */
+	static void freeBuffer(tagBuffer& b);
+
+	/**
+	 * The function fixes variable `c` to `v`, and propagates this fixing.
+	 * \param[in,out] b buffer of calling thread;
+	 * \param[in] c,v variable and its value.
+	 * \return `false` if a contradiction has been found.
+	 */
+	bool fix(tagBuffer& b, int c, int v) const;
+
+	/**
+	 * The function probes a binary variable, and writes the results into the buffer.
+	 * \param[in,out] b buffer of calling thread;
+	 * \param[in] c variable.
+	 * \return `false` if there is not enough memory.
+	 */
+	bool probeVar(tagBuffer& b, int c) const;
+
+	/**
+	 * The function appends a new bound to the buffer.
+	 * \param[in,out] b buffer;
+	 * \param[in] j variable;
+	 * \param[in] lo,up bounds.
+	 * \return `false` if there is not enough memory.
+	 */
+	static bool addResult(tagBuffer& b, int j, double lo, double up);
+
+	/**
+	 * The function appends an implication to the buffer.
+	 * \param[in,out] b buffer;
+	 * \param[in] lit1,lit2 literals which cannot both be equal to one.
+	 * \return `false` if there is not enough memory.
+	 */
+	static bool addImplication(tagBuffer& b, int lit1, int lit2);
+
+	/**
+	 * The function probes the candidates assigned to a thread.
+	 * \param[in,out] b buffer of calling thread.
+	 */
+	void probeCands(tagBuffer& b);
+
+	/**
+	 * The function merges the buffers of all threads into the global bounds and the list of implications.
+	 * \param[in] threadNum number of threads;
+	 * \param[in] pBuf buffers;
+	 * \param cpChanged working array of size `m_copy.getColNum()` filled with zeroes, on return it is again filled with zeroes;
+	 * \param[out] cpTouched `cpTouched[j]=1` if the bounds of some variable sharing a row with `j` have changed.
+	 * \return number of variables which bounds have changed.
+	 * \throws CMemoryException lack of memory.
+	 */
+	int merge(int threadNum, tagBuffer* pBuf, char* cpChanged, char* cpTouched);
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of a probing thread.
+	 * \param[in] param pointer to thread buffer.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+};
+
+#endif // #ifndef __PROBING__H
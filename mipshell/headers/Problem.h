@@ -52,6 +52,34 @@ class CFunction;
 class CDvar;
 class CTerm;
 class CLinSum;
+class CRelBranching;
+class CCheckpoint;
+class CRootRace;
+class CIncumbent;
+class CMatrixCopy;
+class CDecomposition;
+class CCutPool;
+class CCutSelector;
+class CConcurrentSep;
+class CSeparator;
+class CMod2Sep;
+class CZeroHalfSep;
+class CCliqueSep;
+class CConflict;
+class CCutAging;
+class CCutStat;
+struct tagCutFamilyStat;
+class CLiftProject;
+class CFeasPump;
+class CLns;
+class CDiving;
+class CProbing;
+class CPropagator;
+class CSymmetry;
+class CRestart;
+class CSolutionPool;
+class CMipStart;
+class CHeurScheduler;
 
 /// `CProblem` represents MIP instances.
 class MIPSHELL_API CProblem: public CMIP 
@@ -67,6 +95,40 @@ class MIPSHELL_API CProblem: public CMIP
 	double *m_dpRedCost, *m_dpPrice; ///< only pointers used to extract reduced costs and shadow prices
 	int m_iCutState; ///< 0 - constraint, 1 - global cut, 2 - local cut
 	CCtr* m_pLastCut; ///< starts a chain of cuts
+	CRelBranching* m_pRelBr; ///< if not `0`, reliability branching is used.
+	int m_iRelBrCol; ///< column selected by reliability branching at currently processed node, or `-1`.
+	double m_dRelBrVal; ///< (not scaled) value of variable `m_iRelBrCol` in node LP solution.
+	CCheckpoint* m_pCkp; ///< if not `0`, checkpoints are taken periodically.
+	CRootRace* m_pRace; ///< if not `0`, root node racing is done before branch-and-cut starts.
+	CIncumbent* m_pInc; ///< record solution and bound on optimal objective value published to all threads.
+	int m_iNodeCount; ///< number of nodes branched by this thread.
+	CDecomposition* m_pDecomp; ///< if not `0`, independent components of the matrix are solved separately.
+	bool m_bDecompSolved; ///< `true` if the problem has been solved by `m_pDecomp`.
+	CCutPool* m_pCutPool; ///< if not `0`, global cuts generated by __MIPshell__ are stored in this pool.
+	CCutSelector* m_pCutSel; ///< if not `0`, cuts generated by __MIPshell__ are filtered by this selector.
+	CConcurrentSep* m_pConcSep; ///< if not `0`, runs separators added by `addSeparator()`.
+	CMod2Sep* m_pMod2Sep; ///< if not `0`, mod-2 cuts are separated by this separator (owned by `m_pConcSep`).
+	CZeroHalfSep* m_pZeroHalfSep; ///< if not `0`, zero-half cuts are separated by this separator (owned by `m_pConcSep`).
+	CCliqueSep* m_pCliqueSep; ///< if not `0`, clique cuts are separated by this separator (owned by `m_pConcSep`).
+	CConflict* m_pConflict; ///< if not `0`, infeasible nodes are analysed, and derived nogoods are added to `m_pCutPool`.
+	CCutAging* m_pCutAging; ///< if not `0`, cuts that are not binding for long are evicted from node LPs to `m_pCutPool`.
+	CCutStat* m_pCutStat; ///< if not `0`, time, bound gain, and survival of cuts are recorded for each cut family.
+	CLiftProject* m_pLiftProject; ///< if not `0`, lift-and-project cuts are generated from the optimal tableau.
+	CFeasPump* m_pFeasPump; ///< if not `0`, the feasibility pump looks for a first solution before (or while) branch-and-cut runs.
+	CLns* m_pLns; ///< if not `0`, large neighbourhood search heuristics are run on a spare thread after the root node.
+	CDiving* m_pDiving; ///< if not `0`, a portfolio of diving heuristics is run on idle threads after the root node.
+	CProbing* m_pProbing; ///< if not `0`, binary variables are probed in parallel before the solver preprocesses the problem.
+	CPropagator* m_pPropagator; ///< if not `0`, the bounds of every node are propagated over the rows of the original problem.
+	CSymmetry* m_pSymmetry; ///< if not `0`, symmetries of the original problem are detected and broken by Schreier-Sims cuts.
+	CRestart* m_pRestart; ///< if not `0`, the solver is restarted if many integer variables have been fixed at the root node.
+	CSolutionPool* m_pPool; ///< if not `0`, the best distinct feasible solutions found during the search are stored in this pool.
+	bool m_bPoolSolved; ///< `true` if the solution of the problem is taken from `m_pPool`.
+	CHeurScheduler* m_pSched; ///< if not `0`, the heuristics of __MIPshell__ are scheduled within a time budget.
+	CMipStart* m_pStart; ///< if not `0`, it stores a (partial) start solution which is turned into an initial record solution.
+	int *m_ipHdToCol; ///< `m_ipHdToCol[h]` is column of variable with handle `h`, or `-1` if the variable has been removed by preprocessing; it is filled by `mapHandles()`.
+	int m_iCutHashNum; ///< number of cuts sent by `sendSelectedCuts()` in previous round.
+	int m_iMaxCutHashNum; ///< size of `m_ulpCutHash`.
+	unsigned long long *m_ulpCutHash; ///< hash values (see `CCutAging::hashRow()`) of cuts sent by `sendSelectedCuts()` in previous round.
 public:
 	CLinSum *m_pSum; ///< 10 pointers are used to allocate memory for 10 CLinSum objects
 private:
@@ -174,6 +236,400 @@ public:
 	double getShadowPrice(CCtr& ctr);
 #define getprice getShadowPrice ///< alias for `CProblem::getShadowPrice()`
 	
+	/**
+	 * The procedure switches on _reliability branching_:
+	 * strong branching is applied to a branching candidate only until its pseudocosts become reliable;
+	 * after that, the candidate is scored by its pseudocosts.
+	 * Pseudocosts are computed from the objective decreases both in strong branching LPs and in the children of branched nodes.
+	 * The candidates of one node are evaluated in parallel, each thread solving the branch LPs on its own copy of the node LP.
+	 * \param[in] threshold pseudocost is reliable if it has been computed from at least `threshold` observations;
+	 * \param[in] maxCandNum at most `maxCandNum` candidates are evaluated by strong branching at any node;
+	 * \param[in] threadNum number of threads evaluating strong branching candidates;
+	 *  if `threadNum=0`, all threads of the solver are used at the root node, and one thread at any other node.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CRelBranching`.
+	 */
+	void setReliabilityBranching(int threshold=4, int maxCandNum=32, int threadNum=0);
+
+	/**
+	 * The procedure switches on periodic checkpoints.
+	 * Every `interval` seconds, the record solution, the bound on the optimal objective value,
+	 * and pseudocosts (if reliability branching is on) are written to a file by a background thread.
+	 * If the checkpoint file exists when `solve()` is called, and it has been written for the same problem,
+	 * the solver resumes from the written state; the record solution read is used only if it is feasible.
+	 * The checkpoint file is deleted when `solve()` completes without being stopped by the time limit.
+	 * \param[in] fileName name of checkpoint file; if `fileName=0`, the file name is
+	 *  made up by appending the extension ".ckp" to the name of the problem;
+	 * \param[in] interval time (in seconds) between two consecutive checkpoints.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CCheckpoint`.
+	 */
+	void setCheckpoint(const char* fileName=0, int interval=600);
+
+	/**
+	 * Any thread can read the record objective value and the bound on the optimal objective value
+	 * from the returned object without locking.
+	 * \return pointer to the object that publishes the record solution.
+	 * \sa `CIncumbent`.
+	 */
+	const CIncumbent* getIncumbent() const
+		{return m_pInc;}
+
+	/**
+	 * This function overloads `CMIP::changeRecord()` to publish the record solution to all threads.
+	 * \param[in]  objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`.
+	 */
+	virtual void changeRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd);
+
+	/**
+	 * The procedure switches on root node racing.
+	 * Before branch-and-cut starts, `racerNum` racers solve the root node in parallel, each with its own settings.
+	 * The settings of the racer with the best root bound are used to solve the problem;
+	 * global cuts and the best solution found by all racers are passed to the solver.
+	 * \param[in] racerNum number of racers; if `racerNum=0`, one racer per thread is run.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CRootRace`.
+	 */
+	void setRootRacing(int racerNum=0);
+
+	/**
+	 * The procedure switches on the objective feasibility pump.
+	 * The pump alternates projections of rounded points onto the LP relaxation with rounding of LP solutions;
+	 * the solution it finds is passed to the solver as a record.
+	 * \param[in] maxIterNum maximum number of pumping iterations;
+	 * \param[in] background if `true`, the pump is run on a background thread while branch-and-cut proceeds;
+	 *  otherwise, it is run before the root node is processed.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CFeasPump`.
+	 */
+	void setFeasibilityPump(int maxIterNum=100, bool background=false);
+
+	/**
+	 * The procedure switches on large neighbourhood search heuristics: RENS, RINS, and local branching.
+	 * After the root node has been processed, sub-MIPs are solved on a spare thread, and
+	 * improving solutions are passed to the solver as records.
+	 * \param[in] nodeLimit maximum number of nodes processed when solving a sub-MIP;
+	 * \param[in] timeLimit limit (in seconds) on solution time of a sub-MIP;
+	 * \param[in] minFixRate RENS and RINS are run only if at least this fraction of integer variables are fixed;
+	 * \param[in] radius radius of local branching neighbourhood.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CLns`.
+	 */
+	void setLnsHeuristics(int nodeLimit=500, int timeLimit=10, double minFixRate=0.3, int radius=10);
+
+	/**
+	 * The procedure switches on the portfolio of diving heuristics: fractional, coefficient, pseudocost,
+	 * vector length, guided, and conflict diving.
+	 * After the root node has been processed, dives are made on idle threads, each of which solves its own copy of the LP;
+	 * strategies are chosen at random according to their success rates, and
+	 * improving solutions are passed to the solver as records.
+	 * \param[in] threadNum number of diving threads; if `threadNum=0`, all processors not used by the solver are used.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CDiving`.
+	 */
+	void setDivingPortfolio(int threadNum=0);
+
+	/**
+	 * The procedure switches on adaptive scheduling of the feasibility pump, LNS neighbourhoods, and diving strategies
+	 * (see `CHeurScheduler`).
+	 * The rounding heuristics of the solver (see `CMIP::setRoundingType()`) run inside the core;
+	 * they are neither timed nor scheduled.
+	 * The time spent and the improving solutions found by every heuristic are accounted;
+	 * heuristics are called only while their total time does not exceed `timeFraction` of solution time,
+	 * and, when several heuristics compete, the one with the largest upper confidence bound
+	 * on the number of improving solutions per second is chosen.
+	 * The statistics of heuristics are printed by `solStatistics()`;
+	 * nothing is printed if none of the above heuristics has been switched on.
+	 * \param[in] timeFraction fraction of solution time which may be spent in heuristics;
+	 * \param[in] explore weight of the exploration term of upper confidence bounds.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setHeuristicScheduling(double timeFraction=0.1, double explore=1.0);
+
+	/**
+	 * The procedure switches on parallel probing of binary variables.
+	 * Before the solver preprocesses the problem, candidate variables are distributed among threads,
+	 * each of which probes its variables against read-only bounds and writes fixings, bounds, and implications
+	 * into its own buffer; the buffers are merged between rounds.
+	 * New bounds are passed to the solver, and implications are added to the clique table (if clique cuts are switched on).
+	 * \param[in] threadNum number of probing threads; if `threadNum=0`, the number of solver threads is used;
+	 * \param[in] maxRoundNum maximum number of probing rounds;
+	 * \param[in] timeLimitPerRound limit (in seconds) on the time of one probing round;
+	 * \param[in] replace if `true`, probing of the solver is reduced to depth one (the solver always probes while preprocessing).
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CProbing`.
+	 */
+	void setParallelProbing(int threadNum=0, int maxRoundNum=3, int timeLimitPerRound=10, bool replace=true);
+
+	/**
+	 * The procedure switches on incremental activity propagation at the nodes of the search tree (see `CPropagator`).
+	 * Minimum and maximum activities of the rows of the original problem are kept for the root bounds;
+	 * at every node, only the bounds that differ from the root ones are changed, only the rows affected by these changes
+	 * are processed, and the activities are restored when the node has been processed.
+	 * Packing and cardinality rows are processed by a special kernel.
+	 * Tightened bounds are passed to the solver; a node is pruned if a contradiction has been found.
+	 * \param[in] maxWork maximum number of row entries scanned at one node.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setActivityPropagation(int maxWork=100000);
+
+	/**
+	 * The procedure switches on detection and breaking of symmetries (see `CSymmetry`).
+	 * Before the solver preprocesses the problem, the generators of (a subgroup of) the symmetry group are searched
+	 * by partition refinement of the colored graph of the problem, and for every binary base column \f$x_b\f$
+	 * of the stabilizer chain, the inequalities \f$x_b \ge x_j\f$ are added for all columns \f$x_j\f$ from the orbit of \f$x_b\f$;
+	 * the total number of these inequalities does not exceed the number of columns.
+	 * \param[in] maxGenNum maximum number of generators;
+	 * \param[in] timeLimit limit (in seconds) on the time of symmetry detection.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setSymmetryBreaking(int maxGenNum=100, int timeLimit=10);
+
+	/**
+	 * The procedure switches on restarts after processing the root node (see `CRestart`).
+	 * If, when the solver is about to branch at the root node, the share of integer variables fixed
+	 * (by preprocessing the root node, reduced cost fixing, and so on) is not less than `minFixRate`,
+	 * the solver is stopped, and the problem is loaded again with the bounds of integer variables valid at the root node,
+	 * so that the solver preprocesses a smaller problem. The record solution, pool cuts, and pseudocosts are kept.
+	 * \param[in] minFixRate minimum share of fixed integer variables;
+	 * \param[in] maxRestartNum maximum number of restarts.
+	 * \throws CMemoryException lack of memory.
+	 * \attention Restarts are done only if preprocessing has been switched off by calling `preprocOff()`.
+	 *  Preprocessing may remove, substitute, or fix columns by dual arguments, so that the root bounds of its columns
+	 *  are not valid bounds of the problem variables; besides, the solver keeps the preprocessing stack of its first run
+	 *  when the problem is loaded again. Otherwise, the restart is skipped, and a warning is printed.
+	 *  Without preprocessing, variables are fixed at the root node mostly by reduced costs,
+	 *  which requires a good record solution (e.g., one given by a MIP start, see `setMipStart()`).
+	 * \sa `getRestartNum()`.
+	 */
+	void setRootRestart(double minFixRate=0.3, int maxRestartNum=1);
+
+	/**
+	 * \return number of root restarts done.
+	 * \sa `setRootRestart()`.
+	 */
+	int getRestartNum() const;
+
+	/**
+	 * The procedure switches on the solution pool (see `CSolutionPool`).
+	 * Every feasible solution found during the search, by the solver or by heuristics,
+	 * is offered to the pool, which keeps the `maxSolNum` best distinct solutions.
+	 * If `alternative=false`, the solver still prunes the nodes which are not better than the record,
+	 * and so the pool stores only solutions met on the way to an optimal one.
+	 * If `alternative=true`, solutions are not accepted by the solver, which keeps searching
+	 * until all solutions not worse than the cutoff of the pool (see `CSolutionPool::getCutoff()`) are enumerated;
+	 * then the best solution of the pool is returned as the solution of the problem.
+	 * Since preprocessing of the solver may remove solutions which are not optimal, it is switched off in this mode.
+	 * Once the pool is full, only nodes which may contain solutions better than the worst solution of the pool
+	 * (by at least the greatest common divisor of the objective coefficients if the objective is integral) are processed.
+	 * Such nodes are pruned when branching, since the solver, when given that cutoff as an objective bound,
+	 * sometimes generates cuts which cut off solutions better than the cutoff.
+	 * \attention Searching for alternative solutions is expensive, so it is meant for small problems.
+	 *  Unless `gap` is small, nothing is pruned by bound until the pool is full, and without preprocessing even proving that the pool
+	 *  cannot be improved may take much longer than solving the problem with preprocessing:
+	 *  e.g., a bin packing problem with 18 items and 10 bins, which is solved in 0.1 seconds without the pool,
+	 *  is not solved in two minutes with `setSolutionPool(10,1.0e20,true)`, and a generalized assignment problem
+	 *  with 8 agents and 40 jobs is solved in 40 seconds instead of 0.25 seconds.
+	 * \param[in] maxSolNum maximum number of solutions in the pool;
+	 * \param[in] gap relative gap, only solutions which objective values differ from the best one by at most `gap*max(1,|best|)` are kept;
+	 * \param[in] alternative if `true`, the solver searches for alternative solutions.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setSolutionPool(int maxSolNum=10, double gap=1.0e20, bool alternative=false);
+
+	/**
+	 * \return number of solutions in the solution pool.
+	 * \sa `setSolutionPool()`.
+	 */
+	int getPoolSolNum() const;
+
+	/**
+	 * \param[in] k solution rank (`0` is the best solution).
+	 * \return objective value of `k`-th best solution of the solution pool.
+	 */
+	double getPoolObjective(int k) const;
+
+	/**
+	 * \param[in] k solution rank (`0` is the best solution);
+	 * \param[in] var variable which value is inquired.
+	 * \return value of variable `var` in `k`-th best solution of the solution pool.
+	 */
+	double getPoolValue(int k, CVar& var) const;
+
+	/**
+	 * The procedure sets limits for completing a MIP start (see `CMipStart`), and removes all start values set before.
+	 * Start values are set by calling `setMipStartValue()`.
+	 * \param[in] nodeLimit maximum number of nodes processed when completing a partial start;
+	 * \param[in] timeLimit limit (in seconds) on time of completing a partial start.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setMipStart(int nodeLimit=1000, int timeLimit=10);
+
+	/**
+	 * The procedure sets the value of a variable in the MIP start.
+	 * Before the search starts, a complete start solution is checked and used as the initial record solution;
+	 * a partial one is completed by solving the sub-MIP in which the integer variables with start values are fixed.
+	 * \param[in] var variable;
+	 * \param[in] val start value of `var`.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `setMipStart()`.
+	 */
+	void setMipStartValue(CVar& var, double val);
+
+	/**
+	 * The procedure switches on decomposition of block diagonal problems.
+	 * If the matrix of the original problem splits into two or more independent blocks,
+	 * each block is solved as a separate MIP, and the blocks are solved in parallel.
+	 * If all blocks are solved to optimality, the solution of the problem is composed of the block solutions;
+	 * otherwise, that composed solution (if any) is used as an initial record solution.
+	 * \param[in] threadNum number of threads; if `threadNum=0`, this number is chosen by the solver.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CDecomposition`.
+	 */
+	void setDecomposition(int threadNum=0);
+
+	/**
+	 * The procedure switches on the hashed pool of cuts generated by `separate()`, `gencut()`, and root racers.
+	 * Duplicate cuts are detected in constant time, and are stored only once.
+	 * Before calling `separate()`, the solver checks the cuts from the pool (in parallel if the pool is large),
+	 * and `separate()` is called only if no cut from the pool is violated.
+	 * \param[in] threadNum number of threads used to separate the pool;
+	 *  if `threadNum=0`, this number is chosen by the solver.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CCutPool`.
+	 */
+	void setCutPool(int threadNum=0);
+
+	/**
+	 * The procedure switches on selection of cuts generated by `separate()`, `gencut()`, and taken from the cut pool.
+	 * Every candidate cut is scored by its efficacy, its orthogonality to the cuts already selected,
+	 * and its parallelism to the objective; then a diverse subset of candidates is sent to the solver.
+	 * \param[in] effWeight weight of efficacy;
+	 * \param[in] orthoWeight weight of orthogonality;
+	 * \param[in] parWeight weight of objective parallelism;
+	 * \param[in] minOrtho cuts which orthogonality to selected cuts is less than `minOrtho` are discarded;
+	 * \param[in] maxCutNum maximum number of cuts selected in one round; if `maxCutNum=0`, the number of cuts is not limited.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CCutSelector`.
+	 */
+	void setCutSelection(double effWeight=1.0, double orthoWeight=1.0, double parWeight=0.1,
+		double minOrtho=0.1, int maxCutNum=0);
+
+	/**
+	 * The procedure switches on aging of cuts in node LPs (see `CCutAging`).
+	 * Every time an LP has been solved, the age of each cut in the LP is increased by one if the cut is not binding,
+	 * and it is reset to zero otherwise. Cuts which ages reach an adaptive threshold are evicted from the LP:
+	 * global cuts are moved to the cut pool (the pool is switched on if it is off),
+	 * which returns them to the LP when they are violated again.
+	 * \param[in] maxAge initial (and maximum) value of the threshold;
+	 * \param[in] maxCutNum target number of cuts in node LPs, the threshold decreases when this number is exceeded;
+	 *  if `maxCutNum=0`, the target is the number of rows in the root LP (but not less than `100`).
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setCutAging(int maxAge=8, int maxCutNum=0);
+
+	/**
+	 * The procedure switches on collecting statistics of cut families (see `CCutStat`):
+	 * time spent generating cuts, number of calls, improvement of the LP bound,
+	 * and numbers of cuts that stay in the LP for 1, 10, and 100 rounds.
+	 * The statistics are printed by `solStatistics()` after the solution summary.
+	 * \throws CMemoryException lack of memory.
+	 * \sa getCutFamilyStat().
+	 */
+	void setCutStatistics();
+
+	/**
+	 * \param[in] family cut family (see `enCutFamily`), or `CUTSTAT_AUTO` for cuts generated by the __MIPCL__ core;
+	 * \param[out] stat statistics of `family`.
+	 * \return `false` if statistics of cut families are not collected.
+	 * \sa setCutStatistics().
+	 */
+	bool getCutFamilyStat(int family, tagCutFamilyStat& stat) const;
+
+	/**
+	 * The procedure adds a separator which is run concurrently with `separate()` and all other added separators.
+	 * All of them separate the same solution, each thread writes cuts into its own buffer,
+	 * and the buffers are merged through the cut selector;
+	 * if cut selection has not been switched on, it is switched on with default parameters.
+	 * \param[in] pSep pointer to separator, which will be destroyed by this object;
+	 * \param[in] threadNum maximum number of threads running separators;
+	 *  if `threadNum=0`, the number of threads used by the solver is taken.
+	 * \throws CMemoryException lack of memory.
+	 * \sa `CSeparator`, `CConcurrentSep`.
+	 */
+	void addSeparator(CSeparator* pSep, int threadNum=0);
+
+	/**
+	 * The procedure adds the mod-2 cut separator (see `CMod2Sep`), which works with the rows of the original problem
+	 * and does Gaussian elimination over GF(2) on bit-packed matrices.
+	 * Its running time is reported in the cut statistics.
+	 * \param[in] maxRowNum maximum number of rows in GF(2) matrix;
+	 * \param[in] maxCutNum maximum number of cuts generated in one call;
+	 * \param[in] threadNum maximum number of threads running separators (see `addSeparator()`).
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setMod2Cuts(int maxRowNum=8192, int maxCutNum=64, int threadNum=0);
+
+	/**
+	 * The procedure adds the zero-half cut separator (see `CZeroHalfSep`), which looks for shortest odd cycles
+	 * in the graph built on the rows of the original problem instead of doing Gaussian elimination.
+	 * It may be used together with `setMod2Cuts()`; the running times of both separators are reported in the cut statistics.
+	 * \param[in] maxCutNum maximum number of cuts generated in one call;
+	 * \param[in] threadNum maximum number of threads running separators (see `addSeparator()`).
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setZeroHalfCuts(int maxCutNum=64, int threadNum=0);
+
+	/**
+	 * The procedure adds the clique cut separator (see `CCliqueSep`).
+	 * Its clique table (see `CCliqueTable`) is built once when the problem is loaded,
+	 * and it can be extended later by `addConflict()`.
+	 * \param[in] maxCutNum maximum number of cuts generated in one call;
+	 * \param[in] threadNum maximum number of threads running separators (see `addSeparator()`).
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setCliqueCuts(int maxCutNum=64, int threadNum=0);
+
+	/**
+	 * The procedure adds to the clique table an implication saying that two binary variables
+	 * (or their complements) cannot both be equal to one.
+	 * It does nothing if clique cuts have not been switched on by `setCliqueCuts()`, or the problem has not been loaded yet.
+	 * \param[in] var1,var2 binary variables;
+	 * \param[in] val1,val2 values; the conflict is \f$var_1=val_1\f$ and \f$var_2=val_2\f$.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void addConflict(CVar& var1, bool val1, CVar& var2, bool val2);
+
+	/**
+	 * The procedure switches on conflict analysis (see `CConflict`).
+	 * At every node, the bounds set by branching are propagated over the rows of the original problem
+	 * and the objective bound given by the record; if the node is infeasible, it is pruned,
+	 * and the bound changes that caused the infeasibility are traced back to a short nogood in binary variables,
+	 * which is added to the cut pool as a global cut (the pool is switched on if it is off).
+	 * Nogoods of two literals are also added to the clique table if clique cuts are on.
+	 * \param[in] maxLen nogoods of more than `maxLen` literals are discarded.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setConflictAnalysis(int maxLen=16);
+
+	/**
+	 * The procedure switches on generation of lift-and-project cuts (see `CLiftProject`).
+	 * The cuts are derived directly from the rows of the optimal simplex tableau,
+	 * which are combined with the rows of basic variables lying near their bounds
+	 * to increase the distance from the LP solution to the cut; no cut-generating LP is solved.
+	 * The cuts are generated after `separate()` and the cut pool have failed to produce cuts,
+	 * and they are accounted for in the cut statistics as the family `CUT_LIFT_PROJECT`.
+	 * \param[in] maxCutNum maximum number of cuts generated in one round;
+	 * \param[in] maxRoundNum maximum number of rounds at one node;
+	 * \param[in] maxCutSize cuts of more than `maxCutSize` entries are discarded; `0` means no limit;
+	 * \param[in] height cuts are generated only at nodes which heights are not greater than `height`;
+	 *  if `height=0`, only at the root node.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void setLiftProjectCuts(int maxCutNum=50, int maxRoundNum=10, int maxCutSize=0, int height=0);
+
 #define preprocoff preprocOff ///< alias for `CLP::preprocOff()`
 #define setcutpattern setAutoCutPattern ///< alias for `CMIP::setAutoCutPattern()`
 	
@@ -233,6 +689,67 @@ protected:
 	 */
 	virtual void printSolution(const char* fileName=0);
 
+	/**
+	 * This function overloads `CMIP::cutStatistics()` to print also
+	 * how many cuts of each __MIPshell__ family were generated and accepted by the cut selector.
+	 */
+	virtual void cutStatistics();
+
+	/**
+	 * This function overloads `CMIP::solStatistics()` to print, after the solution summary,
+	 * also the statistics of cut families if they are collected,
+	 * and the statistics of heuristics if heuristic scheduling is on; parameters are those of `CMIP::solStatistics()`.
+	 * \sa `setCutStatistics()`, `setHeuristicScheduling()`.
+	 */
+	virtual void solStatistics(std::ostream &out, const char* MIPCLver,
+			const char* solTime, bool timeLimit, int nodeNum,
+			bool feasible, bool hasSolution, double objVal,
+			bool opt, double gap, bool gapLimit, double bound,
+			int difficultNodes);
+
+	/**
+	 * This function overloads `CMIP::mipInfo()` not to print the progress of the search in silent mode:
+	 * if preprocessing is off (e.g., when the solution pool searches for alternative solutions),
+	 * the solver calls `mipInfo()` even if `beSilent()` has been called; parameters are those of `CMIP::mipInfo()`.
+	 */
+	virtual void mipInfo(char *timeElapsed, int nodeNum, int leafNum,
+			double bestObjVal, double objBound, double gap, int solsFound, bool sense, bool header);
+
+	/**
+	 * If reliability branching is on, `CProblem` overloads `CMIP::startBranching()`
+	 *  to choose a branching variable by `CRelBranching::select()`.
+	 * \param[in] nodeHeight height (in the search tree) of the currently processed node.
+	 * \return number of branches.
+	 * \sa `setReliabilityBranching()`, `updateBranch()`.
+	 */
+	virtual int startBranching(int nodeHeight);
+
+	/**
+	 * Together with `startBranching()`, the function implements branching on the variable selected by reliability branching.
+	 * \param[in] i branch index.
+	 * \return `false` if inconsistency has been detected; otherwise, `true`.
+	 */
+	virtual bool updateBranch(int i);
+
+	/**
+	 * If activity propagation or conflict analysis is on, `CProblem` overloads `CMIP::propagate()`
+	 * to call `propagateActivities()` and `analyzeConflict()`.
+	 * \return `false` if the node being processed has been proven to be infeasible; otherwise, `true`.
+	 * \sa `setConflictAnalysis()`.
+	 */
+	virtual bool propagate();
+
+	/**
+	 * If the solution pool is on, `CProblem` overloads `CMIP::isFeasible()` to offer every solution found by the solver to the pool;
+	 * if the solver searches for alternative solutions, the solution is rejected, and the node is branched further
+	 * by `startBranching()`.
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipColHd for `j=1,...,n`, `dpX[j]` is the value of variable with handle `ipColHd[j]`.
+	 * \return `false` if the solution has been rejected; otherwise, `true`.
+	 * \sa `setSolutionPool()`.
+	 */
+	virtual bool isFeasible(int n, const double* dpX, const tagHANDLE* ipColHd);
+
 	/**
 	 * The procedure rewrites solution to an internal `MIPCL` array so that
 	 * the value of any `MIPshell` variable `x` can be accessed via calls `x.getVal()` or `getval(x)`.
@@ -253,7 +770,160 @@ private:
 	bool separate(int n, const double* X, const tagHANDLE* colHd, bool genFlag);
 	bool genCut1(int n, const double* X, const tagHANDLE* colHd);
 
-	void loadCuts(); ///< sends cuts to the solver
+	/**
+	 * The function copies the node LP and the list of branching candidates to `m_pRelBr`,
+	 *  and then calls `CRelBranching::select()`.
+	 * \param[in] nodeHeight height (in the search tree) of the currently processed node.
+	 * \return `true` if a branching variable has been selected.
+	 */
+	bool relBranching(int nodeHeight);
+
+	void takeCheckpoint(); ///< passes the current state to `m_pCkp`.
+	void resumeRecord(); ///< sends the record solution read from checkpoint file to the solver.
+
+	/**
+	 * The procedure sends a solution found outside the solver to the solver,
+	 * if this solution is better than the current record solution.
+	 * \param[in]  objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`.
+	 */
+	void setInitialRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd);
+
+	void copyMatrix(CMatrixCopy& copy); ///< copies the loaded problem to `copy`; it is called before the matrix is closed (and preprocessed).
+	bool decompose(); ///< solves independent components of the matrix; \return `true` if the problem has been solved.
+	void loadDecompRecord(); ///< sends the solution composed by `m_pDecomp` to the solver.
+
+	void race(); ///< runs racers on the copy stored in `m_pRace`, and applies settings of the winner.
+	bool loadRaceResults(bool genFlag); ///< sends cuts and solution found by racers to the solver.
+	void loadPumpRecord(); ///< sends the solution found by `m_pFeasPump` to the solver.
+	void loadLnsRecord(); ///< sends the best solution found by `m_pLns` to the solver.
+	void loadDivingRecord(); ///< sends the best solution found by `m_pDiving` to the solver.
+	void loadRestartRecord(); ///< sends the record solution found before the last restart to the solver.
+	void loadStartRecord(); ///< sends the solution built from the MIP start by `m_pStart` to the solver.
+
+	/**
+	 * The function is called when the solver is about to branch at the root node;
+	 * it stores the bounds of integer variables in `m_pRestart`, and stops the solver if many of them are fixed.
+	 */
+	void checkRestart();
+
+	/**
+	 * The procedure loads the problem again with the bounds stored in `m_pRestart`, and keeps the record solution.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void restart();
+
+	/**
+	 * The function is called from `startBranching()` when the solver searches for alternative solutions;
+	 * it prunes the node if its LP bound is below the cutoff of `m_pPool`, and, if the node LP solution is integral,
+	 * offers this solution to `m_pPool` and selects an integer variable which is not fixed for branching.
+	 * \param[out] brNum number of branches; `0` if the node is to be pruned.
+	 * \return `true` if the node has been processed.
+	 */
+	bool poolBranching(int& brNum);
+
+	/**
+	 * The function sends cuts to the solver.
+	 * \param[in] family family of cuts (see `enCutFamily`).
+	 * \return number of cuts sent; if cut selection is on, cuts rejected by the selector are not counted.
+	 */
+	int loadCuts(int family=0);
+
+	/**
+	 * The function sends cuts chosen by `m_pCutSel` to the solver.
+	 * A cut identical to one sent in the previous round is not sent again:
+	 * it is still violated only if the solver has not been able to enforce it.
+	 * \return number of cuts sent.
+	 * \throws CMemoryException lack of memory.
+	 */
+	int sendSelectedCuts();
+
+	/**
+	 * The function maps variable handles to columns; handles of variables removed by preprocessing are mapped to `-1`.
+	 * The map is kept in its own array since the solver may rewrite its auxiliary arrays while cuts are being added.
+	 * \return `m_ipHdToCol`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	int* mapHandles();
+	void initCutSelector(); ///< passes the objective to `m_pCutSel`.
+
+	/**
+	 * The function sends to the solver the cuts from `m_pCutPool` that are violated by the current solution.
+	 * \param[in] genFlag if `false`, violated cuts are only counted.
+	 * \return `true` if at least one cut from the pool is violated.
+	 */
+	bool separateCutPool(bool genFlag);
+
+	/**
+	 * The function runs `separate()` and the separators added by `addSeparator()` at the same time.
+	 * \param[in] genFlag if `false`, cuts are not sent to the solver.
+	 * \return `true` if at least one cut has been generated (and, if `genFlag=true`, sent to the solver).
+	 */
+	bool separateConcurrently(bool genFlag);
+
+	/**
+	 * The function passes the bounds of the node being processed to `m_pConflict`,
+	 * and writes the derived nogood (if any) into the cut pool.
+	 * \return `false` if the node is infeasible.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool analyzeConflict();
+
+	/**
+	 * The function propagates the bounds of the node being processed over the rows of the original problem (see `m_pPropagator`),
+	 * and passes tightened bounds to the solver.
+	 * \return `false` if the node is infeasible.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool propagateActivities();
+
+	/**
+	 * The function updates the ages of the cuts in the LP, and evicts old cuts.
+	 * \param[in] n number of columns in the LP (columns removed by preprocessing are not counted);
+	 * \param[in] dpX LP solution, `dpX[h]` is value of variable with handle `h` (see `setSolution()`).
+	 * \throws CMemoryException lack of memory.
+	 */
+	void ageCuts(int n, const double* dpX);
+
+	/**
+	 * The function passes the cuts in the LP and the LP bound to `m_pCutStat`.
+	 * \param[in] n number of columns.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void trackCuts(int n);
+
+	/**
+	 * The function passes the cuts added to the LP to `m_pCutStat`.
+	 * \param[in] m rows `m,...,m_iM-1` are cuts just added;
+	 * \param[in] family their family.
+	 */
+	void tagCuts(int m, int family);
+
+	/**
+	 * The function calls `separate()`, and adds its running time to statistics of `CUT_SEPARATE`.
+	 * \return value returned by `separate()`.
+	 */
+	bool timedSeparate();
+
+	/**
+	 * The function passes the tight rows and the columns of the node LP to `m_pLiftProject`,
+	 * and sends lift-and-project cuts to the solver.
+	 * \param[in] n number of columns in the LP (columns removed by preprocessing are not counted);
+	 * \param[in] X LP solution, `X[h]` is value of variable with handle `h` (see `setSolution()`).
+	 * \return `true` if at least one cut has been sent.
+	 * \throws CMemoryException lack of memory.
+	 */
+	bool separateLiftProject(int n, const double* X);
+
+	/**
+	 * The function is called by `CCutPool::separate()` to send the cut
+	 * \f$b_1 \le \sum_{i=0}^{sz-1} dpVal[i] x_{ipHd[i]} \le b_2\f$ to the solver.
+	 * \param[in] pProblem pointer to `CProblem` object;
+	 * \param[in] b1,b2 left and right hand sides;
+	 * \param[in] sz,dpVal,ipHd cut coefficients.
+	 */
+	static void addPoolCut(void* pProblem, double b1, double b2, int sz, const double* dpVal, const int* ipHd);
 	void deleteCuts(); ///< delete all cuts
 
 	char* getCtrName(tagHANDLE rowHd, char *name);
@@ -0,0 +1,226 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Propagator.h interface for `CPropagator` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __PROPAGATOR__H
+#define __PROPAGATOR__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+#include <iostream>
+#include <thread.h>
+#include "MatrixCopy.h"
+
+/**
+ * `CPropagator` implements incremental bound propagation over the rows of a copy of the original problem.
+ *
+ * For every row \f$l_i \le \sum_j a_{ij}x_j \le u_i\f$, the minimum and maximum activities are stored
+ * as sums of finite contributions and numbers of infinite contributions, and they are updated when a bound changes,
+ * so that rows are never rescanned to compute their activities. A changed bound puts into the queue only the rows
+ * (found through the column-wise representation of the matrix) which activity on the side with a finite right hand side has been tightened.
+ * Rows of _packing_ and _cardinality_ type (see `CMIP::CTR_PACKING` and `CMIP::CTR_CARDINALITY`),
+ * in which all variables are binary and all coefficients are `1` or `-1`, are processed by a special kernel:
+ * such a row can imply anything only if its slack is less than one, and then all its free variables are fixed.
+ * All other rows are processed by the general kernel that derives bounds from the residual activities.
+ *
+ * The matrix and the row types are shared and read-only; the bounds, activities, trail, and queue
+ * are stored in a state (`tagState`), so several threads can propagate simultaneously, each on its own state.
+ * Every bound change is written onto the trail, so that the state can be restored by `undo()`.
+ * `CProbing` propagates fixings of binary variables on its thread states;
+ * `CProblem` propagates branching bounds at the nodes of the search tree (see `CProblem::setActivityPropagation()`).
+ */
+class MIPSHELL_API CPropagator
+{
+	friend class CProblem;
+public:
+	/// Bounds, activities, trail, and queue of one propagation thread.
+	struct tagState {
+		double *dpD; ///< `dpD[2*j]` and `dpD[2*j+1]` are lower and upper bounds of variable `j`.
+		double *dpAct; ///< `dpAct[2*i]` (`dpAct[2*i+1]`) is sum of finite contributions to minimum (maximum) activity of row `i`.
+		int *ipInf; ///< `ipInf[2*i]` (`ipInf[2*i+1]`) is number of infinite contributions to minimum (maximum) activity of row `i`.
+		int stamp; ///< counter of propagations, used to mark trail and queue entries of the current propagation.
+		int varTrailNum; ///< number of variables in `ipVarTrail`.
+		int *ipVarTrail; ///< variables which bounds have been changed by the current propagation.
+		double *dpVarOld; ///< `dpVarOld[2*k]`, `dpVarOld[2*k+1]` are bounds of variable `ipVarTrail[k]` before propagation.
+		int *ipVarStamp; ///< `ipVarStamp[j]=stamp` if variable `j` is in `ipVarTrail`.
+		int rowTrailNum; ///< number of rows in `ipRowTrail`.
+		int *ipRowTrail; ///< rows which activities have been changed by the current propagation.
+		double *dpRowOld; ///< activities of rows from `ipRowTrail` before propagation (two entries per row).
+		int *ipRowInfOld; ///< numbers of infinite contributions of rows from `ipRowTrail` before propagation (two entries per row).
+		int *ipRowStamp; ///< `ipRowStamp[i]=stamp` if row `i` is in `ipRowTrail`.
+		int *ipQueue; ///< cyclic queue of rows to be processed.
+		int qHead; ///< position of the first row in `ipQueue`.
+		int qNum; ///< number of rows in `ipQueue`.
+		int *ipInQueue; ///< `ipInQueue[i]=stamp` if row `i` is in the queue.
+		long long rowNum; ///< number of rows processed by the general kernel.
+		long long cardRowNum; ///< number of rows processed by the packing and cardinality kernel.
+	};
+
+protected:
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	int m_iMaxWork; ///< maximum number of row entries scanned by one propagation at a node of the search tree.
+	int *m_ipColBeg; ///< entries of column `j` are stored in positions `m_ipColBeg[j],...,m_ipColBeg[j+1]-1` of `m_ipColRow` and `m_dpColVal`.
+	int *m_ipColRow; ///< row indices of column entries.
+	double *m_dpColVal; ///< coefficients of column entries.
+	unsigned *m_ipRowType; ///< `m_ipRowType[i]` is `CMIP::CTR_PACKING` or `CMIP::CTR_CARDINALITY` if row `i` is processed by the special kernel, and `0` otherwise.
+	double *m_dpD; ///< global bounds, `m_dpD[2*j]` and `m_dpD[2*j+1]` are lower and upper bounds of variable `j`.
+
+// states used at the nodes of the search tree
+	int m_iNodeStateNum; ///< size of `m_ppNodeState`.
+	tagState** m_ppNodeState; ///< `m_ppNodeState[t]` is the state used by thread `t`.
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< Locks `m_ppNodeState`.
+#endif
+
+// statistics
+	std::atomic<int> m_iCallNum; ///< number of nodes processed.
+	std::atomic<int> m_iPruneNum; ///< number of nodes proven infeasible.
+	std::atomic<long long> m_lBdNum; ///< number of bounds tightened at the nodes.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxWork maximum number of row entries scanned by one propagation at a node of the search tree.
+	 */
+	CPropagator(int maxWork=100000);
+	virtual ~CPropagator(); ///< The destructor.
+
+	/**
+	 * The function builds column-wise representation of the matrix, classifies the rows, and sets global bounds;
+	 * it must be called after `m_copy` has been filled in.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void init();
+
+	/**
+	 * \return number of variables.
+	 */
+	int getColNum() const
+		{return m_copy.getColNum();}
+
+	/**
+	 * The function allocates memory for a state.
+	 * \param[out] s state.
+	 * \return `false` if there is not enough memory.
+	 */
+	bool allocState(tagState& s) const;
+
+	/**
+	 * The function frees memory allocated for a state.
+	 * \param[in,out] s state.
+	 */
+	static void freeState(tagState& s);
+
+	/**
+	 * The function sets the bounds of a state, and computes its row activities.
+	 * \param[out] s state;
+	 * \param[in] dpD bounds of variables (see `tagState::dpD`).
+	 */
+	void resetState(tagState& s, const double* dpD) const;
+
+	/**
+	 * The function starts a new propagation: all bound changes made after this call can be reverted by `undo()`.
+	 * \param[in,out] s state.
+	 */
+	void startPropagation(tagState& s) const;
+
+	/**
+	 * The function changes bounds of a variable, updates row activities, and puts affected rows into the queue.
+	 * \param[in,out] s state;
+	 * \param[in] j variable;
+	 * \param[in] lo,up new bounds.
+	 */
+	void changeBound(tagState& s, int j, double lo, double up) const;
+
+	/**
+	 * The function propagates bound changes through the rows in the queue.
+	 * \param[in,out] s state;
+	 * \param[in] maxWork when this number of row entries have been scanned, propagation stops (the bounds derived so far are valid).
+	 * \return `false` if a contradiction has been found.
+	 */
+	bool propagate(tagState& s, int maxWork) const;
+
+	/**
+	 * The function restores bounds and row activities changed since the last call to `startPropagation()`.
+	 * \param[in,out] s state.
+	 */
+	void undo(tagState& s) const;
+
+	/**
+	 * The function prints the numbers of nodes processed and pruned, bounds tightened,
+	 * and rows processed by the general and special kernels.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+protected:
+	/**
+	 * The function computes row activities.
+	 * \param[in] dpD bounds of variables;
+	 * \param[out] dpAct,ipInf finite parts and numbers of infinite contributions of row activities.
+	 */
+	void computeActivities(const double* dpD, double* dpAct, int* ipInf) const;
+
+	/**
+	 * The function returns the state of a thread used at the nodes of the search tree;
+	 * the state is created at the first call.
+	 * \param[in] thread thread index.
+	 * \return pointer to state, or `0` if there is not enough memory.
+	 */
+	tagState* getNodeState(int thread);
+
+private:
+	/**
+	 * The general kernel derives bounds of the variables of a row from its residual activities.
+	 * \param[in,out] s state;
+	 * \param[in] i row.
+	 * \return `false` if a contradiction has been found.
+	 */
+	bool propagateRow(tagState& s, int i) const;
+
+	/**
+	 * The special kernel for packing and cardinality rows fixes all free variables of a row if its slack is less than one.
+	 * \param[in,out] s state;
+	 * \param[in] i row.
+	 * \return `false` if a contradiction has been found.
+	 */
+	bool propagateCardinality(tagState& s, int i) const;
+};
+
+#endif // #ifndef __PROPAGATOR__H
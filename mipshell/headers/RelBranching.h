@@ -0,0 +1,288 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file RelBranching.h interface for `CRelBranching` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RELBRANCHING__H
+#define __RELBRANCHING__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <thread.h>
+
+class CLP;
+
+#define RELBR_MEM_SIZE 32 ///< number of last branchings remembered by `CRelBranching` to recognize children of branched nodes.
+#define RELBR_OBJ_TOL 1.0e-6 ///< a node is not taken as a child of a branched node if its LP bound is greater by more than this relative tolerance.
+
+/// Branching done by `CRelBranching` at some node.
+struct tagBranching {
+	int hd; ///< handle of branching variable, or `-1` if the entry is empty.
+	int col; ///< column of branching variable.
+	int height; ///< height of the branched node.
+	int observed; ///< bit `dir` is set when the child in direction `dir` (`0` for down, `1` for up) has been observed.
+	double x; ///< (not scaled) value of branching variable in node LP solution.
+	double obj; ///< objective value of node LP.
+};
+
+/**
+ * `CRelBranching` implements _reliability branching_.
+ *
+ * For every variable (indexed by its handle), two pseudocosts are maintained:
+ * the average decrease of the objective per unit change of the variable value when branching down and up.
+ * A pseudocost is said to be _reliable_ if it has been computed from at least `m_iRelThreshold` observations.
+ * At any node, strong branching is applied only to those candidates which pseudocosts are not yet reliable;
+ * all other candidates are scored by their pseudocosts.
+ * Besides strong branching, pseudocosts are updated by the objective decreases observed in the children of branched nodes.
+ * The solver does not tell which node is the parent of the processed one, and so every object remembers
+ * its last `RELBR_MEM_SIZE` branchings; a node is taken as a child of one of them if its height is greater by one,
+ * the bound of the branching variable is the one set in a branch, and no other remembered branching fits.
+ *
+ * Strong branching works with a copy of the node LP (rows, including cuts, and local bounds).
+ * This copy is in the space of the scaled matrix of the solver, whereas candidate values are not scaled;
+ * the bounds of branches are scaled when they are set in the copy.
+ * The candidates of one node are distributed among a number of threads,
+ * each of which solves the branch LPs on its own copy of the node LP.
+ * These copies are kept from node to node: while the rows of the node LP are not changed,
+ * only bounds are updated, and the branch LPs are solved starting from the last basis of the copy.
+ *
+ * Pseudocost tables are shared between all `CRelBranching` objects
+ * cloned from the same object; they are freed by the object which created them.
+ * All the other data (the node LP copy and the candidate list) are private to each object,
+ * and, therefore, to each thread of the branch-and-cut procedure.
+ */
+class MIPSHELL_API CRelBranching
+{
+	friend class CProblem;
+
+	bool m_bOwner; ///< `true` if `*this` object allocated (and must free) pseudocost tables.
+	int m_iRelThreshold; ///< pseudocost is reliable if it has been computed from at least `m_iRelThreshold` observations.
+	int m_iMaxCandNum; ///< at most `m_iMaxCandNum` candidates are evaluated by strong branching at any node.
+	int m_iThreadNum; ///< number of threads evaluating strong branching candidates; `0` means that this number is chosen automatically.
+
+	int m_iHdNum; ///< pseudocosts are stored for variables with handles `0,...,m_iHdNum-1`.
+	double *m_dpPcSum; ///< `m_dpPcSum[2*hd]` (`m_dpPcSum[2*hd+1]`) is sum of per-unit objective decreases observed when branching down (up) on variable with handle `hd`.
+	int *m_ipPcNum; ///< `m_ipPcNum[2*hd]` (`m_ipPcNum[2*hd+1]`) is number of observations summed up in `m_dpPcSum[2*hd]` (`m_dpPcSum[2*hd+1]`).
+	double *m_dpPcTotal; ///< `m_dpPcTotal[0]` (`m_dpPcTotal[1]`) is sum of all down (up) observations; `m_dpPcTotal[2]` (`m_dpPcTotal[3]`) is their number.
+#ifndef __ONE_THREAD_
+	_RWLOCK *m_rwPcLock; ///< Locks pseudocost tables.
+	_MUTEX m_candMutex; ///< Locks `m_iNextCand` when candidates are distributed among threads.
+#endif
+
+// node LP copy
+	int m_iM; ///< number of rows in node LP.
+	int m_iN; ///< number of columns in node LP.
+	int m_iMaxM; ///< size of memory allocated for rows.
+	int m_iMaxN; ///< size of memory allocated for columns.
+	int m_iMaxNZ; ///< size of memory allocated for matrix entries.
+	double *m_dpC; ///< objective coefficients.
+	double *m_dpD; ///< `m_dpD[2*j]` and `m_dpD[2*j+1]` are lower and upper bounds of variable `j`.
+	double *m_dpB; ///< `m_dpB[2*i]` and `m_dpB[2*i+1]` are left and right hand sides of row `i`.
+	int *m_ipBeg; ///< row `i` is stored in positions `m_ipBeg[i],...,m_ipBeg[i+1]-1` of `m_dpVal` and `m_ipCol`.
+	double *m_dpVal; ///< matrix coefficients.
+	int *m_ipCol; ///< column indices of matrix coefficients.
+
+// candidates
+	int m_iCandNum; ///< number of branching candidates.
+	int m_iMaxCandMem; ///< size of memory allocated for candidates.
+	int *m_ipCandCol; ///< `m_ipCandCol[k]` is column index of candidate `k`.
+	int *m_ipCandHd; ///< `m_ipCandHd[k]` is handle of candidate `k`.
+	int *m_ipCandExp; ///< in node LP, column `m_ipCandCol[k]` is scaled: its values are those of candidate `k` multiplied by `2^{-m_ipCandExp[k]}`.
+	double *m_dpCandX; ///< `m_dpCandX[k]` is (not scaled) value of candidate `k` in node LP solution.
+	double *m_dpCandScore; ///< `m_dpCandScore[k]` is score of candidate `k`.
+	double *m_dpCandGain; ///< `m_dpCandGain[2*k]` (`m_dpCandGain[2*k+1]`) is objective decrease in down (up) branch of candidate `k`.
+	int *m_ipSbCand; ///< list of candidates to be evaluated by strong branching.
+	int m_iSbCandNum; ///< number of candidates in `m_ipSbCand`.
+	int m_iNextCand; ///< next not yet processed position in `m_ipSbCand`.
+	double m_dNodeObj; ///< objective value of node LP.
+
+// last branchings
+	tagBranching m_pBr[RELBR_MEM_SIZE]; ///< last branchings done by `*this` object.
+	int m_iBrNext; ///< next branching is stored in `m_pBr[m_iBrNext]`, overwriting the oldest one.
+
+// strong branching LPs
+	int m_iMaxLpNum; ///< size of `m_ppLp` and `m_ulpLpKey`.
+	int m_iNextLp; ///< next not yet taken LP in `m_ppLp`.
+	CLP **m_ppLp; ///< `m_ppLp[t]` is copy of node LP used by `t`-th thread evaluating candidates.
+	unsigned long long *m_ulpLpKey; ///< `m_ulpLpKey[t]` is key of rows loaded into `m_ppLp[t]`.
+	unsigned long long m_ulRowKey; ///< key of rows of node LP.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] threshold reliability threshold;
+	 * \param[in] maxCandNum maximum number of candidates evaluated by strong branching at any node;
+	 * \param[in] threadNum number of threads evaluating strong branching candidates;
+	 *  if `threadNum=0`, all threads of the solver are used at the root node, and one thread at any other node.
+	 */
+	CRelBranching(int threshold, int maxCandNum, int threadNum);
+
+	/**
+	 * The clone constructor: pseudocost tables of `other` are shared with the new object.
+	 * \param[in] other object to be cloned.
+	 */
+	CRelBranching(const CRelBranching &other);
+
+	virtual ~CRelBranching(); ///< The destructor.
+
+	/**
+	 * The function allocates memory for pseudocost tables.
+	 * \param[in] hdNum pseudocosts are kept for variables with handles `0,...,hdNum-1`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void allocMemForPseudocosts(int hdNum);
+
+	/**
+	 * \param[in] hd variable handle;
+	 * \param[in] dir `0` for down branch, and `1` for up branch.
+	 * \return `true` if pseudocost of variable `hd` in direction `dir` is reliable.
+	 */
+	bool isReliable(int hd, int dir) const
+		{return (m_ipPcNum[(hd<<1)+dir] >= m_iRelThreshold)? true: false;}
+
+	/**
+	 * \return size (in doubles) of memory needed to store pseudocost tables by `storePseudocosts()`.
+	 */
+	int getPseudocostSize() const
+		{return (m_iHdNum<<2)+4;}
+
+	/**
+	 * The function copies pseudocost tables into a given memory buffer.
+	 * \param[out] dpMem array of size `getPseudocostSize()`.
+	 */
+	void storePseudocosts(double* dpMem);
+
+	/**
+	 * The function restores pseudocost tables from a memory buffer filled by `storePseudocosts()`.
+	 * \param[in] dpMem array of size `getPseudocostSize()`.
+	 */
+	void restorePseudocosts(const double* dpMem);
+
+private:
+	void allocMemForNodeLp(int m, int n, int nz); ///< \throws CMemoryException lack of memory.
+	void allocMemForCands(int n); ///< \throws CMemoryException lack of memory.
+
+	/**
+	 * \param[in] hd variable handle;
+	 * \param[in] dir `0` for down branch, and `1` for up branch.
+	 * \return pseudocost of variable `hd` in direction `dir`;
+	 *  if no observation has been done for this variable yet, the average over all variables is returned.
+	 * \attention Pseudocost tables must be locked for reading by the calling procedure.
+	 */
+	double getPseudocost(int hd, int dir) const;
+
+	/**
+	 * The function adds one observation to pseudocost tables.
+	 * \param[in] hd variable handle;
+	 * \param[in] dir `0` for down branch, and `1` for up branch;
+	 * \param[in] gain per-unit decrease of the objective.
+	 * \attention Pseudocost tables must be locked for writing by the calling procedure.
+	 */
+	void updatePseudocost(int hd, int dir, double gain);
+
+	/**
+	 * The function remembers a branching.
+	 * \param[in] k index of branching candidate;
+	 * \param[in] height height of the branched node.
+	 */
+	void storeBranching(int k, int height);
+
+	/**
+	 * The function adds to pseudocost tables the objective decrease observed in a child of a remembered branching.
+	 * \param[in] b index of branching in `m_pBr`;
+	 * \param[in] dir `0` for down branch, and `1` for up branch;
+	 * \param[in] objVal objective value of LP of the child node.
+	 */
+	void observeChild(int b, int dir, double objVal);
+
+	/**
+	 * The function solves both branch LPs for all candidates from `m_ipSbCand` which index is taken from `m_iNextCand`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void evalCands();
+
+	/**
+	 * The function computes the key of rows of node LP, and stores it in `m_ulRowKey`.
+	 */
+	void setRowKey();
+
+	/**
+	 * The function makes `m_ppLp[t]` a copy of node LP.
+	 * If the rows of `m_ppLp[t]` are those of node LP, only objective and bounds are updated;
+	 * otherwise, `m_ppLp[t]` is built again.
+	 * \param[in] t index of LP.
+	 * \return pointer to `m_ppLp[t]`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	CLP* loadNodeLp(int t);
+
+	/**
+	 * The function allocates memory for `lpNum` strong branching LPs; LPs already built are kept.
+	 * \param[in] lpNum number of LPs.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void allocMemForLps(int lpNum);
+
+	/**
+	 * The function distributes candidates from `m_ipSbCand` among `threadNum` threads and waits until all of them are evaluated.
+	 * \param[in] threadNum number of threads.
+	 */
+	void strongBranching(int threadNum);
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of threads created in `strongBranching()`.
+	 * \param[in] param pointer to `CRelBranching` object.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+
+	/**
+	 * The function selects a branching variable among the candidates stored in `m_ipCandCol`, `m_ipCandHd` and `m_dpCandX`.
+	 * \param[in] threadNum number of threads to be used for strong branching.
+	 * \return index of selected candidate, or `-1` if all candidates have been rejected.
+	 * \throws CMemoryException lack of memory.
+	 */
+	int select(int threadNum);
+};
+
+#endif // #ifndef __RELBRANCHING__H
@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Restart.h interface for `CRestart` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __RESTART__H
+#define __RESTART__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <iostream>
+#include <atomic>
+
+/**
+ * `CRestart` stores the data needed to restart the solution process after the root node has been processed.
+ *
+ * When the solver is about to branch at the root node, reduced cost fixing, probing, and cut generation
+ * may have fixed a large share of integer variables. As the solver keeps working with the matrix prepared
+ * before these fixings were done, `CProblem` stops the solver if the share of fixed variables is not less than `m_dMinFixRate`,
+ * and then it loads the problem again with the bounds of integer variables valid at the root node.
+ * The solver builds its matrix for the reduced problem from scratch; the record solution, pool cuts, and pseudocosts
+ * (all of which are indexed by handles) are kept; the record solution is passed to the solver when it first calls
+ * `CProblem::separate()` or `CProblem::startBranching()`, since the bounds fixed by reduced costs are valid only
+ * for solutions better than the record.
+ * The solver is not restarted if preprocessing is on, since bounds of preprocessed columns may be valid
+ * only for some optimal solutions (or for substituted variables), and the preprocessing stack of the first run
+ * is not rebuilt when the problem is loaded again; such skipped restarts are counted in `m_iSkipNum`.
+ */
+class MIPSHELL_API CRestart
+{
+	friend class CProblem;
+
+	double m_dMinFixRate; ///< restart is done if the share of integer variables fixed at the root node is not less than this value.
+	int m_iMaxRestartNum; ///< maximum number of restarts.
+
+	int m_iColNum; ///< number of columns in the original problem.
+	double *m_dpD; ///< `m_dpD[2*j]` and `m_dpD[2*j+1]` are bounds of integer variable with handle `j` valid at the root node.
+	char *m_cpBd; ///< `m_cpBd[j]=1` if bounds of variable with handle `j` are stored in `m_dpD`.
+
+	bool m_bChecked; ///< `true` if the root node of the current run has been checked.
+	std::atomic<bool> m_bRestart; ///< `true` if the solver has been stopped to be restarted; then all nodes are pruned in all threads.
+
+	bool m_bRec; ///< `true` if record solution is stored in `m_dpRecX` and `m_ipRecHd`.
+	double m_dRecObj; ///< objective value of record solution.
+	int m_iRecNum; ///< number of components in record solution.
+	double *m_dpRecX; ///< `m_dpRecX[i]` is value of variable with handle `m_ipRecHd[i]` in record solution.
+	int *m_ipRecHd; ///< handles of record solution components.
+
+// statistics
+	int m_iRestartNum; ///< number of restarts done.
+	int m_iSkipNum; ///< number of restarts skipped since preprocessing is on.
+	int m_iFixNum; ///< number of integer variables fixed at the root node before the last restart.
+	int m_iVarNum; ///< number of columns in the solver matrix before the last restart.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] minFixRate restart is done if the share of integer variables fixed at the root node is not less than `minFixRate`;
+	 * \param[in] maxRestartNum maximum number of restarts.
+	 */
+	CRestart(double minFixRate=0.3, int maxRestartNum=1);
+	virtual ~CRestart(); ///< The destructor.
+
+	/**
+	 * The function allocates memory.
+	 * \param[in] n number of columns in the original problem.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void init(int n);
+
+	/**
+	 * \return `true` if the root node of the current run can be checked.
+	 */
+	bool canRestart() const
+		{return (!m_bChecked && m_iRestartNum < m_iMaxRestartNum)? true: false;}
+
+	/**
+	 * The function stores bounds of an integer variable valid at the root node.
+	 * \param[in] hd handle of variable;
+	 * \param[in] lo,up bounds.
+	 */
+	void setBounds(int hd, double lo, double up)
+		{m_dpD[hd<<1]=lo; m_dpD[(hd<<1)+1]=up; m_cpBd[hd]=1;}
+
+	/**
+	 * The function prints the numbers of done and skipped restarts, and the numbers of fixed variables and columns before the last restart.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+};
+
+#endif // #ifndef __RESTART__H
@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file RootRace.h interface for `CRootRace` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __ROOTRACE__H
+#define __ROOTRACE__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <thread.h>
+#include "MatrixCopy.h"
+
+/**
+ * `CRootRace` implements _racing ramp-up_ at the root node.
+ *
+ * Before the branch-and-cut procedure starts, a number of _racers_ solve
+ * the root node of the same problem, each with its own settings
+ * (cut patterns, probing depth, and LP separation rule).
+ * Every racer is an independent `CMIP` object built from a copy of the original problem,
+ * and the racers are run in parallel.
+ *
+ * When all the racers have processed their root nodes,
+ *   - the racer with the least upper bound (for maximization) on the optimal objective value wins,
+ *     and its settings are used to solve the problem;
+ *   - global cuts generated by all racers are collected (in variable handles) to be added to the pool;
+ *   - the best solution found by any racer becomes the initial record solution.
+ */
+class MIPSHELL_API CRootRace
+{
+	friend class CProblem;
+	friend class CRootRacer;
+
+	int m_iRacerNum; ///< number of racers.
+	int m_iNextRacer; ///< next racer to be started.
+	int m_iWinner; ///< index of winning racer, or `-1` if no racer has processed its root node.
+	double *m_dpRootBound; ///< `m_dpRootBound[k]` is upper bound computed by racer `k` at its root node.
+
+	CMatrixCopy m_copy; ///< copy of the original problem.
+
+// record
+	bool m_bRec; ///< `true` if one of the racers has found a solution.
+	double m_dRecObj; ///< objective value of best solution found by racers.
+	int m_iRecNum; ///< number of components in `m_dpRecX` and `m_ipRecHd`.
+	double *m_dpRecX; ///< `m_dpRecX[i]` is value of variable with handle `m_ipRecHd[i]` in best solution found.
+	int *m_ipRecHd; ///< handles of solution components.
+
+// cuts
+	int m_iCutNum; ///< number of collected cuts.
+	int m_iMaxCutNum; ///< size of memory allocated for cuts.
+	int m_iMaxCutNz; ///< size of memory allocated for cut coefficients.
+	double *m_dpCutB; ///< `m_dpCutB[2*i]` and `m_dpCutB[2*i+1]` are left and right hand sides of cut `i`.
+	int *m_ipCutBeg; ///< cut `i` is stored in positions `m_ipCutBeg[i],...,m_ipCutBeg[i+1]-1` of `m_dpCutVal` and `m_ipCutHd`.
+	double *m_dpCutVal; ///< cut coefficients.
+	int *m_ipCutHd; ///< variable handles of cut coefficients.
+
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< Locks `m_iNextRacer`, record, and cuts.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] racerNum number of racers.
+	 * \throws CMemoryException lack of memory.
+	 */
+	CRootRace(int racerNum);
+	virtual ~CRootRace(); ///< The destructor.
+
+	/**
+	 * The function changes settings of a given solver as racer `k` does.
+	 * \param[in,out] mip solver;
+	 * \param[in] k racer index.
+	 */
+	static void applySettings(CMIP& mip, int k);
+
+	/**
+	 * The function runs all racers and waits until all of them have processed their root nodes.
+	 * \param[in] threadNum number of threads.
+	 * \return index of winning racer, or `-1` if no racer has processed its root node.
+	 */
+	int race(int threadNum);
+
+	/**
+	 * \return number of collected cuts.
+	 */
+	int getCutNum() const
+		{return m_iCutNum;}
+
+private:
+	void allocMemForCuts(int cutNum, int nz); ///< \throws CMemoryException lack of memory.
+
+	/**
+	 * The function is called by racers to store a new solution if it is better than `m_dRecObj`.
+	 * \param[in]  objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`.
+	 */
+	void setRecord(double objVal, int n, const double* dpX, const int* ipHd);
+
+	/**
+	 * The function is called by racers to store a global cut
+	 * \f$b_1 \le \sum_{i=0}^{sz-1} dpVal[i] x_{ipHd[i]} \le b_2\f$.
+	 * \param[in] b1,b2 left and right hand sides;
+	 * \param[in] sz,dpVal,ipHd cut coefficients.
+	 */
+	void addCut(double b1, double b2, int sz, const double* dpVal, const int* ipHd);
+
+	void runRacers(); ///< runs racers which indices are taken from `m_iNextRacer`.
+
+#ifndef __ONE_THREAD_
+	/**
+	 * The start function of threads created in `race()`.
+	 * \param[in] param pointer to `CRootRace` object.
+	 * \return always `0`.
+	 */
+#ifdef _WIN32
+	static unsigned int __stdcall startThread(void* param);
+#else
+	static void* startThread(void* param);
+#endif
+#endif
+};
+
+#endif // #ifndef __ROOTRACE__H
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Separator.h interface for `CSeparator` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SEPARATOR__H
+#define __SEPARATOR__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <atomic>
+
+class CCutSelector;
+
+/**
+ * `CSeparator` is the base class for separators that are run concurrently (see `CProblem::addSeparator()`).
+ *
+ * Unlike `CProblem::separate()`, which is written in terms of the modeling objects,
+ * a separator works with variable handles only: it receives the solution to be separated
+ * and writes the cuts it has found into a cut buffer.
+ * Different separators are run simultaneously on the same solution, and each solver thread
+ * may call the same separator, therefore `separate()` must not change data shared with other calls.
+ */
+class MIPSHELL_API CSeparator
+{
+	friend class CConcurrentSep;
+
+	std::atomic<long long> m_lTime; ///< total running time (in microseconds) of `separate()`.
+	std::atomic<int> m_iCallNum; ///< number of calls to `separate()`.
+	std::atomic<int> m_iCutNum; ///< number of cuts generated by `separate()`.
+
+public:
+	CSeparator(): m_lTime(0), m_iCallNum(0), m_iCutNum(0) {} ///< The constructor.
+	virtual ~CSeparator() {} ///< The destructor.
+
+	/**
+	 * \return name of separator.
+	 */
+	virtual const char* getName() const
+		{return "separator";}
+
+	/**
+	 * The function separates a given solution.
+	 * Each cut \f$b_1 \le \sum_{i=0}^{sz-1} dpVal[i] x_{ipHd[i]} \le b_2\f$ is written by calling
+	 * `cuts.addCand(CUT_SEPARATOR,type,b1,b2,sz,dpVal,ipHd)`, where `type` is `0` for global cuts,
+	 * and `CTR_LOCAL` for local ones.
+	 * \param[in] hdNum number of variables;
+	 * \param[in] dpX solution, `dpX[j]` is value of variable with handle `j`, `j=0,...,hdNum-1`;
+	 * \param[in] ipHdToCol `ipHdToCol[j]` is column of variable with handle `j`, or `-1` if the variable
+	 *  has been removed from the LP by preprocessing; values `dpX[j]` of removed variables are not valid,
+	 *  and cuts must not include removed variables;
+	 * \param[in,out] cuts cut buffer owned by the calling thread.
+	 * \return number of cuts written.
+	 */
+	virtual int separate(int hdNum, const double* dpX, const int* ipHdToCol, CCutSelector& cuts) = 0;
+};
+
+#endif // #ifndef __SEPARATOR__H
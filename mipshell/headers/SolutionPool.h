@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file SolutionPool.h interface for `CSolutionPool` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SOLUTIONPOOL__H
+#define __SOLUTIONPOOL__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <iostream>
+#include <thread.h>
+#include "MatrixCopy.h"
+
+#define SOL_POOL_TOL 1.0e-6 ///< feasibility and integrality tolerance, also used for comparing solution components and objective values.
+
+/**
+ * `CSolutionPool` keeps up to `m_iMaxSolNum` best distinct feasible solutions.
+ *
+ * Solutions are stored as dense vectors indexed by variable handles, and they are organized as a heap,
+ * on the top of which is the worst solution of the pool; so, a new solution is rejected
+ * after one comparison if the pool is full and the solution is not better than the worst one,
+ * and otherwise it replaces the worst one. Two solutions are distinct if the values
+ * of at least one variable differ by more than `SOL_POOL_TOL`;
+ * solutions with different objective values are distinct without comparing their components.
+ * Every solution is checked against a copy of the original problem before it is inserted,
+ * and solutions violating bounds, integrality, or constraints are rejected.
+ * Solutions which objective values are worse than the best objective value by more than the gap are removed from the pool.
+ * If all variables with nonzero objective coefficients are integer, and these coefficients are integral,
+ * objective values are multiples of their greatest common divisor `m_dObjStep`, and so,
+ * when the pool is full, a new solution must be better than the worst one by at least `m_dObjStep`.
+ *
+ * Objective values are stored as for maximization; `getObjVal()` returns them in the original sense.
+ * The pool is shared by all threads, and its functions are serialized by a mutex.
+ */
+class MIPSHELL_API CSolutionPool
+{
+	friend class CProblem;
+
+	int m_iMaxSolNum; ///< maximum number of solutions in the pool.
+	double m_dGap; ///< solution is kept only if its objective value differs from the best one by at most `m_dGap*max(1,|best|)`.
+	bool m_bAlternative; ///< if `true`, solutions are not passed to the solver, which keeps searching for alternative solutions.
+
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	bool m_bSense; ///< `true` for maximization, and `false` for minimization.
+	int m_iColNum; ///< number of variables (size of solutions).
+	double *m_dpC; ///< objective coefficients (as for maximization).
+	double m_dObjStep; ///< if positive, objective values of all feasible solutions are multiples of `m_dObjStep`.
+
+	int m_iSolNum; ///< number of solutions in the pool.
+	double m_dBestObj; ///< best objective value (as for maximization) of solutions offered to the pool.
+	double *m_dpObj; ///< `m_dpObj[s]` is objective value (as for maximization) of solution stored in slot `s`.
+	double *m_dpX; ///< solution stored in slot `s` occupies positions `s*m_iColNum,...,(s+1)*m_iColNum-1`.
+	int *m_ipHeap; ///< `m_ipHeap[0],...,m_ipHeap[m_iSolNum-1]` are slots organized as a heap, `m_ipHeap[0]` is the worst solution.
+	int *m_ipRank; ///< `m_ipRank[k]` is slot of `k`-th best solution; it is computed by `sort()`.
+	double *m_dpTmp; ///< buffer for the solution being added.
+
+// statistics
+	int m_iOfferNum; ///< number of solutions offered to the pool.
+	int m_iDupNum; ///< number of duplicates rejected.
+	int m_iInfeasNum; ///< number of infeasible solutions rejected.
+	int m_iInsertNum; ///< number of solutions inserted into the pool.
+
+#ifndef __ONE_THREAD_
+	_MUTEX m_mutex; ///< serializes access to the pool.
+#endif
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxSolNum maximum number of solutions in the pool;
+	 * \param[in] gap relative gap, solution is kept only if its objective value differs from the best one by at most `gap*max(1,|best|)`;
+	 * \param[in] alternative if `true`, solutions are not passed to the solver, and the solver keeps searching for alternative solutions.
+	 */
+	CSolutionPool(int maxSolNum=10, double gap=1.0e20, bool alternative=false);
+	virtual ~CSolutionPool(); ///< The destructor.
+
+	/**
+	 * The function empties the pool, and allocates memory for solutions of the problem stored in `m_copy`.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void init();
+
+	/**
+	 * The function offers a solution to the pool.
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`;
+	 *  if `ipHd=0`, `dpX[j]` is value of variable with handle `j`.
+	 * \return `true` if the solution has been inserted into the pool.
+	 */
+	bool add(int n, const double* dpX, const int* ipHd);
+
+	/**
+	 * \return objective value (as for maximization) below which solutions are not kept by the pool;
+	 *  `-CLP::INF` if any solution would be kept; if the pool is full, the cutoff exceeds the objective value
+	 *  of the worst solution (by `m_dObjStep` if the objective is integral).
+	 */
+	double getCutoff();
+
+	/**
+	 * The function orders solutions by their objective values; it must be called before `getObjVal()` and `getSolution()`.
+	 */
+	void sort();
+
+	/**
+	 * \return number of solutions in the pool.
+	 */
+	int getSolNum() const
+		{return m_iSolNum;}
+
+	/**
+	 * \param[in] k solution rank (`0` is the best solution).
+	 * \return objective value of `k`-th best solution.
+	 */
+	double getObjVal(int k) const
+		{return (m_bSense)? m_dpObj[m_ipRank[k]]: -m_dpObj[m_ipRank[k]];}
+
+	/**
+	 * \param[in] k solution rank (`0` is the best solution).
+	 * \return `k`-th best solution, its component `j` is value of variable with handle `j`.
+	 */
+	const double* getSolution(int k) const
+		{return m_dpX+m_ipRank[k]*m_iColNum;}
+
+	/**
+	 * The function prints the numbers of offered, duplicate, infeasible, inserted, and kept solutions, and the range of objective values.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out);
+
+private:
+	/**
+	 * \return `true` if `m_dpTmp` satisfies all bounds, integrality conditions, and constraints of `m_copy`.
+	 */
+	bool isFeasible() const;
+
+	/**
+	 * \param[in] obj objective value (as for maximization).
+	 * \return `true` if the pool already has a solution with objective value `obj` equal to `m_dpTmp`.
+	 */
+	bool isDuplicate(double obj) const;
+
+	/**
+	 * The function is called by `add()` and `getCutoff()` when the mutex is locked.
+	 * \return cutoff of the pool (see `getCutoff()`).
+	 */
+	double computeCutoff() const;
+
+	/**
+	 * The function removes the worst solution from the heap.
+	 * \return slot of the removed solution.
+	 */
+	int pop();
+
+	/**
+	 * The function restores the heap after `m_ipHeap[k]` has been set.
+	 * \param[in] k position in the heap.
+	 */
+	void siftDown(int k);
+
+	/**
+	 * The function restores the heap after `m_ipHeap[k]` has been set.
+	 * \param[in] k position in the heap.
+	 */
+	void siftUp(int k);
+};
+
+#endif // #ifndef __SOLUTIONPOOL__H
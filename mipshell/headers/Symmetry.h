@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file Symmetry.h interface for `CSymmetry` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SYMMETRY__H
+#define __SYMMETRY__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include <chrono>
+#include <iostream>
+#include "MatrixCopy.h"
+
+/**
+ * `CSymmetry` detects symmetries of a copy of the original problem, and breaks them by adding _Schreier-Sims cuts_.
+ *
+ * The problem is represented by a colored graph: there is a vertex for every column and every row,
+ * and an edge for every nonzero entry of the matrix. Column vertices are initially colored by types,
+ * objective coefficients and bounds, row vertices by types and sides, and edges by coefficients.
+ * Every automorphism of this graph that maps columns to columns is a symmetry of the problem.
+ *
+ * Automorphisms are searched by _partition refinement_: the coloring is refined until every two vertices of the same color
+ * have the same numbers of neighbours of each color joined by edges of each color (the partition becomes _equitable_).
+ * Along a _stabilizer chain_, columns \f$b_1,b_2,\dots\f$ (the _base_) are individualized one by one; at level \f$k\f$,
+ * for every column \f$w\f$ from the cell of \f$b_k\f$, two copies of the partition are refined, one after individualizing \f$b_k\f$,
+ * and the other after individualizing \f$w\f$, and then the vertices with equal numbers in the same cells are individualized
+ * in both copies until the partitions become discrete. The bijection between the two discrete partitions is checked to be
+ * an automorphism and, if it is, it is a generator that maps \f$b_k\f$ to \f$w\f$ and fixes \f$b_1,\dots,b_{k-1}\f$.
+ * There is no backtracking, so the generators found may generate only a subgroup of the symmetry group.
+ *
+ * Let \f$O_k\f$ be the orbit of \f$b_k\f$ under the group generated by the generators found at levels \f$k,k+1,\dots\f$.
+ * For every binary column \f$b_k\f$, the inequalities \f$x_{b_k} \ge x_j\f$, \f$j \in O_k\setminus\{b_k\}\f$, are valid
+ * for at least one optimal solution of every symmetric class, and all these inequalities can be added together.
+ * `CProblem` adds them to the problem before the solver preprocesses it.
+ */
+class MIPSHELL_API CSymmetry
+{
+	friend class CProblem;
+
+	CMatrixCopy m_copy; ///< copy of the original problem.
+	int m_iMaxGenNum; ///< maximum number of generators.
+	int m_iTimeLimit; ///< time limit (in seconds).
+	int m_iMaxCutNum; ///< maximum number of cuts, `CProblem` sets it to the number of rows reserved for cuts.
+
+// graph
+	int m_iColNum; ///< number of columns.
+	int m_iVertNum; ///< number of vertices, vertex `j < m_iColNum` is column `j`, and vertex `m_iColNum+i` is row `i`.
+	int *m_ipAdjBeg; ///< neighbours of vertex `v` are `m_ipAdj[m_ipAdjBeg[v]],...,m_ipAdj[m_ipAdjBeg[v+1]-1]`.
+	int *m_ipAdj; ///< adjacency lists.
+	unsigned long long *m_lpEdgeColor; ///< `m_lpEdgeColor[e]` is color (hashed coefficient) of edge `m_ipAdj[e]`.
+
+// working arrays
+	int *m_ipColor; ///< coloring refined along the stabilizer chain.
+	int *m_ipColor1; ///< first copy of coloring.
+	int *m_ipColor2; ///< second copy of coloring.
+	int *m_ipOrder; ///< vertices sorted by colors.
+	int *m_ipCount; ///< cell sizes.
+	int *m_ipPerm; ///< permutation of vertices being built.
+	int *m_ipParent; ///< union-find forest of orbits.
+	unsigned long long *m_lpHash; ///< hashes of neighbourhoods.
+	double *m_dpW; ///< working array of size `m_iColNum` filled with zeroes.
+
+// results
+	int m_iGenNum; ///< number of generators found.
+	int *m_ipGen; ///< generator `k` maps column `j` to column `m_ipGen[k*m_iColNum+j]`.
+	int *m_ipGenLevel; ///< generator `k` has been found at level `m_ipGenLevel[k]` of the stabilizer chain.
+	int m_iBaseNum; ///< number of base columns.
+	int *m_ipBase; ///< base columns.
+	int m_iCutNum; ///< number of cuts.
+	int *m_ipCut; ///< cut `k` is \f$x_{m\_ipCut[2k]} \ge x_{m\_ipCut[2k+1]}\f$.
+
+// statistics
+	int m_iOrbitNum; ///< number of nontrivial orbits of columns.
+	int m_iOrbitColNum; ///< number of columns in nontrivial orbits.
+	std::chrono::steady_clock::time_point m_start; ///< start time of detection.
+	bool m_bTimeOut; ///< `true` if search has been stopped by the time limit.
+	double m_dTime; ///< detection time (in seconds).
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxGenNum maximum number of generators;
+	 * \param[in] timeLimit time limit (in seconds).
+	 */
+	CSymmetry(int maxGenNum=100, int timeLimit=10);
+	virtual ~CSymmetry(); ///< The destructor.
+
+	/**
+	 * The function searches for generators of the symmetry group of `m_copy`, and computes Schreier-Sims cuts.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void detect();
+
+	/**
+	 * \return number of cuts computed by `detect()`.
+	 */
+	int getCutNum() const
+		{return m_iCutNum;}
+
+	/**
+	 * \param[in] k cut index.
+	 * \param[out] b,j cut `k` is \f$x_b \ge x_j\f$.
+	 */
+	void getCut(int k, int &b, int &j) const
+		{b=m_ipCut[k<<1]; j=m_ipCut[(k<<1)+1];}
+
+	/**
+	 * The function prints the numbers of generators, base columns, orbits, columns in orbits, and cuts, and detection time.
+	 * \param[in] out output stream.
+	 */
+	void printStatistics(std::ostream &out) const;
+
+private:
+	/**
+	 * The function builds the colored graph of `m_copy`, and allocates working memory.
+	 * \throws CMemoryException lack of memory.
+	 */
+	void initGraph();
+
+	/**
+	 * The function colors vertices by types, objective coefficients, bounds, and sides.
+	 * \param[out] ipColor colors.
+	 * \return number of colors.
+	 */
+	int initColors(int* ipColor);
+
+	/**
+	 * The function refines a coloring until it becomes equitable.
+	 * New colors depend only on old colors and the graph, and not on vertex numbers.
+	 * \param[in,out] ipColor colors;
+	 * \param[in] colorNum number of colors.
+	 * \return number of colors in the refined coloring.
+	 */
+	int refine(int* ipColor, int colorNum);
+
+	/**
+	 * The function gives vertex `v` a color of its own; `v` gets color of its cell,
+	 * and all other vertices of this cell get the next color.
+	 * \param[in,out] ipColor colors;
+	 * \param[in] colorNum number of colors;
+	 * \param[in] v vertex.
+	 * \return number of colors.
+	 */
+	int individualize(int* ipColor, int colorNum, int v);
+
+	/**
+	 * \param[in] ipColor colors;
+	 * \param[in] colorNum number of colors;
+	 * \param[out] ipCount `ipCount[c]` is number of vertices of color `c`.
+	 * \return first color of a cell of columns with more than one column, or `-1` if all columns have different colors.
+	 */
+	int countCells(const int* ipColor, int colorNum, int* ipCount) const;
+
+	/**
+	 * The function searches for an automorphism mapping column `v` to column `w`.
+	 * \param[in] ipColor equitable coloring;
+	 * \param[in] colorNum number of colors;
+	 * \param[in] v,w columns of the same color.
+	 * \return `true` if an automorphism has been found; then it is stored in `m_ipPerm`.
+	 */
+	bool findAutomorphism(const int* ipColor, int colorNum, int v, int w);
+
+	/**
+	 * \return `true` if `m_ipPerm` is an automorphism of `m_copy`.
+	 */
+	bool isAutomorphism();
+
+	/**
+	 * \param[in] j column.
+	 * \return root of the tree of `m_ipParent` containing `j`.
+	 */
+	int findRoot(int j);
+
+	/**
+	 * The function computes orbits along the stabilizer chain, and Schreier-Sims cuts.
+	 */
+	void computeCuts();
+
+	/**
+	 * \return `true` if the time limit has been exceeded.
+	 */
+	bool timeOut();
+};
+
+#endif // #ifndef __SYMMETRY__H
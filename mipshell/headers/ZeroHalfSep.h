@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////
+/**
+ * \file ZeroHalfSep.h interface for `CZeroHalfSep` class
+ * |  __Author__  | N.N. Pisaruk                              |
+ * |-------------:|:------------------------------------------|
+ * |  __e-mail__  | nicolaipisaruk@gmail.com                  |
+ * | __home page__| http://pisaruk.narod.ru                   |
+ *
+ *   \copyright __2015 Nicolai N. Pisaruk__
+ */
+
+/*
+ *  This file is part of the mixed integer class library (MIPCL).
+ *
+ *  MIPCL is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 3 of the License, or (at your option) any later version.
+ *
+ *  MIPCL is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with MIPCL; if not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __ZEROHALFSEP__H
+#define __ZEROHALFSEP__H
+
+#ifdef _WINDOWS
+#ifndef MIPSHELL_API
+#ifdef MIPSHELL_EXPORTS
+#define MIPSHELL_API __declspec(dllexport)
+#else
+#define MIPSHELL_API __declspec(dllimport)
+#endif
+#endif
+#else
+#ifndef MIPSHELL_API
+#define MIPSHELL_API
+#endif
+#endif
+
+#include "Mod2Sep.h"
+
+/**
+ * `CZeroHalfSep` separates zero-half (mod-2) cuts by searching for shortest odd cycles in the _mod-2 graph_,
+ * and it does no Gaussian elimination.
+ *
+ * The candidate rows are those of `CMod2Sep`. Given a solution \f$x^*\f$,
+ * variables at their bounds are dropped (their parities are moved to the right hand sides),
+ * and every other integer variable is a node of the graph. Each row of slack less than one becomes an edge
+ * which ends are the two variables with odd coefficients that are farthest from their bounds;
+ * all other variables with odd coefficients are made even by adding their bound constraints,
+ * and their distances to the bounds are added to the edge weight.
+ * A row with only one such variable is an edge connecting it to a special node,
+ * and a row with no such variables is a loop at the special node.
+ * The edge parity is the parity of the right hand side.
+ * A cycle of odd parity and weight \f$w<1\f$ gives a mod-2 cut which violation is at least \f$(1-w)/2\f$.
+ * Shortest odd cycles are found by Dijkstra's algorithm in the doubled graph, which node \f$(v,p)\f$
+ * represents reaching node \f$v\f$ by a path of parity \f$p\f$.
+ *
+ * On very sparse problems, the graph is much smaller than the GF(2) matrix of `CMod2Sep`,
+ * and the cuts, which are sums of few rows, are much sparser.
+ */
+class MIPSHELL_API CZeroHalfSep: public CMod2Sep
+{
+	friend class CProblem;
+
+	long long m_lMaxWork; ///< maximum number of arcs scanned in one call to `separate()`.
+
+public:
+	/**
+	 * The constructor.
+	 * \param[in] maxCutNum maximum number of cuts generated in one call.
+	 */
+	CZeroHalfSep(int maxCutNum=64);
+	virtual ~CZeroHalfSep(); ///< The destructor.
+
+	/**
+	 * \return name of separator.
+	 */
+	virtual const char* getName() const
+		{return "zero-half";}
+
+	/**
+	 * The function separates a given solution by zero-half cuts.
+	 * \param[in] hdNum number of variables;
+	 * \param[in] dpSol solution, `dpSol[j]` is value of variable with handle `j`;
+	 * \param[in] ipHdToCol `ipHdToCol[j]` is column of variable with handle `j`, or `-1` if the variable has been removed by preprocessing;
+	 * \param[in,out] cuts cut buffer.
+	 * \return number of cuts written.
+	 * \throws CMemoryException lack of memory.
+	 */
+	virtual int separate(int hdNum, const double* dpSol, const int* ipHdToCol, CCutSelector& cuts);
+};
+
+#endif // #ifndef __ZEROHALFSEP__H
@@ -40,6 +40,10 @@
 #include "VarArray.h"
 #include "Array.h"
 #include "Set.h"
+#include "Separator.h"
+#include "CutSelector.h"
+#include "CutStat.h"
+#include "LiftProject.h"
 
 ///////////////////////////////////
 
@@ -0,0 +1,416 @@
+// Checkpoint.cpp: implementation of the CCheckpoint class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <except.h>
+#include <lp.h>
+#include "Checkpoint.h"
+
+#define CKP_VERSION 2 ///< version of checkpoint file format.
+#define CKP_TOL 1.0e-6 ///< feasibility and integrality tolerance used to check record solutions read from files.
+static const char CKP_MAGIC[8]={'M','I','P','C','L','C','K','P'}; ///< first 8 bytes of any checkpoint file.
+
+/**
+ * The function appends a block of memory to a memory image.
+ * \param[in,out] cp current position in image; on return, `cp` points to the first byte after appended block;
+ * \param[in] pMem,size memory block of `size` bytes.
+ */
+static inline void appendBlock(char* &cp, const void* pMem, int size)
+{
+	memcpy(cp,pMem,size);
+	cp+=size;
+}
+
+/**
+ * The function adds a block of memory to a hash value (FNV-1a).
+ * \param[in,out] h hash value;
+ * \param[in] pMem,size memory block of `size` bytes.
+ */
+static void hashBlock(unsigned long long &h, const void* pMem, int size)
+{
+	const unsigned char* cp=static_cast<const unsigned char*>(pMem);
+	for (int i=0; i < size; ++i) {
+		h^=cp[i];
+		h*=1099511628211ull;
+	}
+} // end of hashBlock()
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CCheckpoint::CCheckpoint(const char* fileName, int interval)
+{
+	if (!(m_strFileName = new char[strlen(fileName)+1])) {
+		throw new CMemoryException("CCheckpoint::CCheckpoint");
+	}
+	strcpy(m_strFileName,fileName);
+	m_iInterval=interval;
+	m_tLast=time(0);
+	m_uHash=0;
+	m_bRec=false;
+	m_dRecObj=0.0;
+	m_iRecNum=0;
+	m_dpRecX=0;
+	m_ipRecHd=0;
+	m_iPcSize=0;
+	m_dpPc=0;
+	m_dObjBound=0.0;
+	m_bResume=false;
+	m_cpImage=0;
+	m_iImageSize=0;
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+	m_bRunning=false;
+	m_bStop=false;
+#endif
+} // end of CCheckpoint::CCheckpoint()
+
+CCheckpoint::~CCheckpoint()
+{
+	stop();
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	if (m_dpRecX) {
+		delete[] m_dpRecX;
+		delete[] m_ipRecHd;
+	}
+	if (m_dpPc)
+		delete[] m_dpPc;
+	if (m_cpImage)
+		delete[] m_cpImage;
+	delete[] m_strFileName;
+} // end of CCheckpoint::~CCheckpoint()
+
+void CCheckpoint::init()
+{
+	const double* dpVal;
+	const int* ipCol;
+	double d[3];
+	unsigned type;
+	int sz;
+	bool bSense=m_copy.getSense();
+	unsigned long long h=14695981039346656037ull;
+	hashBlock(h,&bSense,sizeof(bool));
+	for (int j=0; j < m_copy.getColNum(); ++j) {
+		d[0]=m_copy.getObjCoeff(j);
+		d[1]=m_copy.getLoBound(j);
+		d[2]=m_copy.getUpBound(j);
+		type=m_copy.getVarType(j);
+		hashBlock(h,d,3*sizeof(double));
+		hashBlock(h,&type,sizeof(unsigned));
+	}
+	for (int i=0; i < m_copy.getRowNum(); ++i) {
+		d[0]=m_copy.getRowLoBound(i);
+		d[1]=m_copy.getRowUpBound(i);
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		hashBlock(h,d,2*sizeof(double));
+		hashBlock(h,&sz,sizeof(int));
+		hashBlock(h,dpVal,sz*sizeof(double));
+		hashBlock(h,ipCol,sz*sizeof(int));
+	}
+	m_uHash=h;
+} // end of CCheckpoint::init()
+
+//////////////////////////////////////////////////////////////////////
+// Taking snapshots
+//////////////////////////////////////////////////////////////////////
+void CCheckpoint::setRecord(double objVal, int n, const double* dpX, const int* ipHd)
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if (n > m_iRecNum || !m_dpRecX) {
+		if (m_dpRecX) {
+			delete[] m_dpRecX;
+			delete[] m_ipRecHd;
+		}
+		if (!(m_dpRecX = new double[n]) || !(m_ipRecHd = new int[n])) {
+#ifndef __ONE_THREAD_
+			_MUTEX_UNLOCK(&m_mutex)
+#endif
+			throw new CMemoryException("CCheckpoint::setRecord");
+		}
+	}
+	m_dRecObj=objVal;
+	m_iRecNum=n;
+	if (dpX != m_dpRecX) { // not called from `CProblem::resumeRecord()`
+		memcpy(m_dpRecX,dpX,n*sizeof(double));
+		memcpy(m_ipRecHd,ipHd,n*sizeof(int));
+	}
+	m_bRec=true;
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+} // end of CCheckpoint::setRecord()
+
+void CCheckpoint::takeSnapshot(double objBound, int pcSize, const double* dpPc)
+{
+	char *cpImage, *cp;
+	int size, version=CKP_VERSION, bRec, m=m_copy.getRowNum(), n=m_copy.getColNum();
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	m_tLast=time(0);
+	size=sizeof(CKP_MAGIC)+5*sizeof(int)+sizeof(m_uHash)+2*sizeof(double)+
+		m_iRecNum*(sizeof(double)+sizeof(int))+sizeof(int)+pcSize*sizeof(double);
+	if (!(cpImage = new char[size])) {
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+		throw new CMemoryException("CCheckpoint::takeSnapshot");
+	}
+	bRec=(m_bRec)? 1: 0;
+	cp=cpImage;
+	appendBlock(cp,CKP_MAGIC,sizeof(CKP_MAGIC));
+	appendBlock(cp,&version,sizeof(int));
+	appendBlock(cp,&m,sizeof(int));
+	appendBlock(cp,&n,sizeof(int));
+	appendBlock(cp,&m_uHash,sizeof(m_uHash));
+	appendBlock(cp,&objBound,sizeof(double));
+	appendBlock(cp,&bRec,sizeof(int));
+	appendBlock(cp,&m_dRecObj,sizeof(double));
+	appendBlock(cp,&m_iRecNum,sizeof(int));
+	if (m_iRecNum) {
+		appendBlock(cp,m_dpRecX,m_iRecNum*sizeof(double));
+		appendBlock(cp,m_ipRecHd,m_iRecNum*sizeof(int));
+	}
+	appendBlock(cp,&pcSize,sizeof(int));
+	if (pcSize)
+		appendBlock(cp,dpPc,pcSize*sizeof(double));
+	if (m_cpImage)
+		delete[] m_cpImage; // writer has not got previous image yet
+	m_cpImage=cpImage;
+	m_iImageSize=size;
+#ifndef __ONE_THREAD_
+	bool bRunning=m_bRunning;
+	_MUTEX_UNLOCK(&m_mutex)
+	if (bRunning)
+		return;
+#endif
+	write(m_cpImage,m_iImageSize);
+	delete[] m_cpImage;
+	m_cpImage=0;
+} // end of CCheckpoint::takeSnapshot()
+
+bool CCheckpoint::write(const char* cpImage, int size)
+{
+	bool flag=false;
+	char* tmpName;
+	if (!(tmpName = new char[strlen(m_strFileName)+5]))
+		return false;
+	strcpy(tmpName,m_strFileName);
+	strcat(tmpName,".tmp");
+	std::ofstream fout(tmpName,std::ios::binary|std::ios::trunc);
+	if (!fout.fail()) {
+		fout.write(cpImage,size);
+		fout.close();
+		if (!fout.fail()) {
+#ifdef _WIN32
+			std::remove(m_strFileName); // `rename()` does not replace existing files
+#endif
+			flag=(std::rename(tmpName,m_strFileName))? false: true;
+		}
+	}
+	delete[] tmpName;
+	return flag;
+} // end of CCheckpoint::write()
+
+//////////////////////////////////////////////////////////////////////
+// Writer thread
+//////////////////////////////////////////////////////////////////////
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CCheckpoint::startThread(void* param)
+#else
+void* CCheckpoint::startThread(void* param)
+#endif
+{
+	static_cast<CCheckpoint*>(param)->writer();
+	return 0;
+} // end of CCheckpoint::startThread()
+#endif
+
+void CCheckpoint::writer()
+{
+#ifndef __ONE_THREAD_
+	char* cpImage;
+	int size;
+	for (bool bStop=false; !bStop;) {
+		bStop=m_bStop;
+		_MUTEX_LOCK(&m_mutex)
+		cpImage=m_cpImage;
+		size=m_iImageSize;
+		m_cpImage=0;
+		_MUTEX_UNLOCK(&m_mutex)
+		if (cpImage) {
+			write(cpImage,size);
+			delete[] cpImage;
+		}
+		else if (!bStop)
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+#endif
+} // end of CCheckpoint::writer()
+
+void CCheckpoint::start()
+{
+	m_tLast=time(0);
+#ifndef __ONE_THREAD_
+	if (!m_bRunning) {
+		m_bStop=false;
+		m_bRunning=true;
+		_THREAD_CREATE(m_thread,startThread,this)
+	}
+#endif
+} // end of CCheckpoint::start()
+
+void CCheckpoint::stop()
+{
+#ifndef __ONE_THREAD_
+	if (m_bRunning) {
+		m_bStop=true;
+		_THREAD_JOIN(m_thread)
+		_THREAD_CLOSE(m_thread)
+		m_bRunning=false;
+	}
+#endif
+} // end of CCheckpoint::stop()
+
+void CCheckpoint::remove()
+{
+	char* tmpName;
+	std::remove(m_strFileName);
+	if ((tmpName = new char[strlen(m_strFileName)+5])) {
+		strcpy(tmpName,m_strFileName);
+		strcat(tmpName,".tmp");
+		std::remove(tmpName);
+		delete[] tmpName;
+	}
+	if (m_cpImage) {
+		delete[] m_cpImage;
+		m_cpImage=0;
+	}
+} // end of CCheckpoint::remove()
+
+//////////////////////////////////////////////////////////////////////
+// Resuming
+//////////////////////////////////////////////////////////////////////
+bool CCheckpoint::read()
+{
+	char magic[sizeof(CKP_MAGIC)];
+	int version, m, n, bRec, hdNum=m_copy.getColNum();
+	unsigned long long hash;
+	std::ifstream fin(m_strFileName,std::ios::binary);
+	if (fin.fail())
+		return false;
+	fin.read(magic,sizeof(CKP_MAGIC));
+	fin.read(reinterpret_cast<char*>(&version),sizeof(int));
+	fin.read(reinterpret_cast<char*>(&m),sizeof(int));
+	fin.read(reinterpret_cast<char*>(&n),sizeof(int));
+	fin.read(reinterpret_cast<char*>(&hash),sizeof(hash));
+	if (fin.fail() || memcmp(magic,CKP_MAGIC,sizeof(CKP_MAGIC)) || version != CKP_VERSION ||
+			m != m_copy.getRowNum() || n != hdNum || hash != m_uHash)
+		return false; // the file has been written for another problem
+	fin.read(reinterpret_cast<char*>(&m_dObjBound),sizeof(double));
+	fin.read(reinterpret_cast<char*>(&bRec),sizeof(int));
+	fin.read(reinterpret_cast<char*>(&m_dRecObj),sizeof(double));
+	fin.read(reinterpret_cast<char*>(&n),sizeof(int));
+	if (fin.fail() || n < 0)
+		return false;
+	if (n) {
+		int size=(n > hdNum)? n: hdNum; // `checkRecord()` writes a dense vector of size `hdNum`
+		if (m_dpRecX) {
+			delete[] m_dpRecX;
+			delete[] m_ipRecHd;
+			m_ipRecHd=0;
+		}
+		if (!(m_dpRecX = new double[size]) || !(m_ipRecHd = new int[size])) {
+			if (m_dpRecX) {
+				delete[] m_dpRecX;
+				m_dpRecX=0;
+			}
+			throw new CMemoryException("CCheckpoint::read");
+		}
+		fin.read(reinterpret_cast<char*>(m_dpRecX),n*sizeof(double));
+		fin.read(reinterpret_cast<char*>(m_ipRecHd),n*sizeof(int));
+	}
+	m_iRecNum=n;
+	fin.read(reinterpret_cast<char*>(&n),sizeof(int));
+	if (fin.fail() || n < 0) {
+		m_iRecNum=0;
+		return false;
+	}
+	if ((m_iPcSize=n)) {
+		if (m_dpPc)
+			delete[] m_dpPc;
+		if (!(m_dpPc = new double[n])) {
+			throw new CMemoryException("CCheckpoint::read");
+		}
+		fin.read(reinterpret_cast<char*>(m_dpPc),n*sizeof(double));
+		if (fin.fail())
+			m_iPcSize=0;
+	}
+	m_bRec=(bRec && m_iRecNum && checkRecord())? true: false;
+	if (!m_bRec)
+		m_iRecNum=0;
+	m_bResume=m_bRec;
+	return true;
+} // end of CCheckpoint::read()
+
+bool CCheckpoint::checkRecord()
+{
+	const double* dpVal;
+	const int* ipCol;
+	double *dpX, s, b, x;
+	int sz, hd, n=m_copy.getColNum();
+	if (!(dpX = new double[n])) {
+		throw new CMemoryException("CCheckpoint::checkRecord");
+	}
+	for (int j=0; j < n; ++j) {
+		dpX[j]=0.0;
+	}
+	for (int i=0; i < m_iRecNum; ++i) {
+		if ((hd=m_ipRecHd[i]) >= 0 && hd < n)
+			dpX[hd]=m_dpRecX[i];
+	}
+	bool flag=true;
+	for (int j=0; j < n && flag; ++j) {
+		x=dpX[j];
+		if (!std::isfinite(x) || x < m_copy.getLoBound(j)-CKP_TOL || x > m_copy.getUpBound(j)+CKP_TOL)
+			flag=false;
+		else if (m_copy.isInteger(j) && fabs(x-floor(x+0.5)) > CKP_TOL)
+			flag=false;
+	}
+	for (int i=0; i < m_copy.getRowNum() && flag; ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		for (s=0.0, --sz; sz >= 0; --sz) {
+			s+=dpVal[sz]*dpX[ipCol[sz]];
+		}
+		if ((b=m_copy.getRowLoBound(i)) > -CLP::INF && s < b-CKP_TOL*(1.0+fabs(b)))
+			flag=false;
+		else if ((b=m_copy.getRowUpBound(i)) < CLP::INF && s > b+CKP_TOL*(1.0+fabs(b)))
+			flag=false;
+	}
+	if (flag) {
+		for (s=0.0, sz=0; sz < n; ++sz) {
+			s+=m_copy.getObjCoeff(sz)*dpX[sz];
+		}
+		if (fabs(s-m_dRecObj) > CKP_TOL*(1.0+fabs(s)))
+			flag=false;
+	}
+	if (flag) {
+		memcpy(m_dpRecX,dpX,n*sizeof(double));
+		for (int j=0; j < n; ++j) {
+			m_ipRecHd[j]=j;
+		}
+		m_iRecNum=n;
+	}
+	delete[] dpX;
+	return flag;
+} // end of CCheckpoint::checkRecord()
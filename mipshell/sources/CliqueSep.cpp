@@ -0,0 +1,146 @@
+// CliqueSep.cpp: implementation of the CCliqueSep class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <except.h>
+#include <lp.h>
+#include <Sort.h>
+#include "CutSelector.h"
+#include "CliqueSep.h"
+
+#define CLIQUESEP_TOL 1.0e-6 ///< literals which weights are not greater than `CLIQUESEP_TOL` are considered as zero weight literals.
+#define CLIQUESEP_MIN_VIOL 1.0e-3 ///< cliques which weights are not greater than `1+CLIQUESEP_MIN_VIOL` are not written.
+#define CLIQUESEP_MAX_START 512 ///< maximum number of start literals in one call.
+#define CLIQUESEP_MAX_NBR 4096 ///< maximum number of neighbours of start literal examined.
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CCliqueSep::CCliqueSep(int maxCutNum)
+{
+	m_iMaxCutNum=maxCutNum;
+} // end of CCliqueSep::CCliqueSep()
+
+CCliqueSep::~CCliqueSep()
+{
+} // end of CCliqueSep::~CCliqueSep()
+
+//////////////////////////////////////////////////////////////////////
+// Separation
+//////////////////////////////////////////////////////////////////////
+int CCliqueSep::separate(int hdNum, const double* dpX, const int* ipHdToCol, CCutSelector& cuts)
+{
+	double x, w, weight, *dpMem, *dpCandW, *dpNbrW, *dpVal;
+	int i, k, l, lit, sz, nbrNum, posNum, negNum, n=m_table.getColNum(), fracNum=0, candNum=0, cutNum=0;
+	int *ipMem, *ipCand, *ipOrd, *ipNbr, *ipNbrOrd, *ipClique, *ipHd;
+	if (hdNum < n || !m_table.getCliqueNum())
+		return 0;
+	for (int j=0; j < n; ++j) {
+		if (ipHdToCol[j] >= 0 && dpX[j] > CLIQUESEP_TOL && dpX[j] < 1.0-CLIQUESEP_TOL)
+			++fracNum;
+	}
+	if (!fracNum)
+		return 0;
+	if (!(dpMem = new double[(fracNum<<1)+(CLIQUESEP_MAX_NBR<<1)+1])) {
+		throw new CMemoryException("CCliqueSep::separate");
+	}
+	if (!(ipMem = new int[(fracNum<<2)+(CLIQUESEP_MAX_NBR<<2)+2])) {
+		delete[] dpMem;
+		throw new CMemoryException("CCliqueSep::separate");
+	}
+	dpCandW=dpMem;
+	dpNbrW=dpCandW+(fracNum<<1);
+	dpVal=dpNbrW+CLIQUESEP_MAX_NBR;
+	ipCand=ipMem;
+	ipOrd=ipCand+(fracNum<<1);
+	ipNbr=ipOrd+(fracNum<<1);
+	ipNbrOrd=ipNbr+CLIQUESEP_MAX_NBR;
+	ipClique=ipNbrOrd+CLIQUESEP_MAX_NBR;
+	ipHd=ipClique+CLIQUESEP_MAX_NBR+1;
+	m_table.lockRead();
+	try {
+	// literals of fractional variables are start literals; variables removed from the LP by preprocessing are not used
+		for (int j=0; j < n; ++j) {
+			if (ipHdToCol[j] < 0 || (x=dpX[j]) <= CLIQUESEP_TOL || x >= 1.0-CLIQUESEP_TOL)
+				continue;
+			for (lit=j<<1; lit <= ((j<<1) | 1); ++lit) {
+				if (m_table.hasConflicts(lit)) {
+					dpCandW[candNum]=(lit & 1)? 1.0-x: x;
+					ipOrd[candNum]=candNum;
+					ipCand[candNum++]=lit;
+				}
+			}
+		}
+		SORT::decSortDouble(candNum,ipOrd,dpCandW);
+		for (int t=0; t < candNum && t < CLIQUESEP_MAX_START && cutNum < m_iMaxCutNum; ++t) {
+			lit=ipCand[ipOrd[t]];
+			weight=dpCandW[ipOrd[t]];
+			nbrNum=m_table.getNeighbors(lit,CLIQUESEP_MAX_NBR,ipNbr);
+			w=weight;
+			for (posNum=k=0; k < nbrNum; ++k) {
+				if (ipHdToCol[(l=ipNbr[k]) >> 1] < 0) {
+					dpNbrW[k]=0.0;
+					continue;
+				}
+				x=dpX[l>>1];
+				if ((dpNbrW[k]=(l & 1)? 1.0-x: x) > CLIQUESEP_TOL) {
+					ipNbrOrd[posNum++]=k;
+					w+=dpNbrW[k];
+				}
+			}
+			if (w <= 1.0+CLIQUESEP_MIN_VIOL)
+				continue; // even all neighbours together do not give a violated clique
+		// greedy max-weight clique containing `lit`
+			SORT::decSortDouble(posNum,ipNbrOrd,dpNbrW);
+			ipClique[0]=lit;
+			sz=1;
+			for (int s=0; s < posNum; ++s) {
+				l=ipNbr[k=ipNbrOrd[s]];
+				if (l == (lit ^ 1))
+					continue;
+				for (i=1; i < sz; ++i) {
+					if (ipClique[i] == (l ^ 1) || !m_table.isAdjacent(l,ipClique[i]))
+						break;
+				}
+				if (i == sz) {
+					ipClique[sz++]=l;
+					weight+=dpNbrW[k];
+				}
+			}
+			if (weight <= 1.0+CLIQUESEP_MIN_VIOL)
+				continue;
+		// extend clique by zero weight literals
+			for (k=0; k < nbrNum; ++k) {
+				if (dpNbrW[k] > CLIQUESEP_TOL || (l=ipNbr[k]) == (lit ^ 1) || ipHdToCol[l>>1] < 0)
+					continue;
+				for (i=1; i < sz; ++i) {
+					if (ipClique[i] == (l ^ 1) || !m_table.isAdjacent(l,ipClique[i]))
+						break;
+				}
+				if (i == sz)
+					ipClique[sz++]=l;
+			}
+		// clique inequality in variables: sum of x_j over positive literals minus sum of x_j over negative ones <= 1-(number of negative literals)
+			for (negNum=i=0; i < sz; ++i) {
+				ipHd[i]=ipClique[i] >> 1;
+				if (ipClique[i] & 1) {
+					dpVal[i]=-1.0;
+					++negNum;
+				}
+				else
+					dpVal[i]=1.0;
+			}
+			if (cuts.addCand(CUT_SEPARATOR,0,-CLP::INF,1.0-negNum,sz,dpVal,ipHd))
+				++cutNum;
+		}
+	}
+	catch(CMemoryException* pe) {
+		m_table.unlockRead();
+		delete[] ipMem;
+		delete[] dpMem;
+		throw pe;
+	}
+	m_table.unlockRead();
+	delete[] ipMem;
+	delete[] dpMem;
+	return cutNum;
+} // end of CCliqueSep::separate()
@@ -0,0 +1,351 @@
+// CliqueTable.cpp: implementation of the CCliqueTable class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <except.h>
+#include <lp.h>
+#include <Sort.h>
+#include "MatrixCopy.h"
+#include "CliqueTable.h"
+
+#define CLIQUE_TOL 1.0e-6 ///< tolerance used to compare coefficients.
+#define CLIQUE_MAX_BITSET_LIT 8192 ///< adjacency matrix is stored as bitsets if the number of literals is not greater than this value.
+#define CLIQUE_MAX_ROW_EXT 16 ///< maximum number of extra cliques built from one row.
+#define CLIQUE_MIN_PENDING 1024 ///< per-literal lists are rebuilt when pending cliques contain more literals than this value
+                                ///< and more than 1/8 of all literals.
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CCliqueTable::CCliqueTable()
+{
+	m_iColNum=0;
+	m_iCliqueNum=m_iMaxCliqueNum=0;
+	m_iLitNum=m_iMaxLitNum=0;
+	m_ipCliqueBeg=m_ipLit=0;
+	m_iIndexedNum=0;
+	m_ipLitBeg=m_ipLitClique=0;
+	m_iAdjWordNum=0;
+	m_ulpAdj=0;
+#ifndef __ONE_THREAD_
+	_RWLOCK_INIT(m_rwLock)
+#endif
+} // end of CCliqueTable::CCliqueTable()
+
+CCliqueTable::~CCliqueTable()
+{
+#ifndef __ONE_THREAD_
+	_RWLOCK_DESTROY(m_rwLock)
+#endif
+	reset();
+} // end of CCliqueTable::~CCliqueTable()
+
+void CCliqueTable::reset()
+{
+	if (m_ipCliqueBeg)
+		delete[] m_ipCliqueBeg;
+	if (m_ipLit)
+		delete[] m_ipLit;
+	if (m_ipLitBeg)
+		delete[] m_ipLitBeg;
+	if (m_ipLitClique)
+		delete[] m_ipLitClique;
+	if (m_ulpAdj)
+		delete[] m_ulpAdj;
+	m_ipCliqueBeg=m_ipLit=m_ipLitBeg=m_ipLitClique=0;
+	m_ulpAdj=0;
+	m_iCliqueNum=m_iMaxCliqueNum=m_iLitNum=m_iMaxLitNum=m_iIndexedNum=m_iAdjWordNum=0;
+} // end of CCliqueTable::reset()
+
+void CCliqueTable::allocMem(int cliqueNum, int litNum)
+{
+	if (cliqueNum > m_iMaxCliqueNum) {
+		int *ipBeg;
+		if (cliqueNum < (m_iMaxCliqueNum << 1))
+			cliqueNum=m_iMaxCliqueNum << 1;
+		if (!(ipBeg = new int[cliqueNum+1])) {
+			throw new CMemoryException("CCliqueTable::allocMem");
+		}
+		if (m_ipCliqueBeg) {
+			memcpy(ipBeg,m_ipCliqueBeg,(m_iCliqueNum+1)*sizeof(int));
+			delete[] m_ipCliqueBeg;
+		}
+		else
+			ipBeg[0]=0;
+		m_ipCliqueBeg=ipBeg;
+		m_iMaxCliqueNum=cliqueNum;
+	}
+	if (litNum > m_iMaxLitNum) {
+		int *ipLit;
+		if (litNum < (m_iMaxLitNum << 1))
+			litNum=m_iMaxLitNum << 1;
+		if (!(ipLit = new int[litNum])) {
+			throw new CMemoryException("CCliqueTable::allocMem");
+		}
+		if (m_ipLit) {
+			memcpy(ipLit,m_ipLit,m_iLitNum*sizeof(int));
+			delete[] m_ipLit;
+		}
+		m_ipLit=ipLit;
+		m_iMaxLitNum=litNum;
+	}
+} // end of CCliqueTable::allocMem()
+
+//////////////////////////////////////////////////////////////////////
+// Building the table
+//////////////////////////////////////////////////////////////////////
+void CCliqueTable::appendClique(int sz, const int* ipLit)
+{
+	allocMem(m_iCliqueNum+1,m_iLitNum+sz);
+	memcpy(m_ipLit+m_iLitNum,ipLit,sz*sizeof(int));
+	m_ipCliqueBeg[++m_iCliqueNum]=(m_iLitNum+=sz);
+	if (m_ulpAdj) {
+		for (int i=0; i < sz; ++i) {
+			unsigned long long* ulpRow=m_ulpAdj+ipLit[i]*m_iAdjWordNum;
+			for (int k=0; k < sz; ++k) {
+				if (k != i)
+					ulpRow[ipLit[k]>>6]|=1ULL << (ipLit[k] & 63);
+			}
+		}
+	}
+} // end of CCliqueTable::appendClique()
+
+void CCliqueTable::buildIndex()
+{
+	int l, litNum=m_iColNum << 1, *ipLitBeg, *ipLitClique;
+	if (!(ipLitBeg = new int[litNum+1])) {
+		throw new CMemoryException("CCliqueTable::buildIndex");
+	}
+	if (!(ipLitClique = new int[m_iLitNum+1])) {
+		delete[] ipLitBeg;
+		throw new CMemoryException("CCliqueTable::buildIndex");
+	}
+	memset(ipLitBeg,0,(litNum+1)*sizeof(int));
+	for (int k=0; k < m_iLitNum; ++k) {
+		++ipLitBeg[m_ipLit[k]+1];
+	}
+	for (l=0; l < litNum; ++l) {
+		ipLitBeg[l+1]+=ipLitBeg[l];
+	}
+	for (int q=0; q < m_iCliqueNum; ++q) {
+		for (int k=m_ipCliqueBeg[q]; k < m_ipCliqueBeg[q+1]; ++k) {
+			ipLitClique[ipLitBeg[m_ipLit[k]]++]=q; // lists are sorted
+		}
+	}
+	for (l=litNum; l > 0; --l) {
+		ipLitBeg[l]=ipLitBeg[l-1];
+	}
+	ipLitBeg[0]=0;
+	if (m_ipLitBeg) {
+		delete[] m_ipLitBeg;
+		delete[] m_ipLitClique;
+	}
+	m_ipLitBeg=ipLitBeg;
+	m_ipLitClique=ipLitClique;
+	m_iIndexedNum=m_iCliqueNum;
+} // end of CCliqueTable::buildIndex()
+
+void CCliqueTable::build(const CMatrixCopy& copy)
+{
+	const double* dpVal;
+	const int* ipCol;
+	double *dpA, b, a, sign;
+	int *ipLit, *ipOrd, *ipClique, i, j, k, p, sz, n=copy.getColNum(), m=copy.getRowNum(), maxSz=0;
+	reset();
+	m_iColNum=n;
+	for (i=0; i < m; ++i) {
+		if ((sz=copy.getRow(i,dpVal,ipCol)) > maxSz)
+			maxSz=sz;
+	}
+	if (2*n <= CLIQUE_MAX_BITSET_LIT) {
+		m_iAdjWordNum=((n<<1)+63) >> 6;
+		if (!(m_ulpAdj = new unsigned long long[(n<<1)*m_iAdjWordNum+1])) {
+			throw new CMemoryException("CCliqueTable::build");
+		}
+		memset(m_ulpAdj,0,(n<<1)*m_iAdjWordNum*sizeof(unsigned long long));
+	}
+	if (!(dpA = new double[maxSz+1])) {
+		throw new CMemoryException("CCliqueTable::build");
+	}
+	if (!(ipLit = new int[3*maxSz+2])) {
+		delete[] dpA;
+		throw new CMemoryException("CCliqueTable::build");
+	}
+	ipOrd=ipLit+maxSz;
+	ipClique=ipOrd+maxSz;
+	try {
+		for (i=0; i < m; ++i) {
+			if ((sz=copy.getRow(i,dpVal,ipCol)) < 2)
+				continue;
+			for (k=0; k < sz; ++k) {
+				j=ipCol[k];
+				if (!copy.isInteger(j) || copy.getLoBound(j) < -CLIQUE_TOL || copy.getUpBound(j) > 1.0+CLIQUE_TOL)
+					break;
+			}
+			if (k < sz)
+				continue; // not all variables are binary
+			for (int side=0; side < 2; ++side) {
+				if (!side) {
+					if ((b=copy.getRowUpBound(i)) >= CLP::INF)
+						continue;
+					sign=1.0;
+				}
+				else {
+					if ((b=copy.getRowLoBound(i)) <= -CLP::INF)
+						continue;
+					sign=-1.0;
+					b=-b;
+				}
+			// complement variables with negative coefficients
+				for (k=0; k < sz; ++k) {
+					ipOrd[k]=k;
+					if ((a=sign*dpVal[k]) < 0.0) {
+						dpA[k]=-a;
+						b-=a;
+						ipLit[k]=(ipCol[k] << 1) | 1;
+					}
+					else {
+						dpA[k]=a;
+						ipLit[k]=ipCol[k] << 1;
+					}
+				}
+				SORT::decSortDouble(sz,ipOrd,dpA);
+				if (dpA[ipOrd[0]]+dpA[ipOrd[1]] <= b+CLIQUE_TOL)
+					continue; // no conflicts
+				for (k=2; k < sz && dpA[ipOrd[k-1]]+dpA[ipOrd[k]] > b+CLIQUE_TOL; ++k);
+				for (p=0; p < k; ++p) {
+					ipClique[p]=ipLit[ipOrd[p]];
+				}
+				appendClique(k,ipClique);
+			// each remaining literal conflicting with some of the largest ones gives another clique
+				p=k-1;
+				for (int l=k; l < sz && l-k < CLIQUE_MAX_ROW_EXT; ++l) {
+					for (; p >= 0 && dpA[ipOrd[p]]+dpA[ipOrd[l]] <= b+CLIQUE_TOL; --p);
+					if (p < 0)
+						break;
+					ipClique[p+1]=ipLit[ipOrd[l]];
+					appendClique(p+2,ipClique);
+				}
+			}
+		}
+		buildIndex();
+	}
+	catch(CMemoryException* pe) {
+		delete[] ipLit;
+		delete[] dpA;
+		throw pe;
+	}
+	delete[] ipLit;
+	delete[] dpA;
+} // end of CCliqueTable::build()
+
+void CCliqueTable::addClique(int sz, const int* ipLit)
+{
+#ifndef __ONE_THREAD_
+	_RWLOCK_WRLOCK(&m_rwLock)
+#endif
+	try {
+		appendClique(sz,ipLit);
+		int pendingNum=m_iLitNum-m_ipCliqueBeg[m_iIndexedNum];
+		if (pendingNum > CLIQUE_MIN_PENDING && pendingNum > (m_iLitNum >> 3))
+			buildIndex();
+	}
+	catch(CMemoryException* pe) {
+#ifndef __ONE_THREAD_
+		_RWLOCK_UNLOCK_WRLOCK(&m_rwLock)
+#endif
+		throw pe;
+	}
+#ifndef __ONE_THREAD_
+	_RWLOCK_UNLOCK_WRLOCK(&m_rwLock)
+#endif
+} // end of CCliqueTable::addClique()
+
+//////////////////////////////////////////////////////////////////////
+// Queries
+//////////////////////////////////////////////////////////////////////
+bool CCliqueTable::isPendingEdge(int lit1, int lit2) const
+{
+	int k, q, mask;
+	for (q=m_iIndexedNum; q < m_iCliqueNum; ++q) {
+		for (mask=0, k=m_ipCliqueBeg[q]; k < m_ipCliqueBeg[q+1]; ++k) {
+			if (m_ipLit[k] == lit1)
+				mask|=1;
+			else if (m_ipLit[k] == lit2)
+				mask|=2;
+		}
+		if (mask == 3)
+			return true;
+	}
+	return false;
+} // end of CCliqueTable::isPendingEdge()
+
+bool CCliqueTable::hasConflicts(int lit) const
+{
+	if (m_ipLitBeg && m_ipLitBeg[lit+1] > m_ipLitBeg[lit])
+		return true;
+	if (m_iIndexedNum < m_iCliqueNum) {
+		for (int k=m_ipCliqueBeg[m_iIndexedNum]; k < m_iLitNum; ++k) {
+			if (m_ipLit[k] == lit)
+				return true;
+		}
+	}
+	return false;
+} // end of CCliqueTable::hasConflicts()
+
+bool CCliqueTable::isAdjacent(int lit1, int lit2) const
+{
+	if (m_ulpAdj)
+		return ((m_ulpAdj[lit1*m_iAdjWordNum+(lit2>>6)] >> (lit2 & 63)) & 1ULL)? true: false;
+	if (m_ipLitBeg) {
+	// intersect sorted lists of cliques
+		int k1=m_ipLitBeg[lit1], e1=m_ipLitBeg[lit1+1], k2=m_ipLitBeg[lit2], e2=m_ipLitBeg[lit2+1];
+		while (k1 < e1 && k2 < e2) {
+			if (m_ipLitClique[k1] < m_ipLitClique[k2])
+				++k1;
+			else if (m_ipLitClique[k1] > m_ipLitClique[k2])
+				++k2;
+			else
+				return true;
+		}
+	}
+	return isPendingEdge(lit1,lit2);
+} // end of CCliqueTable::isAdjacent()
+
+int CCliqueTable::getNeighbors(int lit, int maxNum, int* ipNbr) const
+{
+	int k, q, num=0;
+	if (m_ipLitBeg) {
+		for (int t=m_ipLitBeg[lit]; t < m_ipLitBeg[lit+1] && num < maxNum; ++t) {
+			q=m_ipLitClique[t];
+			for (k=m_ipCliqueBeg[q]; k < m_ipCliqueBeg[q+1] && num < maxNum; ++k) {
+				if (m_ipLit[k] != lit)
+					ipNbr[num++]=m_ipLit[k];
+			}
+		}
+	}
+	for (q=m_iIndexedNum; q < m_iCliqueNum && num < maxNum; ++q) {
+		for (k=m_ipCliqueBeg[q]; k < m_ipCliqueBeg[q+1]; ++k) {
+			if (m_ipLit[k] == lit)
+				break;
+		}
+		if (k == m_ipCliqueBeg[q+1])
+			continue;
+		for (k=m_ipCliqueBeg[q]; k < m_ipCliqueBeg[q+1] && num < maxNum; ++k) {
+			if (m_ipLit[k] != lit)
+				ipNbr[num++]=m_ipLit[k];
+		}
+	}
+// sort and remove duplicates
+	if (num > 1) {
+		std::sort(ipNbr,ipNbr+num);
+		for (q=0, k=1; k < num; ++k) {
+			if (ipNbr[k] != ipNbr[q])
+				ipNbr[++q]=ipNbr[k];
+		}
+		num=q+1;
+	}
+	return num;
+} // end of CCliqueTable::getNeighbors()
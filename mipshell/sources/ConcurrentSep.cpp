@@ -0,0 +1,254 @@
+// ConcurrentSep.cpp: implementation of the CConcurrentSep class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <except.h>
+#include "Separator.h"
+#include "CutSelector.h"
+#include "ConcurrentSep.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CConcurrentSep::CConcurrentSep(int threadNum)
+{
+	m_bOwner=true;
+	m_iSepNum=m_iMaxSepNum=0;
+	m_ppSep=0;
+	m_iThreadNum=threadNum;
+	m_iHdNum=0;
+	m_dpX=0;
+	m_ipHdToCol=0;
+	m_iNextSep=m_iNextBuf=m_iBufNum=m_iCutNum=0;
+	m_ppBuf=0;
+	m_pErr=0;
+#ifndef __ONE_THREAD_
+	m_iWorkerNum=0;
+	m_pThreads=0;
+	_MUTEX_INIT(m_mutex)
+#endif
+} // end of CConcurrentSep::CConcurrentSep()
+
+CConcurrentSep::CConcurrentSep(const CConcurrentSep &other)
+{
+	m_bOwner=false;
+	m_iSepNum=m_iMaxSepNum=other.m_iSepNum;
+	m_ppSep=other.m_ppSep;
+	m_iThreadNum=other.m_iThreadNum;
+	m_iHdNum=0;
+	m_dpX=0;
+	m_ipHdToCol=0;
+	m_iNextSep=m_iNextBuf=m_iBufNum=m_iCutNum=0;
+	m_ppBuf=0;
+	m_pErr=0;
+#ifndef __ONE_THREAD_
+	m_iWorkerNum=0;
+	m_pThreads=0;
+	_MUTEX_INIT(m_mutex)
+#endif
+} // end of CConcurrentSep::CConcurrentSep(const CConcurrentSep &other)
+
+CConcurrentSep::~CConcurrentSep()
+{
+#ifndef __ONE_THREAD_
+	if (m_pThreads)
+		delete[] m_pThreads;
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	if (m_ppBuf) {
+		for (int t=0; t < m_iBufNum; ++t) {
+			delete m_ppBuf[t];
+		}
+		delete[] m_ppBuf;
+	}
+	if (m_bOwner && m_ppSep) {
+		for (int k=0; k < m_iSepNum; ++k) {
+			delete m_ppSep[k];
+		}
+		delete[] m_ppSep;
+	}
+} // end of CConcurrentSep::~CConcurrentSep()
+
+void CConcurrentSep::addSeparator(CSeparator* pSep)
+{
+	if (m_iSepNum == m_iMaxSepNum) {
+		CSeparator** ppSep;
+		int sepNum=(m_iMaxSepNum)? m_iMaxSepNum << 1: 4;
+		if (!(ppSep = new CSeparator*[sepNum])) {
+			throw new CMemoryException("CConcurrentSep::addSeparator");
+		}
+		if (m_ppSep) {
+			memcpy(ppSep,m_ppSep,m_iSepNum*sizeof(CSeparator*));
+			delete[] m_ppSep;
+		}
+		m_ppSep=ppSep;
+		m_iMaxSepNum=sepNum;
+	}
+	m_ppSep[m_iSepNum++]=pSep;
+} // end of CConcurrentSep::addSeparator()
+
+//////////////////////////////////////////////////////////////////////
+// Separation
+//////////////////////////////////////////////////////////////////////
+void CConcurrentSep::runSeparators()
+{
+	int k, t, cutNum;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	t=m_iNextBuf++;
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	for (;;) {
+#ifndef __ONE_THREAD_
+		_MUTEX_LOCK(&m_mutex)
+#endif
+		k=(m_iNextSep < m_iSepNum && !m_pErr)? m_iNextSep++: -1;
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+		if (k < 0)
+			break;
+		std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+		try {
+			cutNum=m_ppSep[k]->separate(m_iHdNum,m_dpX,m_ipHdToCol,*m_ppBuf[t]);
+		}
+		catch(CException* pe) {
+			cutNum=0;
+#ifndef __ONE_THREAD_
+			_MUTEX_LOCK(&m_mutex)
+#endif
+			if (m_pErr)
+				delete pe;
+			else
+				m_pErr=pe; // rethrown by `finish()`
+#ifndef __ONE_THREAD_
+			_MUTEX_UNLOCK(&m_mutex)
+#endif
+		}
+		m_ppSep[k]->m_lTime.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now()-startTime).count(),std::memory_order_relaxed);
+		m_ppSep[k]->m_iCallNum.fetch_add(1,std::memory_order_relaxed);
+		m_ppSep[k]->m_iCutNum.fetch_add(cutNum,std::memory_order_relaxed);
+#ifndef __ONE_THREAD_
+		_MUTEX_LOCK(&m_mutex)
+#endif
+		m_iCutNum+=cutNum;
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+	}
+} // end of CConcurrentSep::runSeparators()
+
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CConcurrentSep::startThread(void* param)
+#else
+void* CConcurrentSep::startThread(void* param)
+#endif
+{
+	static_cast<CConcurrentSep*>(param)->runSeparators();
+	return 0;
+} // end of CConcurrentSep::startThread()
+#endif
+
+void CConcurrentSep::start(int hdNum, const double* dpX, const int* ipHdToCol, const CCutSelector& sel, int threadNum)
+{
+	if (m_iThreadNum > 0)
+		threadNum=m_iThreadNum;
+	if (threadNum > m_iSepNum)
+		threadNum=m_iSepNum;
+	if (threadNum < 1)
+		threadNum=1;
+	if (m_ppBuf && hdNum != m_iHdNum) { // the problem has been changed, buffers are to be cloned again
+		for (int t=0; t < m_iBufNum; ++t) {
+			delete m_ppBuf[t];
+		}
+		m_iBufNum=0;
+	}
+	if (threadNum > m_iBufNum) {
+		CCutSelector** ppBuf;
+		if (!(ppBuf = new CCutSelector*[threadNum])) {
+			throw new CMemoryException("CConcurrentSep::start");
+		}
+		if (m_ppBuf) {
+			memcpy(ppBuf,m_ppBuf,m_iBufNum*sizeof(CCutSelector*));
+			delete[] m_ppBuf;
+		}
+		m_ppBuf=ppBuf;
+#ifndef __ONE_THREAD_
+		if (m_pThreads) {
+			delete[] m_pThreads;
+			m_pThreads=0;
+		}
+#endif
+		for (; m_iBufNum < threadNum; ++m_iBufNum) {
+			if (!(m_ppBuf[m_iBufNum] = new CCutSelector(sel))) {
+				throw new CMemoryException("CConcurrentSep::start");
+			}
+		}
+	}
+	m_iHdNum=hdNum;
+	m_dpX=dpX;
+	m_ipHdToCol=ipHdToCol;
+	m_iNextSep=m_iNextBuf=m_iCutNum=0;
+	m_pErr=0;
+#ifndef __ONE_THREAD_
+	if ((m_iWorkerNum=threadNum-1) > 0) {
+		if (!m_pThreads) {
+			if (!(m_pThreads = new _THREAD[m_iBufNum])) {
+				throw new CMemoryException("CConcurrentSep::start");
+			}
+		}
+		for (int t=0; t < m_iWorkerNum; ++t) {
+			_THREAD_CREATE(m_pThreads[t],startThread,this)
+		}
+	}
+#endif
+} // end of CConcurrentSep::start()
+
+int CConcurrentSep::finish(CCutSelector& sel)
+{
+	runSeparators();
+#ifndef __ONE_THREAD_
+	for (int t=0; t < m_iWorkerNum; ++t) {
+		_THREAD_JOIN(m_pThreads[t])
+		_THREAD_CLOSE(m_pThreads[t])
+	}
+	m_iWorkerNum=0;
+#endif
+	m_dpX=0;
+	m_ipHdToCol=0;
+	for (int t=0; t < m_iBufNum; ++t) {
+		sel.merge(*m_ppBuf[t]);
+		m_ppBuf[t]->clear();
+	}
+	if (m_pErr) {
+		CException* pe=m_pErr;
+		m_pErr=0;
+		sel.clear();
+		throw pe;
+	}
+	return m_iCutNum;
+} // end of CConcurrentSep::finish()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CConcurrentSep::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	out << "MIPshell separators\n";
+	out << "====== Separator ===== Calls ===== Cuts ==== Time(s)\n";
+	for (int k=0; k < m_iSepNum; ++k) {
+		sprintf(str,"%15.15s %11d %10d %10.3f\n",m_ppSep[k]->getName(),
+			m_ppSep[k]->m_iCallNum.load(std::memory_order_relaxed),
+			m_ppSep[k]->m_iCutNum.load(std::memory_order_relaxed),
+			1.0e-6*m_ppSep[k]->m_lTime.load(std::memory_order_relaxed));
+		out << str;
+	}
+	out << std::endl;
+} // end of CConcurrentSep::printStatistics()
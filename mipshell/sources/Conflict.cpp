@@ -0,0 +1,387 @@
+// Conflict.cpp: implementation of the CConflict class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <except.h>
+#include <lp.h>
+#include <Sort.h>
+#include "MatrixCopy.h"
+#include "Conflict.h"
+
+#define CONFLICT_FEAS_TOL 1.0e-6 ///< row is violated if its minimum activity exceeds its right hand side by more than `CONFLICT_FEAS_TOL` (relative).
+#define CONFLICT_EXPL_TOL 1.0e-9 ///< tolerance used when explaining violations and implied bounds.
+#define CONFLICT_INT_TOL 1.0e-6 ///< integrality tolerance used when rounding implied bounds.
+#define CONFLICT_BOUND_TOL 1.0e-9 ///< node bound differs from global one if the difference is greater than `CONFLICT_BOUND_TOL`.
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CConflict::CConflict(int maxLen): m_iCallNum(0), m_iInfNum(0), m_iNogoodNum(0), m_lLitNum(0)
+{
+	m_iColNum=m_iRowNum=0;
+	m_bSense=false;
+	m_dpD=0;
+	m_cpInt=0;
+	m_dpRhs=0;
+	m_ipBeg=m_ipCol=0;
+	m_dpVal=0;
+	m_ipColBeg=m_ipColRow=0;
+	m_iMaxLen=maxLen;
+	m_lMaxWork=0;
+} // end of CConflict::CConflict()
+
+CConflict::~CConflict()
+{
+	if (m_dpD)
+		delete[] m_dpD;
+	if (m_cpInt)
+		delete[] m_cpInt;
+	if (m_ipBeg)
+		delete[] m_ipBeg;
+} // end of CConflict::~CConflict()
+
+void CConflict::init(const CMatrixCopy& copy)
+{
+	const double* dpVal;
+	const int* ipCol;
+	double l, u;
+	int i, j, k, sz, m=copy.getRowNum(), n=copy.getColNum(), rowNum=0, nz=0;
+	for (i=0; i < m; ++i) {
+		sz=copy.getRow(i,dpVal,ipCol);
+		if (copy.getRowUpBound(i) < CLP::VAR_INF) {
+			++rowNum;
+			nz+=sz;
+		}
+		if (copy.getRowLoBound(i) > -CLP::VAR_INF) {
+			++rowNum;
+			nz+=sz;
+		}
+	}
+	for (j=0; j < n; ++j) {
+		if (copy.getObjCoeff(j) != 0.0)
+			++nz;
+	}
+	if (!(m_dpD = new double[(n<<1)+rowNum+nz])) {
+		throw new CMemoryException("CConflict::init");
+	}
+	m_dpRhs=m_dpD+(n<<1);
+	m_dpVal=m_dpRhs+rowNum;
+	if (!(m_ipBeg = new int[rowNum+2+nz+n+1+nz])) {
+		throw new CMemoryException("CConflict::init");
+	}
+	m_ipCol=m_ipBeg+rowNum+2;
+	m_ipColBeg=m_ipCol+nz;
+	m_ipColRow=m_ipColBeg+n+1;
+	if (!(m_cpInt = new char[n])) {
+		throw new CMemoryException("CConflict::init");
+	}
+	m_iColNum=n;
+	m_iRowNum=rowNum;
+	m_bSense=copy.getSense();
+	for (j=0; j < n; ++j) {
+		m_dpD[j<<1]=l=copy.getLoBound(j);
+		m_dpD[(j<<1)+1]=u=copy.getUpBound(j);
+		m_cpInt[j]=(!copy.isInteger(j))? 0: (l > -0.5 && u < 1.5)? 2: 1;
+	}
+// rows are written as less-than-or-equal-to inequalities
+	rowNum=nz=0;
+	for (i=0; i < m; ++i) {
+		sz=copy.getRow(i,dpVal,ipCol);
+		if (copy.getRowUpBound(i) < CLP::VAR_INF) {
+			m_ipBeg[rowNum]=nz;
+			m_dpRhs[rowNum++]=copy.getRowUpBound(i);
+			for (k=0; k < sz; ++k) {
+				m_dpVal[nz]=dpVal[k];
+				m_ipCol[nz++]=ipCol[k];
+			}
+		}
+		if (copy.getRowLoBound(i) > -CLP::VAR_INF) {
+			m_ipBeg[rowNum]=nz;
+			m_dpRhs[rowNum++]=-copy.getRowLoBound(i);
+			for (k=0; k < sz; ++k) {
+				m_dpVal[nz]=-dpVal[k];
+				m_ipCol[nz++]=ipCol[k];
+			}
+		}
+	}
+// objective row: -c^Tx <= -record for maximization, and c^Tx <= record for minimization
+	m_ipBeg[rowNum]=nz;
+	for (j=0; j < n; ++j) {
+		if (copy.getObjCoeff(j) != 0.0) {
+			m_dpVal[nz]=(m_bSense)? -copy.getObjCoeff(j): copy.getObjCoeff(j);
+			m_ipCol[nz++]=j;
+		}
+	}
+	m_ipBeg[rowNum+1]=nz;
+// column index
+	memset(m_ipColBeg,0,(n+1)*sizeof(int));
+	for (k=0; k < nz; ++k) {
+		++m_ipColBeg[m_ipCol[k]+1];
+	}
+	for (j=0; j < n; ++j) {
+		m_ipColBeg[j+1]+=m_ipColBeg[j];
+	}
+	for (i=0; i <= rowNum; ++i) {
+		for (k=m_ipBeg[i]; k < m_ipBeg[i+1]; ++k) {
+			m_ipColRow[m_ipColBeg[m_ipCol[k]]++]=i;
+		}
+	}
+	for (j=n; j > 0; --j) {
+		m_ipColBeg[j]=m_ipColBeg[j-1];
+	}
+	m_ipColBeg[0]=0;
+	m_lMaxWork=(static_cast<long long>(nz) << 2)+1000;
+} // end of CConflict::init()
+
+void CConflict::tightenBounds(int j, double l, double u)
+{
+	if (l > m_dpD[j<<1])
+		m_dpD[j<<1]=l;
+	if (u < m_dpD[(j<<1)+1])
+		m_dpD[(j<<1)+1]=u;
+} // end of CConflict::tightenBounds()
+
+//////////////////////////////////////////////////////////////////////
+// Analysis
+//////////////////////////////////////////////////////////////////////
+void CConflict::explain(int r, int skip, double thr, int pos, const int* ipLast, const int* ipPrev,
+		const double* dpNew, char* cpMark, int* ipInd, double* dpDelta) const
+{
+	double a, glob, sum=0.0;
+	int j, t, bd, infNum=0, cnt=0, *ipTr=ipInd+m_iColNum;
+	for (int k=m_ipBeg[r]; k < m_ipBeg[r+1]; ++k) {
+		if ((j=m_ipCol[k]) == skip)
+			continue;
+		bd=((a=m_dpVal[k]) > 0.0)? j<<1: (j<<1)+1;
+		for (t=ipLast[bd]; t >= pos; t=ipPrev[t]);
+		glob=m_dpD[bd];
+		if ((a > 0.0)? glob <= -CLP::VAR_INF: glob >= CLP::VAR_INF) {
+			if (t >= 0) { // infinite contribution, bound must be kept
+				cpMark[t]=1;
+				sum+=a*dpNew[t];
+			}
+			else
+				++infNum;
+			continue;
+		}
+		sum+=a*glob;
+		if (t >= 0) {
+			dpDelta[cnt]=a*(dpNew[t]-glob);
+			ipTr[cnt]=t;
+			ipInd[cnt]=cnt;
+			++cnt;
+		}
+	}
+// the largest contributions are taken first
+	SORT::decSortDouble(cnt,ipInd,dpDelta);
+	for (int s=0; s < cnt; ++s) {
+		if (!infNum && sum > thr)
+			break;
+		sum+=dpDelta[ipInd[s]];
+		cpMark[ipTr[ipInd[s]]]=1;
+	}
+} // end of CConflict::explain()
+
+bool CConflict::analyze(double* dpD, double record, int& sz, double* dpVal, int* ipHd, double& b)
+{
+	double a, l, u, rhs, minAct, rest, bound, *dpMem, *dpNew, *dpDelta;
+	int i, j, k, t, r, bd, infNum, infCol, qHead, qNum, trNum, oneNum;
+	int *ipMem, *ipLast, *ipPrev, *ipBd, *ipReason, *ipQueue, *ipInd;
+	char *cpMem, *cpInQueue, *cpMark;
+	int n=m_iColNum, rowNum=m_iRowNum+1, maxTrNum=(n<<2)+16, conflictRow=-1;
+	long long work=0;
+	bool flag, bCutoff=(m_bSense)? record > -CLP::VAR_INF: record < CLP::VAR_INF;
+	double objRhs=(m_bSense)? -record: record;
+	sz=0;
+	m_iCallNum.fetch_add(1,std::memory_order_relaxed);
+	if (!(dpMem = new double[maxTrNum+n])) {
+		throw new CMemoryException("CConflict::analyze");
+	}
+	if (!(ipMem = new int[(n<<1)+(maxTrNum*3)+rowNum+(n<<1)])) {
+		delete[] dpMem;
+		throw new CMemoryException("CConflict::analyze");
+	}
+	if (!(cpMem = new char[rowNum+maxTrNum])) {
+		delete[] ipMem;
+		delete[] dpMem;
+		throw new CMemoryException("CConflict::analyze");
+	}
+	dpNew=dpMem;
+	dpDelta=dpNew+maxTrNum;
+	ipLast=ipMem;
+	ipPrev=ipLast+(n<<1);
+	ipBd=ipPrev+maxTrNum;
+	ipReason=ipBd+maxTrNum;
+	ipQueue=ipReason+maxTrNum;
+	ipInd=ipQueue+rowNum;
+	cpInQueue=cpMem;
+	cpMark=cpInQueue+rowNum;
+	memset(cpInQueue,0,rowNum);
+	qHead=qNum=0;
+
+// node bounds that differ from global ones start the trail
+	for (trNum=bd=0; bd < (n<<1); ++bd) {
+		ipLast[bd]=-1;
+		if ((bd & 1)? dpD[bd] < m_dpD[bd]-CONFLICT_BOUND_TOL: dpD[bd] > m_dpD[bd]+CONFLICT_BOUND_TOL) {
+			ipLast[bd]=trNum;
+			ipPrev[trNum]=-1;
+			ipBd[trNum]=bd;
+			ipReason[trNum]=-1;
+			dpNew[trNum++]=dpD[bd];
+			j=bd>>1;
+			for (k=m_ipColBeg[j]; k < m_ipColBeg[j+1]; ++k) {
+				if (!cpInQueue[r=m_ipColRow[k]] && (r < m_iRowNum || bCutoff)) {
+					cpInQueue[r]=1;
+					ipQueue[(qHead+qNum++)%rowNum]=r;
+				}
+			}
+		}
+	}
+	if (bCutoff && !cpInQueue[m_iRowNum]) {
+		cpInQueue[m_iRowNum]=1;
+		ipQueue[(qHead+qNum++)%rowNum]=m_iRowNum;
+	}
+
+// propagation
+	while (qNum && conflictRow < 0 && work < m_lMaxWork) {
+		r=ipQueue[qHead];
+		qHead=(qHead+1)%rowNum;
+		--qNum;
+		cpInQueue[r]=0;
+		rhs=(r < m_iRowNum)? m_dpRhs[r]: objRhs;
+		minAct=0.0;
+		infNum=0;
+		infCol=-1;
+		for (k=m_ipBeg[r]; k < m_ipBeg[r+1]; ++k) {
+			j=m_ipCol[k];
+			if ((a=m_dpVal[k]) > 0.0) {
+				if ((l=dpD[j<<1]) <= -CLP::VAR_INF) {
+					++infNum;
+					infCol=j;
+				}
+				else
+					minAct+=a*l;
+			}
+			else {
+				if ((u=dpD[(j<<1)+1]) >= CLP::VAR_INF) {
+					++infNum;
+					infCol=j;
+				}
+				else
+					minAct+=a*u;
+			}
+		}
+		work+=m_ipBeg[r+1]-m_ipBeg[r];
+		if (infNum > 1)
+			continue;
+		if (!infNum && minAct > rhs+CONFLICT_FEAS_TOL*(1.0+fabs(rhs))) {
+			conflictRow=r;
+			break;
+		}
+		for (k=m_ipBeg[r]; k < m_ipBeg[r+1]; ++k) {
+			if (!m_cpInt[j=m_ipCol[k]] || (infNum && j != infCol))
+				continue;
+			if ((a=m_dpVal[k]) > 0.0) {
+				rest=(infNum)? minAct: minAct-a*dpD[j<<1];
+				bound=floor((rhs-rest)/a+CONFLICT_INT_TOL);
+				if (bound >= dpD[(j<<1)+1]-0.5)
+					continue;
+				if (bound < dpD[j<<1]-0.5) {
+					conflictRow=r;
+					break;
+				}
+				bd=(j<<1)+1;
+			}
+			else {
+				rest=(infNum)? minAct: minAct-a*dpD[(j<<1)+1];
+				bound=ceil((rhs-rest)/a-CONFLICT_INT_TOL);
+				if (bound <= dpD[j<<1]+0.5)
+					continue;
+				if (bound > dpD[(j<<1)+1]+0.5) {
+					conflictRow=r;
+					break;
+				}
+				bd=j<<1;
+			}
+			if (trNum == maxTrNum) {
+				work=m_lMaxWork; // trail is full, propagation stops
+				break;
+			}
+			dpD[bd]=dpNew[trNum]=bound;
+			ipBd[trNum]=bd;
+			ipReason[trNum]=r;
+			ipPrev[trNum]=ipLast[bd];
+			ipLast[bd]=trNum++;
+			for (t=m_ipColBeg[j]; t < m_ipColBeg[j+1]; ++t) {
+				if (!cpInQueue[i=m_ipColRow[t]] && (i < m_iRowNum || bCutoff)) {
+					cpInQueue[i]=1;
+					ipQueue[(qHead+qNum++)%rowNum]=i;
+				}
+			}
+		}
+	}
+
+	if (conflictRow >= 0) {
+		m_iInfNum.fetch_add(1,std::memory_order_relaxed);
+	// bound changes are traced back to node bounds
+		memset(cpMark,0,trNum);
+		rhs=(conflictRow < m_iRowNum)? m_dpRhs[conflictRow]: objRhs;
+		explain(conflictRow,-1,rhs+CONFLICT_EXPL_TOL*(1.0+fabs(rhs)),trNum,ipLast,ipPrev,dpNew,cpMark,ipInd,dpDelta);
+		flag=true;
+		oneNum=0;
+		for (t=trNum-1; t >= 0; --t) {
+			if (!cpMark[t])
+				continue;
+			j=(bd=ipBd[t]) >> 1;
+			if ((r=ipReason[t]) < 0) {
+				if (m_cpInt[j] != 2 || sz == m_iMaxLen) {
+					flag=false; // nogood cannot be written in binary variables, or it is too long
+					break;
+				}
+				ipHd[sz]=j;
+				if (bd & 1)
+					dpVal[sz++]=1.0; // x_j=0
+				else {
+					dpVal[sz++]=-1.0; // x_j=1
+					++oneNum;
+				}
+			}
+			else {
+				for (k=m_ipBeg[r]; m_ipCol[k] != j; ++k);
+				a=m_dpVal[k];
+				rhs=(r < m_iRowNum)? m_dpRhs[r]: objRhs;
+			// bound dpNew[t] is implied if, with x_j one unit beyond it, the row would be violated
+				rhs-=(bd & 1)? a*(dpNew[t]+1.0): a*(dpNew[t]-1.0);
+				explain(r,j,rhs+CONFLICT_EXPL_TOL*(1.0+fabs(rhs)),t,ipLast,ipPrev,dpNew,cpMark,ipInd,dpDelta);
+			}
+		}
+		if (flag && sz) {
+			b=1.0-oneNum;
+			m_iNogoodNum.fetch_add(1,std::memory_order_relaxed);
+			m_lLitNum.fetch_add(sz,std::memory_order_relaxed);
+		}
+		else
+			sz=0;
+	}
+	delete[] cpMem;
+	delete[] ipMem;
+	delete[] dpMem;
+	return (conflictRow >= 0)? true: false;
+} // end of CConflict::analyze()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CConflict::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	int nogoodNum=m_iNogoodNum.load(std::memory_order_relaxed);
+	out << "Conflict analysis\n";
+	out << "===== Calls == Infeasible === Nogoods == Avg.length\n";
+	sprintf(str,"%11d %12d %10d %12.1f\n",m_iCallNum.load(std::memory_order_relaxed),
+		m_iInfNum.load(std::memory_order_relaxed),nogoodNum,
+		(nogoodNum)? static_cast<double>(m_lLitNum.load(std::memory_order_relaxed))/nogoodNum: 0.0);
+	out << str << std::endl;
+} // end of CConflict::printStatistics()
@@ -0,0 +1,186 @@
+// CutAging.cpp: implementation of the CCutAging class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <except.h>
+#include "CutAging.h"
+
+/**
+ * \param[in] h hash value;
+ * \param[in] v value to be mixed into `h`.
+ * \return new hash value.
+ */
+static inline unsigned long long mixHash(unsigned long long h, unsigned long long v)
+{
+	return h ^ (v+0x9e3779b97f4a7c15ull+(h << 6)+(h >> 2));
+}
+
+/**
+ * \param[in] a row coefficient or side.
+ * \return bit pattern of `a`.
+ */
+static inline unsigned long long doubleBits(double a)
+{
+	unsigned long long v;
+	memcpy(&v,&a,sizeof(double));
+	return v;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CCutAging::CCutAging(int maxAge, int maxRowNum)
+{
+	if (!(m_pStat = new tagStat())) {
+		throw new CMemoryException("CCutAging::CCutAging");
+	}
+	m_bOwner=true;
+	m_iMaxAge=m_iAge=(maxAge > 0)? maxAge: 1;
+	m_iMaxRowNum=maxRowNum;
+	m_iTableSize=m_iMaxTableSize=m_iNewTableSize=m_iMaxNewTableSize=0;
+	m_ulpKey=m_ulpNewKey=0;
+	m_ipAge=m_ipNewAge=0;
+	m_iMaxColNum=0;
+	m_dpVal=0;
+	m_ipCol=0;
+} // end of CCutAging::CCutAging()
+
+CCutAging::CCutAging(const CCutAging &other)
+{
+	m_pStat=other.m_pStat;
+	m_bOwner=false;
+	m_iMaxAge=m_iAge=other.m_iMaxAge;
+	m_iMaxRowNum=other.m_iMaxRowNum;
+	m_iTableSize=m_iMaxTableSize=m_iNewTableSize=m_iMaxNewTableSize=0;
+	m_ulpKey=m_ulpNewKey=0;
+	m_ipAge=m_ipNewAge=0;
+	m_iMaxColNum=0;
+	m_dpVal=0;
+	m_ipCol=0;
+} // end of CCutAging::CCutAging(const CCutAging &other)
+
+CCutAging::~CCutAging()
+{
+	if (m_ulpKey)
+		delete[] m_ulpKey;
+	if (m_ipAge)
+		delete[] m_ipAge;
+	if (m_ulpNewKey)
+		delete[] m_ulpNewKey;
+	if (m_ipNewAge)
+		delete[] m_ipNewAge;
+	if (m_dpVal)
+		delete[] m_dpVal;
+	if (m_ipCol)
+		delete[] m_ipCol;
+	if (m_bOwner)
+		delete m_pStat;
+} // end of CCutAging::~CCutAging()
+
+void CCutAging::allocMemForRows(int n)
+{
+	if (n > m_iMaxColNum) {
+		if (m_dpVal)
+			delete[] m_dpVal;
+		if (m_ipCol)
+			delete[] m_ipCol;
+		m_ipCol=0;
+		m_iMaxColNum=0;
+		if (!(m_dpVal = new double[n]) || !(m_ipCol = new int[n])) {
+			throw new CMemoryException("CCutAging::allocMemForRows");
+		}
+		m_iMaxColNum=n;
+	}
+} // end of CCutAging::allocMemForRows()
+
+//////////////////////////////////////////////////////////////////////
+// Aging
+//////////////////////////////////////////////////////////////////////
+unsigned long long CCutAging::hashRow(int sz, const double* dpVal, const int* ipCol, double lhs, double rhs)
+{
+	unsigned long long h=static_cast<unsigned long long>(sz);
+	h=mixHash(h,doubleBits(lhs));
+	h=mixHash(h,doubleBits(rhs));
+	for (int k=0; k < sz; ++k) {
+		h=mixHash(h,static_cast<unsigned long long>(ipCol[k]));
+		h=mixHash(h,doubleBits(dpVal[k]));
+	}
+	return (h)? h: 1;
+} // end of CCutAging::hashRow()
+
+void CCutAging::startRound(int rowNum)
+{
+	int size=64;
+	while (size < (rowNum << 1))
+		size<<=1;
+	if (size > m_iMaxNewTableSize) {
+		if (m_ulpNewKey)
+			delete[] m_ulpNewKey;
+		if (m_ipNewAge)
+			delete[] m_ipNewAge;
+		m_ipNewAge=0;
+		m_iMaxNewTableSize=0;
+		if (!(m_ulpNewKey = new unsigned long long[size]) || !(m_ipNewAge = new int[size])) {
+			throw new CMemoryException("CCutAging::startRound");
+		}
+		m_iMaxNewTableSize=size;
+	}
+	m_iNewTableSize=size;
+	memset(m_ulpNewKey,0,size*sizeof(unsigned long long));
+} // end of CCutAging::startRound()
+
+int CCutAging::update(unsigned long long key, bool binding)
+{
+	int k, age=0;
+	if (!binding && m_iTableSize) {
+		for (k=static_cast<int>(key & (m_iTableSize-1)); m_ulpKey[k]; k=(k+1) & (m_iTableSize-1)) {
+			if (m_ulpKey[k] == key) {
+				age=m_ipAge[k];
+				break;
+			}
+		}
+		++age;
+	}
+	for (k=static_cast<int>(key & (m_iNewTableSize-1)); m_ulpNewKey[k] && m_ulpNewKey[k] != key;
+		k=(k+1) & (m_iNewTableSize-1));
+	m_ulpNewKey[k]=key;
+	m_ipNewAge[k]=age;
+	return age;
+} // end of CCutAging::update()
+
+void CCutAging::finishRound(int rowNum, int evictNum)
+{
+	unsigned long long *ulpKey=m_ulpKey;
+	int *ipAge=m_ipAge, size=m_iMaxTableSize;
+	m_ulpKey=m_ulpNewKey;
+	m_ipAge=m_ipNewAge;
+	m_iTableSize=m_iNewTableSize;
+	m_iMaxTableSize=m_iMaxNewTableSize;
+	m_ulpNewKey=ulpKey;
+	m_ipNewAge=ipAge;
+	m_iMaxNewTableSize=size;
+	if (rowNum > m_iMaxRowNum) {
+		if ((m_iAge >>= 1) < 1)
+			m_iAge=1;
+	}
+	else if ((rowNum << 1) < m_iMaxRowNum && m_iAge < m_iMaxAge)
+		++m_iAge;
+	m_pStat->roundNum.fetch_add(1,std::memory_order_relaxed);
+	m_pStat->evictNum.fetch_add(evictNum,std::memory_order_relaxed);
+	for (int k=m_pStat->maxRowNum.load(std::memory_order_relaxed); rowNum > k &&
+		!m_pStat->maxRowNum.compare_exchange_weak(k,rowNum,std::memory_order_relaxed););
+} // end of CCutAging::finishRound()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CCutAging::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	out << "Cut aging\n";
+	out << "===== Rounds ==== Evicted == Max.cuts in LP\n";
+	sprintf(str,"%12d %11d %16d\n",m_pStat->roundNum.load(std::memory_order_relaxed),
+		m_pStat->evictNum.load(std::memory_order_relaxed),m_pStat->maxRowNum.load(std::memory_order_relaxed));
+	out << str << std::endl;
+} // end of CCutAging::printStatistics()
@@ -0,0 +1,366 @@
+// CutPool.cpp: implementation of the CCutPool class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cmath>
+#include <except.h>
+#include <lp.h>
+#include <Sort.h>
+#include "CutPool.h"
+
+#define CUTPOOL_EPS 1.0e-9 ///< two normalized coefficients are equal if they differ by less than `CUTPOOL_EPS`.
+
+/**
+ * \param[in] h hash value;
+ * \param[in] v value to be mixed into `h`.
+ * \return new hash value.
+ */
+static inline unsigned long long mixHash(unsigned long long h, unsigned long long v)
+{
+	return h ^ (v+0x9e3779b97f4a7c15ull+(h << 6)+(h >> 2));
+}
+
+/**
+ * \param[in] a normalized coefficient or side of a cut.
+ * \return `a` rounded to a multiple of `CUTPOOL_EPS`.
+ */
+static inline unsigned long long quantize(double a)
+{
+	if (a <= -CLP::INF)
+		return 0x7ff0000000000001ull;
+	if (a >= CLP::INF)
+		return 0x7ff0000000000002ull;
+	if (fabs(a) >= 1.0e9) { // rounding would overflow
+		unsigned long long u;
+		memcpy(&u,&a,sizeof(double));
+		return u;
+	}
+	return static_cast<unsigned long long>(static_cast<long long>(floor(a/CUTPOOL_EPS+0.5)));
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CCutPool::CCutPool(int threadNum)
+{
+	m_iThreadNum=threadNum;
+	m_iHdNum=0;
+	m_iCutNum=m_iMaxCutNum=m_iNZ=m_iMaxNZ=0;
+	m_dpB=m_dpVal=0;
+	m_ipBeg=m_ipHd=0;
+	m_ulpHash=0;
+	m_cpViolated=0;
+	m_iTableSize=0;
+	m_ipTable=0;
+	m_ipInd=0;
+	m_dpX=0;
+	m_dTol=0.0;
+	m_iNextBatch=0;
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+	_MUTEX_INIT(m_batchMutex)
+#endif
+} // end of CCutPool::CCutPool()
+
+CCutPool::~CCutPool()
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+	_MUTEX_DESTROY(m_batchMutex)
+#endif
+	if (m_dpB) {
+		delete[] m_dpB;
+		delete[] m_ipBeg;
+		delete[] m_ulpHash;
+		delete[] m_cpViolated;
+	}
+	if (m_dpVal) {
+		delete[] m_dpVal;
+		delete[] m_ipHd;
+	}
+	if (m_ipTable)
+		delete[] m_ipTable;
+	if (m_ipInd)
+		delete[] m_ipInd;
+} // end of CCutPool::~CCutPool()
+
+void CCutPool::reset(int hdNum)
+{
+	m_iCutNum=m_iNZ=0;
+	if (hdNum > m_iHdNum) {
+		if (m_ipInd)
+			delete[] m_ipInd;
+		m_ipInd=0;
+		if (!(m_ipInd = new int[hdNum])) {
+			throw new CMemoryException("CCutPool::reset");
+		}
+	}
+	m_iHdNum=hdNum;
+	allocMem(1024,16*1024);
+	if (m_iTableSize)
+		memset(m_ipTable,0xff,m_iTableSize*sizeof(int));
+	else
+		rehash(2048);
+} // end of CCutPool::reset()
+
+void CCutPool::allocMem(int cutNum, int nz)
+{
+	if (cutNum > m_iMaxCutNum) {
+		double *dpB;
+		int *ipBeg;
+		unsigned long long *ulpHash;
+		char *cpViolated;
+		if (cutNum < (m_iMaxCutNum << 1))
+			cutNum=m_iMaxCutNum << 1;
+		if (!(dpB = new double[cutNum<<1]) || !(ipBeg = new int[cutNum+1]) ||
+			!(ulpHash = new unsigned long long[cutNum]) || !(cpViolated = new char[cutNum])) {
+			throw new CMemoryException("CCutPool::allocMem");
+		}
+		if (m_dpB) {
+			memcpy(dpB,m_dpB,(m_iCutNum<<1)*sizeof(double));
+			memcpy(ipBeg,m_ipBeg,(m_iCutNum+1)*sizeof(int));
+			memcpy(ulpHash,m_ulpHash,m_iCutNum*sizeof(unsigned long long));
+			delete[] m_dpB;
+			delete[] m_ipBeg;
+			delete[] m_ulpHash;
+			delete[] m_cpViolated;
+		}
+		else
+			ipBeg[0]=0;
+		m_dpB=dpB;
+		m_ipBeg=ipBeg;
+		m_ulpHash=ulpHash;
+		m_cpViolated=cpViolated;
+		m_iMaxCutNum=cutNum;
+	}
+	if (nz > m_iMaxNZ) {
+		double *dpVal;
+		int *ipHd;
+		if (nz < (m_iMaxNZ << 1))
+			nz=m_iMaxNZ << 1;
+		if (!(dpVal = new double[nz]) || !(ipHd = new int[nz])) {
+			throw new CMemoryException("CCutPool::allocMem");
+		}
+		if (m_dpVal) {
+			memcpy(dpVal,m_dpVal,m_iNZ*sizeof(double));
+			memcpy(ipHd,m_ipHd,m_iNZ*sizeof(int));
+			delete[] m_dpVal;
+			delete[] m_ipHd;
+		}
+		m_dpVal=dpVal;
+		m_ipHd=ipHd;
+		m_iMaxNZ=nz;
+	}
+} // end of CCutPool::allocMem()
+
+//////////////////////////////////////////////////////////////////////
+// Hashing
+//////////////////////////////////////////////////////////////////////
+unsigned long long CCutPool::hash(int i) const
+{
+	unsigned long long h=static_cast<unsigned long long>(m_ipBeg[i+1]-m_ipBeg[i]);
+	h=mixHash(h,quantize(m_dpB[i<<1]));
+	h=mixHash(h,quantize(m_dpB[(i<<1)+1]));
+	for (int k=m_ipBeg[i]; k < m_ipBeg[i+1]; ++k) {
+		h=mixHash(h,static_cast<unsigned long long>(m_ipHd[k]));
+		h=mixHash(h,quantize(m_dpVal[k]));
+	}
+	return h;
+} // end of CCutPool::hash()
+
+bool CCutPool::isEqual(int i, int k) const
+{
+	int t=m_ipBeg[i], s=m_ipBeg[k], sz=m_ipBeg[i+1]-t;
+	if (m_ulpHash[i] != m_ulpHash[k] || sz != m_ipBeg[k+1]-s)
+		return false;
+	for (int r=0; r < 2; ++r) {
+		double b1=m_dpB[(i<<1)+r], b2=m_dpB[(k<<1)+r];
+		if (b1 != b2 && fabs(b1-b2) >= CUTPOOL_EPS)
+			return false;
+	}
+	for (int q=0; q < sz; ++q) {
+		if (m_ipHd[t+q] != m_ipHd[s+q] || fabs(m_dpVal[t+q]-m_dpVal[s+q]) >= CUTPOOL_EPS)
+			return false;
+	}
+	return true;
+} // end of CCutPool::isEqual()
+
+void CCutPool::rehash(int tableSize)
+{
+	int *ipTable, mask=tableSize-1;
+	if (!(ipTable = new int[tableSize])) {
+		throw new CMemoryException("CCutPool::rehash");
+	}
+	memset(ipTable,0xff,tableSize*sizeof(int));
+	for (int i=0; i < m_iCutNum; ++i) {
+		int k=static_cast<int>(m_ulpHash[i]) & mask;
+		while (ipTable[k] >= 0)
+			k=(k+1) & mask;
+		ipTable[k]=i;
+	}
+	if (m_ipTable)
+		delete[] m_ipTable;
+	m_ipTable=ipTable;
+	m_iTableSize=tableSize;
+} // end of CCutPool::rehash()
+
+bool CCutPool::add(double b1, double b2, int sz, const double* dpVal, const int* ipHd)
+{
+	int i, k, mask, nz;
+	double w, a=0.0;
+	for (k=0; k < sz; ++k) {
+		if (ipHd[k] < 0 || ipHd[k] >= m_iHdNum)
+			return false; // cut has a variable that cannot be evaluated
+		if (a < (w=fabs(dpVal[k])))
+			a=w;
+	}
+	if (a == 0.0)
+		return false;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	try {
+		allocMem(m_iCutNum+1,m_iNZ+sz);
+		if ((m_iCutNum+1) << 1 > m_iTableSize)
+			rehash(m_iTableSize << 1);
+	}
+	catch(CMemoryException* pe) {
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+		throw pe;
+	}
+// write normalized cut as cut `m_iCutNum`
+	i=m_iCutNum;
+	for (k=0; k < sz; ++k) {
+		m_ipInd[k]=k;
+	}
+	SORT::incSortInt(sz,m_ipInd,ipHd);
+	nz=m_iNZ;
+	for (k=0; k < sz; ++k) {
+		m_ipHd[nz]=ipHd[m_ipInd[k]];
+		m_dpVal[nz++]=dpVal[m_ipInd[k]]/a;
+	}
+	m_ipBeg[i+1]=nz;
+	m_dpB[i<<1]=(b1 > -CLP::INF)? b1/a: -CLP::INF;
+	m_dpB[(i<<1)+1]=(b2 < CLP::INF)? b2/a: CLP::INF;
+	m_ulpHash[i]=hash(i);
+
+	mask=m_iTableSize-1;
+	for (k=static_cast<int>(m_ulpHash[i]) & mask; m_ipTable[k] >= 0; k=(k+1) & mask) {
+		if (isEqual(m_ipTable[k],i)) { // duplicate
+#ifndef __ONE_THREAD_
+			_MUTEX_UNLOCK(&m_mutex)
+#endif
+			return false;
+		}
+	}
+	m_ipTable[k]=i;
+	m_iNZ=nz;
+	++m_iCutNum;
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return true;
+} // end of CCutPool::add()
+
+//////////////////////////////////////////////////////////////////////
+// Separation
+//////////////////////////////////////////////////////////////////////
+void CCutPool::checkBatches()
+{
+	const double *dpX=m_dpX;
+	double s, tol=m_dTol;
+	int b, i, i2, batchNum=(m_iCutNum+CUTPOOL_BATCH-1)/CUTPOOL_BATCH;
+	for (;;) {
+#ifndef __ONE_THREAD_
+		_MUTEX_LOCK(&m_batchMutex)
+#endif
+		b=(m_iNextBatch < batchNum)? m_iNextBatch++: -1;
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_batchMutex)
+#endif
+		if (b < 0)
+			break;
+		i2=(b+1)*CUTPOOL_BATCH;
+		if (i2 > m_iCutNum)
+			i2=m_iCutNum;
+		for (i=b*CUTPOOL_BATCH; i < i2; ++i) {
+			const double *dpVal=m_dpVal;
+			const int *ipHd=m_ipHd;
+			s=0.0;
+			for (int k=m_ipBeg[i]; k < m_ipBeg[i+1]; ++k) {
+				s+=dpVal[k]*dpX[ipHd[k]];
+			}
+			m_cpViolated[i]=(s > m_dpB[(i<<1)+1]+tol || s < m_dpB[i<<1]-tol)? 1: 0;
+		}
+	}
+} // end of CCutPool::checkBatches()
+
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CCutPool::startThread(void* param)
+#else
+void* CCutPool::startThread(void* param)
+#endif
+{
+	static_cast<CCutPool*>(param)->checkBatches();
+	return 0;
+} // end of CCutPool::startThread()
+#endif
+
+int CCutPool::separate(const double* dpX, int threadNum, double tol,
+	void (*sendCut)(void* param, double b1, double b2, int sz, const double* dpVal, const int* ipHd), void* param)
+{
+	int cutNum=0;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	m_dpX=dpX;
+	m_dTol=tol;
+	m_iNextBatch=0;
+	try {
+#ifndef __ONE_THREAD_
+		if (m_iNZ < CUTPOOL_PAR_NZ)
+			threadNum=1;
+		else if (threadNum > (m_iCutNum+CUTPOOL_BATCH-1)/CUTPOOL_BATCH)
+			threadNum=(m_iCutNum+CUTPOOL_BATCH-1)/CUTPOOL_BATCH;
+		if (threadNum > 1) {
+			_THREAD* pThreads;
+			if (!(pThreads = new _THREAD[--threadNum])) {
+				throw new CMemoryException("CCutPool::separate");
+			}
+			for (int t=0; t < threadNum; ++t) {
+				_THREAD_CREATE(pThreads[t],startThread,this)
+			}
+			checkBatches();
+			for (int t=0; t < threadNum; ++t) {
+				_THREAD_JOIN(pThreads[t])
+				_THREAD_CLOSE(pThreads[t])
+			}
+			delete[] pThreads;
+		}
+		else
+#endif
+		checkBatches();
+
+		for (int i=0; i < m_iCutNum; ++i) {
+			if (m_cpViolated[i]) {
+				if (sendCut)
+					(*sendCut)(param,m_dpB[i<<1],m_dpB[(i<<1)+1],m_ipBeg[i+1]-m_ipBeg[i],
+						m_dpVal+m_ipBeg[i],m_ipHd+m_ipBeg[i]);
+				++cutNum;
+			}
+		}
+	}
+	catch(CMemoryException* pe) {
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+		throw pe;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return cutNum;
+} // end of CCutPool::separate()
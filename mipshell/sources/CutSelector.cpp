@@ -0,0 +1,310 @@
+// CutSelector.cpp: implementation of the CCutSelector class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cmath>
+#include <cstdio>
+#include <except.h>
+#include <lp.h>
+#include "CutSelector.h"
+
+#define CUTSEL_EPS 1.0e-6 ///< cuts which efficacy is not greater than `CUTSEL_EPS` are never selected.
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CCutSelector::CCutSelector(double effWeight, double orthoWeight, double parWeight, double minOrtho, int maxCutNum)
+{
+	m_bOwner=true;
+	m_dEffWeight=effWeight;
+	m_dOrthoWeight=orthoWeight;
+	m_dParWeight=parWeight;
+	m_dMinOrtho=minOrtho;
+	m_iMaxCutNum=maxCutNum;
+	m_iHdNum=0;
+	m_dpC=0;
+	m_dCNorm=0.0;
+	if (!(m_ipGenerated = new std::atomic<int>[CUT_FAMILY_NUM<<1])) {
+		throw new CMemoryException("CCutSelector::CCutSelector");
+	}
+	m_ipAccepted=m_ipGenerated+CUT_FAMILY_NUM;
+	for (int f=0; f < (CUT_FAMILY_NUM<<1); ++f) {
+		m_ipGenerated[f].store(0);
+	}
+	m_iCandNum=m_iMaxCandNum=m_iNZ=m_iMaxNZ=m_iSelectedNum=0;
+	m_dpB=m_dpVal=m_dpEff=m_dpNorm=m_dpScore=m_dpOrtho=m_dpDense=0;
+	m_ipBeg=m_ipHd=m_ipFamily=m_ipSelected=0;
+	m_ipType=0;
+} // end of CCutSelector::CCutSelector()
+
+CCutSelector::CCutSelector(const CCutSelector &other)
+{
+	m_bOwner=false;
+	m_dEffWeight=other.m_dEffWeight;
+	m_dOrthoWeight=other.m_dOrthoWeight;
+	m_dParWeight=other.m_dParWeight;
+	m_dMinOrtho=other.m_dMinOrtho;
+	m_iMaxCutNum=other.m_iMaxCutNum;
+	m_iHdNum=other.m_iHdNum;
+	m_dpC=other.m_dpC;
+	m_dCNorm=other.m_dCNorm;
+	m_ipGenerated=other.m_ipGenerated;
+	m_ipAccepted=other.m_ipAccepted;
+	m_iCandNum=m_iMaxCandNum=m_iNZ=m_iMaxNZ=m_iSelectedNum=0;
+	m_dpB=m_dpVal=m_dpEff=m_dpNorm=m_dpScore=m_dpOrtho=m_dpDense=0;
+	m_ipBeg=m_ipHd=m_ipFamily=m_ipSelected=0;
+	m_ipType=0;
+} // end of CCutSelector::CCutSelector(const CCutSelector &other)
+
+CCutSelector::~CCutSelector()
+{
+	if (m_bOwner) {
+		if (m_dpC)
+			delete[] m_dpC;
+		delete[] m_ipGenerated;
+	}
+	if (m_dpB) {
+		delete[] m_dpB;
+		delete[] m_ipBeg;
+	}
+	if (m_dpVal) {
+		delete[] m_dpVal;
+		delete[] m_ipHd;
+	}
+	if (m_dpDense)
+		delete[] m_dpDense;
+} // end of CCutSelector::~CCutSelector()
+
+void CCutSelector::allocMem(int candNum, int nz)
+{
+	if (candNum > m_iMaxCandNum) {
+		double *dpB;
+		int *ipBeg;
+		if (candNum < (m_iMaxCandNum << 1))
+			candNum=m_iMaxCandNum << 1;
+		if (!(dpB = new double[6*candNum]) || !(ipBeg = new int[5*candNum+1])) {
+			throw new CMemoryException("CCutSelector::allocMem");
+		}
+		if (m_dpB) {
+			memcpy(dpB,m_dpB,(m_iCandNum<<1)*sizeof(double));
+			memcpy(ipBeg,m_ipBeg,(m_iCandNum+1)*sizeof(int));
+			memcpy(ipBeg+candNum+1,m_ipType,m_iCandNum*sizeof(int));
+			memcpy(ipBeg+2*candNum+1,m_ipFamily,m_iCandNum*sizeof(int));
+			delete[] m_dpB;
+			delete[] m_ipBeg;
+		}
+		else
+			ipBeg[0]=0;
+		m_dpB=dpB;
+		m_dpEff=dpB+(candNum<<1);
+		m_dpNorm=m_dpEff+candNum;
+		m_dpScore=m_dpNorm+candNum;
+		m_dpOrtho=m_dpScore+candNum;
+		m_ipBeg=ipBeg;
+		m_ipType=reinterpret_cast<unsigned*>(ipBeg+candNum+1);
+		m_ipFamily=ipBeg+2*candNum+1;
+		m_ipSelected=m_ipFamily+candNum;
+		m_iMaxCandNum=candNum;
+	}
+	if (nz > m_iMaxNZ) {
+		double *dpVal;
+		int *ipHd;
+		if (nz < (m_iMaxNZ << 1))
+			nz=m_iMaxNZ << 1;
+		if (!(dpVal = new double[nz]) || !(ipHd = new int[nz])) {
+			throw new CMemoryException("CCutSelector::allocMem");
+		}
+		if (m_dpVal) {
+			memcpy(dpVal,m_dpVal,m_iNZ*sizeof(double));
+			memcpy(ipHd,m_ipHd,m_iNZ*sizeof(int));
+			delete[] m_dpVal;
+			delete[] m_ipHd;
+		}
+		m_dpVal=dpVal;
+		m_ipHd=ipHd;
+		m_iMaxNZ=nz;
+	}
+} // end of CCutSelector::allocMem()
+
+void CCutSelector::allocMemForDense()
+{
+	if (!(m_dpDense = new double[m_iHdNum+1])) {
+		throw new CMemoryException("CCutSelector::allocMemForDense");
+	}
+	memset(m_dpDense,0,(m_iHdNum+1)*sizeof(double));
+} // end of CCutSelector::allocMemForDense()
+
+void CCutSelector::setObjective(int hdNum, const double* dpC)
+{
+	if (m_dpC)
+		delete[] m_dpC;
+	if (m_dpDense)
+		delete[] m_dpDense;
+	m_dpC=m_dpDense=0;
+	if (!(m_dpC = new double[hdNum+1])) {
+		throw new CMemoryException("CCutSelector::setObjective");
+	}
+	m_iHdNum=hdNum;
+	memcpy(m_dpC,dpC,hdNum*sizeof(double));
+	m_dCNorm=0.0;
+	for (int j=0; j < hdNum; ++j) {
+		m_dCNorm+=dpC[j]*dpC[j];
+	}
+	m_dCNorm=sqrt(m_dCNorm);
+	for (int f=0; f < (CUT_FAMILY_NUM<<1); ++f) {
+		m_ipGenerated[f].store(0);
+	}
+	clear();
+} // end of CCutSelector::setObjective()
+
+//////////////////////////////////////////////////////////////////////
+// Selection
+//////////////////////////////////////////////////////////////////////
+bool CCutSelector::addCand(int family, unsigned type, double b1, double b2, int sz, const double* dpVal, const int* ipHd)
+{
+	for (int k=0; k < sz; ++k) {
+		if (ipHd[k] < 0 || ipHd[k] >= m_iHdNum)
+			return false;
+	}
+	allocMem(m_iCandNum+1,m_iNZ+sz);
+	int i=m_iCandNum++;
+	memcpy(m_dpVal+m_iNZ,dpVal,sz*sizeof(double));
+	memcpy(m_ipHd+m_iNZ,ipHd,sz*sizeof(int));
+	m_ipBeg[i+1]=(m_iNZ+=sz);
+	m_dpB[i<<1]=b1;
+	m_dpB[(i<<1)+1]=b2;
+	m_ipType[i]=type;
+	m_ipFamily[i]=family;
+	m_ipGenerated[family].fetch_add(1,std::memory_order_relaxed);
+	return true;
+} // end of CCutSelector::addCand()
+
+int CCutSelector::merge(const CCutSelector &other)
+{
+	int i, nz=m_iNZ;
+	allocMem(m_iCandNum+other.m_iCandNum,m_iNZ+other.m_iNZ);
+	memcpy(m_dpVal+m_iNZ,other.m_dpVal,other.m_iNZ*sizeof(double));
+	memcpy(m_ipHd+m_iNZ,other.m_ipHd,other.m_iNZ*sizeof(int));
+	m_iNZ+=other.m_iNZ;
+	for (int k=0; k < other.m_iCandNum; ++k) {
+		i=m_iCandNum++;
+		m_ipBeg[i+1]=nz+other.m_ipBeg[k+1];
+		m_dpB[i<<1]=other.m_dpB[k<<1];
+		m_dpB[(i<<1)+1]=other.m_dpB[(k<<1)+1];
+		m_ipType[i]=other.m_ipType[k];
+		m_ipFamily[i]=other.m_ipFamily[k];
+	}
+	return other.m_iCandNum;
+} // end of CCutSelector::merge()
+
+int CCutSelector::select(const double* dpX)
+{
+	int i, k, best;
+	double s, a, w, maxEff=0.0, bestScore;
+	if (!m_dpDense)
+		allocMemForDense();
+// compute efficacies, norms, and parallelisms
+	for (i=0; i < m_iCandNum; ++i) {
+		s=a=w=0.0;
+		for (k=m_ipBeg[i]; k < m_ipBeg[i+1]; ++k) {
+			s+=m_dpVal[k]*dpX[m_ipHd[k]];
+			a+=m_dpVal[k]*m_dpVal[k];
+			w+=m_dpVal[k]*m_dpC[m_ipHd[k]];
+		}
+		if ((a=sqrt(a)) < CUTSEL_EPS) {
+			m_dpEff[i]=0.0;
+			continue;
+		}
+		m_dpNorm[i]=a;
+		if (s > m_dpB[(i<<1)+1])
+			m_dpEff[i]=(s-m_dpB[(i<<1)+1])/a;
+		else if (s < m_dpB[i<<1])
+			m_dpEff[i]=(m_dpB[i<<1]-s)/a;
+		else
+			m_dpEff[i]=0.0;
+		if (maxEff < m_dpEff[i])
+			maxEff=m_dpEff[i];
+		m_dpScore[i]=(m_dCNorm > 0.0)? m_dParWeight*fabs(w)/(a*m_dCNorm): 0.0;
+	}
+// greedy selection
+	double *dpOrtho=m_dpOrtho;
+	m_iSelectedNum=0;
+	if (maxEff <= CUTSEL_EPS)
+		return 0;
+	for (i=0; i < m_iCandNum; ++i) {
+		dpOrtho[i]=(m_dpEff[i] > CUTSEL_EPS)? 1.0: -1.0; // negative orthogonality means the candidate is dropped
+	}
+	for (;;) {
+		if (m_iMaxCutNum && m_iSelectedNum >= m_iMaxCutNum)
+			break;
+		best=-1;
+		bestScore=-1.0;
+		for (i=0; i < m_iCandNum; ++i) {
+			if (dpOrtho[i] < m_dMinOrtho)
+				continue;
+			s=m_dEffWeight*m_dpEff[i]/maxEff+m_dpScore[i]+m_dOrthoWeight*dpOrtho[i];
+			if (s > bestScore) {
+				bestScore=s;
+				best=i;
+			}
+		}
+		if (best < 0)
+			break;
+		m_ipSelected[m_iSelectedNum++]=best;
+		m_ipAccepted[m_ipFamily[best]].fetch_add(1,std::memory_order_relaxed);
+		dpOrtho[best]=-1.0;
+	// update orthogonalities
+		a=m_dpNorm[best];
+		for (k=m_ipBeg[best]; k < m_ipBeg[best+1]; ++k) {
+			m_dpDense[m_ipHd[k]]+=m_dpVal[k]/a;
+		}
+		for (i=0; i < m_iCandNum; ++i) {
+			if (dpOrtho[i] < m_dMinOrtho)
+				continue;
+			s=0.0;
+			for (k=m_ipBeg[i]; k < m_ipBeg[i+1]; ++k) {
+				s+=m_dpVal[k]*m_dpDense[m_ipHd[k]];
+			}
+			if ((w=1.0-fabs(s)/m_dpNorm[i]) < dpOrtho[i])
+				dpOrtho[i]=w;
+		}
+		for (k=m_ipBeg[best]; k < m_ipBeg[best+1]; ++k) {
+			m_dpDense[m_ipHd[k]]=0.0;
+		}
+	}
+	return m_iSelectedNum;
+} // end of CCutSelector::select()
+
+int CCutSelector::getSelected(int k, unsigned &type, double &b1, double &b2, const double* &dpVal, const int* &ipHd) const
+{
+	int i=m_ipSelected[k];
+	type=m_ipType[i];
+	b1=m_dpB[i<<1];
+	b2=m_dpB[(i<<1)+1];
+	dpVal=m_dpVal+m_ipBeg[i];
+	ipHd=m_ipHd+m_ipBeg[i];
+	return m_ipBeg[i+1]-m_ipBeg[i];
+} // end of CCutSelector::getSelected()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CCutSelector::printStatistics(std::ostream &out) const
+{
+	static const char* familyName[CUT_FAMILY_NUM]={"separate","gencut","pool","separators","lift&project"};
+	char str[128];
+	int gen, acc, totalGen=0, totalAcc=0;
+	out << "MIPshell cut selection\n";
+	out << "========== Cuts = Generated = Accepted === Rate%\n";
+	for (int f=0; f < CUT_FAMILY_NUM; ++f) {
+		if (!(gen=m_ipGenerated[f].load(std::memory_order_relaxed)))
+			continue;
+		acc=m_ipAccepted[f].load(std::memory_order_relaxed);
+		sprintf(str,"%15s %11d %10d %10.2f\n",familyName[f],gen,acc,100.0*acc/gen);
+		out << str;
+		totalGen+=gen;
+		totalAcc+=acc;
+	}
+	sprintf(str,"========= total %11d %10d %10.2f\n",totalGen,totalAcc,(totalGen)? 100.0*totalAcc/totalGen: 0.0);
+	out << str << std::endl;
+} // end of CCutSelector::printStatistics()
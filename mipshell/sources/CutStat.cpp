@@ -0,0 +1,262 @@
+// CutStat.cpp: implementation of the CCutStat class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <except.h>
+#include "CutStat.h"
+
+static const int ageCheckpoint[CUTSTAT_AGE_NUM]={1,10,100}; ///< ages at which surviving cuts are counted.
+
+CCutStat::tagStat::tagStat()
+{
+	roundNum=0;
+	for (int f=0; f < CUTSTAT_NUM; ++f) {
+		lpTime[f]=0;
+		callNum[f]=cutNum[f]=0;
+		gain[f]=0.0;
+		for (int k=0; k < CUTSTAT_AGE_NUM; ++k) {
+			aliveNum[f][k]=0;
+		}
+	}
+} // end of CCutStat::tagStat::tagStat()
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CCutStat::CCutStat()
+{
+	if (!(m_pStat = new tagStat())) {
+		throw new CMemoryException("CCutStat::CCutStat");
+	}
+	m_bOwner=true;
+	m_iNode=-1;
+	m_bSameNode=false;
+	m_dObj=0.0;
+	memset(m_ipRoundCutNum,0,CUTSTAT_NUM*sizeof(int));
+	m_iTableSize=m_iMaxTableSize=m_iKeyNum=m_iNewTableSize=m_iMaxNewTableSize=0;
+	m_ulpKey=m_ulpNewKey=0;
+	m_ipInfo=m_ipNewInfo=0;
+	m_iMaxColNum=0;
+	m_dpVal=0;
+	m_ipCol=0;
+} // end of CCutStat::CCutStat()
+
+CCutStat::CCutStat(const CCutStat &other)
+{
+	m_pStat=other.m_pStat;
+	m_bOwner=false;
+	m_iNode=-1;
+	m_bSameNode=false;
+	m_dObj=0.0;
+	memset(m_ipRoundCutNum,0,CUTSTAT_NUM*sizeof(int));
+	m_iTableSize=m_iMaxTableSize=m_iKeyNum=m_iNewTableSize=m_iMaxNewTableSize=0;
+	m_ulpKey=m_ulpNewKey=0;
+	m_ipInfo=m_ipNewInfo=0;
+	m_iMaxColNum=0;
+	m_dpVal=0;
+	m_ipCol=0;
+} // end of CCutStat::CCutStat(const CCutStat &other)
+
+CCutStat::~CCutStat()
+{
+	if (m_ulpKey)
+		delete[] m_ulpKey;
+	if (m_ipInfo)
+		delete[] m_ipInfo;
+	if (m_ulpNewKey)
+		delete[] m_ulpNewKey;
+	if (m_ipNewInfo)
+		delete[] m_ipNewInfo;
+	if (m_dpVal)
+		delete[] m_dpVal;
+	if (m_ipCol)
+		delete[] m_ipCol;
+	if (m_bOwner)
+		delete m_pStat;
+} // end of CCutStat::~CCutStat()
+
+void CCutStat::allocMemForRows(int n)
+{
+	if (n > m_iMaxColNum) {
+		if (m_dpVal)
+			delete[] m_dpVal;
+		if (m_ipCol)
+			delete[] m_ipCol;
+		m_ipCol=0;
+		m_iMaxColNum=0;
+		if (!(m_dpVal = new double[n]) || !(m_ipCol = new int[n])) {
+			throw new CMemoryException("CCutStat::allocMemForRows");
+		}
+		m_iMaxColNum=n;
+	}
+} // end of CCutStat::allocMemForRows()
+
+void CCutStat::allocNewTable(int size)
+{
+	if (size > m_iMaxNewTableSize) {
+		if (m_ulpNewKey)
+			delete[] m_ulpNewKey;
+		if (m_ipNewInfo)
+			delete[] m_ipNewInfo;
+		m_ipNewInfo=0;
+		m_iMaxNewTableSize=0;
+		if (!(m_ulpNewKey = new unsigned long long[size]) || !(m_ipNewInfo = new int[size])) {
+			throw new CMemoryException("CCutStat::allocNewTable");
+		}
+		m_iMaxNewTableSize=size;
+	}
+	m_iNewTableSize=size;
+	memset(m_ulpNewKey,0,size*sizeof(unsigned long long));
+} // end of CCutStat::allocNewTable()
+
+void CCutStat::swapTables()
+{
+	unsigned long long *ulpKey=m_ulpKey;
+	int *ipInfo=m_ipInfo, size=m_iMaxTableSize;
+	m_ulpKey=m_ulpNewKey;
+	m_ipInfo=m_ipNewInfo;
+	m_iTableSize=m_iNewTableSize;
+	m_iMaxTableSize=m_iMaxNewTableSize;
+	m_ulpNewKey=ulpKey;
+	m_ipNewInfo=ipInfo;
+	m_iMaxNewTableSize=size;
+} // end of CCutStat::swapTables()
+
+//////////////////////////////////////////////////////////////////////
+// Rounds
+//////////////////////////////////////////////////////////////////////
+void CCutStat::startRound(int node, int rowNum)
+{
+	int size=64;
+	while (size < (rowNum << 1))
+		size<<=1;
+	allocNewTable(size);
+	m_iKeyNum=0;
+	m_bSameNode=(node == m_iNode)? true: false;
+	m_iNode=node;
+} // end of CCutStat::startRound()
+
+void CCutStat::update(unsigned long long key)
+{
+	int k, t, age, family=(m_bSameNode)? CUTSTAT_AUTO: CUTSTAT_NONE, info=-1;
+	for (t=static_cast<int>(key & (m_iNewTableSize-1)); m_ulpNewKey[t]; t=(t+1) & (m_iNewTableSize-1)) {
+		if (m_ulpNewKey[t] == key)
+			return; // the LP holds several copies of the cut
+	}
+	if (m_iTableSize) {
+		for (k=static_cast<int>(key & (m_iTableSize-1)); m_ulpKey[k]; k=(k+1) & (m_iTableSize-1)) {
+			if (m_ulpKey[k] == key) {
+				info=m_ipInfo[k];
+				break;
+			}
+		}
+	}
+	if (info >= 0) {
+		family=info & 0xF;
+		age=(info >> 4)+1;
+	}
+	else {
+		age=1;
+		if (family == CUTSTAT_AUTO) {
+			++m_ipRoundCutNum[CUTSTAT_AUTO];
+			m_pStat->cutNum[CUTSTAT_AUTO].fetch_add(1,std::memory_order_relaxed);
+		}
+	}
+	if (family != CUTSTAT_NONE) {
+		for (k=0; k < CUTSTAT_AGE_NUM; ++k) {
+			if (age == ageCheckpoint[k]) {
+				m_pStat->aliveNum[family][k].fetch_add(1,std::memory_order_relaxed);
+				break;
+			}
+		}
+	}
+	if (age > ageCheckpoint[CUTSTAT_AGE_NUM-1])
+		age=ageCheckpoint[CUTSTAT_AGE_NUM-1]; // the cut has passed all checkpoints
+	++m_iKeyNum;
+	m_ulpNewKey[t]=key;
+	m_ipNewInfo[t]=(age << 4) | family;
+} // end of CCutStat::update()
+
+void CCutStat::finishRound(double obj)
+{
+	int f, cutNum=0;
+	double gain;
+	swapTables();
+	if (m_bSameNode && (gain=m_dObj-obj) > 0.0) {
+		for (f=0; f < CUTSTAT_NUM; ++f) {
+			cutNum+=m_ipRoundCutNum[f];
+		}
+		if (cutNum) {
+			gain/=cutNum;
+			for (f=0; f < CUTSTAT_NUM; ++f) {
+				if (m_ipRoundCutNum[f]) {
+					double g=m_pStat->gain[f].load(std::memory_order_relaxed);
+					while (!m_pStat->gain[f].compare_exchange_weak(g,g+gain*m_ipRoundCutNum[f],std::memory_order_relaxed));
+				}
+			}
+		}
+	}
+	m_dObj=obj;
+	memset(m_ipRoundCutNum,0,CUTSTAT_NUM*sizeof(int));
+	m_pStat->roundNum.fetch_add(1,std::memory_order_relaxed);
+} // end of CCutStat::finishRound()
+
+void CCutStat::addCut(unsigned long long key, int family)
+{
+	int k;
+	if (((m_iKeyNum+1) << 1) > m_iTableSize) {
+		allocNewTable((m_iTableSize)? (m_iTableSize << 1): 64);
+		for (int t=0; t < m_iTableSize; ++t) {
+			if (m_ulpKey[t]) {
+				for (k=static_cast<int>(m_ulpKey[t] & (m_iNewTableSize-1)); m_ulpNewKey[k]; k=(k+1) & (m_iNewTableSize-1));
+				m_ulpNewKey[k]=m_ulpKey[t];
+				m_ipNewInfo[k]=m_ipInfo[t];
+			}
+		}
+		swapTables();
+	}
+	for (k=static_cast<int>(key & (m_iTableSize-1)); m_ulpKey[k] && m_ulpKey[k] != key; k=(k+1) & (m_iTableSize-1));
+	if (!m_ulpKey[k])
+		++m_iKeyNum;
+	m_ulpKey[k]=key;
+	m_ipInfo[k]=family; // age is 0
+	++m_ipRoundCutNum[family];
+	m_pStat->cutNum[family].fetch_add(1,std::memory_order_relaxed);
+} // end of CCutStat::addCut()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CCutStat::getStat(int family, tagCutFamilyStat& stat) const
+{
+	stat.time=1.0e-6*static_cast<double>(m_pStat->lpTime[family].load(std::memory_order_relaxed));
+	stat.callNum=m_pStat->callNum[family].load(std::memory_order_relaxed);
+	stat.cutNum=m_pStat->cutNum[family].load(std::memory_order_relaxed);
+	stat.boundGain=m_pStat->gain[family].load(std::memory_order_relaxed);
+	for (int k=0; k < CUTSTAT_AGE_NUM; ++k) {
+		stat.aliveNum[k]=m_pStat->aliveNum[family][k].load(std::memory_order_relaxed);
+	}
+} // end of CCutStat::getStat()
+
+void CCutStat::printStatistics(std::ostream &out) const
+{
+	static const char* familyName[CUTSTAT_NUM]={"separate","gencut","pool","separators","lift&project","auto"};
+	char str[128];
+	tagCutFamilyStat stat;
+	out << "Cut families (" << m_pStat->roundNum.load(std::memory_order_relaxed) << " rounds)\n";
+	out << "====== Family ===== Time == Calls ===== Cuts ==== Bound gain == Alive:1 ===== 10 ==== 100\n";
+	for (int f=0; f < CUTSTAT_NUM; ++f) {
+		getStat(f,stat);
+		if (!stat.callNum && !stat.cutNum)
+			continue;
+		if (f == CUTSTAT_AUTO)
+			sprintf(str,"%12s %10s %8s %8d %14.6g %10d %8d %8d\n",familyName[f],"-","-",stat.cutNum,stat.boundGain,
+				stat.aliveNum[0],stat.aliveNum[1],stat.aliveNum[2]);
+		else
+			sprintf(str,"%12s %10.3f %8d %8d %14.6g %10d %8d %8d\n",familyName[f],stat.time,stat.callNum,stat.cutNum,stat.boundGain,
+				stat.aliveNum[0],stat.aliveNum[1],stat.aliveNum[2]);
+		out << str;
+	}
+	out << std::endl;
+} // end of CCutStat::printStatistics()
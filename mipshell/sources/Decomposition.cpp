@@ -0,0 +1,242 @@
+// Decomposition.cpp: implementation of the CDecomposition class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cmath>
+#include <except.h>
+#include <cmip.h>
+#include "Decomposition.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CDecomposition::CDecomposition(int threadNum)
+{
+	m_iThreadNum=threadNum;
+	m_iCompThreadNum=1;
+	m_iCompNum=0;
+	m_ipCompColBeg=m_ipCompCol=m_ipCompRowBeg=m_ipCompRow=0;
+	m_iNextComp=0;
+	m_ipCompState=0;
+	m_dpCompObj=0;
+	m_bSolved=m_bRec=false;
+	m_dObjVal=0.0;
+	m_dpX=0;
+	m_ipHd=0;
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+#endif
+} // end of CDecomposition::CDecomposition()
+
+CDecomposition::~CDecomposition()
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	if (m_ipCompColBeg) {
+		delete[] m_ipCompColBeg;
+		delete[] m_dpCompObj;
+	}
+	if (m_dpX) {
+		delete[] m_dpX;
+		delete[] m_ipHd;
+	}
+} // end of CDecomposition::~CDecomposition()
+
+//////////////////////////////////////////////////////////////////////
+// Decomposition
+//////////////////////////////////////////////////////////////////////
+int CDecomposition::decompose()
+{
+	int m=m_copy.getRowNum(), n=m_copy.getColNum(), k, *ipColComp, *ipRowComp;
+	if (m_ipCompColBeg) {
+		delete[] m_ipCompColBeg;
+		delete[] m_dpCompObj;
+		m_ipCompColBeg=0;
+		m_dpCompObj=0;
+	}
+	if (m_dpX) {
+		delete[] m_dpX;
+		delete[] m_ipHd;
+	}
+	m_dpX=0;
+	m_ipHd=0;
+	m_bSolved=m_bRec=false;
+	if (!(m_dpX = new double[n+1]) || !(m_ipHd = new int[n+m+1])) {
+		throw new CMemoryException("CDecomposition::decompose");
+	}
+	ipColComp=m_ipHd;
+	ipRowComp=m_ipHd+n;
+	m_iCompNum=m_copy.getComponents(ipColComp,ipRowComp);
+
+// sort columns and rows by components (counting sort)
+	if (!(m_ipCompColBeg = new int[4*m_iCompNum+n+m+4]) || !(m_dpCompObj = new double[m_iCompNum+1])) {
+		throw new CMemoryException("CDecomposition::decompose");
+	}
+	m_ipCompRowBeg=m_ipCompColBeg+m_iCompNum+1;
+	m_ipCompState=m_ipCompRowBeg+m_iCompNum+1;
+	m_ipCompCol=m_ipCompState+m_iCompNum+1;
+	m_ipCompRow=m_ipCompCol+n;
+	for (k=0; k <= m_iCompNum; ++k) {
+		m_ipCompColBeg[k]=m_ipCompRowBeg[k]=0;
+	}
+	for (int j=0; j < n; ++j) {
+		if ((k=ipColComp[j]) >= 0)
+			++m_ipCompColBeg[k+1];
+	}
+	for (int i=0; i < m; ++i) {
+		if ((k=ipRowComp[i]) >= 0)
+			++m_ipCompRowBeg[k+1];
+	}
+	for (k=0; k < m_iCompNum; ++k) {
+		m_ipCompColBeg[k+1]+=m_ipCompColBeg[k];
+		m_ipCompRowBeg[k+1]+=m_ipCompRowBeg[k];
+	}
+	k=m_ipCompColBeg[m_iCompNum]; // columns without nonzero entries follow all components
+	for (int j=0; j < n; ++j) {
+		if (ipColComp[j] >= 0)
+			m_ipCompCol[m_ipCompColBeg[ipColComp[j]]++]=j;
+		else
+			m_ipCompCol[k++]=j;
+	}
+	for (int i=0; i < m; ++i) {
+		if ((k=ipRowComp[i]) >= 0)
+			m_ipCompRow[m_ipCompRowBeg[k]++]=i;
+	}
+	for (k=m_iCompNum; k > 0; --k) {
+		m_ipCompColBeg[k]=m_ipCompColBeg[k-1];
+		m_ipCompRowBeg[k]=m_ipCompRowBeg[k-1];
+	}
+	m_ipCompColBeg[0]=m_ipCompRowBeg[0]=0;
+
+	for (int j=0; j < n; ++j) {
+		m_ipHd[j]=j;
+	}
+	return m_iCompNum;
+} // end of CDecomposition::decompose()
+
+bool CDecomposition::solveIsolatedColumns()
+{
+	int j;
+	double c, l, u, x;
+	bool sense=m_copy.getSense();
+	for (int k=m_ipCompColBeg[m_iCompNum]; k < m_copy.getColNum(); ++k) {
+		l=m_copy.getLoBound(j=m_ipCompCol[k]);
+		u=m_copy.getUpBound(j);
+		if (m_copy.isInteger(j)) {
+			l=ceil(l);
+			u=floor(u);
+		}
+		if (!(c=m_copy.getObjCoeff(j)))
+			x=(l > -CLP::INF)? l: (u < CLP::INF)? u: 0.0;
+		else if ((c > 0.0) == sense)
+			x=u;
+		else
+			x=l;
+		if (x <= -CLP::INF || x >= CLP::INF)
+			return false; // objective is unbounded
+		m_dpX[j]=x;
+		m_dObjVal+=c*x;
+	}
+	return true;
+} // end of CDecomposition::solveIsolatedColumns()
+
+void CDecomposition::solveComponents()
+{
+	double *dpX;
+	int k, n, *ipHd;
+	for (;;) {
+#ifndef __ONE_THREAD_
+		_MUTEX_LOCK(&m_mutex)
+#endif
+		k=(m_iNextComp < m_iCompNum)? m_iNextComp++: -1;
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+		if (k < 0)
+			break;
+		try {
+			CMIP comp("comp");
+			comp.beSilent(); // the component is preprocessed when it is loaded
+			m_copy.load(comp,m_ipCompRowBeg[k+1]-m_ipCompRowBeg[k],m_ipCompRow+m_ipCompRowBeg[k],
+				m_ipCompColBeg[k+1]-m_ipCompColBeg[k],m_ipCompCol+m_ipCompColBeg[k]);
+#ifndef __ONE_THREAD_
+			comp.setThreadNum(m_iCompThreadNum);
+#endif
+			comp.optimize();
+			if (comp.isSolution()) {
+				n=comp.getSolution(dpX=0,ipHd=0);
+				for (int i=0; i < n; ++i) {
+					m_dpX[ipHd[i]]=dpX[i]; // components do not intersect
+				}
+				m_dpCompObj[k]=comp.getObjVal();
+				m_ipCompState[k]=(comp.isSolutionOptimal())? 2: 1;
+			}
+		}
+		catch(CException* pe) {
+			delete pe; // component `k` is left unsolved
+		}
+	}
+} // end of CDecomposition::solveComponents()
+
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CDecomposition::startThread(void* param)
+#else
+void* CDecomposition::startThread(void* param)
+#endif
+{
+	static_cast<CDecomposition*>(param)->solveComponents();
+	return 0;
+} // end of CDecomposition::startThread()
+#endif
+
+bool CDecomposition::solve(int threadNum)
+{
+	int k;
+	m_dObjVal=0.0;
+	if (!solveIsolatedColumns())
+		return false;
+	for (k=0; k < m_iCompNum; ++k) {
+		m_ipCompState[k]=0;
+	}
+	m_iNextComp=0;
+#ifndef __ONE_THREAD_
+	if (threadNum < 1)
+		threadNum=1;
+	m_iCompThreadNum=threadNum; // threads are shared evenly among components solved simultaneously
+	if (threadNum > m_iCompNum)
+		threadNum=m_iCompNum;
+	m_iCompThreadNum/=threadNum;
+	if (threadNum > 1) {
+		_THREAD* pThreads;
+		if (!(pThreads = new _THREAD[--threadNum])) {
+			throw new CMemoryException("CDecomposition::solve");
+		}
+		for (int t=0; t < threadNum; ++t) {
+			_THREAD_CREATE(pThreads[t],startThread,this)
+		}
+		solveComponents();
+		for (int t=0; t < threadNum; ++t) {
+			_THREAD_JOIN(pThreads[t])
+			_THREAD_CLOSE(pThreads[t])
+		}
+		delete[] pThreads;
+	}
+	else
+#endif
+	solveComponents();
+
+	m_bSolved=true;
+	for (k=0; k < m_iCompNum; ++k) {
+		if (!m_ipCompState[k])
+			break;
+		if (m_ipCompState[k] < 2)
+			m_bSolved=false;
+		m_dObjVal+=m_dpCompObj[k];
+	}
+	if (k < m_iCompNum)
+		m_bSolved=false;
+	else
+		m_bRec=!m_bSolved;
+	return m_bSolved;
+} // end of CDecomposition::solve()
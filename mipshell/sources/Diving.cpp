@@ -0,0 +1,623 @@
+// Diving.cpp: implementation of the CDiving class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <thread>
+#include <chrono>
+#include <except.h>
+#include <lp.h>
+#include "Incumbent.h"
+#include "HeurScheduler.h"
+#include "Diving.h"
+
+#define DIVE_TOL 1.0e-6 ///< feasibility and integrality tolerance.
+#define DIVE_NOISE 0.1 ///< scores of candidates are multiplied by random factors from `[1,1+DIVE_NOISE)` to diversify dives.
+#define DIVE_BATCH_RATE 0.1 ///< at every diving step, this fraction of fractional variables (but at least one variable) is rounded.
+#define DIVE_ROUNDABLE 1.0e9 ///< added to scores (in coefficient diving) of variables that can be rounded without violating any row.
+#define DIVE_FREE_FAIL_NUM 3 ///< a thread sleeps only after more than `DIVE_FREE_FAIL_NUM` unsuccessful dives in a row.
+#define DIVE_MAX_SLEEP_LOG 6 ///< sleeping time grows (twice with every unsuccessful dive) up to `DIVE_WAIT*2^DIVE_MAX_SLEEP_LOG` milliseconds.
+#define DIVE_WAIT 20 ///< time (in milliseconds) between two checks whether the record solution has changed.
+
+/**
+ * \param[in,out] seed state of random number generator.
+ * \return random number uniformly distributed in `[0,1)`.
+ */
+static inline double nextRandom(unsigned long long& seed)
+{
+	seed^=seed >> 12;
+	seed^=seed << 25;
+	seed^=seed >> 27;
+	return static_cast<double>((seed*0x2545f4914f6cdd1dull) >> 11)*(1.0/9007199254740992.0);
+}
+
+static const char* strategyName[CDiving::DIVE_NUM]={"fractional","coefficient","pseudocost","vector length","guided","conflict"}; ///< names of strategies.
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CDiving::CDiving(int threadNum)
+{
+	m_iThreadNum=(threadNum > 0)? threadNum: 0;
+	m_pInc=0;
+	m_pSched=0;
+	m_bStop=false;
+	m_bStarted=false;
+	m_iIntNum=0;
+	m_dpC=0;
+	m_ipLock=m_ipColLen=0;
+	m_bRec=false;
+	m_dRecObj=0.0;
+	m_iRecNum=0;
+	m_dpRecX=0;
+	m_ipRecHd=0;
+	for (int k=0; k < DIVE_NUM; ++k) {
+		m_ipCallNum[k]=m_ipSolNum[k]=m_ipLpNum[k]=0;
+		m_dpTime[k]=0.0;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+	m_pThread=0;
+	m_pParam=0;
+	m_iStartedNum=0;
+#endif
+} // end of CDiving::CDiving()
+
+CDiving::~CDiving()
+{
+	stop();
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	if (m_dpC)
+		delete[] m_dpC;
+	if (m_ipLock)
+		delete[] m_ipLock;
+	if (m_dpRecX) {
+		delete[] m_dpRecX;
+		delete[] m_ipRecHd;
+	}
+} // end of CDiving::~CDiving()
+
+void CDiving::prepare()
+{
+	const double* dpVal;
+	const int* ipCol;
+	int m=m_copy.getRowNum(), n=m_copy.getColNum(), sz, j;
+	if (m_dpC)
+		return;
+	if (!(m_dpC = new double[n])) {
+		throw new CMemoryException("CDiving::prepare");
+	}
+	if (!(m_ipLock = new int[3*n])) {
+		throw new CMemoryException("CDiving::prepare");
+	}
+	m_ipColLen=m_ipLock+(n<<1);
+	memset(m_ipLock,0,3*n*sizeof(int));
+	for (m_iIntNum=j=0; j < n; ++j) {
+		m_dpC[j]=(m_copy.getSense())? -m_copy.getObjCoeff(j): m_copy.getObjCoeff(j);
+		if (m_copy.isInteger(j))
+			++m_iIntNum;
+	}
+	for (int i=0; i < m; ++i) {
+		bool lo=(m_copy.getRowLoBound(i) > -CLP::INF)? true: false, up=(m_copy.getRowUpBound(i) < CLP::INF)? true: false;
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		for (int k=0; k < sz; ++k) {
+			j=ipCol[k];
+			++m_ipColLen[j];
+			if (up)
+				++m_ipLock[(j<<1)+((dpVal[k] > 0.0)? 1: 0)];
+			if (lo)
+				++m_ipLock[(j<<1)+((dpVal[k] > 0.0)? 0: 1)];
+		}
+	}
+} // end of CDiving::prepare()
+
+//////////////////////////////////////////////////////////////////////
+// Records
+//////////////////////////////////////////////////////////////////////
+bool CDiving::isFeasible(const double* dpX) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	double s, b;
+	int sz;
+	for (int j=0; j < m_copy.getColNum(); ++j) {
+		if (dpX[j] < m_copy.getLoBound(j)-DIVE_TOL || dpX[j] > m_copy.getUpBound(j)+DIVE_TOL)
+			return false;
+	}
+	for (int i=0; i < m_copy.getRowNum(); ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		for (s=0.0, --sz; sz >= 0; --sz) {
+			s+=dpVal[sz]*dpX[ipCol[sz]];
+		}
+		if ((b=m_copy.getRowLoBound(i)) > -CLP::INF && s < b-DIVE_TOL*(1.0+fabs(b)))
+			return false;
+		if ((b=m_copy.getRowUpBound(i)) < CLP::INF && s > b+DIVE_TOL*(1.0+fabs(b)))
+			return false;
+	}
+	return true;
+} // end of CDiving::isFeasible()
+
+bool CDiving::setRecord(double objVal, const double* dpX)
+{
+	int n=m_copy.getColNum();
+	bool flag=false;
+	if (m_pInc)
+		m_pInc->offer(n,dpX,0);
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if ((!m_iRecNum || ((m_copy.getSense())? objVal > m_dRecObj: objVal < m_dRecObj)) &&
+			(!m_pInc || m_pInc->isBetter(objVal))) {
+		if (!m_dpRecX) {
+			if (!(m_dpRecX = new double[n]) || !(m_ipRecHd = new int[n])) {
+#ifndef __ONE_THREAD_
+				_MUTEX_UNLOCK(&m_mutex)
+#endif
+				throw new CMemoryException("CDiving::setRecord");
+			}
+		}
+		m_dRecObj=objVal;
+		m_iRecNum=n;
+		memcpy(m_dpRecX,dpX,n*sizeof(double));
+		for (int j=0; j < n; ++j) {
+			m_ipRecHd[j]=j;
+		}
+		m_bRec=flag=true;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return flag;
+} // end of CDiving::setRecord()
+
+bool CDiving::getRecord(double* dpRecX, double& objVal, int* ipHd)
+{
+	int n=m_copy.getColNum(), k=0;
+	bool sense=m_copy.getSense();
+	if (m_pInc->isSolution() && (k=m_pInc->getSolution(objVal,n,dpRecX+n,ipHd)) > n)
+		k=0;
+	for (int j=0; j < n; ++j) {
+		dpRecX[j]=0.0;
+	}
+	for (int i=0; i < k; ++i) {
+		dpRecX[ipHd[i]]=dpRecX[n+i];
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if (m_iRecNum && (!k || ((sense)? m_dRecObj > objVal: m_dRecObj < objVal))) {
+		for (int i=0; i < m_iRecNum; ++i) {
+			dpRecX[m_ipRecHd[i]]=m_dpRecX[i];
+		}
+		objVal=m_dRecObj;
+		k=m_iRecNum;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return (k)? true: false;
+} // end of CDiving::getRecord()
+
+//////////////////////////////////////////////////////////////////////
+// Diving
+//////////////////////////////////////////////////////////////////////
+int CDiving::chooseStrategy(double r, bool rec)
+{
+	double dpW[DIVE_NUM], s=0.0;
+	int k;
+	if (m_pSched) {
+		int ipHeur[DIVE_NUM], ipStrategy[DIVE_NUM], num=0;
+		for (k=0; k < DIVE_NUM; ++k) {
+			if (k != DIVE_GUIDED || rec) {
+				ipStrategy[num]=k;
+				ipHeur[num++]=m_ipHeur[k];
+			}
+		}
+		return ipStrategy[m_pSched->select(num,ipHeur)];
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	for (k=0; k < DIVE_NUM; ++k) { // success rates with one success in two dives assumed a priori
+		s+=dpW[k]=(k == DIVE_GUIDED && !rec)? 0.0:
+			static_cast<double>(m_ipSolNum[k]+1)/static_cast<double>(m_ipCallNum[k]+2);
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	for (r*=s, k=0; k < DIVE_NUM-1 && (r-=dpW[k]) >= 0.0; ++k);
+	if (k == DIVE_GUIDED && !rec)
+		k=DIVE_FRACTIONAL;
+	return k;
+} // end of CDiving::chooseStrategy()
+
+int CDiving::select(int strategy, tagDiver& w) const
+{
+	int n=m_copy.getColNum(), candNum=0, ld, lu;
+	double x, fd, fu, pd, pu, score;
+	bool u;
+	for (int j=0; j < n; ++j) {
+		if (!m_copy.isInteger(j))
+			continue;
+		x=w.dpX[j];
+		fd=x-floor(x);
+		if (fd < DIVE_TOL || fd > 1.0-DIVE_TOL)
+			continue;
+		fu=1.0-fd;
+		switch (strategy) {
+			case DIVE_COEFFICIENT:
+				ld=m_ipLock[j<<1];
+				lu=m_ipLock[(j<<1)+1];
+				u=(ld != lu)? lu < ld: fu < fd;
+				score=((u)? lu+fu: ld+fd)+((((u)? lu: ld))? 0.0: DIVE_ROUNDABLE);
+				break;
+			case DIVE_PSEUDOCOST:
+				pd=(w.ipPcNum[j<<1])? w.dpPc[j<<1]/w.ipPcNum[j<<1]:
+					((w.ipPcTotal[0])? w.dpPcTotal[0]/w.ipPcTotal[0]: 1.0);
+				pu=(w.ipPcNum[(j<<1)+1])? w.dpPc[(j<<1)+1]/w.ipPcNum[(j<<1)+1]:
+					((w.ipPcTotal[1])? w.dpPcTotal[1]/w.ipPcTotal[1]: 1.0);
+				pd*=fd;
+				pu*=fu;
+				u=(pu != pd)? pu < pd: fu < fd;
+				score=(u)? (pu+DIVE_TOL)/(pd+DIVE_TOL): (pd+DIVE_TOL)/(pu+DIVE_TOL);
+				break;
+			case DIVE_VECTOR_LENGTH: // the direction which worsens the objective
+				u=(m_dpC[j] >= 0.0)? true: false;
+				score=(fabs(m_dpC[j])*((u)? fu: fd)+DIVE_TOL)/(m_ipColLen[j]+1);
+				break;
+			case DIVE_GUIDED:
+				u=(w.dpRecX[j] > x)? true: false;
+				score=fabs(x-w.dpRecX[j]);
+				break;
+			case DIVE_CONFLICT:
+				ld=w.ipConflict[j<<1];
+				lu=w.ipConflict[(j<<1)+1];
+				u=(ld != lu)? lu < ld: fu < fd;
+				score=((u)? fu: fd)/(1.0+ld+lu);
+				break;
+			default: // DIVE_FRACTIONAL
+				u=fu < fd;
+				score=(u)? fu: fd;
+		}
+		w.ipCand[candNum]=(j<<1)+((u)? 1: 0);
+		w.dpScore[candNum++]=score*(1.0+DIVE_NOISE*nextRandom(w.seed));
+	}
+	return candNum;
+} // end of CDiving::select()
+
+bool CDiving::dive(CLP& lp, int strategy, double cutoff, tagDiver& w, int& lpNum)
+{
+	int n=m_copy.getColNum(), maxLpNum=m_iIntNum+10, fixedNum=0, batchNum=0, candNum, sz, c, j, k, q, *ipHd;
+	double *dpLpX, obj, prevObj=0.0, x, f, s;
+	bool flipped=false, found=false;
+	lp.optimize();
+	lpNum=1;
+	while (!m_bStop.load(std::memory_order_relaxed)) {
+		if (!lp.isSolution()) {
+			if (!batchNum)
+				break;
+			if (batchNum > 1) { // only the best rounding of the batch is kept
+				for (k=1; k < batchNum; ++k) {
+					j=w.ipCand[k] >> 1;
+					w.dpD[(j<<1)+(w.ipCand[k] & 1)]=w.dpBatchOld[k];
+					lp.setVarBounds(j,w.dpD[j<<1],w.dpD[(j<<1)+1]);
+				}
+				batchNum=1;
+			}
+			else {
+				++w.ipConflict[w.ipCand[0]];
+				if (flipped)
+					break;
+			// the last rounding is reversed
+				j=w.ipCand[0] >> 1;
+				x=w.dpBatchX[0];
+				if (w.ipCand[0] & 1) {
+					w.dpD[j<<1]=w.dpBatchOld[0];
+					w.dpBatchOld[0]=w.dpD[(j<<1)+1];
+					w.dpD[(j<<1)+1]=floor(x);
+				}
+				else {
+					w.dpD[(j<<1)+1]=w.dpBatchOld[0];
+					w.dpBatchOld[0]=w.dpD[j<<1];
+					w.dpD[j<<1]=ceil(x);
+				}
+				w.ipCand[0]^=1;
+				flipped=true;
+				lp.setVarBounds(j,w.dpD[j<<1],w.dpD[(j<<1)+1]);
+			}
+			lp.optimize();
+			++lpNum;
+			continue;
+		}
+		for (j=0; j < n; ++j) {
+			w.dpX[j]=0.0;
+		}
+		sz=lp.getSolution(dpLpX,ipHd);
+		for (k=0; k < sz; ++k) {
+			if (ipHd[k] >= 0 && ipHd[k] < n)
+				w.dpX[ipHd[k]]=dpLpX[k];
+		}
+		for (obj=0.0, j=0; j < n; ++j) {
+			obj+=m_dpC[j]*w.dpX[j];
+		}
+		if (obj >= cutoff)
+			break;
+		if (batchNum) { // pseudocosts: objective increase is shared in proportion to rounding distances
+			for (s=0.0, k=0; k < batchNum; ++k) {
+				x=w.dpBatchX[k];
+				s+=(w.ipCand[k] & 1)? ceil(x)-x: x-floor(x);
+			}
+			if (s > DIVE_TOL) {
+				f=(obj > prevObj)? (obj-prevObj)/s: 0.0;
+				for (k=0; k < batchNum; ++k) {
+					c=w.ipCand[k];
+					w.dpPc[c]+=f;
+					++w.ipPcNum[c];
+					w.dpPcTotal[c & 1]+=f;
+					++w.ipPcTotal[c & 1];
+				}
+			}
+		}
+		if (!(candNum=select(strategy,w))) { // integral solution
+			for (obj=0.0, j=0; j < n; ++j) {
+				if (m_copy.isInteger(j))
+					w.dpX[j]=floor(w.dpX[j]+0.5);
+				obj+=m_copy.getObjCoeff(j)*w.dpX[j];
+			}
+			if (isFeasible(w.dpX))
+				found=setRecord(obj,w.dpX);
+			break;
+		}
+		if (lpNum >= maxLpNum)
+			break;
+
+	// the best candidates are moved to the beginning of the list, and rounded
+		batchNum=1+static_cast<int>(DIVE_BATCH_RATE*(candNum-1));
+		for (k=0; k < batchNum; ++k) {
+			for (q=k, j=k+1; j < candNum; ++j) {
+				if (w.dpScore[j] < w.dpScore[q])
+					q=j;
+			}
+			c=w.ipCand[q];
+			w.ipCand[q]=w.ipCand[k];
+			w.dpScore[q]=w.dpScore[k];
+			w.ipCand[k]=c;
+			j=c >> 1;
+			if (w.dpD[j<<1] == m_copy.getLoBound(j) && w.dpD[(j<<1)+1] == m_copy.getUpBound(j))
+				w.ipFixed[fixedNum++]=j;
+			w.dpBatchX[k]=x=w.dpX[j];
+			if (c & 1) {
+				w.dpBatchOld[k]=w.dpD[j<<1];
+				w.dpD[j<<1]=ceil(x);
+			}
+			else {
+				w.dpBatchOld[k]=w.dpD[(j<<1)+1];
+				w.dpD[(j<<1)+1]=floor(x);
+			}
+			lp.setVarBounds(j,w.dpD[j<<1],w.dpD[(j<<1)+1]);
+		}
+		flipped=false;
+		prevObj=obj;
+		lp.optimize();
+		++lpNum;
+	}
+
+// original bounds are restored
+	for (k=0; k < fixedNum; ++k) {
+		j=w.ipFixed[k];
+		w.dpD[j<<1]=m_copy.getLoBound(j);
+		w.dpD[(j<<1)+1]=m_copy.getUpBound(j);
+		lp.setVarBounds(j,w.dpD[j<<1],w.dpD[(j<<1)+1]);
+	}
+	return found;
+} // end of CDiving::dive()
+
+void CDiving::run(int thread, bool wait)
+{
+	const double* dpVal;
+	const int* ipCol;
+	int m=m_copy.getRowNum(), n=m_copy.getColNum(), sz, nz=0, j, lpNum, solNum, *ipMem;
+	double *dpMem, objVal, cutoff;
+	bool rec, found;
+	tagDiver w;
+	if (!n)
+		return;
+	for (int i=0; i < m; ++i) {
+		nz+=m_copy.getRow(i,dpVal,ipCol);
+	}
+	if (!(dpMem = new double[10*n])) {
+		throw new CMemoryException("CDiving::run");
+	}
+	if (!(ipMem = new int[7*n])) {
+		delete[] dpMem;
+		throw new CMemoryException("CDiving::run");
+	}
+	w.seed=0x2545f4914f6cdd1dull^(0x9e3779b97f4a7c15ull*static_cast<unsigned long long>(thread+1));
+	w.failNum=0;
+	w.dpX=dpMem;
+	w.dpD=w.dpX+n;
+	w.dpRecX=w.dpD+(n<<1);
+	w.dpPc=w.dpRecX+(n<<1);
+	w.dpScore=w.dpPc+(n<<1);
+	w.dpBatchX=w.dpScore+n;
+	w.dpBatchOld=w.dpBatchX+n;
+	w.ipPcNum=ipMem;
+	w.ipConflict=w.ipPcNum+(n<<1);
+	w.ipFixed=w.ipConflict+(n<<1);
+	w.ipCand=w.ipFixed+n;
+	w.ipHd=w.ipCand+n;
+	w.dpPcTotal[0]=w.dpPcTotal[1]=0.0;
+	w.ipPcTotal[0]=w.ipPcTotal[1]=0;
+	memset(w.dpPc,0,(n<<1)*sizeof(double));
+	memset(ipMem,0,(n<<2)*sizeof(int));
+	for (j=0; j < n; ++j) {
+		w.dpD[j<<1]=m_copy.getLoBound(j);
+		w.dpD[(j<<1)+1]=m_copy.getUpBound(j);
+	}
+
+	try {
+		CLP lp("dive");
+		double *dpRowVal=w.dpRecX; // used as working memory while building the LP
+		int *ipRowCol=w.ipHd;
+		lp.preprocOff(); // column `j` of the LP must stay column `j` to be changed between dives
+		lp.setScaling(CLP::SCL_NO); // bounds passed to `setVarBounds()` are not scaled
+		lp.beSilent();
+		lp.openMatrix(m,n,nz);
+		lp.setObjSense(false);
+		for (j=0; j < n; ++j) {
+			lp.addVar(j,0,m_dpC[j],m_copy.getLoBound(j),m_copy.getUpBound(j));
+		}
+		for (int i=0; i < m; ++i) {
+			sz=m_copy.getRow(i,dpVal,ipCol);
+			memcpy(dpRowVal,dpVal,sz*sizeof(double));
+			memcpy(ipRowCol,ipCol,sz*sizeof(int));
+			lp.addRow(i,0,m_copy.getRowLoBound(i),m_copy.getRowUpBound(i),sz,dpRowVal,ipRowCol);
+		}
+		lp.closeMatrix();
+		lp.optimize();
+		if (!lp.isSolution()) // the LP is infeasible or unbounded
+			wait=false;
+
+		for (int t=0; lp.isSolution() && !m_bStop.load(std::memory_order_relaxed) && (wait || t < DIVE_NUM); ++t) {
+			if ((rec=getRecord(w.dpRecX,objVal,w.ipHd))) {
+				cutoff=(m_copy.getSense())? -objVal: objVal;
+				cutoff-=DIVE_TOL*(1.0+fabs(cutoff));
+			}
+			else
+				cutoff=CLP::INF;
+			int strategy=(wait)? chooseStrategy(nextRandom(w.seed),rec): t;
+			if (strategy == DIVE_GUIDED && !rec)
+				continue;
+			if (m_pSched && !m_pSched->admit(m_ipHeur[strategy])) { // the time budget of heuristics is exhausted
+				if (wait)
+					std::this_thread::sleep_for(std::chrono::milliseconds(DIVE_WAIT));
+				continue;
+			}
+			std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+			found=dive(lp,strategy,cutoff,w,lpNum);
+			double time=1.0e-6*static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now()-startTime).count());
+#ifndef __ONE_THREAD_
+			_MUTEX_LOCK(&m_mutex)
+#endif
+			++m_ipCallNum[strategy];
+			if (found)
+				++m_ipSolNum[strategy];
+			m_ipLpNum[strategy]+=lpNum;
+			m_dpTime[strategy]+=time;
+#ifndef __ONE_THREAD_
+			_MUTEX_UNLOCK(&m_mutex)
+#endif
+			if (m_pSched)
+				m_pSched->report(m_ipHeur[strategy],time,found);
+			if (found)
+				w.failNum=0;
+			else if (++w.failNum > DIVE_FREE_FAIL_NUM && wait) {
+			// after many failures, the thread sleeps until the record changes or the sleeping time expires
+				int k=w.failNum-DIVE_FREE_FAIL_NUM, sleepNum=1 << ((k < DIVE_MAX_SLEEP_LOG)? k: DIVE_MAX_SLEEP_LOG);
+				for (solNum=m_pInc->getSolNum(); sleepNum && !m_bStop.load(std::memory_order_relaxed); --sleepNum) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(DIVE_WAIT));
+					if (m_pInc->getSolNum() != solNum) {
+						w.failNum=0;
+						break;
+					}
+				}
+			}
+		}
+	}
+	catch(CException* pe) {
+		delete[] ipMem;
+		delete[] dpMem;
+		throw pe;
+	}
+	delete[] ipMem;
+	delete[] dpMem;
+} // end of CDiving::run()
+
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CDiving::startThread(void* param)
+#else
+void* CDiving::startThread(void* param)
+#endif
+{
+	tagThreadParam* pParam=static_cast<tagThreadParam*>(param);
+	try {
+		pParam->pDiving->run(pParam->thread,true);
+	}
+	catch(CException* pe) {
+		delete pe; // this thread gives up
+	}
+	return 0;
+} // end of CDiving::startThread()
+#endif
+
+void CDiving::start(CIncumbent* pInc, int idleNum)
+{
+	m_pInc=pInc;
+	m_bStop=false;
+	m_bStarted=true;
+	prepare();
+#ifndef __ONE_THREAD_
+	int threadNum=(m_iThreadNum)? m_iThreadNum: idleNum;
+	if (threadNum < 1)
+		threadNum=1;
+	if (!(m_pThread = new _THREAD[threadNum]) || !(m_pParam = new tagThreadParam[threadNum])) {
+		throw new CMemoryException("CDiving::start");
+	}
+	for (m_iStartedNum=0; m_iStartedNum < threadNum; ++m_iStartedNum) {
+		m_pParam[m_iStartedNum].pDiving=this;
+		m_pParam[m_iStartedNum].thread=m_iStartedNum;
+		_THREAD_CREATE(m_pThread[m_iStartedNum],startThread,m_pParam+m_iStartedNum)
+	}
+#else
+	run(0,false);
+#endif
+} // end of CDiving::start()
+
+void CDiving::setScheduler(CHeurScheduler* pSched)
+{
+	m_pSched=pSched;
+	for (int k=0; k < DIVE_NUM; ++k) {
+		m_ipHeur[k]=pSched->addHeuristic(strategyName[k]);
+	}
+} // end of CDiving::setScheduler()
+
+void CDiving::stop()
+{
+	m_bStop=true;
+#ifndef __ONE_THREAD_
+	for (int t=0; t < m_iStartedNum; ++t) {
+		_THREAD_JOIN(m_pThread[t])
+		_THREAD_CLOSE(m_pThread[t])
+	}
+	m_iStartedNum=0;
+	if (m_pThread) {
+		delete[] m_pThread;
+		m_pThread=0;
+	}
+	if (m_pParam) {
+		delete[] m_pParam;
+		m_pParam=0;
+	}
+#endif
+	m_bStarted=false;
+} // end of CDiving::stop()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CDiving::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	out << "Diving\n";
+	out << "====== Strategy ===== Dives === Solutions ======== LPs ===== Time\n";
+	for (int k=0; k < DIVE_NUM; ++k) {
+		sprintf(str,"%14s %11d %13d %12d %12.3f\n",strategyName[k],m_ipCallNum[k],m_ipSolNum[k],m_ipLpNum[k],m_dpTime[k]);
+		out << str;
+	}
+	out << std::endl;
+} // end of CDiving::printStatistics()
@@ -0,0 +1,415 @@
+// FeasPump.cpp: implementation of the CFeasPump class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <except.h>
+#include <lp.h>
+#include "HeurScheduler.h"
+#include "FeasPump.h"
+
+#define FEASPUMP_TOL 1.0e-6 ///< feasibility and integrality tolerance.
+#define FEASPUMP_ALPHA_FACTOR 0.9 ///< weight of the original objective is multiplied by this factor at every iteration.
+#define FEASPUMP_FLIP_NUM 10 ///< average number of variables flipped to break a short cycle.
+#define FEASPUMP_HIST_LEN 10 ///< number of previous rounded points compared with the current one to detect long cycles.
+
+/**
+ * \param[in] h hash value;
+ * \param[in] v value to be mixed into `h`.
+ * \return new hash value.
+ */
+static inline unsigned long long mixHash(unsigned long long h, unsigned long long v)
+{
+	return h ^ (v+0x9e3779b97f4a7c15ull+(h << 6)+(h >> 2));
+}
+
+/**
+ * \param[in] intNum,ipInt list of integer columns;
+ * \param[in] dpXr rounded point.
+ * \return hash value of the integer part of `dpXr`.
+ */
+static unsigned long long hashPoint(int intNum, const int* ipInt, const double* dpXr)
+{
+	unsigned long long h=static_cast<unsigned long long>(intNum);
+	for (int k=0; k < intNum; ++k) {
+		h=mixHash(h,static_cast<unsigned long long>(static_cast<long long>(dpXr[ipInt[k]])));
+	}
+	return h;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CFeasPump::CFeasPump(int maxIterNum, bool background)
+{
+	m_iMaxIterNum=(maxIterNum > 0)? maxIterNum: 1;
+	m_bBackground=background;
+	m_bStop=false;
+	m_uSeed=0x2545f4914f6cdd1dull;
+	m_pSched=0;
+	m_iHeur=-1;
+	m_bRec=false;
+	m_dRecObj=0.0;
+	m_iRecNum=0;
+	m_dpRecX=0;
+	m_ipRecHd=0;
+	m_iIterNum=m_iFlipNum=m_iPerturbNum=0;
+	m_bSolved=false;
+	m_dTime=0.0;
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+	m_bThread=false;
+#endif
+} // end of CFeasPump::CFeasPump()
+
+CFeasPump::~CFeasPump()
+{
+	stop();
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	if (m_dpRecX) {
+		delete[] m_dpRecX;
+		delete[] m_ipRecHd;
+	}
+} // end of CFeasPump::~CFeasPump()
+
+double CFeasPump::random()
+{
+	m_uSeed^=m_uSeed >> 12;
+	m_uSeed^=m_uSeed << 25;
+	m_uSeed^=m_uSeed >> 27;
+	return static_cast<double>((m_uSeed*0x2545f4914f6cdd1dull) >> 11)*(1.0/9007199254740992.0);
+} // end of CFeasPump::random()
+
+//////////////////////////////////////////////////////////////////////
+// Pumping
+//////////////////////////////////////////////////////////////////////
+void CFeasPump::buildLp(CLP& lp, const double* dpC) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	int m=m_copy.getRowNum(), n=m_copy.getColNum(), sz, nz=0, *ipRowCol;
+	double *dpRowVal;
+	for (int i=0; i < m; ++i) {
+		nz+=m_copy.getRow(i,dpVal,ipCol);
+	}
+	if (!(dpRowVal = new double[n+(n+1)/2+1])) {
+		throw new CMemoryException("CFeasPump::buildLp");
+	}
+	ipRowCol=reinterpret_cast<int*>(dpRowVal+n);
+	try {
+		lp.preprocOff(); // column `j` of the LP must stay column `j` to be changed between iterations
+		lp.setScaling(CLP::SCL_NO); // bounds passed to `setVarBounds()` are not scaled
+		lp.beSilent();
+		lp.openMatrix(m,n,nz);
+		lp.setObjSense(false);
+		for (int j=0; j < n; ++j) {
+			lp.addVar(j,0,dpC[j],m_copy.getLoBound(j),m_copy.getUpBound(j));
+		}
+		for (int i=0; i < m; ++i) {
+			sz=m_copy.getRow(i,dpVal,ipCol);
+			memcpy(dpRowVal,dpVal,sz*sizeof(double));
+			memcpy(ipRowCol,ipCol,sz*sizeof(int));
+			lp.addRow(i,0,m_copy.getRowLoBound(i),m_copy.getRowUpBound(i),sz,dpRowVal,ipRowCol);
+		}
+		lp.closeMatrix();
+	}
+	catch(CException* pe) {
+		delete[] dpRowVal;
+		throw pe;
+	}
+	delete[] dpRowVal;
+} // end of CFeasPump::buildLp()
+
+bool CFeasPump::isFeasible(const double* dpX) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	double s, b;
+	int sz;
+	for (int j=0; j < m_copy.getColNum(); ++j) {
+		if (dpX[j] < m_copy.getLoBound(j)-FEASPUMP_TOL || dpX[j] > m_copy.getUpBound(j)+FEASPUMP_TOL)
+			return false;
+	}
+	for (int i=0; i < m_copy.getRowNum(); ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		for (s=0.0, --sz; sz >= 0; --sz) {
+			s+=dpVal[sz]*dpX[ipCol[sz]];
+		}
+		if ((b=m_copy.getRowLoBound(i)) > -CLP::INF && s < b-FEASPUMP_TOL*(1.0+fabs(b)))
+			return false;
+		if ((b=m_copy.getRowUpBound(i)) < CLP::INF && s > b+FEASPUMP_TOL*(1.0+fabs(b)))
+			return false;
+	}
+	return true;
+} // end of CFeasPump::isFeasible()
+
+void CFeasPump::setRecord(int n, const double* dpX)
+{
+	double objVal=0.0;
+	for (int j=0; j < n; ++j) {
+		objVal+=m_copy.getObjCoeff(j)*dpX[j];
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if (!m_dpRecX) {
+		if (!(m_dpRecX = new double[n]) || !(m_ipRecHd = new int[n])) {
+#ifndef __ONE_THREAD_
+			_MUTEX_UNLOCK(&m_mutex)
+#endif
+			throw new CMemoryException("CFeasPump::setRecord");
+		}
+	}
+	m_dRecObj=objVal;
+	m_iRecNum=n;
+	memcpy(m_dpRecX,dpX,n*sizeof(double));
+	for (int j=0; j < n; ++j) {
+		m_ipRecHd[j]=j;
+	}
+	m_bRec=true;
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+} // end of CFeasPump::setRecord()
+
+bool CFeasPump::run()
+{
+	std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+	int n=m_copy.getColNum(), intNum=0, sz, j, k, t, *ipInt, *ipHd;
+	double *dpMem, *dpLpX, x, lb, ub, norm=0.0, alpha=1.0;
+	unsigned long long h, ullHist[FEASPUMP_HIST_LEN];
+	bool found=false;
+	if (!n || (m_pSched && !m_pSched->admit(m_iHeur)))
+		return false;
+	if (!(dpMem = new double[5*n]) || !(ipInt = new int[n])) {
+		if (dpMem)
+			delete[] dpMem;
+		throw new CMemoryException("CFeasPump::run");
+	}
+	double *dpC=dpMem, *dpX=dpC+n, *dpXr=dpX+n, *dpD=dpXr+n, *dpDist=dpD+n;
+	for (j=0; j < n; ++j) {
+		dpC[j]=(m_copy.getSense())? -m_copy.getObjCoeff(j): m_copy.getObjCoeff(j);
+		norm+=dpC[j]*dpC[j];
+		if (m_copy.isInteger(j))
+			ipInt[intNum++]=j;
+	}
+	norm=(norm > 0.0)? sqrt(static_cast<double>(intNum)/norm): 0.0;
+	for (t=0; t < FEASPUMP_HIST_LEN; ++t) {
+		ullHist[t]=0;
+	}
+
+	try {
+		CLP lp("pump");
+		buildLp(lp,dpC);
+		lp.optimize();
+		for (int it=0; lp.isSolution() && !m_bStop.load(std::memory_order_relaxed); ++it) {
+			for (j=0; j < n; ++j) {
+				dpX[j]=0.0;
+			}
+			sz=lp.getSolution(dpLpX,ipHd);
+			for (k=0; k < sz; ++k) {
+				if (ipHd[k] >= 0 && ipHd[k] < n)
+					dpX[ipHd[k]]=dpLpX[k];
+			}
+		// rounding
+			memcpy(dpXr,dpX,n*sizeof(double));
+			for (k=0; k < intNum; ++k) {
+				j=ipInt[k];
+				lb=ceil(m_copy.getLoBound(j)-FEASPUMP_TOL);
+				ub=floor(m_copy.getUpBound(j)+FEASPUMP_TOL);
+				if ((x=floor(dpX[j]+0.5)) < lb)
+					x=lb;
+				else if (x > ub)
+					x=ub;
+				dpXr[j]=x;
+			}
+			if (isFeasible(dpXr)) {
+				found=true;
+				break;
+			}
+			if (it >= m_iMaxIterNum)
+				break;
+
+		// cycle detection
+			bool cycle=false;
+			h=hashPoint(intNum,ipInt,dpXr);
+			if (it && h == ullHist[(it-1) % FEASPUMP_HIST_LEN]) { // short cycle: flip variables of largest distance
+				int flipNum=FEASPUMP_FLIP_NUM/2+static_cast<int>(random()*FEASPUMP_FLIP_NUM);
+				for (k=0; k < intNum; ++k) {
+					j=ipInt[k];
+					dpDist[j]=fabs(dpX[j]-dpXr[j]);
+				}
+				for (t=0; t < flipNum; ++t) {
+					int q=-1;
+					for (k=0; k < intNum; ++k) {
+						j=ipInt[k];
+						if (dpDist[j] > FEASPUMP_TOL && (q < 0 || dpDist[j] > dpDist[q]))
+							q=j;
+					}
+					if (q < 0)
+						break;
+					dpDist[q]=0.0;
+					dpXr[q]+=(dpX[q] > dpXr[q])? 1.0: -1.0;
+				}
+				if (t) {
+					++m_iFlipNum;
+					h=hashPoint(intNum,ipInt,dpXr);
+				}
+				else
+					cycle=true; // nothing to flip
+			}
+			for (t=1; !cycle && t < FEASPUMP_HIST_LEN && t <= it; ++t) {
+				if (h == ullHist[(it-t) % FEASPUMP_HIST_LEN])
+					cycle=true;
+			}
+			if (cycle) { // long cycle: random perturbation
+				for (k=0; k < intNum; ++k) {
+					j=ipInt[k];
+					double r=random()-0.3;
+					if (fabs(dpX[j]-dpXr[j])+((r > 0.0)? r: 0.0) > 0.5) {
+						lb=ceil(m_copy.getLoBound(j)-FEASPUMP_TOL);
+						ub=floor(m_copy.getUpBound(j)+FEASPUMP_TOL);
+						if (dpXr[j] > dpX[j])
+							dpXr[j]=(dpXr[j]-1.0 >= lb)? dpXr[j]-1.0: dpXr[j]+1.0;
+						else
+							dpXr[j]=(dpXr[j]+1.0 <= ub)? dpXr[j]+1.0: dpXr[j]-1.0;
+					}
+				}
+				++m_iPerturbNum;
+				h=hashPoint(intNum,ipInt,dpXr);
+			}
+			ullHist[it % FEASPUMP_HIST_LEN]=h;
+
+		// projection: distance to the rounded point combined with the objective
+			alpha*=FEASPUMP_ALPHA_FACTOR;
+			for (j=0; j < n; ++j) {
+				dpD[j]=alpha*norm*dpC[j];
+			}
+			for (k=0; k < intNum; ++k) {
+				j=ipInt[k];
+				lb=m_copy.getLoBound(j);
+				ub=m_copy.getUpBound(j);
+				if (ub-lb < FEASPUMP_TOL)
+					continue;
+				if (dpXr[j] <= lb+FEASPUMP_TOL)
+					dpD[j]+=1.0-alpha;
+				else if (dpXr[j] >= ub-FEASPUMP_TOL)
+					dpD[j]-=1.0-alpha;
+				else if (dpX[j] > dpXr[j]+FEASPUMP_TOL)
+					dpD[j]+=1.0-alpha;
+				else if (dpX[j] < dpXr[j]-FEASPUMP_TOL)
+					dpD[j]-=1.0-alpha;
+			}
+			for (j=0; j < n; ++j) {
+				lp.setObjCoeff(j,dpD[j]);
+			}
+			lp.optimize();
+			++m_iIterNum;
+		}
+
+		if (found) {
+			if (intNum < n) { // continuous variables are computed for the integer variables fixed
+				for (k=0; k < intNum; ++k) {
+					j=ipInt[k];
+					lp.setVarBounds(j,dpXr[j],dpXr[j]);
+				}
+				for (j=0; j < n; ++j) {
+					lp.setObjCoeff(j,dpC[j]);
+				}
+				lp.optimize();
+				if (lp.isSolution()) {
+					memcpy(dpX,dpXr,n*sizeof(double));
+					sz=lp.getSolution(dpLpX,ipHd);
+					for (k=0; k < sz; ++k) {
+						if ((j=ipHd[k]) >= 0 && j < n && !m_copy.isInteger(j))
+							dpX[j]=dpLpX[k];
+					}
+					if (isFeasible(dpX))
+						memcpy(dpXr,dpX,n*sizeof(double));
+				}
+			}
+			setRecord(n,dpXr);
+			m_bSolved=true;
+		}
+	}
+	catch(CException* pe) {
+		delete[] ipInt;
+		delete[] dpMem;
+		throw pe;
+	}
+	delete[] ipInt;
+	delete[] dpMem;
+	double time=1.0e-6*static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now()-startTime).count());
+	m_dTime+=time;
+	if (m_pSched)
+		m_pSched->report(m_iHeur,time,found);
+	return found;
+} // end of CFeasPump::run()
+
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CFeasPump::startThread(void* param)
+#else
+void* CFeasPump::startThread(void* param)
+#endif
+{
+	try {
+		static_cast<CFeasPump*>(param)->run();
+	}
+	catch(CException* pe) {
+		delete pe; // the pump gives up
+	}
+	return 0;
+} // end of CFeasPump::startThread()
+#endif
+
+void CFeasPump::start()
+{
+	m_bStop=false;
+#ifndef __ONE_THREAD_
+	if (m_bBackground) {
+		stop();
+		m_bStop=false;
+		_THREAD_CREATE(m_thread,startThread,this)
+		m_bThread=true;
+		return;
+	}
+#endif
+	run();
+} // end of CFeasPump::start()
+
+void CFeasPump::stop()
+{
+	m_bStop=true;
+#ifndef __ONE_THREAD_
+	if (m_bThread) {
+		_THREAD_JOIN(m_thread)
+		_THREAD_CLOSE(m_thread)
+		m_bThread=false;
+	}
+#endif
+} // end of CFeasPump::stop()
+
+void CFeasPump::setScheduler(CHeurScheduler* pSched)
+{
+	m_pSched=pSched;
+	m_iHeur=pSched->addHeuristic("feasibility pump");
+} // end of CFeasPump::setScheduler()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CFeasPump::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	out << "Feasibility pump\n";
+	out << "=== Iterations === Flips === Perturbations === Solution ===== Time\n";
+	sprintf(str,"%14d %11d %17d %12s %12.3f\n",m_iIterNum,m_iFlipNum,m_iPerturbNum,
+		(m_bSolved)? "found": "none",m_dTime);
+	out << str << std::endl;
+} // end of CFeasPump::printStatistics()
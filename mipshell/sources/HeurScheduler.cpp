@@ -0,0 +1,179 @@
+// HeurScheduler.cpp: implementation of the CHeurScheduler class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include "HeurScheduler.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CHeurScheduler::CHeurScheduler(double timeFraction, double explore)
+{
+	m_dTimeFraction=(timeFraction < 0.0)? 0.0: (timeFraction > 1.0)? 1.0: timeFraction;
+	m_dExplore=(explore > 0.0)? explore: 0.0;
+	m_startTime=std::chrono::steady_clock::now();
+	m_iHeurNum=0;
+	m_dTotalTime=0.0;
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+#endif
+} // end of CHeurScheduler::CHeurScheduler()
+
+CHeurScheduler::~CHeurScheduler()
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+} // end of CHeurScheduler::~CHeurScheduler()
+
+int CHeurScheduler::addHeuristic(const char* name)
+{
+	int k;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	for (k=0; k < m_iHeurNum && strcmp(m_sName[k],name); ++k);
+	if (k == m_iHeurNum) {
+		if (m_iHeurNum < HEUR_MAX_NUM) {
+			m_sName[k]=name;
+			m_ipCallNum[k]=m_ipSolNum[k]=m_ipSkipNum[k]=0;
+			m_dpTime[k]=0.0;
+			++m_iHeurNum;
+		}
+		else
+			k=-1;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return k;
+} // end of CHeurScheduler::addHeuristic()
+
+void CHeurScheduler::start()
+{
+	m_startTime=std::chrono::steady_clock::now();
+} // end of CHeurScheduler::start()
+
+double CHeurScheduler::getElapsedTime() const
+{
+	return 1.0e-6*static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now()-m_startTime).count());
+} // end of CHeurScheduler::getElapsedTime()
+
+//////////////////////////////////////////////////////////////////////
+// Scheduling
+//////////////////////////////////////////////////////////////////////
+bool CHeurScheduler::admit(int heur)
+{
+	bool flag=true;
+	if (heur < 0) // heuristics not registered are not managed
+		return true;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if (m_ipCallNum[heur] && m_dTotalTime > m_dTimeFraction*getElapsedTime()) {
+		++m_ipSkipNum[heur];
+		flag=false;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return flag;
+} // end of CHeurScheduler::admit()
+
+int CHeurScheduler::select(int num, const int* ipHeur)
+{
+	double dpRate[HEUR_MAX_NUM], maxRate=0.0, score, bestScore=-1.0, logN;
+	int k, h, best=0, callNum=0;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	for (k=0; k < num && k < HEUR_MAX_NUM; ++k) {
+		if ((h=ipHeur[k]) < 0 || !m_ipCallNum[h]) { // heuristics not called yet are tried first
+			best=k;
+			bestScore=-2.0;
+			break;
+		}
+		callNum+=m_ipCallNum[h];
+		dpRate[k]=static_cast<double>(m_ipSolNum[h]+1)/(m_dpTime[h]+HEUR_TIME_PRIOR);
+		if (dpRate[k] > maxRate)
+			maxRate=dpRate[k];
+	}
+	if (bestScore > -2.0) {
+		logN=log(static_cast<double>(callNum));
+		for (k=0; k < num && k < HEUR_MAX_NUM; ++k) {
+			h=ipHeur[k];
+			score=dpRate[k]/maxRate+m_dExplore*sqrt(logN/static_cast<double>(m_ipCallNum[h]));
+			if (score > bestScore) {
+				bestScore=score;
+				best=k;
+			}
+		}
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return best;
+} // end of CHeurScheduler::select()
+
+double CHeurScheduler::getRemainingTime()
+{
+	double time;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	time=m_dTimeFraction*getElapsedTime()-m_dTotalTime;
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return time;
+} // end of CHeurScheduler::getRemainingTime()
+
+void CHeurScheduler::report(int heur, double time, bool improved)
+{
+	if (heur < 0)
+		return;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	++m_ipCallNum[heur];
+	if (improved)
+		++m_ipSolNum[heur];
+	m_dpTime[heur]+=time;
+	m_dTotalTime+=time;
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+} // end of CHeurScheduler::report()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CHeurScheduler::printStatistics(std::ostream &out)
+{
+	char str[128];
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if (!m_iHeurNum) { // no heuristic has been scheduled
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+		return;
+	}
+	out << "Heuristic scheduling\n";
+	out << "====== Heuristic ==== Calls === Skipped === Solutions ===== Time === Sols/sec\n";
+	for (int k=0; k < m_iHeurNum; ++k) {
+		sprintf(str,"%16s %10d %11d %13d %10.3f %12.3f\n",m_sName[k],m_ipCallNum[k],m_ipSkipNum[k],m_ipSolNum[k],m_dpTime[k],
+			(m_dpTime[k] > 0.0)? static_cast<double>(m_ipSolNum[k])/m_dpTime[k]: 0.0);
+		out << str;
+	}
+	sprintf(str,"Time in heuristics: %.3f, budget: %.3f\n",m_dTotalTime,m_dTimeFraction*getElapsedTime());
+	out << str;
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	out << std::endl;
+} // end of CHeurScheduler::printStatistics()
@@ -0,0 +1,194 @@
+// Incumbent.cpp: implementation of the CIncumbent class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <except.h>
+#include <lp.h>
+#include "Incumbent.h"
+#include "SolutionPool.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CIncumbent::CIncumbent()
+{
+	m_iNum.store(0);
+	m_iMaxNum.store(0);
+	m_dpX.store(0);
+	m_ipHd.store(0);
+	m_iOldNum=m_iMaxOldNum=0;
+	m_dppOldX=0;
+	m_ippOldHd=0;
+	m_pPool=0;
+	m_uVersion.store(0);
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+#endif
+	reset(true);
+} // end of CIncumbent::CIncumbent()
+
+CIncumbent::~CIncumbent()
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	if (m_dpX.load()) {
+		delete[] m_dpX.load();
+		delete[] m_ipHd.load();
+	}
+	freeOldArrays();
+	if (m_dppOldX) {
+		delete[] m_dppOldX;
+		delete[] m_ippOldHd;
+	}
+} // end of CIncumbent::~CIncumbent()
+
+void CIncumbent::freeOldArrays()
+{
+	for (int i=0; i < m_iOldNum; ++i) {
+		delete[] m_dppOldX[i];
+		delete[] m_ippOldHd[i];
+	}
+	m_iOldNum=0;
+} // end of CIncumbent::freeOldArrays()
+
+void CIncumbent::keepOldArrays()
+{
+	if (m_iOldNum == m_iMaxOldNum) {
+		int maxNum=(m_iMaxOldNum)? m_iMaxOldNum<<1: 4;
+		double **dppX;
+		int **ippHd;
+		if (!(dppX = new double*[maxNum]) || !(ippHd = new int*[maxNum])) {
+			throw new CMemoryException("CIncumbent::keepOldArrays");
+		}
+		if (m_dppOldX) {
+			memcpy(dppX,m_dppOldX,m_iOldNum*sizeof(double*));
+			memcpy(ippHd,m_ippOldHd,m_iOldNum*sizeof(int*));
+			delete[] m_dppOldX;
+			delete[] m_ippOldHd;
+		}
+		m_dppOldX=dppX;
+		m_ippOldHd=ippHd;
+		m_iMaxOldNum=maxNum;
+	}
+	m_dppOldX[m_iOldNum]=m_dpX.load(std::memory_order_relaxed);
+	m_ippOldHd[m_iOldNum++]=m_ipHd.load(std::memory_order_relaxed);
+} // end of CIncumbent::keepOldArrays()
+
+void CIncumbent::reset(bool sense, int maxNum)
+{
+	freeOldArrays(); // no reader is active when the solver is (re)started
+	if (maxNum > m_iMaxNum.load()) {
+		double *dpX=m_dpX.load();
+		int *ipHd=m_ipHd.load();
+		if (dpX) {
+			delete[] dpX;
+			delete[] ipHd;
+		}
+		m_dpX.store(0);
+		m_ipHd.store(0);
+		m_iMaxNum.store(0);
+		if (!(dpX = new double[maxNum])) {
+			throw new CMemoryException("CIncumbent::reset");
+		}
+		m_dpX.store(dpX);
+		if (!(ipHd = new int[maxNum])) {
+			throw new CMemoryException("CIncumbent::reset");
+		}
+		m_ipHd.store(ipHd);
+		m_iMaxNum.store(maxNum);
+	}
+	m_bSense=sense;
+	m_iNum.store(0);
+	m_dObjVal.store((sense)? -CLP::INF: CLP::INF);
+	m_dObjBound.store((sense)? CLP::INF: -CLP::INF);
+	m_iSolNum.store(0);
+} // end of CIncumbent::reset()
+
+//////////////////////////////////////////////////////////////////////
+// Publishing and reading
+//////////////////////////////////////////////////////////////////////
+bool CIncumbent::publish(double objVal, int n, const double* dpX, const int* ipHd)
+{
+	if (!isBetter(objVal))
+		return false;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if (!isBetter(objVal)) { // another thread has published a better solution
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+		return false;
+	}
+	if (n > m_iMaxNum.load(std::memory_order_relaxed)) {
+		int maxNum=n+(n>>2);
+		double *dpMem=0;
+		int *ipMem=0;
+		try {
+			if (!(dpMem = new double[maxNum]) || !(ipMem = new int[maxNum])) {
+				throw new CMemoryException("CIncumbent::publish");
+			}
+			if (m_dpX.load(std::memory_order_relaxed))
+				keepOldArrays(); // readers may still copy the replaced arrays
+		}
+		catch(CException*) {
+			if (dpMem)
+				delete[] dpMem;
+			if (ipMem)
+				delete[] ipMem;
+#ifndef __ONE_THREAD_
+			_MUTEX_UNLOCK(&m_mutex)
+#endif
+			throw;
+		}
+		m_uVersion.fetch_add(1,std::memory_order_acq_rel);
+		m_dpX.store(dpMem,std::memory_order_release);
+		m_ipHd.store(ipMem,std::memory_order_release);
+		m_iMaxNum.store(maxNum,std::memory_order_release); // after the arrays (see getSolution())
+	}
+	else
+		m_uVersion.fetch_add(1,std::memory_order_acq_rel);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_iNum.store(n,std::memory_order_relaxed);
+	memcpy(m_dpX.load(std::memory_order_relaxed),dpX,n*sizeof(double));
+	memcpy(m_ipHd.load(std::memory_order_relaxed),ipHd,n*sizeof(int));
+	m_dObjVal.store(objVal,std::memory_order_release);
+	m_uVersion.fetch_add(1,std::memory_order_release);
+	m_iSolNum.fetch_add(1,std::memory_order_release);
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return true;
+} // end of CIncumbent::publish()
+
+int CIncumbent::getSolution(double &objVal, int maxNum, double* dpX, int* ipHd) const
+{
+	unsigned v1, v2;
+	int n, size;
+	const double *dpRecX;
+	const int *ipRecHd;
+	do {
+		while ((v1=m_uVersion.load(std::memory_order_acquire)) & 1u)
+			; // writer is active
+		size=m_iMaxNum.load(std::memory_order_acquire); // before the arrays (see publish())
+		dpRecX=m_dpX.load(std::memory_order_acquire);
+		ipRecHd=m_ipHd.load(std::memory_order_acquire);
+		if ((n=m_iNum.load(std::memory_order_relaxed)) > size)
+			n=size; // the solution is being replaced, and the copy is rejected below
+		if (n && n <= maxNum) {
+			objVal=m_dObjVal.load(std::memory_order_relaxed);
+			memcpy(dpX,dpRecX,n*sizeof(double));
+			memcpy(ipHd,ipRecHd,n*sizeof(int));
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		v2=m_uVersion.load(std::memory_order_relaxed);
+	} while (v1 != v2);
+	return n;
+} // end of CIncumbent::getSolution()
+
+void CIncumbent::offer(int n, const double* dpX, const int* ipHd) const
+{
+	if (m_pPool)
+		m_pPool->add(n,dpX,ipHd);
+} // end of CIncumbent::offer()
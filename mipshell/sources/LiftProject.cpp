@@ -0,0 +1,713 @@
+// LiftProject.cpp: implementation of the CLiftProject class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <except.h>
+#include <lp.h>
+#include <Sort.h>
+#include "LiftProject.h"
+
+#define LIFTPROJECT_MIN_FRAC 0.01 ///< integer variables which fractional parts are less than `LIFTPROJECT_MIN_FRAC` or greater than `1-LIFTPROJECT_MIN_FRAC` are not used to generate cuts.
+#define LIFTPROJECT_ZERO 1.0e-11 ///< tableau entries which absolute values are not greater than `LIFTPROJECT_ZERO` are treated as zeroes.
+#define LIFTPROJECT_PIVOT_TOL 1.0e-9 ///< basic matrix is considered singular if a pivot is less than `LIFTPROJECT_PIVOT_TOL` times the maximum entry.
+#define LIFTPROJECT_MIN_SIDE 1.0e-6 ///< distances from the combined row constant to the disjunction sides must be greater than `LIFTPROJECT_MIN_SIDE`.
+#define LIFTPROJECT_MIN_GAIN 1.0e-3 ///< row combination is taken if it increases the distance to the cut by more than `LIFTPROJECT_MIN_GAIN` (relative).
+#define LIFTPROJECT_MIN_EFF 1.0e-4 ///< cuts which efficacies are not greater than `LIFTPROJECT_MIN_EFF` are discarded.
+#define LIFTPROJECT_MAX_DYN 1.0e8 ///< coefficients less than `1/LIFTPROJECT_MAX_DYN` times the maximum coefficient are removed from cuts.
+#define LIFTPROJECT_MAX_BASIS 500 ///< cuts are not generated if the basis has more than `LIFTPROJECT_MAX_BASIS` rows.
+#define LIFTPROJECT_MAX_CAND 20 ///< maximum number of candidate rows for combining.
+#define LIFTPROJECT_MAX_PIVOT 5 ///< maximum number of row combinations per cut.
+#define LIFTPROJECT_MAX_WORK 500000ll ///< maximum number of entries scanned when evaluating row combinations in one round.
+
+/**
+ * \param[in] c coefficient of \f$y_j\f$ in the row;
+ * \param[in] isInt if `true`, \f$y_j\f$ is integer;
+ * \param[in] d1,d2 distances from the row constant to the disjunction sides.
+ * \return coefficient of \f$y_j\f$ in the cut.
+ */
+static inline double cutCoeff(double c, bool isInt, double d1, double d2)
+{
+	if (isInt) {
+		double phi=c-floor(c);
+		return (phi*d2 < (1.0-phi)*d1)? phi/d1: (1.0-phi)/d2;
+	}
+	return (c >= 0.0)? c/d1: -c/d2;
+} // end of cutCoeff()
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CLiftProject::CLiftProject(int maxCutNum, int maxRoundNum, int maxCutSize, int maxHeight)
+{
+	if (!(m_pStat = new tagStat())) {
+		throw new CMemoryException("CLiftProject::CLiftProject");
+	}
+	m_bOwner=true;
+	m_iMaxCutNum=(maxCutNum > 0)? maxCutNum: 1;
+	m_iMaxRoundNum=maxRoundNum;
+	m_iMaxCutSize=maxCutSize;
+	m_iMaxHeight=maxHeight;
+	m_iNode=-1;
+	m_iRoundNum=0;
+	m_iColNum=m_iRowNum=m_iMaxColNum=m_iMaxRowNum=m_iMaxNZ=0;
+	m_dpX=m_dpL=m_dpU=m_dpB=m_dpVal=0;
+	m_cpState=m_cpInt=m_cpSide=0;
+	m_ipBeg=m_ipCol=0;
+	m_iCutNum=m_iMaxCutNZ=0;
+	m_dpCutVal=0;
+	m_ipCutCol=0;
+	if (!(m_dpCutRhs = new double[m_iMaxCutNum])) {
+		throw new CMemoryException("CLiftProject::CLiftProject");
+	}
+	if (!(m_ipCutBeg = new int[m_iMaxCutNum+1])) {
+		throw new CMemoryException("CLiftProject::CLiftProject");
+	}
+	m_ipCutBeg[0]=0;
+} // end of CLiftProject::CLiftProject()
+
+CLiftProject::CLiftProject(const CLiftProject &other)
+{
+	m_pStat=other.m_pStat;
+	m_bOwner=false;
+	m_iMaxCutNum=other.m_iMaxCutNum;
+	m_iMaxRoundNum=other.m_iMaxRoundNum;
+	m_iMaxCutSize=other.m_iMaxCutSize;
+	m_iMaxHeight=other.m_iMaxHeight;
+	m_iNode=-1;
+	m_iRoundNum=0;
+	m_iColNum=m_iRowNum=m_iMaxColNum=m_iMaxRowNum=m_iMaxNZ=0;
+	m_dpX=m_dpL=m_dpU=m_dpB=m_dpVal=0;
+	m_cpState=m_cpInt=m_cpSide=0;
+	m_ipBeg=m_ipCol=0;
+	m_iCutNum=m_iMaxCutNZ=0;
+	m_dpCutVal=0;
+	m_ipCutCol=0;
+	if (!(m_dpCutRhs = new double[m_iMaxCutNum])) {
+		throw new CMemoryException("CLiftProject::CLiftProject(const CLiftProject &other)");
+	}
+	if (!(m_ipCutBeg = new int[m_iMaxCutNum+1])) {
+		throw new CMemoryException("CLiftProject::CLiftProject(const CLiftProject &other)");
+	}
+	m_ipCutBeg[0]=0;
+} // end of CLiftProject::CLiftProject(const CLiftProject &other)
+
+CLiftProject::~CLiftProject()
+{
+	if (m_dpX)
+		delete[] m_dpX;
+	if (m_cpState)
+		delete[] m_cpState;
+	if (m_ipBeg)
+		delete[] m_ipBeg;
+	if (m_dpCutRhs)
+		delete[] m_dpCutRhs;
+	if (m_ipCutBeg)
+		delete[] m_ipCutBeg;
+	if (m_dpCutVal)
+		delete[] m_dpCutVal;
+	if (m_ipCutCol)
+		delete[] m_ipCutCol;
+	if (m_bOwner)
+		delete m_pStat;
+} // end of CLiftProject::~CLiftProject()
+
+bool CLiftProject::startRound(int node, int height)
+{
+	if (height > m_iMaxHeight)
+		return false;
+	if (node != m_iNode) {
+		m_iNode=node;
+		m_iRoundNum=0;
+	}
+	return (m_iRoundNum++ < m_iMaxRoundNum)? true: false;
+} // end of CLiftProject::startRound()
+
+void CLiftProject::allocMem(int n, int rowNum, int nz)
+{
+	if (n > m_iMaxColNum || rowNum > m_iMaxRowNum || nz > m_iMaxNZ) {
+		if (m_dpX)
+			delete[] m_dpX;
+		if (m_cpState)
+			delete[] m_cpState;
+		if (m_ipBeg)
+			delete[] m_ipBeg;
+		m_cpState=0;
+		m_ipBeg=0;
+		m_iMaxColNum=m_iMaxRowNum=m_iMaxNZ=0;
+		if (n < m_iMaxColNum)
+			n=m_iMaxColNum;
+		if (rowNum < m_iMaxRowNum)
+			rowNum=m_iMaxRowNum;
+		if (nz < m_iMaxNZ)
+			nz=m_iMaxNZ;
+		if (!(m_dpX = new double[3*n+rowNum+nz]) || !(m_cpState = new char[(n<<1)+rowNum]) ||
+			!(m_ipBeg = new int[rowNum+1+nz])) {
+			throw new CMemoryException("CLiftProject::allocMem");
+		}
+		m_dpL=m_dpX+n;
+		m_dpU=m_dpL+n;
+		m_dpB=m_dpU+n;
+		m_dpVal=m_dpB+rowNum;
+		m_cpInt=m_cpState+n;
+		m_cpSide=m_cpInt+n;
+		m_ipCol=m_ipBeg+rowNum+1;
+		m_iMaxColNum=n;
+		m_iMaxRowNum=rowNum;
+		m_iMaxNZ=nz;
+	}
+	m_iColNum=n;
+	m_iRowNum=0;
+	m_ipBeg[0]=0;
+} // end of CLiftProject::allocMem()
+
+void CLiftProject::addCut(int sz, const double* dpVal, const int* ipCol, double b)
+{
+	int nz=m_ipCutBeg[m_iCutNum];
+	if (nz+sz > m_iMaxCutNZ) {
+		int maxNZ=(nz+sz) << 1;
+		double *dpCutVal;
+		int *ipCutCol;
+		if (!(dpCutVal = new double[maxNZ])) {
+			throw new CMemoryException("CLiftProject::addCut");
+		}
+		if (!(ipCutCol = new int[maxNZ])) {
+			delete[] dpCutVal;
+			throw new CMemoryException("CLiftProject::addCut");
+		}
+		if (nz) {
+			memcpy(dpCutVal,m_dpCutVal,nz*sizeof(double));
+			memcpy(ipCutCol,m_ipCutCol,nz*sizeof(int));
+		}
+		if (m_dpCutVal)
+			delete[] m_dpCutVal;
+		if (m_ipCutCol)
+			delete[] m_ipCutCol;
+		m_dpCutVal=dpCutVal;
+		m_ipCutCol=ipCutCol;
+		m_iMaxCutNZ=maxNZ;
+	}
+	memcpy(m_dpCutVal+nz,dpVal,sz*sizeof(double));
+	memcpy(m_ipCutCol+nz,ipCol,sz*sizeof(int));
+	m_dpCutRhs[m_iCutNum]=b;
+	m_ipCutBeg[++m_iCutNum]=nz+sz;
+} // end of CLiftProject::addCut()
+
+//////////////////////////////////////////////////////////////////////
+// Tableau
+//////////////////////////////////////////////////////////////////////
+bool CLiftProject::factor(double* dpLU, int* ipPerm, const int* ipPos) const
+{
+	int p=m_iRowNum, r, q;
+	double a, maxVal=0.0, *dpRow, *dpPivRow;
+	memset(dpLU,0,p*p*sizeof(double));
+	for (int t=0; t < p; ++t) {
+		ipPerm[t]=t;
+		dpRow=dpLU+t*p;
+		for (int k=m_ipBeg[t]; k < m_ipBeg[t+1]; ++k) {
+			if ((q=ipPos[m_ipCol[k]]) >= 0) {
+				dpRow[q]+=m_dpVal[k];
+				if (fabs(dpRow[q]) > maxVal)
+					maxVal=fabs(dpRow[q]);
+			}
+		}
+	}
+	for (int c=0; c < p; ++c) {
+		for (a=0.0, q=r=c; r < p; ++r) {
+			if (fabs(dpLU[r*p+c]) > a) {
+				a=fabs(dpLU[r*p+c]);
+				q=r;
+			}
+		}
+		if (a <= LIFTPROJECT_PIVOT_TOL*maxVal)
+			return false;
+		if (q != c) {
+			for (int s=0; s < p; ++s) {
+				a=dpLU[q*p+s];
+				dpLU[q*p+s]=dpLU[c*p+s];
+				dpLU[c*p+s]=a;
+			}
+			r=ipPerm[q];
+			ipPerm[q]=ipPerm[c];
+			ipPerm[c]=r;
+		}
+		dpPivRow=dpLU+c*p;
+		for (r=c+1; r < p; ++r) {
+			dpRow=dpLU+r*p;
+			if (dpRow[c] != 0.0) {
+				a=(dpRow[c]/=dpPivRow[c]);
+				for (int s=c+1; s < p; ++s) {
+					dpRow[s]-=a*dpPivRow[s];
+				}
+			}
+		}
+	}
+	return true;
+} // end of CLiftProject::factor()
+
+int CLiftProject::tableauRow(int q, const double* dpLU, const int* ipPerm, double* dpU, double* dpRow, int* ipSupp, char* cpMark) const
+{
+	int j, t, sz=0, n=m_iColNum, p=m_iRowNum;
+	double a, *dpZ=dpU+p;
+// u^T B = e_q^T, where P*B = L*U; first z^T U = e_q^T, and then w^T L = z^T, u[ipPerm[i]]=w[i]
+	for (int i=0; i < p; ++i) {
+		a=(i == q)? 1.0: 0.0;
+		for (int r=0; r < i; ++r) {
+			a-=dpLU[r*p+i]*dpZ[r];
+		}
+		dpZ[i]=a/dpLU[i*p+i];
+	}
+	for (int i=p-1; i >= 0; --i) {
+		a=dpZ[i];
+		for (int r=i+1; r < p; ++r) {
+			a-=dpLU[r*p+i]*dpZ[r];
+		}
+		dpZ[i]=a;
+		dpU[ipPerm[i]]=a;
+	}
+// x_k = u^T b - sum(alpha_j x_j: j non-basic) - sum(u_t side_t y_{n+t}), where alpha = u^T A
+	for (t=0; t < p; ++t) {
+		if (fabs(a=dpU[t]) <= LIFTPROJECT_ZERO)
+			continue;
+		for (int k=m_ipBeg[t]; k < m_ipBeg[t+1]; ++k) {
+			j=m_ipCol[k];
+			if (m_cpState[j] && m_dpL[j] < m_dpU[j]) {
+				if (!cpMark[j]) {
+					cpMark[j]=1;
+					ipSupp[sz++]=j;
+				}
+				dpRow[j]+=a*m_dpVal[k];
+			}
+		}
+		if (m_cpSide[t]) {
+			dpRow[n+t]=a*m_cpSide[t];
+			cpMark[n+t]=1;
+			ipSupp[sz++]=n+t;
+		}
+	}
+	int sz0=sz;
+	for (sz=t=0; t < sz0; ++t) {
+		cpMark[j=ipSupp[t]]=0;
+		if (fabs(dpRow[j]) <= LIFTPROJECT_ZERO)
+			dpRow[j]=0.0;
+		else {
+			if (j < n && m_cpState[j] > 0)
+				dpRow[j]=-dpRow[j]; // y_j = u_j - x_j
+			ipSupp[sz++]=j;
+		}
+	}
+	return sz;
+} // end of CLiftProject::tableauRow()
+
+//////////////////////////////////////////////////////////////////////
+// Separation
+//////////////////////////////////////////////////////////////////////
+int CLiftProject::separate()
+{
+	int n=m_iColNum, p=m_iRowNum, ny=n+p, basicNum=0;
+	m_iCutNum=0;
+	if (!p || p > LIFTPROJECT_MAX_BASIS)
+		return 0;
+	for (int j=0; j < n; ++j) {
+		if (!m_cpState[j])
+			++basicNum;
+	}
+	if (basicNum != p)
+		return 0;
+	std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+	m_pStat->roundNum.fetch_add(1,std::memory_order_relaxed);
+
+	double *dpMem, *dpLU, *dpU, *dpC, *dpBi, *dpYb, *dpA, *dpKey, *dpCandVal=0, *dpCandYb;
+	int *ipMem, *ipPerm, *ipPos, *ipSupp, *ipUnion, *ipSrc, *ipCand, *ipCandBeg, *ipCutCol, *ipCandCol=0, *ipCandSide;
+	char *cpMem, *cpMark, *cpYInt, *cpInSupp;
+	int i, j, k, t, q, sz, candNum=0, srcNum=0, candNZ=0, maxCandNZ;
+	double a, x, f;
+	long long work=0;
+	if (!(dpMem = new double[p*p+(p<<1)+3*ny+(n<<1)+LIFTPROJECT_MAX_CAND])) {
+		throw new CMemoryException("CLiftProject::separate");
+	}
+	if (!(ipMem = new int[p+(n<<2)+(ny<<1)+(LIFTPROJECT_MAX_CAND<<1)+1])) {
+		delete[] dpMem;
+		throw new CMemoryException("CLiftProject::separate");
+	}
+	if (!(cpMem = new char[3*ny])) {
+		delete[] ipMem;
+		delete[] dpMem;
+		throw new CMemoryException("CLiftProject::separate");
+	}
+	dpLU=dpMem;
+	dpU=dpLU+p*p;
+	dpC=dpU+(p<<1);
+	dpBi=dpC+ny;
+	dpYb=dpBi+ny;
+	dpA=dpYb+ny;
+	dpKey=dpA+n;
+	dpCandYb=dpKey+n;
+	ipPerm=ipMem;
+	ipPos=ipPerm+p;
+	ipSrc=ipPos+n;
+	ipCand=ipSrc+n;
+	ipCutCol=ipCand+n;
+	ipSupp=ipCutCol+n;
+	ipUnion=ipSupp+ny;
+	ipCandBeg=ipUnion+ny;
+	ipCandSide=ipCandBeg+LIFTPROJECT_MAX_CAND+1;
+	cpMark=cpMem;
+	cpYInt=cpMark+ny;
+	cpInSupp=cpYInt+ny;
+	memset(cpMem,0,3*ny);
+	memset(dpC,0,(ny<<1)*sizeof(double));
+	memset(dpA,0,n*sizeof(double));
+	try {
+		for (q=j=0; j < n; ++j) {
+			ipPos[j]=(m_cpState[j])? -1: q++;
+		}
+		if (!factor(dpLU,ipPerm,ipPos))
+			throw 0;
+	// values of y-variables, and their types: 1 - integer, 2 - free (cuts must not contain free variables)
+		for (j=0; j < n; ++j) {
+			if (!m_cpState[j]) {
+				dpYb[j]=0.0;
+				x=m_dpX[j];
+				f=x-floor(x);
+				if (m_cpInt[j] && f >= LIFTPROJECT_MIN_FRAC && f <= 1.0-LIFTPROJECT_MIN_FRAC) {
+					dpKey[j]=fabs(f-0.5);
+					ipSrc[srcNum++]=j;
+				}
+				else {
+					a=(x-m_dpL[j] < m_dpU[j]-x)? x-m_dpL[j]: m_dpU[j]-x;
+					if (a < CLP::VAR_INF) {
+						dpKey[j]=a;
+						ipCand[candNum++]=j;
+					}
+				}
+				continue;
+			}
+			a=(m_cpState[j] < 0)? m_dpL[j]: m_dpU[j];
+			if (a <= -CLP::VAR_INF || a >= CLP::VAR_INF) {
+				cpYInt[j]=2;
+				dpYb[j]=0.0;
+			}
+			else {
+				dpYb[j]=(m_cpState[j] < 0)? m_dpX[j]-a: a-m_dpX[j];
+				if (dpYb[j] < 0.0)
+					dpYb[j]=0.0;
+				if (m_cpInt[j] && a == floor(a))
+					cpYInt[j]=1;
+			}
+		}
+		for (t=0; t < p; ++t) {
+			for (a=0.0, k=m_ipBeg[t]; k < m_ipBeg[t+1]; ++k) {
+				a+=m_dpVal[k]*m_dpX[m_ipCol[k]];
+			}
+			dpYb[n+t]=(m_cpSide[t])? m_cpSide[t]*(m_dpB[t]-a): 0.0;
+			if (dpYb[n+t] < 0.0)
+				dpYb[n+t]=0.0;
+		}
+		SORT::incSortDouble(srcNum,ipSrc,dpKey);
+	// fractional sources may also serve as candidates, but the closest to their bounds go first
+		for (i=0; i < srcNum; ++i) {
+			j=ipSrc[i];
+			x=m_dpX[j];
+			a=(x-m_dpL[j] < m_dpU[j]-x)? x-m_dpL[j]: m_dpU[j]-x;
+			if (a < CLP::VAR_INF) {
+				dpKey[j]=a;
+				ipCand[candNum++]=j;
+			}
+		}
+		SORT::incSortDouble(candNum,ipCand,dpKey);
+		if (candNum > LIFTPROJECT_MAX_CAND)
+			candNum=LIFTPROJECT_MAX_CAND;
+	// rows of candidates: (y_i - yb_i) + sum(b_j (y_j - yb_j)) = 0
+		maxCandNZ=(ny < 1024)? candNum*ny: candNum*1024;
+		if (!(dpCandVal = new double[maxCandNZ]) || !(ipCandCol = new int[maxCandNZ])) {
+			throw new CMemoryException("CLiftProject::separate");
+		}
+		ipCandBeg[0]=0;
+		for (int c=0; c < candNum; ++c) {
+			i=ipCand[c];
+			sz=tableauRow(ipPos[i],dpLU,ipPerm,dpU,dpC,ipSupp,cpMark);
+			x=m_dpX[i];
+			ipCandSide[c]=(x-m_dpL[i] < m_dpU[i]-x)? -1: 1;
+			dpCandYb[c]=(ipCandSide[c] < 0)? x-m_dpL[i]: m_dpU[i]-x;
+			for (t=0; t < sz; ++t) {
+				if (cpYInt[ipSupp[t]] == 2)
+					break;
+			}
+			if (t < sz || candNZ+sz > maxCandNZ) {
+				ipCandSide[c]=0; // row contains free variables, or there is no memory left
+				sz=0;
+			}
+			for (t=0; t < sz; ++t) {
+				j=ipSupp[t];
+				dpCandVal[candNZ]=(ipCandSide[c] < 0)? dpC[j]: -dpC[j];
+				ipCandCol[candNZ++]=j;
+			}
+			for (t=0; t < sz; ++t) {
+				dpC[ipSupp[t]]=0.0;
+			}
+			ipCandBeg[c+1]=candNZ;
+		}
+
+		for (int s=0; s < srcNum && m_iCutNum < m_iMaxCutNum && work < LIFTPROJECT_MAX_WORK; ++s) {
+			int kCol=ipSrc[s], usedNum=0;
+			double F=floor(m_dpX[kCol]), score, bestScore, bestGamma;
+			sz=tableauRow(ipPos[kCol],dpLU,ipPerm,dpU,dpC,ipSupp,cpMark);
+			for (t=0; t < sz; ++t) {
+				if (cpYInt[ipSupp[t]] == 2)
+					break;
+				cpInSupp[ipSupp[t]]=1;
+			}
+			if (t < sz) { // row contains free variables
+				for (t=0; t < sz; ++t) {
+					cpInSupp[ipSupp[t]]=0;
+					dpC[ipSupp[t]]=0.0;
+				}
+				continue;
+			}
+		// combining rows
+			for (bestScore=-1.0;;) {
+				int bestCand=-1, unionNum;
+				bestGamma=0.0;
+				for (int c=-1; c < candNum; ++c) {
+					unionNum=0;
+					if (c >= 0) {
+						if (!ipCandSide[c] || ipCand[c] == kCol || cpInSupp[ipCand[c]])
+							continue;
+						for (k=ipCandBeg[c]; k < ipCandBeg[c+1]; ++k) {
+							j=ipCandCol[k];
+							dpBi[j]=dpCandVal[k];
+							if (!cpInSupp[j])
+								ipUnion[unionNum++]=j;
+						}
+					}
+					int bp=(c >= 0)? ipCandBeg[c]: -1;
+					for (;;) {
+						double gamma=0.0, c0, d1, d2, lhs=0.0, nrm=0.0, pi, cj;
+						if (c >= 0) {
+							if (bp >= ipCandBeg[c+1])
+								break;
+							j=ipCandCol[bp++];
+							if (fabs(dpBi[j]) <= LIFTPROJECT_ZERO || dpC[j] == 0.0)
+								continue;
+							gamma=dpC[j]/dpBi[j];
+						}
+					// c0 = x_k + sum(c_j yb_j), the cut is evaluated at yb
+						c0=m_dpX[kCol];
+						for (t=0; t < sz; ++t) {
+							j=ipSupp[t];
+							c0+=(dpC[j]-gamma*dpBi[j])*dpYb[j];
+						}
+						for (t=0; t < unionNum; ++t) {
+							j=ipUnion[t];
+							c0-=gamma*dpBi[j]*dpYb[j];
+						}
+						if (c >= 0)
+							c0-=gamma*dpCandYb[c];
+						work+=sz+unionNum;
+						d1=c0-F;
+						d2=F+1.0-c0;
+						if (d1 > LIFTPROJECT_MIN_SIDE && d2 > LIFTPROJECT_MIN_SIDE) {
+							for (t=0; t < sz; ++t) {
+								j=ipSupp[t];
+								if (fabs(cj=dpC[j]-gamma*dpBi[j]) > LIFTPROJECT_ZERO) {
+									pi=cutCoeff(cj,(cpYInt[j] == 1)? true: false,d1,d2);
+									lhs+=pi*dpYb[j];
+									nrm+=pi*pi;
+								}
+							}
+							for (t=0; t < unionNum; ++t) {
+								j=ipUnion[t];
+								if (fabs(cj=-gamma*dpBi[j]) > LIFTPROJECT_ZERO) {
+									pi=cutCoeff(cj,(cpYInt[j] == 1)? true: false,d1,d2);
+									lhs+=pi*dpYb[j];
+									nrm+=pi*pi;
+								}
+							}
+							if (c >= 0) {
+								i=ipCand[c];
+								pi=cutCoeff(-gamma,(m_cpInt[i] && ((ipCandSide[c] < 0)? m_dpL[i]: m_dpU[i]) ==
+									floor((ipCandSide[c] < 0)? m_dpL[i]: m_dpU[i]))? true: false,d1,d2);
+								lhs+=pi*dpCandYb[c];
+								nrm+=pi*pi;
+							}
+							if (lhs < 1.0 && nrm > 0.0) {
+								score=(1.0-lhs)/sqrt(nrm);
+								if (score > bestScore*(1.0+LIFTPROJECT_MIN_GAIN) || (c < 0 && score > bestScore)) {
+									bestScore=score;
+									bestCand=c;
+									bestGamma=gamma;
+								}
+							}
+						}
+						if (c < 0 || work >= LIFTPROJECT_MAX_WORK)
+							break;
+					}
+					if (c >= 0) {
+						for (k=ipCandBeg[c]; k < ipCandBeg[c+1]; ++k) {
+							dpBi[ipCandCol[k]]=0.0;
+						}
+					}
+					if (work >= LIFTPROJECT_MAX_WORK)
+						break;
+				}
+				if (bestCand < 0 || usedNum >= LIFTPROJECT_MAX_PIVOT)
+					break;
+			// row k += bestGamma * row of candidate
+				for (k=ipCandBeg[bestCand]; k < ipCandBeg[bestCand+1]; ++k) {
+					j=ipCandCol[k];
+					if (!cpInSupp[j]) {
+						cpInSupp[j]=1;
+						ipSupp[sz++]=j;
+					}
+					dpC[j]-=bestGamma*dpCandVal[k];
+				}
+				i=ipCand[bestCand];
+				cpInSupp[i]=1;
+				ipSupp[sz++]=i;
+				dpC[i]=-bestGamma;
+				dpYb[i]=dpCandYb[bestCand];
+				m_cpState[i]=static_cast<char>(ipCandSide[bestCand]); // x_i becomes non-basic
+				a=(ipCandSide[bestCand] < 0)? m_dpL[i]: m_dpU[i];
+				cpYInt[i]=(m_cpInt[i] && a == floor(a))? 1: 0;
+				++usedNum;
+				m_pStat->pivotNum.fetch_add(1,std::memory_order_relaxed);
+			}
+		// cut sum(pi_j y_j) >= 1 written in terms of x
+			if (bestScore > 0.0) {
+				double c0=m_dpX[kCol], d1, d2, pi, b=1.0, maxVal=0.0, act=0.0, nrm=0.0;
+				int cutSz=0;
+				bool ok=true;
+				for (t=0; t < sz; ++t) {
+					j=ipSupp[t];
+					c0+=dpC[j]*dpYb[j];
+				}
+				d1=c0-F;
+				d2=F+1.0-c0;
+				for (t=0; t < sz; ++t) {
+					j=ipSupp[t];
+					if (fabs(dpC[j]) <= LIFTPROJECT_ZERO)
+						continue;
+					pi=cutCoeff(dpC[j],(cpYInt[j] == 1)? true: false,d1,d2);
+					if (j < n) {
+						if (m_cpState[j] < 0) {
+							dpA[j]+=pi;
+							b+=pi*m_dpL[j];
+						}
+						else {
+							dpA[j]-=pi;
+							b-=pi*m_dpU[j];
+						}
+					}
+					else {
+						q=j-n;
+						a=-m_cpSide[q]*pi;
+						for (k=m_ipBeg[q]; k < m_ipBeg[q+1]; ++k) {
+							dpA[m_ipCol[k]]+=a*m_dpVal[k];
+						}
+						b+=a*m_dpB[q];
+					}
+				}
+			// collect non-zero coefficients; rows may bring in any column
+				for (t=0; t < sz; ++t) {
+					j=ipSupp[t];
+					if (j < n) {
+						if (dpA[j] != 0.0 && !cpMark[j]) {
+							cpMark[j]=1;
+							ipCutCol[cutSz++]=j;
+						}
+					}
+					else {
+						q=j-n;
+						for (k=m_ipBeg[q]; k < m_ipBeg[q+1]; ++k) {
+							if (dpA[i=m_ipCol[k]] != 0.0 && !cpMark[i]) {
+								cpMark[i]=1;
+								ipCutCol[cutSz++]=i;
+							}
+						}
+					}
+				}
+				for (t=0; t < cutSz; ++t) {
+					cpMark[j=ipCutCol[t]]=0;
+					if (fabs(dpA[j]) > maxVal)
+						maxVal=fabs(dpA[j]);
+				}
+			// small coefficients are removed by relaxing the right hand side with bounds of their columns
+				for (k=t=0; t < cutSz; ++t) {
+					a=dpA[j=ipCutCol[t]];
+					dpA[j]=0.0;
+					if (fabs(a) <= maxVal/LIFTPROJECT_MAX_DYN) {
+						x=(a > 0.0)? m_dpU[j]: m_dpL[j];
+						if (x <= -CLP::VAR_INF || x >= CLP::VAR_INF)
+							ok=false;
+						else
+							b-=a*x;
+					}
+					else {
+						dpKey[k]=a;
+						ipCutCol[k++]=j;
+						act+=a*m_dpX[j];
+						nrm+=a*a;
+					}
+				}
+				cutSz=k;
+				if (ok && cutSz && (!m_iMaxCutSize || cutSz <= m_iMaxCutSize) && b-act > LIFTPROJECT_MIN_EFF*sqrt(nrm)) {
+					for (t=0; t < cutSz; ++t) {
+						dpKey[t]/=maxVal;
+					}
+					addCut(cutSz,dpKey,ipCutCol,b/maxVal);
+					m_pStat->cutNum.fetch_add(1,std::memory_order_relaxed);
+				}
+			}
+		// restore basic candidates and clean working arrays
+			for (t=0; t < sz; ++t) {
+				j=ipSupp[t];
+				cpInSupp[j]=0;
+				dpC[j]=0.0;
+				if (j < n && ipPos[j] >= 0) {
+					m_cpState[j]=0;
+					dpYb[j]=0.0;
+					cpYInt[j]=0;
+				}
+			}
+		}
+	}
+	catch(CMemoryException* pe) {
+		if (ipCandCol)
+			delete[] ipCandCol;
+		if (dpCandVal)
+			delete[] dpCandVal;
+		delete[] cpMem;
+		delete[] ipMem;
+		delete[] dpMem;
+		throw pe;
+	}
+	catch(int) { // basic matrix is singular
+	}
+	if (ipCandCol)
+		delete[] ipCandCol;
+	if (dpCandVal)
+		delete[] dpCandVal;
+	delete[] cpMem;
+	delete[] ipMem;
+	delete[] dpMem;
+	m_pStat->lTime.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now()-startTime).count(),std::memory_order_relaxed);
+	return m_iCutNum;
+} // end of CLiftProject::separate()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CLiftProject::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	out << "Lift-and-project cuts\n";
+	out << "===== Rounds ======= Cuts === Combinations ===== Time\n";
+	sprintf(str,"%12d %10d %14d %12.3f\n",m_pStat->roundNum.load(std::memory_order_relaxed),
+		m_pStat->cutNum.load(std::memory_order_relaxed),m_pStat->pivotNum.load(std::memory_order_relaxed),
+		1.0e-6*static_cast<double>(m_pStat->lTime.load(std::memory_order_relaxed)));
+	out << str << std::endl;
+} // end of CLiftProject::printStatistics()
@@ -0,0 +1,446 @@
+// Lns.cpp: implementation of the CLns class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <thread>
+#include <chrono>
+#include <except.h>
+#include <cmip.h>
+#include "Incumbent.h"
+#include "HeurScheduler.h"
+#include "Lns.h"
+
+#define LNS_TOL 1.0e-6 ///< integrality tolerance.
+#define LNS_WAIT 50 ///< time (in milliseconds) the spare thread sleeps while waiting for a new record solution.
+
+static const char* nbhName[CLns::LNS_NUM]={"RENS","RINS","local branching"}; ///< names of neighbourhoods.
+
+/**
+ * `CLnsSolver` solves a sub-MIP built by `CLns`, and reports its solutions to `CLns`.
+ */
+class CLnsSolver: public CMIP
+{
+	CLns* m_pLns; ///< LNS object which built this sub-MIP.
+	int m_iNodeNum; ///< number of nodes processed.
+	bool m_bStopped; ///< `true` if node limit has been exceeded, or `CLns` has asked to stop.
+	bool m_bImproved; ///< `true` if an improving solution has been found.
+public:
+	/**
+	 * The constructor.
+	 * \param[in] pLns LNS object.
+	 */
+	CLnsSolver(CLns* pLns): CMIP("lns")
+		{m_pLns=pLns; m_iNodeNum=0; m_bStopped=m_bImproved=false;}
+
+	bool isImproved() const
+		{return m_bImproved;} ///< \return `true` if an improving solution has been found.
+
+	/**
+	 * The function overloads `CMIP::changeRecord()` to report new solutions to `m_pLns`.
+	 * \param[in]  objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`.
+	 */
+	void changeRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd);
+
+protected:
+	/**
+	 * When the node limit is exceeded, or `m_pLns` has asked to stop, the function creates
+	 * one branch which is always infeasible; so, all the remaining nodes are pruned.
+	 * \param[in] nodeHeight height of the node.
+	 * \return number of branches.
+	 */
+	int startBranching(int nodeHeight);
+
+	bool updateBranch(int i)
+		{return (m_bStopped)? false: CMIP::updateBranch(i);} ///< The only branch created after stopping is infeasible.
+};
+
+void CLnsSolver::changeRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd)
+{
+	CMIP::changeRecord(objVal,n,dpX,ipHd);
+	m_pLns->setRecord(objVal,n,dpX,ipHd);
+	m_bImproved=true;
+} // end of CLnsSolver::changeRecord()
+
+int CLnsSolver::startBranching(int nodeHeight)
+{
+	if (m_bStopped || ++m_iNodeNum > m_pLns->m_iNodeLimit || m_pLns->m_bStop.load(std::memory_order_relaxed)) {
+		m_bStopped=true;
+		return 1;
+	}
+	return CMIP::startBranching(nodeHeight);
+} // end of CLnsSolver::startBranching()
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CLns::CLns(int nodeLimit, int timeLimit, double minFixRate, int radius)
+{
+	m_iNodeLimit=(nodeLimit > 0)? nodeLimit: 1;
+	m_iTimeLimit=(timeLimit > 0)? timeLimit: 1;
+	m_dMinFixRate=minFixRate;
+	m_iRadius=(radius > 0)? radius: 1;
+	m_pInc=0;
+	m_pSched=0;
+	m_bStop=false;
+	m_bStarted=false;
+	m_bLp=false;
+	m_dpLpX=0;
+	m_bRec=false;
+	m_dRecObj=0.0;
+	m_iRecNum=0;
+	m_dpRecX=0;
+	m_ipRecHd=0;
+	for (int k=0; k < LNS_NUM; ++k) {
+		m_ipCallNum[k]=m_ipSolNum[k]=0;
+		m_dpTime[k]=0.0;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+	m_bThread=false;
+#endif
+} // end of CLns::CLns()
+
+CLns::~CLns()
+{
+	stop();
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	if (m_dpLpX)
+		delete[] m_dpLpX;
+	if (m_dpRecX) {
+		delete[] m_dpRecX;
+		delete[] m_ipRecHd;
+	}
+} // end of CLns::~CLns()
+
+void CLns::setLpSolution(int n, const double* dpX, const int* ipHd)
+{
+	int n0=m_copy.getColNum();
+	if (!m_dpLpX) {
+		if (!(m_dpLpX = new double[n0])) {
+			throw new CMemoryException("CLns::setLpSolution");
+		}
+	}
+	for (int j=0; j < n0; ++j) {
+		m_dpLpX[j]=m_copy.getLoBound(j); // variables deleted by the solver are at their bounds
+		if (m_dpLpX[j] <= -CLP::INF)
+			m_dpLpX[j]=(m_copy.getUpBound(j) < CLP::INF)? m_copy.getUpBound(j): 0.0;
+	}
+	for (int i=0; i < n; ++i) {
+		if (ipHd[i] >= 0 && ipHd[i] < n0)
+			m_dpLpX[ipHd[i]]=dpX[i];
+	}
+	m_bLp=true;
+} // end of CLns::setLpSolution()
+
+void CLns::setRecord(double objVal, int n, const double* dpX, const int* ipHd)
+{
+	if (m_pInc)
+		m_pInc->offer(n,dpX,ipHd);
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if ((!m_iRecNum || ((m_copy.getSense())? objVal > m_dRecObj: objVal < m_dRecObj)) &&
+			(!m_pInc || m_pInc->isBetter(objVal))) {
+		if (n > m_iRecNum || !m_dpRecX) {
+			if (m_dpRecX) {
+				delete[] m_dpRecX;
+				delete[] m_ipRecHd;
+			}
+			m_ipRecHd=0;
+			if (!(m_dpRecX = new double[n]) || !(m_ipRecHd = new int[n])) {
+#ifndef __ONE_THREAD_
+				_MUTEX_UNLOCK(&m_mutex)
+#endif
+				throw new CMemoryException("CLns::setRecord");
+			}
+		}
+		m_dRecObj=objVal;
+		m_iRecNum=n;
+		memcpy(m_dpRecX,dpX,n*sizeof(double));
+		memcpy(m_ipRecHd,ipHd,n*sizeof(int));
+		m_bRec=true;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+} // end of CLns::setRecord()
+
+//////////////////////////////////////////////////////////////////////
+// Neighbourhood search
+//////////////////////////////////////////////////////////////////////
+bool CLns::solveSubMip(int nbh, const double* dpRecX, double recObj)
+{
+	const double* dpVal;
+	const int* ipCol;
+	int m=m_copy.getRowNum(), n=m_copy.getColNum(), j, sz, nz=0, intNum=0, fixNum=0, binNum=0, *ipRowCol;
+	double *dpMem, lb, ub, x, b;
+	bool intObj=true, improved=false;
+	std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+	for (int i=0; i < m; ++i) {
+		nz+=m_copy.getRow(i,dpVal,ipCol);
+	}
+	if (!(dpMem = new double[3*n+(n+1)/2+1])) {
+		throw new CMemoryException("CLns::solveSubMip");
+	}
+	double *dpD=dpMem, *dpRowVal=dpD+(n<<1);
+	ipRowCol=reinterpret_cast<int*>(dpRowVal+n);
+
+// bounds of sub-MIP
+	for (j=0; j < n; ++j) {
+		dpD[j<<1]=lb=m_copy.getLoBound(j);
+		dpD[(j<<1)+1]=ub=m_copy.getUpBound(j);
+		if (!m_copy.isInteger(j)) {
+			if (m_copy.getObjCoeff(j) != 0.0)
+				intObj=false;
+			continue;
+		}
+		if (m_copy.getObjCoeff(j) != floor(m_copy.getObjCoeff(j)))
+			intObj=false;
+		++intNum;
+		if (lb == 0.0 && ub == 1.0)
+			++binNum;
+		if (nbh == LNS_RENS) {
+			x=m_dpLpX[j];
+			if (fabs(x-floor(x+0.5)) < LNS_TOL) {
+				dpD[j<<1]=dpD[(j<<1)+1]=floor(x+0.5);
+				++fixNum;
+			}
+			else {
+				dpD[j<<1]=floor(x);
+				dpD[(j<<1)+1]=ceil(x);
+			}
+		}
+		else if (nbh == LNS_RINS) {
+			if (fabs(dpRecX[j]-m_dpLpX[j]) < LNS_TOL) {
+				dpD[j<<1]=dpD[(j<<1)+1]=floor(dpRecX[j]+0.5);
+				++fixNum;
+			}
+		}
+	}
+	if (!intNum || (nbh == LNS_LOCAL_BRANCHING && !binNum) ||
+			(nbh != LNS_LOCAL_BRANCHING && fixNum < m_dMinFixRate*intNum)) {
+		delete[] dpMem;
+		return false;
+	}
+	if (m_pSched && !m_pSched->admit(m_ipHeur[nbh])) { // the time budget of heuristics is exhausted
+		delete[] dpMem;
+		return false;
+	}
+
+	++m_ipCallNum[nbh];
+	try {
+		CLnsSolver mip(this);
+		mip.beSilent();
+#ifndef __ONE_THREAD_
+		mip.setThreadNum(1);
+#endif
+		mip.openMatrix(m+2,n,nz+(n<<1));
+		mip.setObjSense(m_copy.getSense());
+		for (j=0; j < n; ++j) {
+			mip.addVar(j,m_copy.getVarType(j),m_copy.getObjCoeff(j),dpD[j<<1],dpD[(j<<1)+1]);
+			if (m_copy.isInteger(j))
+				mip.setVarPriority(j,m_copy.getVarPriority(j));
+		}
+		for (int i=0; i < m; ++i) {
+			sz=m_copy.getRow(i,dpVal,ipCol);
+			memcpy(dpRowVal,dpVal,sz*sizeof(double));
+			memcpy(ipRowCol,ipCol,sz*sizeof(int));
+			mip.addRow(i,m_copy.getCtrType(i),m_copy.getRowLoBound(i),m_copy.getRowUpBound(i),sz,dpRowVal,ipRowCol);
+		}
+		if (dpRecX) { // objective cutoff
+			for (sz=0, j=0; j < n; ++j) {
+				if (m_copy.getObjCoeff(j) != 0.0) {
+					dpRowVal[sz]=m_copy.getObjCoeff(j);
+					ipRowCol[sz++]=j;
+				}
+			}
+			b=(intObj)? 1.0-LNS_TOL: LNS_TOL*(1.0+fabs(recObj));
+			if (m_copy.getSense())
+				mip.addRow(m,0,recObj+b,CLP::INF,sz,dpRowVal,ipRowCol);
+			else
+				mip.addRow(m,0,-CLP::INF,recObj-b,sz,dpRowVal,ipRowCol);
+		}
+		if (nbh == LNS_LOCAL_BRANCHING) { // at most `m_iRadius` binary variables change their record values
+			for (sz=0, b=m_iRadius, j=0; j < n; ++j) {
+				if (m_copy.isInteger(j) && m_copy.getLoBound(j) == 0.0 && m_copy.getUpBound(j) == 1.0) {
+					if (dpRecX[j] > 0.5) {
+						dpRowVal[sz]=-1.0;
+						b-=1.0;
+					}
+					else
+						dpRowVal[sz]=1.0;
+					ipRowCol[sz++]=j;
+				}
+			}
+			mip.addRow(m+1,0,-CLP::INF,b,sz,dpRowVal,ipRowCol);
+		}
+		mip.closeMatrix();
+		int timeLimit=m_iTimeLimit;
+		if (m_pSched) { // the sub-MIP should not overdraw the time budget of heuristics by much
+			double rest=m_pSched->getRemainingTime();
+			if (rest < static_cast<double>(timeLimit))
+				timeLimit=(rest > 1.0)? static_cast<int>(rest): 1;
+		}
+		mip.optimize(timeLimit);
+		if ((improved=mip.isImproved()))
+			++m_ipSolNum[nbh];
+	}
+	catch(CException* pe) {
+		delete[] dpMem;
+		m_dpTime[nbh]+=1.0e-6*static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now()-startTime).count());
+		throw pe;
+	}
+	delete[] dpMem;
+	double time=1.0e-6*static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now()-startTime).count());
+	m_dpTime[nbh]+=time;
+	if (m_pSched)
+		m_pSched->report(m_ipHeur[nbh],time,improved);
+	return improved;
+} // end of CLns::solveSubMip()
+
+bool CLns::getRecord(double* dpRecX, double& objVal, int* ipHd)
+{
+	int n=m_copy.getColNum(), k=0;
+	bool sense=m_copy.getSense();
+	if (m_pInc->isSolution() && (k=m_pInc->getSolution(objVal,n,dpRecX+n,ipHd)) > n)
+		k=0;
+	for (int j=0; j < n; ++j) {
+		dpRecX[j]=0.0;
+	}
+	for (int i=0; i < k; ++i) {
+		dpRecX[ipHd[i]]=dpRecX[n+i];
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if (m_iRecNum && m_iRecNum <= n && (!k || ((sense)? m_dRecObj > objVal: m_dRecObj < objVal))) {
+		for (int i=0; i < m_iRecNum; ++i) {
+			dpRecX[m_ipRecHd[i]]=m_dpRecX[i];
+		}
+		objVal=m_dRecObj;
+		k=m_iRecNum;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return (k)? true: false;
+} // end of CLns::getRecord()
+
+void CLns::run(bool wait)
+{
+	int n=m_copy.getColNum(), *ipHd;
+	double *dpRecX, objVal, lastObj=0.0;
+	bool rec, searched=false;
+	if (!(dpRecX = new double[n+n+(n+1)/2+1])) {
+		throw new CMemoryException("CLns::run");
+	}
+	ipHd=reinterpret_cast<int*>(dpRecX+n+n);
+	try {
+		if (m_bLp) {
+			rec=getRecord(dpRecX,objVal,ipHd);
+			solveSubMip(LNS_RENS,(rec)? dpRecX: 0,objVal);
+		}
+	// RINS and local branching are run around every new record
+		while (!m_bStop.load(std::memory_order_relaxed)) {
+			if (!getRecord(dpRecX,objVal,ipHd) || (searched && objVal == lastObj)) {
+				if (!wait)
+					break;
+				std::this_thread::sleep_for(std::chrono::milliseconds(LNS_WAIT));
+				continue;
+			}
+			searched=true;
+			lastObj=objVal;
+			if (m_pSched && m_bLp) { // the neighbourhood chosen by the scheduler is searched first
+				int ipNbh[2]={LNS_RINS,LNS_LOCAL_BRANCHING}, ipHeur[2]={m_ipHeur[LNS_RINS],m_ipHeur[LNS_LOCAL_BRANCHING]};
+				int k=m_pSched->select(2,ipHeur);
+				if (!solveSubMip(ipNbh[k],dpRecX,objVal) && !m_bStop.load(std::memory_order_relaxed))
+					solveSubMip(ipNbh[1-k],dpRecX,objVal);
+				continue;
+			}
+			if (m_bLp)
+				solveSubMip(LNS_RINS,dpRecX,objVal);
+			if (!m_bStop.load(std::memory_order_relaxed))
+				solveSubMip(LNS_LOCAL_BRANCHING,dpRecX,objVal);
+		}
+	}
+	catch(CException* pe) {
+		delete[] dpRecX;
+		throw pe;
+	}
+	delete[] dpRecX;
+} // end of CLns::run()
+
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CLns::startThread(void* param)
+#else
+void* CLns::startThread(void* param)
+#endif
+{
+	try {
+		static_cast<CLns*>(param)->run(true);
+	}
+	catch(CException* pe) {
+		delete pe; // heuristics give up
+	}
+	return 0;
+} // end of CLns::startThread()
+#endif
+
+void CLns::start(CIncumbent* pInc)
+{
+	m_pInc=pInc;
+	m_bStop=false;
+	m_bStarted=true;
+#ifndef __ONE_THREAD_
+	_THREAD_CREATE(m_thread,startThread,this)
+	m_bThread=true;
+#else
+	run(false);
+#endif
+} // end of CLns::start()
+
+void CLns::setScheduler(CHeurScheduler* pSched)
+{
+	m_pSched=pSched;
+	for (int k=0; k < LNS_NUM; ++k) {
+		m_ipHeur[k]=pSched->addHeuristic(nbhName[k]);
+	}
+} // end of CLns::setScheduler()
+
+void CLns::stop()
+{
+	m_bStop=true;
+#ifndef __ONE_THREAD_
+	if (m_bThread) {
+		_THREAD_JOIN(m_thread)
+		_THREAD_CLOSE(m_thread)
+		m_bThread=false;
+	}
+#endif
+	m_bStarted=false;
+	m_bLp=false;
+} // end of CLns::stop()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CLns::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	out << "Large neighbourhood search\n";
+	out << "= Neighbourhood === Sub-MIPs === Solutions ===== Time\n";
+	for (int k=0; k < LNS_NUM; ++k) {
+		sprintf(str,"%15s %12d %13d %12.3f\n",nbhName[k],m_ipCallNum[k],m_ipSolNum[k],m_dpTime[k]);
+		out << str;
+	}
+	out << std::endl;
+} // end of CLns::printStatistics()
@@ -0,0 +1,172 @@
+// MatrixCopy.cpp: implementation of the CMatrixCopy class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <except.h>
+#include <cmip.h>
+#include "MatrixCopy.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CMatrixCopy::CMatrixCopy()
+{
+	m_bSense=true;
+	m_iM=m_iN=0;
+	m_dpC=m_dpD=m_dpB=m_dpVal=0;
+	m_ipVarType=m_ipCtrType=0;
+	m_ipPri=m_ipBeg=m_ipCol=0;
+} // end of CMatrixCopy::CMatrixCopy()
+
+CMatrixCopy::~CMatrixCopy()
+{
+	if (m_dpC) {
+		delete[] m_dpC;
+		delete[] m_ipVarType;
+		delete[] m_ipBeg;
+		delete[] m_dpVal;
+		delete[] m_ipCol;
+	}
+} // end of CMatrixCopy::~CMatrixCopy()
+
+void CMatrixCopy::allocMem(int m, int n, int nz)
+{
+	if (m_dpC) {
+		delete[] m_dpC;
+		delete[] m_ipVarType;
+		delete[] m_ipBeg;
+		delete[] m_dpVal;
+		delete[] m_ipCol;
+	}
+	m_iM=m;
+	m_iN=n;
+	if (!(m_dpC = new double[3*n+2*m]) || !(m_ipVarType = new unsigned[2*n+m]) ||
+		!(m_ipBeg = new int[m+1]) || !(m_dpVal = new double[nz+1]) || !(m_ipCol = new int[nz+1])) {
+		throw new CMemoryException("CMatrixCopy::allocMem");
+	}
+	m_dpD=m_dpC+n;
+	m_dpB=m_dpD+2*n;
+	m_ipCtrType=m_ipVarType+n;
+	m_ipPri=reinterpret_cast<int*>(m_ipCtrType+m);
+} // end of CMatrixCopy::allocMem()
+
+//////////////////////////////////////////////////////////////////////
+// Loading
+//////////////////////////////////////////////////////////////////////
+void CMatrixCopy::load(CMIP& mip) const
+{
+	int *ipRow, *ipCol;
+	if (!(ipRow = new int[m_iM+m_iN+1])) {
+		throw new CMemoryException("CMatrixCopy::load");
+	}
+	ipCol=ipRow+m_iM;
+	for (int i=0; i < m_iM; ++i) {
+		ipRow[i]=i;
+	}
+	for (int j=0; j < m_iN; ++j) {
+		ipCol[j]=j;
+	}
+	try {
+		load(mip,m_iM,ipRow,m_iN,ipCol);
+	}
+	catch(CMemoryException* pe) {
+		delete[] ipRow;
+		throw pe;
+	}
+	delete[] ipRow;
+} // end of CMatrixCopy::load()
+
+void CMatrixCopy::load(CMIP& mip, int m, const int* ipRow, int n, const int* ipCol) const
+{
+	int i, j, sz, nz=0, *ipInd, *ipSubCol;
+	double *dpVal;
+	for (int r=0; r < m; ++r) {
+		i=ipRow[r];
+		nz+=m_ipBeg[i+1]-m_ipBeg[i];
+	}
+	if (!(dpVal = new double[n+n+(n+1)/2+1]) || !(ipInd = new int[m_iN])) {
+		if (dpVal)
+			delete[] dpVal;
+		throw new CMemoryException("CMatrixCopy::load");
+	}
+	ipSubCol=reinterpret_cast<int*>(dpVal+n);
+	mip.openMatrix(m,n,nz);
+	mip.setObjSense(m_bSense);
+	for (int k=0; k < n; ++k) {
+		ipInd[j=ipCol[k]]=k;
+		mip.addVar(j,m_ipVarType[j],m_dpC[j],m_dpD[j<<1],m_dpD[(j<<1)+1]);
+		if (m_ipVarType[j])
+			mip.setVarPriority(k,m_ipPri[j]);
+	}
+	for (int r=0; r < m; ++r) {
+		i=ipRow[r];
+		sz=0;
+		for (int t=m_ipBeg[i]; t < m_ipBeg[i+1]; ++t) {
+			dpVal[sz]=m_dpVal[t];
+			ipSubCol[sz++]=ipInd[m_ipCol[t]];
+		}
+		mip.addRow(i,m_ipCtrType[i],m_dpB[i<<1],m_dpB[(i<<1)+1],sz,dpVal,ipSubCol);
+	}
+	mip.closeMatrix();
+	delete[] ipInd;
+	delete[] dpVal;
+} // end of CMatrixCopy::load()
+
+//////////////////////////////////////////////////////////////////////
+// Decomposition
+//////////////////////////////////////////////////////////////////////
+/**
+ * \param[in,out] ipRoot union-find forest, `ipRoot[j]` is parent of `j`.
+ * \param[in] j element.
+ * \return root of tree containing `j`.
+ */
+static int findRoot(int* ipRoot, int j)
+{
+	int r=j;
+	while (ipRoot[r] != r)
+		r=ipRoot[r];
+	for (int k; ipRoot[j] != r; j=k) { // path compression
+		k=ipRoot[j];
+		ipRoot[j]=r;
+	}
+	return r;
+} // end of findRoot()
+
+int CMatrixCopy::getComponents(int* ipColComp, int* ipRowComp) const
+{
+	int i, j, r, r1, compNum=0, *ipRoot;
+	if (!(ipRoot = new int[m_iN])) {
+		throw new CMemoryException("CMatrixCopy::getComponents");
+	}
+	for (j=0; j < m_iN; ++j) {
+		ipRoot[j]=j;
+		ipColComp[j]=-1;
+	}
+	for (i=0; i < m_iM; ++i) {
+		if (m_ipBeg[i] == m_ipBeg[i+1])
+			continue;
+		r=findRoot(ipRoot,m_ipCol[m_ipBeg[i]]);
+		for (int t=m_ipBeg[i]+1; t < m_ipBeg[i+1]; ++t) {
+			if ((r1=findRoot(ipRoot,m_ipCol[t])) != r)
+				ipRoot[r1]=r;
+		}
+	}
+	for (i=0; i < m_iM; ++i) {
+		for (int t=m_ipBeg[i]; t < m_ipBeg[i+1]; ++t) {
+			ipColComp[m_ipCol[t]]=-2; // column has nonzero entries
+		}
+	}
+	for (j=0; j < m_iN; ++j) { // number components by their roots
+		if (ipColComp[j] == -2 && findRoot(ipRoot,j) == j)
+			ipColComp[j]=compNum++;
+	}
+	for (j=0; j < m_iN; ++j) {
+		if (ipColComp[j] == -2)
+			ipColComp[j]=ipColComp[findRoot(ipRoot,j)];
+	}
+	for (i=0; i < m_iM; ++i) {
+		ipRowComp[i]=(m_ipBeg[i] < m_ipBeg[i+1])? ipColComp[m_ipCol[m_ipBeg[i]]]: -1;
+	}
+	delete[] ipRoot;
+	return compNum;
+} // end of CMatrixCopy::getComponents()
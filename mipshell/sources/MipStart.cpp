@@ -0,0 +1,314 @@
+// MipStart.cpp: implementation of the CMipStart class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <except.h>
+#include <cmip.h>
+#include "Var.h"
+#include "MipStart.h"
+
+/**
+ * `CMipStartSolver` solves the sub-MIP built by `CMipStart`, and reports its solutions to `CMipStart`.
+ */
+class CMipStartSolver: public CMIP
+{
+	CMipStart* m_pStart; ///< object which built this sub-MIP.
+	int m_iNodeNum; ///< number of nodes processed.
+	bool m_bStopped; ///< `true` if node limit has been exceeded.
+public:
+	/**
+	 * The constructor.
+	 * \param[in] pStart MIP start object.
+	 */
+	CMipStartSolver(CMipStart* pStart): CMIP("start")
+		{m_pStart=pStart; m_iNodeNum=0; m_bStopped=false;}
+
+	int getNodeNum() const
+		{return m_iNodeNum;} ///< \return number of nodes processed.
+
+	/**
+	 * The function overloads `CMIP::changeRecord()` to report new solutions to `m_pStart`.
+	 * \param[in]  objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`.
+	 */
+	void changeRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd);
+
+protected:
+	/**
+	 * When the node limit is exceeded, the function creates one branch which is always infeasible;
+	 * so, all the remaining nodes are pruned.
+	 * \param[in] nodeHeight height of the node.
+	 * \return number of branches.
+	 */
+	int startBranching(int nodeHeight);
+
+	bool updateBranch(int i)
+		{return (m_bStopped)? false: CMIP::updateBranch(i);} ///< The only branch created after stopping is infeasible.
+};
+
+void CMipStartSolver::changeRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd)
+{
+	CMIP::changeRecord(objVal,n,dpX,ipHd);
+	m_pStart->setRecord(objVal,n,dpX,ipHd);
+} // end of CMipStartSolver::changeRecord()
+
+int CMipStartSolver::startBranching(int nodeHeight)
+{
+	if (m_bStopped || ++m_iNodeNum > m_pStart->m_iNodeLimit) {
+		m_bStopped=true;
+		return 1;
+	}
+	return CMIP::startBranching(nodeHeight);
+} // end of CMipStartSolver::startBranching()
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CMipStart::CMipStart(int nodeLimit, int timeLimit)
+{
+	m_iNodeLimit=(nodeLimit > 0)? nodeLimit: 1;
+	m_iTimeLimit=(timeLimit > 0)? timeLimit: 1;
+	m_iSize=m_iCapacity=0;
+	m_dpVal=0;
+	m_ppVar=0;
+	m_bRec=false;
+	m_dRecObj=0.0;
+	m_iRecNum=0;
+	m_dpRecX=0;
+	m_ipRecHd=0;
+	m_iStatus=START_NONE;
+	m_iGivenNum=m_iFixNum=m_iNodeNum=0;
+	m_dTime=0.0;
+} // end of CMipStart::CMipStart()
+
+CMipStart::~CMipStart()
+{
+	if (m_dpVal) {
+		delete[] m_dpVal;
+		delete[] m_ppVar;
+	}
+	if (m_dpRecX) {
+		delete[] m_dpRecX;
+		delete[] m_ipRecHd;
+	}
+} // end of CMipStart::~CMipStart()
+
+void CMipStart::setValue(CVar* pVar, double val)
+{
+	if (m_iSize == m_iCapacity) {
+		int cap=(m_iCapacity)? m_iCapacity<<1: 64;
+		double *dpVal;
+		CVar **ppVar;
+		if (!(dpVal = new double[cap])) {
+			throw new CMemoryException("CMipStart::setValue");
+		}
+		if (!(ppVar = new CVar*[cap])) {
+			delete[] dpVal;
+			throw new CMemoryException("CMipStart::setValue");
+		}
+		if (m_dpVal) {
+			memcpy(dpVal,m_dpVal,m_iSize*sizeof(double));
+			memcpy(ppVar,m_ppVar,m_iSize*sizeof(CVar*));
+			delete[] m_dpVal;
+			delete[] m_ppVar;
+		}
+		m_dpVal=dpVal;
+		m_ppVar=ppVar;
+		m_iCapacity=cap;
+	}
+	m_dpVal[m_iSize]=val;
+	m_ppVar[m_iSize++]=pVar;
+} // end of CMipStart::setValue()
+
+//////////////////////////////////////////////////////////////////////
+// Processing the start
+//////////////////////////////////////////////////////////////////////
+bool CMipStart::isFeasible(const double* dpX) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	double s, b, x;
+	int sz;
+	for (int j=0; j < m_copy.getColNum(); ++j) {
+		x=dpX[j];
+		if (x < m_copy.getLoBound(j)-MIP_START_TOL || x > m_copy.getUpBound(j)+MIP_START_TOL)
+			return false;
+		if (m_copy.isInteger(j) && fabs(x-floor(x+0.5)) > MIP_START_TOL)
+			return false;
+	}
+	for (int i=0; i < m_copy.getRowNum(); ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		for (s=0.0, --sz; sz >= 0; --sz) {
+			s+=dpVal[sz]*dpX[ipCol[sz]];
+		}
+		if ((b=m_copy.getRowLoBound(i)) > -CLP::INF && s < b-MIP_START_TOL*(1.0+fabs(b)))
+			return false;
+		if ((b=m_copy.getRowUpBound(i)) < CLP::INF && s > b+MIP_START_TOL*(1.0+fabs(b)))
+			return false;
+	}
+	return true;
+} // end of CMipStart::isFeasible()
+
+void CMipStart::setRecord(double objVal, int n, const double* dpX, const int* ipHd)
+{
+	int n0=m_copy.getColNum();
+	if (!m_dpRecX) {
+		if (!(m_dpRecX = new double[n0])) {
+			throw new CMemoryException("CMipStart::setRecord");
+		}
+		if (!(m_ipRecHd = new int[n0])) {
+			delete[] m_dpRecX;
+			m_dpRecX=0;
+			throw new CMemoryException("CMipStart::setRecord");
+		}
+	}
+	for (int j=0; j < n0; ++j) {
+		m_dpRecX[j]=0.0;
+		m_ipRecHd[j]=j;
+	}
+	if (ipHd) {
+		for (int i=0; i < n; ++i) {
+			if (ipHd[i] >= 0 && ipHd[i] < n0)
+				m_dpRecX[ipHd[i]]=dpX[i];
+		}
+	}
+	else
+		memcpy(m_dpRecX,dpX,((n < n0)? n: n0)*sizeof(double));
+	m_dRecObj=objVal;
+	m_iRecNum=n0;
+	m_bRec=true;
+} // end of CMipStart::setRecord()
+
+bool CMipStart::complete(const double* dpX, const bool* cpGiven)
+{
+	const double* dpVal;
+	const int* ipCol;
+	int m=m_copy.getRowNum(), n=m_copy.getColNum(), j, sz, nz=0, *ipRowCol;
+	double *dpMem, lb, ub, x;
+	bool found=true;
+	for (int i=0; i < m; ++i) {
+		nz+=m_copy.getRow(i,dpVal,ipCol);
+	}
+	if (!(dpMem = new double[3*n+(n+1)/2+1])) {
+		throw new CMemoryException("CMipStart::complete");
+	}
+	double *dpD=dpMem, *dpRowVal=dpD+(n<<1);
+	ipRowCol=reinterpret_cast<int*>(dpRowVal+n);
+
+// bounds of sub-MIP
+	m_iFixNum=0;
+	for (j=0; j < n; ++j) {
+		dpD[j<<1]=lb=m_copy.getLoBound(j);
+		dpD[(j<<1)+1]=ub=m_copy.getUpBound(j);
+		if (!cpGiven[j] || !m_copy.isInteger(j))
+			continue;
+		x=floor(dpX[j]+0.5);
+		if (x < lb-MIP_START_TOL || x > ub+MIP_START_TOL)
+			found=false; // the start contradicts the bounds
+		dpD[j<<1]=dpD[(j<<1)+1]=x;
+		++m_iFixNum;
+	}
+	if (!found) {
+		delete[] dpMem;
+		return false;
+	}
+
+	try {
+		CMipStartSolver mip(this);
+		mip.beSilent();
+#ifndef __ONE_THREAD_
+		mip.setThreadNum(1);
+#endif
+		mip.openMatrix(m,n,nz);
+		mip.setObjSense(m_copy.getSense());
+		for (j=0; j < n; ++j) {
+			mip.addVar(j,m_copy.getVarType(j),m_copy.getObjCoeff(j),dpD[j<<1],dpD[(j<<1)+1]);
+			if (m_copy.isInteger(j))
+				mip.setVarPriority(j,m_copy.getVarPriority(j));
+		}
+		for (int i=0; i < m; ++i) {
+			sz=m_copy.getRow(i,dpVal,ipCol);
+			memcpy(dpRowVal,dpVal,sz*sizeof(double));
+			memcpy(ipRowCol,ipCol,sz*sizeof(int));
+			mip.addRow(i,m_copy.getCtrType(i),m_copy.getRowLoBound(i),m_copy.getRowUpBound(i),sz,dpRowVal,ipRowCol);
+		}
+		mip.closeMatrix();
+		mip.optimize(m_iTimeLimit);
+		m_iNodeNum=mip.getNodeNum();
+	}
+	catch(CException* pe) {
+		delete[] dpMem;
+		throw pe;
+	}
+	delete[] dpMem;
+	return m_bRec;
+} // end of CMipStart::complete()
+
+bool CMipStart::run()
+{
+	int n=m_copy.getColNum(), hd;
+	double *dpX, obj;
+	bool *cpGiven;
+	std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+	m_bRec=false;
+	m_iRecNum=0;
+	m_iStatus=START_FAILED;
+	m_iGivenNum=m_iFixNum=m_iNodeNum=0;
+	if (!(dpX = new double[n+(n+7)/8+1])) {
+		throw new CMemoryException("CMipStart::run");
+	}
+	cpGiven=reinterpret_cast<bool*>(dpX+n);
+	for (int j=0; j < n; ++j) {
+		dpX[j]=0.0;
+		cpGiven[j]=false;
+	}
+	for (int i=0; i < m_iSize; ++i) { // a later value of the same variable replaces an earlier one
+		if ((hd=m_ppVar[i]->getHandle()) >= 0 && hd < n) {
+			if (!cpGiven[hd]) {
+				cpGiven[hd]=true;
+				++m_iGivenNum;
+			}
+			dpX[hd]=m_dpVal[i];
+		}
+	}
+	try {
+		if (m_iGivenNum == n && isFeasible(dpX)) {
+			for (obj=0.0, hd=0; hd < n; ++hd) {
+				obj+=m_copy.getObjCoeff(hd)*dpX[hd];
+			}
+			setRecord(obj,n,dpX,0);
+			m_iStatus=START_ACCEPTED;
+		}
+		else if (m_iGivenNum && complete(dpX,cpGiven))
+			m_iStatus=START_COMPLETED;
+	}
+	catch(CException* pe) {
+		delete[] dpX;
+		throw pe;
+	}
+	delete[] dpX;
+	m_dTime=1.0e-6*static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now()-startTime).count());
+	return m_bRec;
+} // end of CMipStart::run()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CMipStart::printStatistics(std::ostream &out) const
+{
+	static const char* statusName[]={"not processed","accepted","completed","failed"};
+	char str[128];
+	out << "MIP start\n";
+	out << "===== Given ===== Fixed ===== Nodes ======= Status =========== Objective ===== Time\n";
+	if (m_iRecNum)
+		sprintf(str,"%10d %11d %11d %14s %21g %10.3f\n",m_iGivenNum,m_iFixNum,m_iNodeNum,statusName[m_iStatus],m_dRecObj,m_dTime);
+	else
+		sprintf(str,"%10d %11d %11d %14s %21s %10.3f\n",m_iGivenNum,m_iFixNum,m_iNodeNum,statusName[m_iStatus],"-",m_dTime);
+	out << str;
+	out << std::endl;
+} // end of CMipStart::printStatistics()
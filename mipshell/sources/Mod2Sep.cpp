@@ -0,0 +1,422 @@
+// Mod2Sep.cpp: implementation of the CMod2Sep class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cmath>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include <except.h>
+#include <lp.h>
+#include <Sort.h>
+#include "CutSelector.h"
+#include "Mod2Sep.h"
+
+#define MOD2_TOL 1.0e-6 ///< tolerance used to decide whether a value is integer or a variable is at its bound.
+#define MOD2_MAX_SLACK 0.999 ///< row subsets which total slack is not less than `MOD2_MAX_SLACK` cannot give violated cuts.
+#define MOD2_MIN_VIOL 1.0e-4 ///< cuts which violation is not greater than `MOD2_MIN_VIOL` are not written.
+#define MOD2_MAX_WORDS (1 << 24) ///< maximum size (in 64-bit words) of GF(2) matrix.
+#define MOD2_M4R_K 8 ///< number of pivots in a group processed by the method of four Russians.
+#define MOD2_M4R_DENSITY 0.05 ///< the method of four Russians is used if density of GF(2) matrix is greater than this value,
+#define MOD2_M4R_MIN_ROWS 256 ///< and its number of rows is not less than this value.
+
+static inline bool isOdd(double v)
+{
+	return (static_cast<long long>(floor(v+0.5)) & 1LL)? true: false;
+}
+
+static inline bool getBit(const unsigned long long* ulpRow, int c)
+{
+	return ((ulpRow[c>>6] >> (c & 63)) & 1ULL)? true: false;
+}
+
+static inline void setBit(unsigned long long* ulpRow, int c)
+{
+	ulpRow[c>>6]|=1ULL << (c & 63);
+}
+
+static inline int lowBit(unsigned long long w)
+{
+	int b=0;
+	for (; !(w & 0xFFFFULL); w>>=16, b+=16);
+	for (; !(w & 1ULL); w>>=1, ++b);
+	return b;
+}
+
+/**
+ * The function adds (over GF(2)) one row to another.
+ * \param[in,out] ulpDst row to be changed;
+ * \param[in] ulpSrc row to be added;
+ * \param[in] wordNum number of 64-bit words in rows.
+ */
+static inline void xorRow(unsigned long long* ulpDst, const unsigned long long* ulpSrc, int wordNum)
+{
+	int k=0;
+#ifdef __AVX2__
+	for (; k+4 <= wordNum; k+=4) {
+		__m256i a=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ulpDst+k));
+		__m256i b=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ulpSrc+k));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(ulpDst+k),_mm256_xor_si256(a,b));
+	}
+#endif
+	for (; k < wordNum; ++k) {
+		ulpDst[k]^=ulpSrc[k];
+	}
+} // end of xorRow()
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CMod2Sep::CMod2Sep(int maxRowNum, int maxCutNum)
+{
+	m_iRowNum=0;
+	m_ipRow=0;
+	m_iMaxRowNum=maxRowNum;
+	m_iMaxCutNum=maxCutNum;
+} // end of CMod2Sep::CMod2Sep()
+
+CMod2Sep::~CMod2Sep()
+{
+	if (m_ipRow)
+		delete[] m_ipRow;
+} // end of CMod2Sep::~CMod2Sep()
+
+void CMod2Sep::init()
+{
+	const double* dpVal;
+	const int* ipCol;
+	double b;
+	int j, k, sz, m=m_copy.getRowNum();
+	if (m_ipRow)
+		delete[] m_ipRow;
+	m_iRowNum=0;
+	if (!(m_ipRow = new int[(m<<1)+1])) {
+		throw new CMemoryException("CMod2Sep::init");
+	}
+	for (int i=0; i < m; ++i) {
+		if (!(sz=m_copy.getRow(i,dpVal,ipCol)))
+			continue;
+		for (k=0; k < sz; ++k) {
+			j=ipCol[k];
+			if (!m_copy.isInteger(j) || fabs(dpVal[k]-floor(dpVal[k]+0.5)) > MOD2_TOL)
+				break;
+			if (isOdd(dpVal[k]) && m_copy.getLoBound(j) <= -CLP::INF && m_copy.getUpBound(j) >= CLP::INF)
+				break; // parity of free variable cannot be fixed by its bounds
+		}
+		if (k < sz)
+			continue;
+		if ((b=m_copy.getRowUpBound(i)) < CLP::INF && fabs(b-floor(b+0.5)) <= MOD2_TOL)
+			m_ipRow[m_iRowNum++]=i<<1;
+		if ((b=m_copy.getRowLoBound(i)) > -CLP::INF && fabs(b-floor(b+0.5)) <= MOD2_TOL)
+			m_ipRow[m_iRowNum++]=(i<<1) | 1;
+	}
+} // end of CMod2Sep::init()
+
+void CMod2Sep::getValues(const double* dpSol, const int* ipHdToCol, double* dpX) const
+{
+	double lb;
+	for (int j=m_copy.getColNum()-1; j >= 0; --j) {
+		if (ipHdToCol[j] >= 0)
+			dpX[j]=dpSol[j];
+		else if ((lb=m_copy.getLoBound(j)) == m_copy.getUpBound(j))
+			dpX[j]=lb;
+		else
+			dpX[j]=CLP::INF;
+	}
+} // end of CMod2Sep::getValues()
+
+double CMod2Sep::getSlack(const double* dpX, int r) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	double s=0.0, x;
+	int i=m_ipRow[r] >> 1, sz=m_copy.getRow(i,dpVal,ipCol);
+	for (int k=0; k < sz; ++k) {
+		if ((x=dpX[ipCol[k]]) >= CLP::INF)
+			return CLP::INF;
+		s+=dpVal[k]*x;
+	}
+	return (m_ipRow[r] & 1)? s-m_copy.getRowLoBound(i): m_copy.getRowUpBound(i)-s;
+} // end of CMod2Sep::getSlack()
+
+//////////////////////////////////////////////////////////////////////
+// Elimination over GF(2)
+//////////////////////////////////////////////////////////////////////
+void CMod2Sep::eliminate(int rowNum, int colNum, int wordNum, unsigned long long* ulpMat, char* cpPivot)
+{
+	int p, w;
+	unsigned long long *ulpPivot;
+	memset(cpPivot,0,rowNum);
+	for (int c=0; c < colNum; ++c) {
+		for (p=0; p < rowNum; ++p) {
+			if (!cpPivot[p] && getBit(ulpMat+p*wordNum,c))
+				break;
+		}
+		if (p == rowNum)
+			continue;
+		cpPivot[p]=1;
+		ulpPivot=ulpMat+p*wordNum;
+		w=c>>6; // all rows that are not pivots have zero entries in columns less than `c`
+		for (int r=p+1; r < rowNum; ++r) {
+			if (!cpPivot[r] && getBit(ulpMat+r*wordNum,c))
+				xorRow(ulpMat+r*wordNum+w,ulpPivot+w,wordNum-w);
+		}
+	}
+} // end of CMod2Sep::eliminate()
+
+void CMod2Sep::eliminateM4R(int rowNum, int colNum, int wordNum, unsigned long long* ulpMat, char* cpPivot)
+{
+	int ipPivot[MOD2_M4R_K], ipCol[MOD2_M4R_K];
+	int g, r, i, idx, w, len;
+	bool bit;
+	unsigned long long *ulpRow, *ulpTab;
+	if (!(ulpTab = new unsigned long long[(1 << MOD2_M4R_K)*wordNum])) {
+		throw new CMemoryException("CMod2Sep::eliminateM4R");
+	}
+	memset(cpPivot,0,rowNum);
+	for (int c=0; c < colNum;) {
+		w=c>>6; // all rows have zero entries in columns less than `c` after reduction by previous groups
+		len=wordNum-w;
+	// collect a group of pivots reduced with respect to each other
+		for (g=0; g < MOD2_M4R_K && c < colNum; ++c) {
+			for (r=0; r < rowNum; ++r) {
+				if (cpPivot[r])
+					continue;
+				ulpRow=ulpMat+r*wordNum;
+				bit=getBit(ulpRow,c);
+				for (i=0; i < g; ++i) {
+					if (getBit(ulpRow,ipCol[i]) && getBit(ulpMat+ipPivot[i]*wordNum,c))
+						bit=!bit;
+				}
+				if (bit)
+					break;
+			}
+			if (r == rowNum)
+				continue;
+			ulpRow=ulpMat+r*wordNum;
+			for (i=0; i < g; ++i) {
+				if (getBit(ulpRow,ipCol[i]))
+					xorRow(ulpRow+w,ulpMat+ipPivot[i]*wordNum+w,len);
+			}
+			for (i=0; i < g; ++i) {
+				if (getBit(ulpMat+ipPivot[i]*wordNum,c))
+					xorRow(ulpMat+ipPivot[i]*wordNum+w,ulpRow+w,len);
+			}
+			cpPivot[r]=1;
+			ipPivot[g]=r;
+			ipCol[g++]=c;
+		}
+		if (!g)
+			break;
+	// tabulate all sums of group pivots
+		memset(ulpTab,0,len*sizeof(unsigned long long));
+		for (idx=1; idx < (1 << g); ++idx) {
+			memcpy(ulpTab+idx*len,ulpTab+(idx & (idx-1))*len,len*sizeof(unsigned long long));
+			xorRow(ulpTab+idx*len,ulpMat+ipPivot[lowBit(idx)]*wordNum+w,len);
+		}
+	// reduce other rows
+		for (r=0; r < rowNum; ++r) {
+			if (cpPivot[r])
+				continue;
+			ulpRow=ulpMat+r*wordNum;
+			for (idx=i=0; i < g; ++i) {
+				if (getBit(ulpRow,ipCol[i]))
+					idx|=1 << i;
+			}
+			if (idx)
+				xorRow(ulpRow+w,ulpTab+idx*len,len);
+		}
+	}
+	delete[] ulpTab;
+} // end of CMod2Sep::eliminateM4R()
+
+//////////////////////////////////////////////////////////////////////
+// Separation
+//////////////////////////////////////////////////////////////////////
+bool CMod2Sep::buildCut(const double* dpX, const int* ipHdToCol, int rowNum, const int* ipRow, CCutSelector& cuts,
+		double* dpCoeff, int* ipInd, int* ipPos) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	double a, b=0.0, lb, ub, s=0.0, fixed=0.0;
+	int i, j, k, sz, nz=0;
+	bool neg, flag=false;
+	for (int t=0; t < rowNum; ++t) {
+		i=m_ipRow[ipRow[t]] >> 1;
+		neg=(m_ipRow[ipRow[t]] & 1)? true: false;
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		b+=(neg)? -m_copy.getRowLoBound(i): m_copy.getRowUpBound(i);
+		for (k=0; k < sz; ++k) {
+			if (ipPos[j=ipCol[k]] < 0) {
+				ipPos[j]=nz;
+				ipInd[nz]=j;
+				dpCoeff[nz++]=0.0;
+			}
+			dpCoeff[ipPos[j]]+=(neg)? -dpVal[k]: dpVal[k];
+		}
+	}
+// make all coefficients even by adding bound constraints, and divide the sum by 2
+	sz=0;
+	for (k=0; k < nz; ++k) {
+		ipPos[j=ipInd[k]]=-1;
+		a=floor(dpCoeff[k]+0.5);
+		if (isOdd(a)) {
+			lb=ceil(m_copy.getLoBound(j)-MOD2_TOL);
+			ub=floor(m_copy.getUpBound(j)+MOD2_TOL);
+			if (ub < CLP::INF && (lb <= -CLP::INF || ub-dpX[j] < dpX[j]-lb)) {
+				a+=1.0;
+				b+=ub;
+			}
+			else {
+				a-=1.0;
+				b-=lb;
+			}
+		}
+		if (a == 0.0)
+			continue;
+		if (ipHdToCol[j] < 0) // fixed variable removed from the LP
+			fixed+=0.5*a*dpX[j];
+		else {
+			dpCoeff[sz]=0.5*a;
+			ipInd[sz++]=j;
+			s+=0.5*a*dpX[j];
+		}
+	}
+	b=floor(0.5*floor(b+0.5))-fixed;
+	if (sz && s > b+MOD2_MIN_VIOL)
+		flag=cuts.addCand(CUT_SEPARATOR,0,-CLP::INF,b,sz,dpCoeff,ipInd);
+	return flag;
+} // end of CMod2Sep::buildCut()
+
+int CMod2Sep::separate(int hdNum, const double* dpSol, const int* ipHdToCol, CCutSelector& cuts)
+{
+	const double* dpVal;
+	const int* ipCol;
+	double s, x, lb, ub, *dpMem;
+	int i, j, k, sz, n=m_copy.getColNum(), colNum=0, candNum=0, wordNum, cutNum=0, *ipMem;
+	int *ipColInd, *ipOrd, *ipList, *ipInd, *ipPos;
+	bool neg, rhs;
+	double *dpSlack, *dpCoeff, *dpX;
+	unsigned long long *ulpMat=0, *ulpRow, bitNum=0, word;
+	char *cpPivot=0;
+	if (hdNum < n || !m_iRowNum)
+		return 0;
+	if (!(dpMem = new double[(n<<1)+m_iRowNum])) {
+		throw new CMemoryException("CMod2Sep::separate");
+	}
+	if (!(ipMem = new int[3*n+(m_iRowNum<<1)])) {
+		delete[] dpMem;
+		throw new CMemoryException("CMod2Sep::separate");
+	}
+	dpSlack=dpMem;
+	dpCoeff=dpSlack+m_iRowNum;
+	dpX=dpCoeff+n;
+	getValues(dpSol,ipHdToCol,dpX);
+	ipOrd=ipMem;
+	ipList=ipOrd+m_iRowNum;
+	ipColInd=ipList+m_iRowNum;
+	ipInd=ipColInd+n;
+	ipPos=ipInd+n;
+	try {
+	// columns of GF(2) matrix are fractional variables; `ipColInd[j]` is `-1` (`-2`) if variable `j` is at lower (upper) bound
+		for (j=0; j < n; ++j) {
+			ipPos[j]=-1;
+			ipColInd[j]=-1;
+			if (!m_copy.isInteger(j) || (x=dpX[j]) >= CLP::INF)
+				continue;
+			lb=ceil(m_copy.getLoBound(j)-MOD2_TOL);
+			ub=floor(m_copy.getUpBound(j)+MOD2_TOL);
+			if (lb > -CLP::INF && x <= lb+MOD2_TOL)
+				ipColInd[j]=-1;
+			else if (ub < CLP::INF && x >= ub-MOD2_TOL)
+				ipColInd[j]=-2;
+			else
+				ipColInd[j]=colNum++;
+		}
+	// rows of small slacks; rows with variables removed from the LP are skipped unless these variables are fixed
+		for (int r=0; r < m_iRowNum; ++r) {
+			if ((s=getSlack(dpX,r)) < MOD2_MAX_SLACK) {
+				dpSlack[r]=(s > 0.0)? s: 0.0;
+				ipOrd[candNum++]=r;
+			}
+		}
+		wordNum=((colNum+64)>>6)+((candNum+63)>>6);
+		if (candNum > m_iMaxRowNum || candNum*static_cast<double>(wordNum) > MOD2_MAX_WORDS) {
+			k=(m_iMaxRowNum < MOD2_MAX_WORDS/wordNum)? m_iMaxRowNum: MOD2_MAX_WORDS/wordNum;
+			SORT::minK(k,candNum,ipOrd,dpSlack);
+			candNum=k;
+		}
+		SORT::incSortDouble(candNum,ipOrd,dpSlack); // rows of least slacks are taken as pivots
+		int rhsWord=(colNum+64)>>6;
+		wordNum=rhsWord+((candNum+63)>>6);
+
+	// build GF(2) matrix: row `t` is [parities of fractional variables | parity of right hand side | bitset of rows]
+		if (candNum) {
+			if (!(ulpMat = new unsigned long long[candNum*wordNum]) || !(cpPivot = new char[candNum])) {
+				throw new CMemoryException("CMod2Sep::separate");
+			}
+			memset(ulpMat,0,candNum*wordNum*sizeof(unsigned long long));
+			memset(cpPivot,0,candNum);
+		}
+		for (int t=0; t < candNum; ++t) {
+			i=m_ipRow[ipOrd[t]] >> 1;
+			neg=(m_ipRow[ipOrd[t]] & 1)? true: false;
+			ulpRow=ulpMat+t*wordNum;
+			sz=m_copy.getRow(i,dpVal,ipCol);
+			rhs=isOdd((neg)? m_copy.getRowLoBound(i): m_copy.getRowUpBound(i));
+			for (k=0; k < sz; ++k) {
+				if (!isOdd(dpVal[k]))
+					continue;
+				if ((j=ipColInd[ipCol[k]]) >= 0) {
+					setBit(ulpRow,j);
+					++bitNum;
+				}
+				else if (isOdd((j == -1)? ceil(m_copy.getLoBound(ipCol[k])-MOD2_TOL): floor(m_copy.getUpBound(ipCol[k])+MOD2_TOL)))
+					rhs=!rhs;
+			}
+			if (rhs)
+				setBit(ulpRow,colNum);
+			setBit(ulpRow+rhsWord,t);
+		}
+		if (colNum && candNum) {
+			if (candNum >= MOD2_M4R_MIN_ROWS && bitNum > MOD2_M4R_DENSITY*candNum*colNum)
+				eliminateM4R(candNum,colNum,wordNum,ulpMat,cpPivot);
+			else
+				eliminate(candNum,colNum,wordNum,ulpMat,cpPivot);
+		}
+
+	// rows that are not pivots and have odd right hand sides give mod-2 cuts
+		for (int t=0; t < candNum && cutNum < m_iMaxCutNum; ++t) {
+			ulpRow=ulpMat+t*wordNum;
+			if (cpPivot[t] || !getBit(ulpRow,colNum))
+				continue;
+			s=0.0;
+			sz=0;
+			for (int w=rhsWord; w < wordNum && s < MOD2_MAX_SLACK; ++w) {
+				for (word=ulpRow[w]; word; word&=word-1) {
+					k=ipOrd[((w-rhsWord)<<6)+lowBit(word)];
+					s+=dpSlack[k];
+					ipList[sz++]=k;
+				}
+			}
+			if (s < MOD2_MAX_SLACK && buildCut(dpX,ipHdToCol,sz,ipList,cuts,dpCoeff,ipInd,ipPos))
+				++cutNum;
+		}
+	}
+	catch(CMemoryException* pe) {
+		if (ulpMat)
+			delete[] ulpMat;
+		if (cpPivot)
+			delete[] cpPivot;
+		delete[] ipMem;
+		delete[] dpMem;
+		throw pe;
+	}
+	if (ulpMat)
+		delete[] ulpMat;
+	if (cpPivot)
+		delete[] cpPivot;
+	delete[] ipMem;
+	delete[] dpMem;
+	return cutNum;
+} // end of CMod2Sep::separate()
@@ -0,0 +1,464 @@
+// Probing.cpp: implementation of the CProbing class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <except.h>
+#include <lp.h>
+#include "Probing.h"
+
+#define PROBE_TOL 1.0e-6 ///< feasibility and integrality tolerance.
+#define PROBE_MAX_WORK 20000 ///< maximum number of row entries scanned by one propagation.
+#define PROBE_MAX_IMPL 32 ///< maximum number of implications taken from one fixing.
+#define PROBE_CHECK_TIME 16 ///< a thread checks the time limit after probing this number of variables.
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CProbing::CProbing(int threadNum, int maxRoundNum, int timeLimitPerRound, bool replace): CPropagator()
+{
+	m_iThreadNum=(threadNum > 0)? threadNum: 0;
+	m_iMaxRoundNum=(maxRoundNum > 0)? maxRoundNum: 1;
+	m_iTimeLimitPerRound=(timeLimitPerRound > 0)? timeLimitPerRound: 1;
+	m_bReplace=replace;
+	m_ipCand=m_ipImpl=0;
+	m_iCandNum=m_iRoundThreadNum=0;
+	m_bStop=false;
+	m_bInfeasible=false;
+	m_iImplNum=m_iMaxImplNum=0;
+	m_iRoundNum=m_iProbeNum=m_iFixNum=m_iBdNum=0;
+	m_dTime=0.0;
+} // end of CProbing::CProbing()
+
+CProbing::~CProbing()
+{
+	if (m_ipCand)
+		delete[] m_ipCand;
+	if (m_ipImpl)
+		delete[] m_ipImpl;
+} // end of CProbing::~CProbing()
+
+//////////////////////////////////////////////////////////////////////
+// Thread buffers
+//////////////////////////////////////////////////////////////////////
+bool CProbing::allocBuffer(tagBuffer& b) const
+{
+	int n=m_copy.getColNum();
+	memset(&b,0,sizeof(tagBuffer));
+	if (!allocState(b.state))
+		return false;
+	if (!(b.dpSide = new double[n<<1]))
+		return false;
+	if (!(b.ipSide = new int[3*n]))
+		return false;
+	b.ipSidePos=b.ipSide+n;
+	b.ipSideMark=b.ipSidePos+n;
+	memset(b.ipSideMark,0,n*sizeof(int));
+	return true;
+} // end of CProbing::allocBuffer()
+
+void CProbing::freeBuffer(tagBuffer& b)
+{
+	freeState(b.state);
+	if (b.dpSide)
+		delete[] b.dpSide;
+	if (b.ipSide)
+		delete[] b.ipSide;
+	if (b.ipResCol)
+		delete[] b.ipResCol;
+	if (b.dpResBd)
+		delete[] b.dpResBd;
+	if (b.ipImpl)
+		delete[] b.ipImpl;
+	b.dpSide=b.dpResBd=0;
+	b.ipSide=b.ipResCol=b.ipImpl=0;
+} // end of CProbing::freeBuffer()
+
+bool CProbing::addResult(tagBuffer& b, int j, double lo, double up)
+{
+	if (b.resNum == b.maxResNum) {
+		int maxNum=(b.maxResNum)? b.maxResNum<<1: 64;
+		int* ipCol;
+		double* dpBd;
+		if (!(ipCol = new int[maxNum]))
+			return false;
+		if (!(dpBd = new double[maxNum<<1])) {
+			delete[] ipCol;
+			return false;
+		}
+		if (b.resNum) {
+			memcpy(ipCol,b.ipResCol,b.resNum*sizeof(int));
+			memcpy(dpBd,b.dpResBd,(b.resNum<<1)*sizeof(double));
+			delete[] b.ipResCol;
+			delete[] b.dpResBd;
+		}
+		b.ipResCol=ipCol;
+		b.dpResBd=dpBd;
+		b.maxResNum=maxNum;
+	}
+	b.ipResCol[b.resNum]=j;
+	b.dpResBd[b.resNum<<1]=lo;
+	b.dpResBd[(b.resNum++<<1)+1]=up;
+	return true;
+} // end of CProbing::addResult()
+
+bool CProbing::addImplication(tagBuffer& b, int lit1, int lit2)
+{
+	if (b.implNum == b.maxImplNum) {
+		int maxNum=(b.maxImplNum)? b.maxImplNum<<1: 256;
+		int* ipImpl;
+		if (!(ipImpl = new int[maxNum<<1]))
+			return false;
+		if (b.implNum) {
+			memcpy(ipImpl,b.ipImpl,(b.implNum<<1)*sizeof(int));
+			delete[] b.ipImpl;
+		}
+		b.ipImpl=ipImpl;
+		b.maxImplNum=maxNum;
+	}
+	if (lit1 > lit2) {
+		int t=lit1;
+		lit1=lit2;
+		lit2=t;
+	}
+	b.ipImpl[b.implNum<<1]=lit1;
+	b.ipImpl[(b.implNum++<<1)+1]=lit2;
+	return true;
+} // end of CProbing::addImplication()
+
+bool CProbing::fix(tagBuffer& b, int c, int v) const
+{
+	startPropagation(b.state);
+	changeBound(b.state,c,static_cast<double>(v),static_cast<double>(v));
+	return propagate(b.state,PROBE_MAX_WORK);
+} // end of CProbing::fix()
+
+//////////////////////////////////////////////////////////////////////
+// Probing
+//////////////////////////////////////////////////////////////////////
+bool CProbing::probeVar(tagBuffer& b, int c) const
+{
+	int k, j, implNum;
+	++b.probeNum;
+
+// fixing to 0: bounds are saved in `ipSide` and `dpSide`
+	bool ok0=fix(b,c,0);
+	int stamp0=b.state.stamp;
+	b.sideNum=0;
+	if (ok0) {
+		for (k=0; k < b.state.varTrailNum; ++k) {
+			if ((j=b.state.ipVarTrail[k]) == c)
+				continue;
+			b.dpSide[b.sideNum<<1]=b.state.dpD[j<<1];
+			b.dpSide[(b.sideNum<<1)+1]=b.state.dpD[(j<<1)+1];
+			b.ipSidePos[j]=b.sideNum;
+			b.ipSideMark[j]=stamp0;
+			b.ipSide[b.sideNum++]=j;
+		}
+	}
+	undo(b.state);
+
+// fixing to 1
+	bool ok1=fix(b,c,1);
+	if (!ok0 && !ok1) {
+		b.infeasible=true;
+	}
+	else if (!ok0) { // `x_c=1`, and all bounds derived from this fixing are valid
+		for (k=0; k < b.state.varTrailNum; ++k) {
+			j=b.state.ipVarTrail[k];
+			if (!addResult(b,j,b.state.dpD[j<<1],b.state.dpD[(j<<1)+1])) {
+				undo(b.state);
+				return false;
+			}
+		}
+	}
+	else if (!ok1) { // `x_c=0`
+		if (!addResult(b,c,0.0,0.0)) {
+			undo(b.state);
+			return false;
+		}
+		for (k=0; k < b.sideNum; ++k) {
+			if (!addResult(b,b.ipSide[k],b.dpSide[k<<1],b.dpSide[(k<<1)+1])) {
+				undo(b.state);
+				return false;
+			}
+		}
+	}
+	else {
+	// bounds valid for both fixings
+		for (k=0; k < b.state.varTrailNum; ++k) {
+			if ((j=b.state.ipVarTrail[k]) == c || b.ipSideMark[j] != stamp0)
+				continue;
+			int s=b.ipSidePos[j];
+			double lo=std::min(b.state.dpD[j<<1],b.dpSide[s<<1]), up=std::max(b.state.dpD[(j<<1)+1],b.dpSide[(s<<1)+1]);
+			if (lo > m_dpD[j<<1] || up < m_dpD[(j<<1)+1]) {
+				if (!addResult(b,j,std::max(lo,m_dpD[j<<1]),std::min(up,m_dpD[(j<<1)+1]))) {
+					undo(b.state);
+					return false;
+				}
+			}
+		}
+	// implications: literal `2*c` (`x_c=1`) or `2*c+1` (`x_c=0`) and the complement of a binary fixed by that literal
+		for (implNum=k=0; k < b.state.varTrailNum && implNum < PROBE_MAX_IMPL; ++k) {
+			if ((j=b.state.ipVarTrail[k]) == c || !m_copy.isInteger(j) || m_dpD[j<<1] != 0.0 || m_dpD[(j<<1)+1] != 1.0)
+				continue;
+			int lit=-1;
+			if (b.state.dpD[(j<<1)+1] < 0.5)
+				lit=j<<1;
+			else if (b.state.dpD[j<<1] > 0.5)
+				lit=(j<<1)+1;
+			if (lit >= 0) {
+				if (!addImplication(b,c<<1,lit)) {
+					undo(b.state);
+					return false;
+				}
+				++implNum;
+			}
+		}
+		for (implNum=k=0; k < b.sideNum && implNum < PROBE_MAX_IMPL; ++k) {
+			j=b.ipSide[k];
+			if (!m_copy.isInteger(j) || m_dpD[j<<1] != 0.0 || m_dpD[(j<<1)+1] != 1.0)
+				continue;
+			int lit=-1;
+			if (b.dpSide[(k<<1)+1] < 0.5)
+				lit=j<<1;
+			else if (b.dpSide[k<<1] > 0.5)
+				lit=(j<<1)+1;
+			if (lit >= 0) {
+				if (!addImplication(b,(c<<1)+1,lit)) {
+					undo(b.state);
+					return false;
+				}
+				++implNum;
+			}
+		}
+	}
+	undo(b.state);
+	return true;
+} // end of CProbing::probeVar()
+
+void CProbing::probeCands(tagBuffer& b)
+{
+	int T=m_iRoundThreadNum;
+	for (int k=b.thread, num=0; k < m_iCandNum && !m_bStop && !b.infeasible; k+=T) {
+		if (!probeVar(b,m_ipCand[k])) {
+			b.failed=true;
+			break;
+		}
+		if (!(++num % PROBE_CHECK_TIME) &&
+				std::chrono::duration<double>(std::chrono::steady_clock::now()-m_roundStart).count() > m_iTimeLimitPerRound)
+			m_bStop=true;
+	}
+} // end of CProbing::probeCands()
+
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CProbing::startThread(void* param)
+#else
+void* CProbing::startThread(void* param)
+#endif
+{
+	tagBuffer* pBuf=static_cast<tagBuffer*>(param);
+	pBuf->pProbing->probeCands(*pBuf);
+	return 0;
+} // end of CProbing::startThread()
+#endif
+
+int CProbing::merge(int threadNum, tagBuffer* pBuf, char* cpChanged, char* cpTouched)
+{
+	int t, k, j, changedNum=0, n=m_copy.getColNum();
+	for (t=0; t < threadNum; ++t) {
+		tagBuffer& b=pBuf[t];
+		if (b.infeasible)
+			m_bInfeasible=true;
+		for (k=0; k < b.resNum; ++k) {
+			j=b.ipResCol[k];
+			double lo=b.dpResBd[k<<1], up=b.dpResBd[(k<<1)+1];
+			if (lo > m_dpD[j<<1]) {
+				m_dpD[j<<1]=lo;
+				cpChanged[j]=1;
+			}
+			if (up < m_dpD[(j<<1)+1]) {
+				m_dpD[(j<<1)+1]=up;
+				cpChanged[j]=1;
+			}
+		}
+		if (b.implNum) {
+			if (m_iImplNum+b.implNum > m_iMaxImplNum) {
+				int maxNum=std::max(m_iMaxImplNum<<1,m_iImplNum+b.implNum);
+				int* ipImpl;
+				if (!(ipImpl = new int[maxNum<<1])) {
+					throw new CMemoryException("CProbing::merge");
+				}
+				if (m_iImplNum) {
+					memcpy(ipImpl,m_ipImpl,(m_iImplNum<<1)*sizeof(int));
+				}
+				if (m_ipImpl)
+					delete[] m_ipImpl;
+				m_ipImpl=ipImpl;
+				m_iMaxImplNum=maxNum;
+			}
+			memcpy(m_ipImpl+(m_iImplNum<<1),b.ipImpl,(b.implNum<<1)*sizeof(int));
+			m_iImplNum+=b.implNum;
+		}
+	}
+
+// statistics, and variables to be probed at the next round
+	memset(cpTouched,0,n);
+	for (j=0; j < n; ++j) {
+		if (!cpChanged[j])
+			continue;
+		cpChanged[j]=0;
+		++changedNum;
+		double lo=m_dpD[j<<1], up=m_dpD[(j<<1)+1];
+		if (lo > up+PROBE_TOL*(1.0+fabs(up)))
+			m_bInfeasible=true;
+		else if (lo >= up)
+			++m_iFixNum;
+		else
+			++m_iBdNum;
+		for (int p=m_ipColBeg[j]; p < m_ipColBeg[j+1]; ++p) {
+			const double* dpVal;
+			const int* ipCol;
+			int sz=m_copy.getRow(m_ipColRow[p],dpVal,ipCol);
+			for (k=0; k < sz; ++k) {
+				cpTouched[ipCol[k]]=1;
+			}
+		}
+	}
+	return changedNum;
+} // end of CProbing::merge()
+
+void CProbing::probe(int threadNum)
+{
+	auto start=std::chrono::steady_clock::now();
+	int t, j, n=m_copy.getColNum();
+	init();
+	if (!(m_ipCand = new int[n])) {
+		throw new CMemoryException("CProbing::probe");
+	}
+	if (m_iThreadNum)
+		threadNum=m_iThreadNum;
+#ifdef __ONE_THREAD_
+	threadNum=1;
+#else
+	if (threadNum < 1)
+		threadNum=1;
+#endif
+	tagBuffer* pBuf;
+	char* cpMem;
+	if (!(pBuf = new tagBuffer[threadNum])) {
+		throw new CMemoryException("CProbing::probe");
+	}
+	memset(pBuf,0,threadNum*sizeof(tagBuffer));
+	if (!(cpMem = new char[n<<1])) {
+		delete[] pBuf;
+		throw new CMemoryException("CProbing::probe");
+	}
+	char *cpChanged=cpMem, *cpTouched=cpMem+n;
+	memset(cpMem,0,n<<1);
+	try {
+		for (t=0; t < threadNum; ++t) {
+			if (!allocBuffer(pBuf[t])) {
+				throw new CMemoryException("CProbing::probe");
+			}
+			pBuf[t].pProbing=this;
+			pBuf[t].thread=t;
+		}
+		for (int round=0; round < m_iMaxRoundNum; ++round) {
+			m_iCandNum=0;
+			for (j=0; j < n; ++j) {
+				if (m_copy.isInteger(j) && m_dpD[j<<1] == 0.0 && m_dpD[(j<<1)+1] == 1.0 && (!round || cpTouched[j]))
+					m_ipCand[m_iCandNum++]=j;
+			}
+			if (!m_iCandNum)
+				break;
+			int T=std::min(threadNum,m_iCandNum);
+			for (t=0; t < T; ++t) {
+				tagBuffer& b=pBuf[t];
+				resetState(b.state,m_dpD);
+				b.resNum=b.implNum=b.probeNum=0;
+			}
+			m_iRoundThreadNum=T;
+			m_roundStart=std::chrono::steady_clock::now();
+			m_bStop=false;
+#ifndef __ONE_THREAD_
+			if (T > 1) {
+				_THREAD* pThreads;
+				if (!(pThreads = new _THREAD[T-1])) {
+					throw new CMemoryException("CProbing::probe");
+				}
+				for (t=1; t < T; ++t) {
+					_THREAD_CREATE(pThreads[t-1],startThread,pBuf+t)
+				}
+				probeCands(pBuf[0]);
+				for (t=1; t < T; ++t) {
+					_THREAD_JOIN(pThreads[t-1])
+					_THREAD_CLOSE(pThreads[t-1])
+				}
+				delete[] pThreads;
+			}
+			else
+#endif
+			probeCands(pBuf[0]);
+			++m_iRoundNum;
+			for (t=0; t < T; ++t) {
+				if (pBuf[t].failed) {
+					throw new CMemoryException("CProbing::probe");
+				}
+				m_iProbeNum+=pBuf[t].probeNum;
+			}
+			if (!merge(T,pBuf,cpChanged,cpTouched) || m_bInfeasible)
+				break;
+		}
+	}
+	catch(CMemoryException* pe) {
+		for (t=0; t < threadNum; ++t) {
+			freeBuffer(pBuf[t]);
+		}
+		delete[] cpMem;
+		delete[] pBuf;
+		throw pe;
+	}
+	for (t=0; t < threadNum; ++t) {
+		freeBuffer(pBuf[t]);
+	}
+	delete[] cpMem;
+	delete[] pBuf;
+
+// implications are sorted, so that the result does not depend on the order in which threads have finished
+	if (m_iImplNum) {
+		long long* lpKey;
+		if (!(lpKey = new long long[m_iImplNum])) {
+			throw new CMemoryException("CProbing::probe");
+		}
+		for (int k=0; k < m_iImplNum; ++k) {
+			lpKey[k]=(static_cast<long long>(m_ipImpl[k<<1]) << 32) | static_cast<long long>(m_ipImpl[(k<<1)+1]);
+		}
+		std::sort(lpKey,lpKey+m_iImplNum);
+		m_iImplNum=static_cast<int>(std::unique(lpKey,lpKey+m_iImplNum)-lpKey);
+		for (int k=0; k < m_iImplNum; ++k) {
+			m_ipImpl[k<<1]=static_cast<int>(lpKey[k] >> 32);
+			m_ipImpl[(k<<1)+1]=static_cast<int>(lpKey[k] & 0xffffffffll);
+		}
+		delete[] lpKey;
+	}
+	m_dTime=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+} // end of CProbing::probe()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CProbing::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	out << "Probing\n";
+	out << "=== Rounds ==== Probed ===== Fixed ==== Bounds = Implications ===== Time\n";
+	sprintf(str,"%10d %11d %11d %11d %13d %10.3f\n",m_iRoundNum,m_iProbeNum,m_iFixNum,m_iBdNum,m_iImplNum,m_dTime);
+	out << str;
+	if (m_bInfeasible)
+		out << "Problem is infeasible\n";
+	out << std::endl;
+} // end of CProbing::printStatistics()
@@ -4,8 +4,12 @@
 #include <cstdlib>
 #include <cstdio>
 #include <fstream>
+#include <iostream>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include <except.h>
 #include "Var.h"
 #include "Ctr.h"
@@ -13,6 +17,33 @@
 #include "Function.h"
 #include "DVar.h"
 #include "Problem.h"
+#include "RelBranching.h"
+#include "Checkpoint.h"
+#include "RootRace.h"
+#include "Incumbent.h"
+#include "MatrixCopy.h"
+#include "Decomposition.h"
+#include "CutPool.h"
+#include "CutSelector.h"
+#include "Separator.h"
+#include "ConcurrentSep.h"
+#include "Mod2Sep.h"
+#include "ZeroHalfSep.h"
+#include "CliqueSep.h"
+#include "Conflict.h"
+#include "CutAging.h"
+#include "CutStat.h"
+#include "LiftProject.h"
+#include "FeasPump.h"
+#include "Lns.h"
+#include "Diving.h"
+#include "Probing.h"
+#include "Propagator.h"
+#include "Symmetry.h"
+#include "Restart.h"
+#include "SolutionPool.h"
+#include "MipStart.h"
+#include "HeurScheduler.h"
 
 using std::ofstream;
 using std::endl;
@@ -23,6 +54,15 @@ using std::endl;
 
 extern void int2str(int, char*);
 
+/**
+ * \param[in] startTime time point.
+ * \return time (in microseconds) elapsed since `startTime`.
+ */
+static inline long long elapsedTime(const std::chrono::steady_clock::time_point& startTime)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-startTime).count();
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -38,6 +78,40 @@ void CProblem::init()
 	m_dpVarVal=m_dpRedCost=m_dpPrice=0;
 	m_iCutState=0;
 	m_pLastCut=0;
+	m_pRelBr=0;
+	m_iRelBrCol=-1;
+	m_pCkp=0;
+	m_pRace=0;
+	m_pFeasPump=0;
+	m_pLns=0;
+	m_pDiving=0;
+	m_pProbing=0;
+	m_pSymmetry=0;
+	m_pRestart=0;
+	m_pPool=0;
+	m_bPoolSolved=false;
+	m_pStart=0;
+	m_pSched=0;
+	m_iNodeCount=0;
+	m_pDecomp=0;
+	m_bDecompSolved=false;
+	m_pCutPool=0;
+	m_pCutSel=0;
+	m_pConcSep=0;
+	m_pMod2Sep=0;
+	m_pZeroHalfSep=0;
+	m_pCliqueSep=0;
+	m_pConflict=0;
+	m_pPropagator=0;
+	m_pCutAging=0;
+	m_pCutStat=0;
+	m_pLiftProject=0;
+	m_ipHdToCol=0;
+	m_iCutHashNum=m_iMaxCutHashNum=0;
+	m_ulpCutHash=0;
+	if (!(m_pInc = new CIncumbent())) {
+		throw new CMemoryException("CProblem::init");
+	}
 	m_pSum = new CLinSum[10];
 	for (int i=0; i < 10; ++i)
 		m_pSum[i].makePermanent();
@@ -85,6 +159,68 @@ CProblem::CProblem(const CProblem &other, int thread): CMIP(other,thread)
 	m_dpVarVal=other.m_dpVarVal;
 	m_dpRedCost=other.m_dpRedCost;
 	m_dpPrice=other.m_dpPrice;
+	m_pRelBr=0;
+	m_iRelBrCol=-1;
+	if (other.m_pRelBr) {
+		if (!(m_pRelBr = new CRelBranching(*other.m_pRelBr))) {
+			throw new CMemoryException("CProblem::CProblem(CProblem &other)");
+		}
+	}
+	m_pCkp=other.m_pCkp;
+	m_pRace=0;
+	m_pFeasPump=0;
+	m_pLns=0;
+	m_pDiving=0;
+	m_pProbing=0;
+	m_pSymmetry=0;
+	m_pRestart=0;
+	m_pPool=other.m_pPool;
+	m_bPoolSolved=false;
+	m_pStart=0;
+	m_pSched=0;
+	m_pInc=other.m_pInc;
+	m_iNodeCount=0;
+	m_pDecomp=0;
+	m_bDecompSolved=false;
+	m_pCutPool=other.m_pCutPool;
+	m_pCutSel=0;
+	if (other.m_pCutSel) {
+		if (!(m_pCutSel = new CCutSelector(*other.m_pCutSel))) {
+			throw new CMemoryException("CProblem::CProblem(CProblem &other)");
+		}
+	}
+	m_pMod2Sep=other.m_pMod2Sep;
+	m_pZeroHalfSep=other.m_pZeroHalfSep;
+	m_pCliqueSep=other.m_pCliqueSep;
+	m_pConflict=other.m_pConflict;
+	m_pPropagator=other.m_pPropagator;
+	m_pCutAging=0;
+	if (other.m_pCutAging) {
+		if (!(m_pCutAging = new CCutAging(*other.m_pCutAging))) {
+			throw new CMemoryException("CProblem::CProblem(CProblem &other)");
+		}
+	}
+	m_pCutStat=0;
+	if (other.m_pCutStat) {
+		if (!(m_pCutStat = new CCutStat(*other.m_pCutStat))) {
+			throw new CMemoryException("CProblem::CProblem(CProblem &other)");
+		}
+	}
+	m_ipHdToCol=0;
+	m_iCutHashNum=m_iMaxCutHashNum=0;
+	m_ulpCutHash=0;
+	m_pLiftProject=0;
+	if (other.m_pLiftProject) {
+		if (!(m_pLiftProject = new CLiftProject(*other.m_pLiftProject))) {
+			throw new CMemoryException("CProblem::CProblem(CProblem &other)");
+		}
+	}
+	m_pConcSep=0;
+	if (other.m_pConcSep) {
+		if (!(m_pConcSep = new CConcurrentSep(*other.m_pConcSep))) {
+			throw new CMemoryException("CProblem::CProblem(CProblem &other)");
+		}
+	}
 	m_pSum = new CLinSum[10];
 	for (int i=0; i < 10; ++i)
 		m_pSum[i].makePermanent();
@@ -116,11 +252,58 @@ CProblem::~CProblem()
 		pDvar1=pDvar->getPrev();
 		delete pDvar;
 	}
+	if (m_pCkp)
+		delete m_pCkp;
+	if (m_pRace)
+		delete m_pRace;
+	if (m_pFeasPump)
+		delete m_pFeasPump;
+	if (m_pLns)
+		delete m_pLns;
+	if (m_pDiving)
+		delete m_pDiving;
+	if (m_pProbing)
+		delete m_pProbing;
+	if (m_pSymmetry)
+		delete m_pSymmetry;
+	if (m_pRestart)
+		delete m_pRestart;
+	if (m_pPool)
+		delete m_pPool;
+	if (m_pStart)
+		delete m_pStart;
+	if (m_pSched)
+		delete m_pSched;
+	if (m_pDecomp)
+		delete m_pDecomp;
+	if (m_pCutPool)
+		delete m_pCutPool;
+	if (m_pConflict)
+		delete m_pConflict;
+	if (m_pPropagator)
+		delete m_pPropagator;
+	delete m_pInc;
 #ifndef __ONE_THREAD_
 	}
 #endif
 	if (m_pSum)
 		delete[] m_pSum;
+	if (m_pRelBr)
+		delete m_pRelBr;
+	if (m_pCutSel)
+		delete m_pCutSel;
+	if (m_pConcSep)
+		delete m_pConcSep;
+	if (m_pCutAging)
+		delete m_pCutAging;
+	if (m_pCutStat)
+		delete m_pCutStat;
+	if (m_pLiftProject)
+		delete m_pLiftProject;
+	if (m_ipHdToCol)
+		delete[] m_ipHdToCol;
+	if (m_ulpCutHash)
+		delete[] m_ulpCutHash;
 }
 
 void CProblem::setObj(CLinSum *lsum, bool bSense)
@@ -163,6 +346,7 @@ void CProblem::load()
 	CTerm* pTerm;
 	CFunction* pFunc;
 	CDvar* pDvar;
+	bool bReload=(m_pRestart && m_pRestart->m_iRestartNum > 0);
 	m=nz=0;
 
 	for (pCtr=m_pLastCtr; pCtr; pCtr=pCtr->getPrev()) {
@@ -183,7 +367,12 @@ void CProblem::load()
 		n+=(sz=pDvar->getSize());
 		nz+=(2*sz+1);
 	}
-	openMatrix(m,n,nz);
+	if (m_pSymmetry) { // rows are reserved for symmetry breaking cuts
+		m_pSymmetry->m_iMaxCutNum=n;
+		openMatrix(m+n,n,nz+(n<<1));
+	}
+	else
+		openMatrix(m,n,nz);
 	n=m=0;
 	for (pVar=m_pLastVar; pVar; pVar=pVar->getPrev()) {
 		nz=0;
@@ -285,6 +474,116 @@ void CProblem::load()
 			m_dpC[pTerm->getVar()->getHandle()]=(m_bSense)? pTerm->getCoeff(): -pTerm->getCoeff();
 		}
 	}
+	if (bReload) { // global bounds found at the root node before the restart
+		for (int j=0; j < n; ++j) {
+			if (m_pRestart->m_cpBd[j]) {
+				double lo=m_pRestart->m_dpD[j<<1], up=m_pRestart->m_dpD[(j<<1)+1];
+				if (lo > getVarLoBound(j) || up < getVarUpBound(j))
+					setVarBounds(j,std::max(lo,getVarLoBound(j)),std::min(up,getVarUpBound(j)));
+			}
+		}
+	}
+	else if (m_pRestart)
+		m_pRestart->init(n);
+	if (m_pPool && !bReload) {
+		copyMatrix(m_pPool->m_copy);
+		m_pPool->init();
+		if (m_pPool->m_bAlternative) // dual reductions of the solver may cut off alternative solutions
+			preprocOff();
+	}
+	if (m_pSymmetry) { // cuts are added to the problem before all copies are made
+		if (!bReload) {
+			copyMatrix(m_pSymmetry->m_copy);
+			m_pSymmetry->detect();
+		}
+		for (int k=0; k < m_pSymmetry->getCutNum(); ++k) {
+			int b, j;
+			m_pSymmetry->getCut(k,b,j);
+			CLP::addCtr(r1=m++,0,0.0,INF);
+			addEntry(1.0,r1,b);
+			addEntry(-1.0,r1,j);
+		}
+		if (!isSilent() && !bReload)
+			m_pSymmetry->printStatistics(std::cout);
+	}
+	if (m_pProbing) { // bounds found by probing are passed to all copies
+		if (!bReload) {
+			copyMatrix(m_pProbing->m_copy);
+#ifndef __ONE_THREAD_
+			m_pProbing->probe(getThreadNum());
+#else
+			m_pProbing->probe(1);
+#endif
+		}
+		if (!m_pProbing->isInfeasible()) {
+			for (int j=0; j < n; ++j) {
+				double lo=m_pProbing->getLoBound(j), up=m_pProbing->getUpBound(j);
+				if (lo > getVarLoBound(j) || up < getVarUpBound(j))
+					setVarBounds(j,std::max(lo,getVarLoBound(j)),std::min(up,getVarUpBound(j)));
+			}
+		}
+		if (m_pProbing->m_bReplace)
+			setProbingDepth(1);
+		if (!isSilent() && !bReload)
+			m_pProbing->printStatistics(std::cout);
+	}
+	if (bReload) { // copies of the original problem made at the first load remain valid
+		closeMatrix();
+		return;
+	}
+	if (m_pDecomp) // copies are made before the solver preprocesses the problem
+		copyMatrix(m_pDecomp->m_copy);
+	if (m_pRace)
+		copyMatrix(m_pRace->m_copy);
+	if (m_pFeasPump)
+		copyMatrix(m_pFeasPump->m_copy);
+	if (m_pLns)
+		copyMatrix(m_pLns->m_copy);
+	if (m_pDiving)
+		copyMatrix(m_pDiving->m_copy);
+	if (m_pStart && m_pStart->getSize())
+		copyMatrix(m_pStart->m_copy);
+	if (m_pCkp) {
+		copyMatrix(m_pCkp->m_copy);
+		m_pCkp->init();
+	}
+	if (m_pSched) {
+		if (m_pFeasPump)
+			m_pFeasPump->setScheduler(m_pSched);
+		if (m_pLns)
+			m_pLns->setScheduler(m_pSched);
+		if (m_pDiving)
+			m_pDiving->setScheduler(m_pSched);
+	}
+	if (m_pMod2Sep) {
+		copyMatrix(m_pMod2Sep->m_copy);
+		m_pMod2Sep->init();
+	}
+	if (m_pZeroHalfSep) {
+		copyMatrix(m_pZeroHalfSep->m_copy);
+		m_pZeroHalfSep->init();
+	}
+	if (m_pPropagator) {
+		copyMatrix(m_pPropagator->m_copy);
+		m_pPropagator->init();
+	}
+	if (m_pCliqueSep || m_pConflict) {
+		CMatrixCopy copy;
+		copyMatrix(copy);
+		if (m_pCliqueSep) {
+			CCliqueTable& table=m_pCliqueSep->m_table;
+			table.build(copy);
+			if (m_pProbing && !m_pProbing->isInfeasible()) {
+				for (int k=0; k < m_pProbing->m_iImplNum; ++k) {
+					int lit1=m_pProbing->m_ipImpl[k<<1], lit2=m_pProbing->m_ipImpl[(k<<1)+1];
+					if (!table.isAdjacent(lit1,lit2))
+						table.addConflict(lit1,lit2);
+				}
+			}
+		}
+		if (m_pConflict)
+			m_pConflict->init(copy);
+	}
 	closeMatrix();
 } // end of CProblem::load
 
@@ -309,6 +608,14 @@ void sortByHandles(int n, double* dpX, int* ipHd, double* dpMem=0)
 void CProblem::setSolution(int n, double *dpVal, int *ipHd, bool bLocal)
 {
 //	int *ipHdToCol=(m_iN)? reinterpret_cast<int*>(m_dpArray): reinterpret_cast<int*>(m_ipVarType);
+	if (!ipHd && !bLocal && m_bDecompSolved) {
+		m_dpVarVal=m_pDecomp->getSolution(); // already sorted by handles
+		return;
+	}
+	if (!ipHd && !bLocal && m_bPoolSolved) {
+		m_dpVarVal=const_cast<double*>(m_pPool->getSolution(0)); // indexed by handles
+		return;
+	}
 	if (!ipHd)
 		n=(bLocal)? CLP::getSolution(dpVal,ipHd): CMIP::getSolution(dpVal,ipHd);
 	m_dpVarVal=dpVal;
@@ -324,6 +631,7 @@ void CProblem::setSolution(int n, double *dpVal, int *ipHd, bool bLocal)
 void CProblem::solve(const char* solFile)
 {
 	m_dpVarVal=m_dpPrice=m_dpRedCost=0;
+	m_bDecompSolved=m_bPoolSolved=false;
 	if (isPureLP()) { // LP problem
 		CLP::optimize();
 		if (CLP::isSolution()) {
@@ -341,8 +649,89 @@ void CProblem::solve(const char* solFile)
 		}
 	}
 	else {
+		m_pInc->reset(CLP::getObjSense(),m_iN);
+		if (m_pDecomp && decompose()) {
+			setSolution(0,0,0,false);
+			return;
+		}
+		if (m_pCutPool)
+			m_pCutPool->reset(m_iVarNum);
+		if (m_pCutSel)
+			initCutSelector();
+		if (m_pRelBr)
+			m_pRelBr->allocMemForPseudocosts(m_iN);
+		if (m_pCkp) {
+			if (m_pCkp->read() && m_pRelBr &&
+					m_pCkp->m_iPcSize == m_pRelBr->getPseudocostSize())
+				m_pRelBr->restorePseudocosts(m_pCkp->m_dpPc);
+			m_pCkp->start();
+		}
+		if (m_pSched)
+			m_pSched->start();
+		if (m_pStart && m_pStart->getSize()) {
+			m_pStart->run();
+			if (!isSilent())
+				m_pStart->printStatistics(std::cout);
+		}
+		if (m_pRace)
+			race();
+		if (m_pFeasPump)
+			m_pFeasPump->start();
 		CMIP::optimize(10000000l,0.0,solFile);
-		if (CMIP::isSolution()) {
+		while (m_pRestart && m_pRestart->m_bRestart) {
+			restart();
+			CMIP::optimize(10000000l,0.0,solFile);
+		}
+		if (m_pFeasPump) {
+			m_pFeasPump->stop();
+			if (!isSilent())
+				m_pFeasPump->printStatistics(std::cout);
+		}
+		if (m_pLns) {
+			m_pLns->stop();
+			if (!isSilent())
+				m_pLns->printStatistics(std::cout);
+		}
+		if (m_pDiving) {
+			m_pDiving->stop();
+			if (!isSilent())
+				m_pDiving->printStatistics(std::cout);
+		}
+		if (m_pRestart && !isSilent())
+			m_pRestart->printStatistics(std::cout);
+		if (m_pPool) {
+			if (CMIP::isSolution()) { // the solution found by preprocessing is not passed to isFeasible()
+				double *dpX=0;
+				int *ipHd=0, n=CMIP::getSolution(dpX,ipHd);
+				m_pPool->add(n,dpX,ipHd);
+			}
+			m_pPool->sort();
+			if (m_pPool->m_bAlternative && m_pPool->getSolNum()) // the solver has not accepted any solution
+				m_bPoolSolved=true;
+			if (!isSilent())
+				m_pPool->printStatistics(std::cout);
+		}
+		if (m_pPropagator && !isSilent())
+			m_pPropagator->printStatistics(std::cout);
+		if (m_pConflict && !isSilent())
+			m_pConflict->printStatistics(std::cout);
+		if (m_pCutAging && !isSilent())
+			m_pCutAging->printStatistics(std::cout);
+		if (m_pLiftProject && !isSilent())
+			m_pLiftProject->printStatistics(std::cout);
+		if (m_pCkp) {
+			if (timeLimitStop()) { // the solution procedure is to be resumed from the last checkpoint
+				if (m_pCkp->m_bResume)
+					resumeRecord();
+				takeCheckpoint();
+				m_pCkp->stop();
+			}
+			else {
+				m_pCkp->stop();
+				m_pCkp->remove();
+			}
+		}
+		if (CMIP::isSolution() || m_bPoolSolved) {
 			setSolution(0,0,0,false);
 		}
 	}
@@ -388,6 +777,10 @@ void CProblem::printSolution(const char* fileName)
 
 double CProblem::getObjective()
 {
+	if (m_bDecompSolved)
+		return m_pDecomp->getObjVal();
+	if (m_bPoolSolved)
+		return m_pPool->getObjVal(0);
 	return (isPureLP())? CLP::getObjVal(): CMIP::getObjVal();
 }
 
@@ -411,6 +804,8 @@ char* CProblem::getVarName(tagHANDLE colHd, char *name)
 
 bool CProblem::isSolution()
 {
+	if (m_bDecompSolved || m_bPoolSolved)
+		return true;
 	return (isPureLP())?
 		CLP::isSolution(): CMIP::isSolution();
 }
@@ -588,15 +983,22 @@ CLinSum& CProblem::getSum(int i)
 //////////////////////////////////////////////////////////////
 // S E P A R A T I O N
 ///////////////////////
-void CProblem::loadCuts()
+int CProblem::loadCuts(int family)
 {
 	double l,u,w;
 	double *dpVal;
 	CVar* pVar;
-	int	*ipHdToCol, *ipCol, *ipInd;
-	int col,i,sz,n;
+	int	*ipHdToCol, *ipCol, *ipInd, *ipHd=0;
+	int col,i,sz,n,cutNum=0;
+	unsigned type;
+	bool inLP;
 
 	n=m_iVarNum;
+	if ((m_pCutPool || m_pCutSel) && !isPureLP()) {
+		if (!(ipHd = new int[n+1])) {
+			throw new CMemoryException("CProblem::loadCuts");
+		}
+	}
 	dpVal=m_dpFd;
 	ipCol=reinterpret_cast<int*>(dpVal+n);
 	ipInd=ipCol+n;
@@ -628,17 +1030,604 @@ void CProblem::loadCuts()
 					u-=w;
 			}
 		} // for (pTerm=pCtr->getLastTerm()
+		type=pCtr->isGlobal()? 0: CTR_LOCAL;
+		inLP=false; // cuts with variables removed by preprocessing are sent directly to the solver, which substitutes them
+		if (ipHd) {
+			for (i=0; i < sz && ipCol[i] < m_iN; i++) {
+				ipHd[i]=m_ipColHd[ipCol[i]];
+			}
+			if ((inLP=(i == sz)) && m_pCutPool && !type)
+				m_pCutPool->add(l,u,sz,dpVal,ipHd);
+		}
 		if (isPureLP())
 			addNewRow(NIL,0,l,u,sz,dpVal,ipCol,false,NOT_SCALED,n);
-		else
-			addCut(-2,pCtr->isGlobal()? 0: CTR_LOCAL,l,u,sz,dpVal,ipCol,false,NOT_SCALED,n);
+		else if (!m_pCutSel || !inLP || !m_pCutSel->addCand(family,type,l,u,sz,dpVal,ipHd)) {
+			int m=m_iM;
+			addCut(-2,type,l,u,sz,dpVal,ipCol,false,NOT_SCALED,n);
+			if (m_pCutStat)
+				tagCuts(m,family);
+			++cutNum;
+		}
 		ipHdToCol=reinterpret_cast<int*>(m_dpNorm); // because of possible memory reallocation
 		for (i=0; i < sz; i++) {
 			ipInd[ipCol[i]]=NIL;
 		}
 	}
+	if (ipHd)
+		delete[] ipHd;
+	if (m_pCutSel && !isPureLP())
+		cutNum+=sendSelectedCuts();
+	return cutNum;
 } // end of CProblem::loadCuts
 
+int* CProblem::mapHandles()
+{
+	if (!m_ipHdToCol) {
+		if (!(m_ipHdToCol = new int[m_iVarNum])) {
+			throw new CMemoryException("CProblem::mapHandles");
+		}
+	}
+	for (int j=0; j < m_iVarNum; j++) {
+		m_ipHdToCol[j]=-1;
+	}
+	for (int i=0; i < m_iN; i++) {
+		m_ipHdToCol[m_ipColHd[i]]=i;
+	}
+	return m_ipHdToCol;
+} // end of CProblem::mapHandles()
+
+int CProblem::sendSelectedCuts()
+{
+	unsigned type;
+	double b1, b2;
+	const double *dpCutVal;
+	const int *ipCutHd;
+	unsigned long long h, *ulpHash;
+	int t, sz, n=m_iVarNum, hashNum=m_iCutHashNum, cutNum=m_pCutSel->select(m_dpVarVal), sentNum=0;
+	mapHandles();
+	if (hashNum+cutNum > m_iMaxCutHashNum) {
+		if (!(ulpHash = new unsigned long long[hashNum+cutNum])) {
+			throw new CMemoryException("CProblem::sendSelectedCuts");
+		}
+		if (m_ulpCutHash) {
+			memcpy(ulpHash,m_ulpCutHash,hashNum*sizeof(unsigned long long));
+			delete[] m_ulpCutHash;
+		}
+		m_ulpCutHash=ulpHash;
+		m_iMaxCutHashNum=hashNum+cutNum;
+	}
+	ulpHash=m_ulpCutHash+hashNum;
+	for (int k=0; k < cutNum; ++k) {
+		sz=m_pCutSel->getSelected(k,type,b1,b2,dpCutVal,ipCutHd);
+		h=CCutAging::hashRow(sz,dpCutVal,ipCutHd,b1,b2);
+		for (t=0; t < hashNum && m_ulpCutHash[t] != h; t++);
+		if (t < hashNum)
+			continue; // the same cut has been sent in the previous round
+		ulpHash[sentNum++]=h;
+		double *dpVal=m_dpFd;
+		int *ipCol=reinterpret_cast<int*>(dpVal+n);
+		for (int i=0; i < sz; i++) {
+			dpVal[i]=dpCutVal[i];
+			ipCol[i]=m_ipHdToCol[ipCutHd[i]];
+		}
+		int m=m_iM;
+		addCut(-2,type,b1,b2,sz,dpVal,ipCol,false,NOT_SCALED,n);
+		if (m_pCutStat)
+			tagCuts(m,m_pCutSel->getSelectedFamily(k));
+	}
+	memmove(m_ulpCutHash,ulpHash,sentNum*sizeof(unsigned long long));
+	m_iCutHashNum=sentNum;
+	m_pCutSel->clear();
+	return sentNum;
+} // end of CProblem::sendSelectedCuts()
+
+void CProblem::setCutSelection(double effWeight, double orthoWeight, double parWeight, double minOrtho, int maxCutNum)
+{
+	if (m_pCutSel)
+		delete m_pCutSel;
+	if (!(m_pCutSel = new CCutSelector(effWeight,orthoWeight,parWeight,minOrtho,maxCutNum))) {
+		throw new CMemoryException("CProblem::setCutSelection");
+	}
+} // end of CProblem::setCutSelection()
+
+void CProblem::addSeparator(CSeparator* pSep, int threadNum)
+{
+	if (!m_pCutSel)
+		setCutSelection();
+	if (!m_pConcSep) {
+		if (!(m_pConcSep = new CConcurrentSep(threadNum))) {
+			throw new CMemoryException("CProblem::addSeparator");
+		}
+	}
+	m_pConcSep->addSeparator(pSep);
+} // end of CProblem::addSeparator()
+
+void CProblem::setMod2Cuts(int maxRowNum, int maxCutNum, int threadNum)
+{
+	CMod2Sep* pSep;
+	if (m_pMod2Sep)
+		return;
+	if (!(pSep = new CMod2Sep(maxRowNum,maxCutNum))) {
+		throw new CMemoryException("CProblem::setMod2Cuts");
+	}
+	try {
+		addSeparator(pSep,threadNum);
+	}
+	catch(CMemoryException* pe) {
+		delete pSep;
+		throw pe;
+	}
+	m_pMod2Sep=pSep;
+} // end of CProblem::setMod2Cuts()
+
+void CProblem::setZeroHalfCuts(int maxCutNum, int threadNum)
+{
+	CZeroHalfSep* pSep;
+	if (m_pZeroHalfSep)
+		return;
+	if (!(pSep = new CZeroHalfSep(maxCutNum))) {
+		throw new CMemoryException("CProblem::setZeroHalfCuts");
+	}
+	try {
+		addSeparator(pSep,threadNum);
+	}
+	catch(CMemoryException* pe) {
+		delete pSep;
+		throw pe;
+	}
+	m_pZeroHalfSep=pSep;
+} // end of CProblem::setZeroHalfCuts()
+
+void CProblem::setCliqueCuts(int maxCutNum, int threadNum)
+{
+	CCliqueSep* pSep;
+	if (m_pCliqueSep)
+		return;
+	if (!(pSep = new CCliqueSep(maxCutNum))) {
+		throw new CMemoryException("CProblem::setCliqueCuts");
+	}
+	try {
+		addSeparator(pSep,threadNum);
+	}
+	catch(CMemoryException* pe) {
+		delete pSep;
+		throw pe;
+	}
+	m_pCliqueSep=pSep;
+} // end of CProblem::setCliqueCuts()
+
+void CProblem::addConflict(CVar& var1, bool val1, CVar& var2, bool val2)
+{
+	if (m_pCliqueSep && var1.getHandle() < m_pCliqueSep->m_table.getColNum() && var2.getHandle() < m_pCliqueSep->m_table.getColNum())
+		m_pCliqueSep->m_table.addConflict((var1.getHandle() << 1) | ((val1)? 0: 1),(var2.getHandle() << 1) | ((val2)? 0: 1));
+} // end of CProblem::addConflict()
+
+void CProblem::setConflictAnalysis(int maxLen)
+{
+	if (m_pConflict)
+		delete m_pConflict;
+	if (!(m_pConflict = new CConflict(maxLen))) {
+		throw new CMemoryException("CProblem::setConflictAnalysis");
+	}
+	if (!m_pCutPool)
+		setCutPool();
+} // end of CProblem::setConflictAnalysis()
+
+bool CProblem::analyzeConflict()
+{
+	double b, *dpD, *dpVal;
+	int sz, hd, *ipHd, n=m_pConflict->getColNum();
+	if (!(dpD = new double[(n<<1)+n])) {
+		throw new CMemoryException("CProblem::analyzeConflict");
+	}
+	if (!(ipHd = new int[n])) {
+		delete[] dpD;
+		throw new CMemoryException("CProblem::analyzeConflict");
+	}
+	dpVal=dpD+(n<<1);
+	for (int j=0; j < n; ++j) {
+		dpD[j<<1]=m_pConflict->getLoBound(j);
+		dpD[(j<<1)+1]=m_pConflict->getUpBound(j);
+	}
+	for (int j=0; j < getVarNum(); ++j) {
+		if ((hd=m_ipColHd[j]) >= 0 && hd < n) {
+			dpD[hd<<1]=getVarLoBound(j);
+			dpD[(hd<<1)+1]=getVarUpBound(j);
+		}
+	}
+	bool flag=true;
+	try {
+		if (m_pConflict->analyze(dpD,m_pInc->getObjVal(),sz,dpVal,ipHd,b)) {
+			flag=false;
+			if (sz) {
+				m_pCutPool->add(b,CLP::INF,sz,dpVal,ipHd);
+				if (sz == 2 && m_pCliqueSep && n <= m_pCliqueSep->m_table.getColNum()) // x_j=1 is literal 2j, and x_j=0 is literal 2j+1
+					m_pCliqueSep->m_table.addConflict((ipHd[0] << 1) | ((dpVal[0] < 0.0)? 0: 1),(ipHd[1] << 1) | ((dpVal[1] < 0.0)? 0: 1));
+			}
+		}
+	}
+	catch(CMemoryException* pe) {
+		delete[] ipHd;
+		delete[] dpD;
+		throw pe;
+	}
+	delete[] ipHd;
+	delete[] dpD;
+	return flag;
+} // end of CProblem::analyzeConflict()
+
+void CProblem::setActivityPropagation(int maxWork)
+{
+	if (m_pPropagator)
+		delete m_pPropagator;
+	if (!(m_pPropagator = new CPropagator(maxWork))) {
+		throw new CMemoryException("CProblem::setActivityPropagation");
+	}
+} // end of CProblem::setActivityPropagation()
+
+bool CProblem::propagateActivities()
+{
+	CPropagator* pProp=m_pPropagator;
+	CPropagator::tagState* pState;
+	int j, k, hd, *ipCol, n=pProp->getColNum();
+	if (!(pState=pProp->getNodeState(m_iThread))) {
+		throw new CMemoryException("CProblem::propagateActivities");
+	}
+	if (!(ipCol = new int[n])) {
+		throw new CMemoryException("CProblem::propagateActivities");
+	}
+	for (hd=0; hd < n; ++hd) {
+		ipCol[hd]=-1;
+	}
+	++pProp->m_iCallNum;
+
+// only the bounds that differ from the root bounds are changed
+	pProp->startPropagation(*pState);
+	for (j=0; j < getVarNum(); ++j) {
+		if ((hd=m_ipColHd[j]) >= 0 && hd < n) {
+			ipCol[hd]=j;
+			double lo=getVarLoBound(j), up=getVarUpBound(j);
+			if (lo != pState->dpD[hd<<1] || up != pState->dpD[(hd<<1)+1])
+				pProp->changeBound(*pState,hd,lo,up);
+		}
+	}
+	bool flag=pProp->propagate(*pState,pProp->m_iMaxWork);
+	if (flag) {
+		for (k=0; k < pState->varTrailNum; ++k) {
+			hd=pState->ipVarTrail[k];
+			if ((j=ipCol[hd]) < 0)
+				continue;
+			double lo=pState->dpD[hd<<1], up=pState->dpD[(hd<<1)+1];
+			if (lo > getVarLoBound(j)) { // bounds are set for scaled columns
+				setVarLoBound(j,ldexp(lo,-m_cpColScale[j]));
+				++pProp->m_lBdNum;
+			}
+			if (up < getVarUpBound(j)) {
+				setVarUpBound(j,ldexp(up,-m_cpColScale[j]));
+				++pProp->m_lBdNum;
+			}
+		}
+	}
+	else
+		++pProp->m_iPruneNum;
+	pProp->undo(*pState);
+	delete[] ipCol;
+	return flag;
+} // end of CProblem::propagateActivities()
+
+bool CProblem::separateConcurrently(bool genFlag)
+{
+	bool flag;
+	int threadNum=1;
+#ifndef __ONE_THREAD_
+	threadNum=getThreadNum();
+#endif
+	std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+	m_pConcSep->start(m_iVarNum,m_dpVarVal,mapHandles(),*m_pCutSel,threadNum);
+	try {
+		flag=timedSeparate();
+	}
+	catch(CException* pe) {
+		m_pConcSep->finish(*m_pCutSel); // worker threads must be joined
+		m_pCutSel->clear();
+		throw pe;
+	}
+	if (m_pConcSep->finish(*m_pCutSel) > 0)
+		flag=true;
+	if (m_pCutStat)
+		m_pCutStat->addTime(CUT_SEPARATOR,elapsedTime(startTime));
+	if (genFlag) {
+		if (flag && !loadCuts(CUT_SEPARATE))
+			flag=false; // all cuts have been rejected by the selector
+		deleteCuts();
+	}
+	else
+		m_pCutSel->clear();
+	return flag;
+} // end of CProblem::separateConcurrently()
+
+void CProblem::initCutSelector()
+{
+	double *dpC;
+	if (!(dpC = new double[m_iVarNum+1])) {
+		throw new CMemoryException("CProblem::initCutSelector");
+	}
+	memset(dpC,0,m_iVarNum*sizeof(double));
+	if (m_pObj) {
+		for (CTerm* pTerm=m_pObj->getLastTerm(); pTerm; pTerm=pTerm->getPrev()) {
+			if (pTerm->getVar() && pTerm->getVar()->getHandle() < m_iVarNum)
+				dpC[pTerm->getVar()->getHandle()]+=pTerm->getCoeff();
+		}
+	}
+	try {
+		m_pCutSel->setObjective(m_iVarNum,dpC);
+	}
+	catch(CMemoryException* pe) {
+		delete[] dpC;
+		throw pe;
+	}
+	delete[] dpC;
+} // end of CProblem::initCutSelector()
+
+void CProblem::cutStatistics()
+{
+	CMIP::cutStatistics();
+	if (m_pCutSel && !isSilent())
+		m_pCutSel->printStatistics(std::cout);
+	if (m_pConcSep && !isSilent())
+		m_pConcSep->printStatistics(std::cout);
+} // end of CProblem::cutStatistics()
+
+void CProblem::solStatistics(std::ostream &out, const char* MIPCLver,
+		const char* solTime, bool timeLimit, int nodeNum,
+		bool feasible, bool hasSolution, double objVal,
+		bool opt, double gap, bool gapLimit, double bound,
+		int difficultNodes)
+{
+	CMIP::solStatistics(out,MIPCLver,solTime,timeLimit,nodeNum,feasible,hasSolution,objVal,opt,gap,gapLimit,bound,difficultNodes);
+	if (m_pCutStat)
+		m_pCutStat->printStatistics(out);
+	if (m_pSched)
+		m_pSched->printStatistics(out);
+} // end of CProblem::solStatistics()
+
+void CProblem::mipInfo(char *timeElapsed, int nodeNum, int leafNum,
+		double bestObjVal, double objBound, double gap, int solsFound, bool sense, bool header)
+{
+	if (!isSilent())
+		CMIP::mipInfo(timeElapsed,nodeNum,leafNum,bestObjVal,objBound,gap,solsFound,sense,header);
+} // end of CProblem::mipInfo()
+
+void CProblem::setCutPool(int threadNum)
+{
+	if (m_pCutPool)
+		delete m_pCutPool;
+	if (!(m_pCutPool = new CCutPool(threadNum))) {
+		throw new CMemoryException("CProblem::setCutPool");
+	}
+} // end of CProblem::setCutPool()
+
+bool CProblem::separateCutPool(bool genFlag)
+{
+	int threadNum=1;
+#ifndef __ONE_THREAD_
+	if (!(threadNum=m_pCutPool->getThreadNum()))
+		threadNum=getThreadNum();
+#endif
+	if (genFlag)
+		mapHandles();
+	std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+	int cutNum=m_pCutPool->separate(m_dpVarVal,threadNum,CUTPOOL_TOL,(genFlag)? addPoolCut: 0,this);
+	if (m_pCutStat)
+		m_pCutStat->addTime(CUT_POOL,elapsedTime(startTime));
+	if (genFlag && m_pCutSel)
+		cutNum=sendSelectedCuts();
+	return (cutNum > 0)? true: false;
+} // end of CProblem::separateCutPool()
+
+void CProblem::setCutAging(int maxAge, int maxCutNum)
+{
+	if (m_pCutAging)
+		delete m_pCutAging;
+	if (!(m_pCutAging = new CCutAging(maxAge,maxCutNum))) {
+		throw new CMemoryException("CProblem::setCutAging");
+	}
+	if (!m_pCutPool)
+		setCutPool();
+} // end of CProblem::setCutAging()
+
+void CProblem::ageCuts(int n, const double* dpX)
+{
+	double lhs, rhs, act, *dpVal;
+	int sz, rowNum=0, evictNum=0, m=m_iM, *ipCol;
+	bool binding;
+	CCutAging* pAging=m_pCutAging;
+	if (!pAging->m_iMaxRowNum)
+		pAging->m_iMaxRowNum=(m_iM0 > 100)? m_iM0: 100;
+	pAging->allocMemForRows(n);
+	pAging->startRound(m-m_iM0);
+	dpVal=pAging->m_dpVal;
+	ipCol=pAging->m_ipCol;
+	for (int i=m_iM0; i < m; ++i) {
+		if (m_ipRowHd[i] >= 0 || (m_ipCtrType[i] & CTR_ATTACHED))
+			continue; // row is managed by the user, or it cannot be removed
+		lhs=getLHS(i);
+		rhs=getRHS(i);
+		if (lhs <= -CLP::VAR_INF && rhs >= CLP::VAR_INF)
+			continue; // row has been evicted
+		++rowNum;
+		sz=getRow(i,dpVal,ipCol,false);
+		act=0.0;
+		for (int k=0; k < sz; ++k) {
+			act+=dpVal[k]*dpX[m_ipColHd[ipCol[k]]];
+		}
+		binding=((rhs < CLP::VAR_INF && act > rhs-CUTAGING_TOL*(1.0+fabs(rhs))) ||
+			(lhs > -CLP::VAR_INF && act < lhs+CUTAGING_TOL*(1.0+fabs(lhs))))? true: false;
+		if (pAging->update(CCutAging::hashRow(sz,dpVal,ipCol,lhs,rhs),binding) >= pAging->getThreshold()) {
+			if (isCtrGlobal(i)) {
+				for (int k=0; k < sz; ++k) {
+					ipCol[k]=m_ipColHd[ipCol[k]];
+				}
+				m_pCutPool->add(lhs,rhs,sz,dpVal,ipCol);
+			}
+			setCtrFree(i); // slack of non-binding row is basic, so the basis remains feasible
+			++evictNum;
+		}
+	}
+	pAging->finishRound(rowNum,evictNum);
+} // end of CProblem::ageCuts()
+
+void CProblem::setCutStatistics()
+{
+	if (m_pCutStat)
+		delete m_pCutStat;
+	if (!(m_pCutStat = new CCutStat())) {
+		throw new CMemoryException("CProblem::setCutStatistics");
+	}
+} // end of CProblem::setCutStatistics()
+
+bool CProblem::getCutFamilyStat(int family, tagCutFamilyStat& stat) const
+{
+	if (!m_pCutStat || family < 0 || family >= CUTSTAT_NUM)
+		return false;
+	m_pCutStat->getStat(family,stat);
+	return true;
+} // end of CProblem::getCutFamilyStat()
+
+void CProblem::trackCuts(int n)
+{
+	int m=m_iM;
+	CCutStat* pStat=m_pCutStat;
+	pStat->allocMemForRows(n);
+	pStat->startRound(getCurrentNode(),m-m_iM0);
+	for (int i=m_iM0; i < m; ++i) {
+		if (m_ipRowHd[i] >= 0 || (m_ipCtrType[i] & CTR_ATTACHED))
+			continue; // row is not a cut
+		double lhs=getLHS(i), rhs=getRHS(i);
+		if (lhs <= -CLP::VAR_INF && rhs >= CLP::VAR_INF)
+			continue; // row has been evicted
+		int sz=getRow(i,pStat->m_dpVal,pStat->m_ipCol,false);
+		pStat->update(CCutAging::hashRow(sz,pStat->m_dpVal,pStat->m_ipCol,lhs,rhs));
+	}
+	pStat->finishRound(CLP::getObjVal());
+} // end of CProblem::trackCuts()
+
+void CProblem::tagCuts(int m, int family)
+{
+	CCutStat* pStat=m_pCutStat;
+	pStat->allocMemForRows(m_iN);
+	for (int i=m; i < m_iM; ++i) {
+		int sz=getRow(i,pStat->m_dpVal,pStat->m_ipCol,false);
+		pStat->addCut(CCutAging::hashRow(sz,pStat->m_dpVal,pStat->m_ipCol,getLHS(i),getRHS(i)),family);
+	}
+} // end of CProblem::tagCuts()
+
+bool CProblem::timedSeparate()
+{
+	if (!m_pCutStat)
+		return separate();
+	std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+	bool flag=separate();
+	m_pCutStat->addTime(CUT_SEPARATE,elapsedTime(startTime));
+	return flag;
+} // end of CProblem::timedSeparate()
+
+void CProblem::setLiftProjectCuts(int maxCutNum, int maxRoundNum, int maxCutSize, int height)
+{
+	if (m_pLiftProject)
+		delete m_pLiftProject;
+	if (!(m_pLiftProject = new CLiftProject(maxCutNum,maxRoundNum,maxCutSize,height))) {
+		throw new CMemoryException("CProblem::setLiftProjectCuts");
+	}
+} // end of CProblem::setLiftProjectCuts()
+
+bool CProblem::separateLiftProject(int n, const double* X)
+{
+	CLiftProject* pLP=m_pLiftProject;
+	int height=getCurrentNodeHeight();
+	if (!pLP->startRound(getCurrentNode(),height))
+		return false;
+	std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+	int i, k, sz, rowNum=0, nz=0, cutNum=0, m=m_iM;
+	unsigned type=(height)? CTR_LOCAL: 0;
+	double lhs, rhs;
+	for (i=0; i < m; ++i) {
+		if (m_ipRowMap[i] < CLP::SHIFT) { // row is tight
+			++rowNum;
+			nz+=getRowSize(i);
+		}
+	}
+	if (rowNum != m_iBasisSize)
+		return false;
+	pLP->allocMem(n,rowNum,nz);
+	for (int j=0; j < n; ++j) {
+		k=m_ipColMap[j];
+		pLP->setColumn(j,X[m_ipColHd[j]],getVarLoBound(j),getVarUpBound(j),isVarIntegral(j),(k >= CLP::SHIFT)? 0: ((k < 0)? -1: 1));
+	}
+	for (i=0; i < m; ++i) {
+		if ((k=m_ipRowMap[i]) < CLP::SHIFT) {
+			sz=getRow(i,pLP->getRowVal(),pLP->getRowCol(),false);
+			lhs=getLHS(i);
+			rhs=getRHS(i);
+			if (!isCtrGlobal(i))
+				type=CTR_LOCAL;
+			pLP->addRow(sz,(k < 0)? lhs: rhs,(lhs == rhs)? 0: ((k < 0)? -1: 1));
+		}
+	}
+	if (int lpCutNum=pLP->separate()) {
+		double b, *dpVal=m_dpFd;
+		const double *dpCutVal;
+		const int *ipCutCol;
+		int *ipCol=reinterpret_cast<int*>(dpVal+n), *ipHd=ipCol+n;
+		for (int c=0; c < lpCutNum; ++c) {
+			sz=pLP->getCut(c,b,dpCutVal,ipCutCol);
+			for (i=0; i < sz; ++i) {
+				ipHd[i]=m_ipColHd[ipCutCol[i]];
+			}
+			if (m_pCutPool && !type)
+				m_pCutPool->add(b,CLP::INF,sz,dpCutVal,ipHd);
+			if (!m_pCutSel || !m_pCutSel->addCand(CUT_LIFT_PROJECT,type,b,CLP::INF,sz,dpCutVal,ipHd)) {
+				for (i=0; i < sz; ++i) {
+					dpVal[i]=dpCutVal[i];
+					ipCol[i]=ipCutCol[i];
+				}
+				k=m_iM;
+				addCut(-2,type,b,CLP::INF,sz,dpVal,ipCol,false,NOT_SCALED,n);
+				if (m_pCutStat)
+					tagCuts(k,CUT_LIFT_PROJECT);
+				++cutNum;
+			}
+		}
+		if (m_pCutSel)
+			cutNum+=sendSelectedCuts();
+	}
+	if (m_pCutStat)
+		m_pCutStat->addTime(CUT_LIFT_PROJECT,elapsedTime(startTime));
+	return (cutNum > 0)? true: false;
+} // end of CProblem::separateLiftProject()
+
+void CProblem::addPoolCut(void* pProblem, double b1, double b2, int sz, const double* dpVal, const int* ipHd)
+{
+	CProblem* pPrb=static_cast<CProblem*>(pProblem);
+	int n=pPrb->m_iVarNum, *ipHdToCol=pPrb->m_ipHdToCol;
+	for (int i=0; i < sz; i++) {
+		if (ipHdToCol[ipHd[i]] < 0)
+			return; // the cut includes a variable removed by preprocessing (e.g., the pool has been filled before a restart)
+	}
+	if (pPrb->m_pCutSel && pPrb->m_pCutSel->addCand(CUT_POOL,0,b1,b2,sz,dpVal,ipHd))
+		return;
+	double *dpCutVal=pPrb->m_dpFd;
+	int *ipCol=reinterpret_cast<int*>(dpCutVal+n);
+	for (int i=0; i < sz; i++) {
+		dpCutVal[i]=dpVal[i];
+		ipCol[i]=ipHdToCol[ipHd[i]];
+	}
+	int m=pPrb->m_iM;
+	pPrb->addCut(-2,0,b1,b2,sz,dpCutVal,ipCol,false,NOT_SCALED,n);
+	if (pPrb->m_pCutStat)
+		pPrb->tagCuts(m,CUT_POOL);
+} // end of CProblem::addPoolCut()
+
 void CProblem::deleteCuts()
 {
 	for (CCtr *pCtr1, *pCtr=m_pLastCut; pCtr; pCtr=pCtr1) {
@@ -651,14 +1640,47 @@ void CProblem::deleteCuts()
 bool CProblem::separate(int n, const double* X, const tagHANDLE* colHd, bool genFlag)
 {
 	bool flag;
+	if (!m_iThread) {
+		if (m_pRestart && m_pRestart->m_bRec)
+			loadRestartRecord();
+		if (m_pCkp && m_pCkp->m_bResume)
+			resumeRecord();
+		if (m_pStart && m_pStart->m_bRec)
+			loadStartRecord();
+		if (m_pDecomp && m_pDecomp->m_bRec)
+			loadDecompRecord();
+		if (m_pFeasPump && m_pFeasPump->m_bRec)
+			loadPumpRecord();
+		if (m_pLns) {
+			if (m_pLns->m_bRec)
+				loadLnsRecord();
+			if (!m_pLns->isStarted() && !getCurrentNodeHeight())
+				m_pLns->setLpSolution(n,X,colHd);
+		}
+		if (m_pDiving && m_pDiving->m_bRec)
+			loadDivingRecord();
+		if (m_pRace && loadRaceResults(genFlag))
+			return true;
+	}
 	setSolution(n,m_dpVarVal=const_cast<double*>(X),const_cast<int*>(colHd),true);
 	m_iCutState=1;
-	if ((flag=separate())) {
+	if (m_pCutStat && genFlag && !isPureLP())
+		trackCuts(n);
+	if (m_pCutAging && genFlag && !isPureLP())
+		ageCuts(m_iN,X);
+	if (m_pCutPool && separateCutPool(genFlag))
+		flag=true;
+	else if (m_pConcSep && !isPureLP())
+		flag=separateConcurrently(genFlag);
+	else if ((flag=timedSeparate())) {
 		if (genFlag) {
-			loadCuts();
+			if (!loadCuts(CUT_SEPARATE) && m_pCutSel)
+				flag=false; // all cuts have been rejected by the selector
 			deleteCuts();
 		}
 	}
+	if (!flag && m_pLiftProject && genFlag && !isPureLP())
+		flag=separateLiftProject(m_iN,X);
 	m_dpVarVal=0; // values of variables are not available if `m_dpVarVal=0`
 	m_iCutState=0;
 	return flag;
@@ -669,8 +1691,13 @@ bool CProblem::genCut1(int n, const double* X, const tagHANDLE* colHd)
 	bool flag;
 	setSolution(n,m_dpVarVal=const_cast<double*>(X),const_cast<int*>(colHd),true);
 	m_iCutState=1;
-	if ((flag=gencut())) {
-		loadCuts();
+	std::chrono::steady_clock::time_point startTime=std::chrono::steady_clock::now();
+	flag=gencut();
+	if (m_pCutStat)
+		m_pCutStat->addTime(CUT_GENCUT,elapsedTime(startTime));
+	if (flag) {
+		if (!loadCuts(CUT_GENCUT) && m_pCutSel)
+			flag=false;
 		deleteCuts();
 	}
 	m_dpVarVal=0; // values of variables are not available if `m_dpVarVal=0`
@@ -678,6 +1705,684 @@ bool CProblem::genCut1(int n, const double* X, const tagHANDLE* colHd)
 	return flag;
 }
 
+//////////////////////////////////////////////////////////////
+// B R A N C H I N G
+///////////////////////
+void CProblem::setReliabilityBranching(int threshold, int maxCandNum, int threadNum)
+{
+	if (m_pRelBr)
+		delete m_pRelBr;
+	if (!(m_pRelBr = new CRelBranching(threshold,maxCandNum,threadNum))) {
+		throw new CMemoryException("CProblem::setReliabilityBranching");
+	}
+	setBranchingRule(MAX_SCORE); // strong branching is done by `m_pRelBr`
+} // end of CProblem::setReliabilityBranching()
+
+bool CProblem::relBranching(int nodeHeight)
+{
+	CRelBranching* pBr=m_pRelBr;
+	int b, d, dir=0, j, k, hd, pri, maxPri, nz, threadNum;
+	double x, f, tol=getIntTol();
+
+	for (k=-1, b=0; b < RELBR_MEM_SIZE; ++b) { // the node may be a child of a remembered branching
+		tagBranching& br=pBr->m_pBr[b];
+		if (br.hd < 0 || br.height+1 != nodeHeight || (j=br.col) >= m_iN || m_ipColHd[j] != br.hd ||
+				m_dObjVal > br.obj+RELBR_OBJ_TOL*(1.0+fabs(br.obj)))
+			continue;
+		if (getVarUpBound(j) == floor(br.x))
+			d=0;
+		else if (getVarLoBound(j) == ceil(br.x))
+			d=1;
+		else
+			continue;
+		if (br.observed & (1 << d))
+			continue;
+		if (k >= 0) { // the parent is not known for sure
+			k=-1;
+			break;
+		}
+		k=b;
+		dir=d;
+	}
+	if (k >= 0)
+		pBr->observeChild(k,dir,m_dObjVal);
+
+	pBr->allocMemForCands(m_iN);
+	maxPri=VAR_PRI_MIN;
+	for (k=j=0; j < m_iN; ++j) {
+		if (isVarStrongIntegral(j) && (hd=m_ipColHd[j]) < pBr->m_iHdNum) {
+			x=ldexp(getVarValue(j),m_cpColScale[j]); // node LP solution is of scaled columns
+			f=x-floor(x);
+			if (f > tol && f < 1.0-tol) {
+				if ((pri=getVarPriority(j)) < maxPri)
+					continue;
+				if (pri > maxPri) {
+					maxPri=pri;
+					k=0;
+				}
+				pBr->m_ipCandCol[k]=j;
+				pBr->m_ipCandHd[k]=hd;
+				pBr->m_ipCandExp[k]=m_cpColScale[j];
+				pBr->m_dpCandX[k++]=x;
+			}
+		}
+	}
+	if (!(pBr->m_iCandNum=k))
+		return false;
+
+	for (nz=0, k=0; k < m_iM; ++k) {
+		nz+=m_ipRowSize[k];
+	}
+	pBr->allocMemForNodeLp(m_iM,m_iN,nz);
+	memcpy(pBr->m_dpC,m_dpC,m_iN*sizeof(double));
+	memcpy(pBr->m_dpD,m_dpD,(m_iN<<1)*sizeof(double));
+	memcpy(pBr->m_dpB,m_dpB,(m_iM<<1)*sizeof(double));
+	pBr->m_ipBeg[0]=nz=0;
+	for (int i=0; i < m_iM; ++i) {
+		nz+=getRow(i,pBr->m_dpVal+nz,pBr->m_ipCol+nz,true);
+		pBr->m_ipBeg[i+1]=nz;
+	}
+	pBr->m_dNodeObj=m_dObjVal;
+
+	threadNum=1;
+#ifndef __ONE_THREAD_
+	if (!(threadNum=pBr->m_iThreadNum))
+		threadNum=(nodeHeight)? 1: getThreadNum();
+#endif
+	if ((k=pBr->select(threadNum)) < 0)
+		return false;
+	pBr->storeBranching(k,nodeHeight);
+	m_iRelBrCol=pBr->m_ipCandCol[k];
+	m_dRelBrVal=pBr->m_dpCandX[k];
+	return true;
+} // end of CProblem::relBranching()
+
+int CProblem::startBranching(int nodeHeight)
+{
+	if (!m_iThread) {
+		if (m_pRestart && m_pRestart->m_bRec)
+			loadRestartRecord();
+		if (m_pCkp && m_pCkp->m_bResume)
+			resumeRecord();
+		if (m_pStart && m_pStart->m_bRec)
+			loadStartRecord();
+		if (m_pDecomp && m_pDecomp->m_bRec)
+			loadDecompRecord();
+		if (m_pFeasPump && m_pFeasPump->m_bRec)
+			loadPumpRecord();
+		if (m_pLns) {
+			if (m_pLns->m_bRec)
+				loadLnsRecord();
+			if (!nodeHeight && !m_pLns->isStarted())
+				m_pLns->start(m_pInc);
+		}
+		if (m_pDiving) {
+			if (m_pDiving->m_bRec)
+				loadDivingRecord();
+			if (!nodeHeight && !m_pDiving->isStarted())
+#ifndef __ONE_THREAD_
+				m_pDiving->start(m_pInc,static_cast<int>(std::thread::hardware_concurrency())-getThreadNum());
+#else
+				m_pDiving->start(m_pInc,0);
+#endif
+		}
+		if (m_pRace)
+			loadRaceResults(false);
+		if (m_pRestart && !nodeHeight && m_pRestart->canRestart())
+			checkRestart();
+	}
+	if (m_pRestart && m_pRestart->m_bRestart)
+		return 1; // the only branch is infeasible, so the solver stops to be restarted
+	if (!m_iThread && !(++m_iNodeCount & 0x3f))
+		m_pInc->setObjBound(getObjBound());
+	if (m_pCkp && m_pCkp->isTime())
+		takeCheckpoint();
+	if (!nodeHeight && !m_iThread && m_pConflict) { // root bounds are valid at all nodes
+		for (int j=0; j < getVarNum(); ++j) {
+			if (m_ipColHd[j] >= 0 && m_ipColHd[j] < m_pConflict->getColNum())
+				m_pConflict->tightenBounds(m_ipColHd[j],getVarLoBound(j),getVarUpBound(j));
+		}
+	}
+	m_iRelBrCol=-1;
+	if (m_pPool && m_pPool->m_bAlternative) {
+		int brNum;
+		if (poolBranching(brNum))
+			return brNum;
+	}
+	if (m_pRelBr && relBranching(nodeHeight))
+		return 2;
+	return CMIP::startBranching(nodeHeight);
+} // end of CProblem::startBranching()
+
+bool CProblem::updateBranch(int i)
+{
+	if (m_pRestart && m_pRestart->m_bRestart)
+		return false;
+	if (m_iRelBrCol < 0)
+		return CMIP::updateBranch(i);
+	if (i) // bounds are set for scaled columns
+		setVarLoBound(m_iRelBrCol,ldexp(ceil(m_dRelBrVal),-m_cpColScale[m_iRelBrCol]));
+	else
+		setVarUpBound(m_iRelBrCol,ldexp(floor(m_dRelBrVal),-m_cpColScale[m_iRelBrCol]));
+	return true;
+} // end of CProblem::updateBranch()
+
+bool CProblem::propagate()
+{
+	if (m_pPropagator && !propagateActivities())
+		return false;
+	if (m_pConflict && !analyzeConflict())
+		return false;
+	return CMIP::propagate();
+} // end of CProblem::propagate()
+
+//////////////////////////////////////////////////////////////
+// C H E C K P O I N T S
+///////////////////////
+void CProblem::setCheckpoint(const char* fileName, int interval)
+{
+	char *str=m_sWarningMsg;
+	if (!fileName) {
+		strcpy(str,m_strProblemName);
+		strcat(str,".ckp");
+		fileName=str;
+	}
+	if (m_pCkp)
+		delete m_pCkp;
+	if (!(m_pCkp = new CCheckpoint(fileName,interval))) {
+		throw new CMemoryException("CProblem::setCheckpoint");
+	}
+} // end of CProblem::setCheckpoint()
+
+void CProblem::changeRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd)
+{
+	CMIP::changeRecord(objVal,n,dpX,ipHd);
+	m_pInc->publish(objVal,n,dpX,ipHd);
+} // end of CProblem::changeRecord()
+
+void CProblem::takeCheckpoint()
+{
+	double *dpPc=0, objVal, bound;
+	int pcSize=0;
+	if (m_pInc->isSolution()) {
+		double *dpX=0;
+		int n, hdNum=m_pCkp->m_copy.getColNum(), *ipHd=0;
+		for (n=hdNum; n > 0;) {
+			if (dpX)
+				delete[] dpX;
+			if (!(dpX = new double[(hdNum=n)+(n+1)/2+1])) {
+				throw new CMemoryException("CProblem::takeCheckpoint");
+			}
+			ipHd=reinterpret_cast<int*>(dpX+hdNum);
+			if ((n=m_pInc->getSolution(objVal,hdNum,dpX,ipHd)) <= hdNum)
+				break; // otherwise, the record has grown, and arrays of size `n` are needed
+		}
+		if (n)
+			m_pCkp->setRecord(objVal,n,dpX,ipHd);
+		delete[] dpX;
+	}
+	if (m_pRelBr) {
+		if (!(dpPc = new double[pcSize=m_pRelBr->getPseudocostSize()])) {
+			throw new CMemoryException("CProblem::takeCheckpoint");
+		}
+		m_pRelBr->storePseudocosts(dpPc);
+	}
+	m_pInc->setObjBound(bound=getObjBound());
+	m_pCkp->takeSnapshot(bound,pcSize,dpPc);
+	if (dpPc)
+		delete[] dpPc;
+} // end of CProblem::takeCheckpoint()
+
+void CProblem::resumeRecord()
+{
+	CCheckpoint* pCkp=m_pCkp;
+	pCkp->m_bResume=false;
+	setInitialRecord(pCkp->m_dRecObj,pCkp->m_iRecNum,pCkp->m_dpRecX,pCkp->m_ipRecHd);
+} // end of CProblem::resumeRecord()
+
+void CProblem::setInitialRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd)
+{
+	if (m_pPool) {
+		m_pPool->add(n,dpX,ipHd);
+		if (m_pPool->m_bAlternative) // the solver must not prune solutions of the same value
+			return;
+	}
+	if (!m_pInc->isBetter(objVal))
+		return;
+	changeRecord(objVal,n,dpX,ipHd);
+	changeObjBound(objVal);
+} // end of CProblem::setInitialRecord()
+
+//////////////////////////////////////////////////////////////
+// D E C O M P O S I T I O N
+///////////////////////
+void CProblem::copyMatrix(CMatrixCopy& copy)
+{
+	int m=m_iM, n=m_iN, nz=0;
+	for (int i=0; i < m; ++i) {
+		nz+=getRowSize(i);
+	}
+	copy.allocMem(m,n,nz);
+	copy.m_bSense=CLP::getObjSense();
+	for (int j=0; j < n; ++j) {
+		copy.m_dpC[j]=(copy.m_bSense)? getObjCoeff(j): -getObjCoeff(j); // the solver stores the objective as maximized
+		copy.m_dpD[j<<1]=getVarLoBound(j);
+		copy.m_dpD[(j<<1)+1]=getVarUpBound(j);
+		if ((copy.m_ipVarType[j]=m_ipVarType[j] & (VAR_INT | VAR_BIN)))
+			copy.m_ipPri[j]=getVarPriority(j);
+	}
+	nz=0;
+	for (int i=0; i < m; ++i) {
+		copy.m_ipBeg[i]=nz;
+		nz+=getRow(i,copy.m_dpVal+nz,copy.m_ipCol+nz,false);
+		copy.m_dpB[i<<1]=getLHS(i);
+		copy.m_dpB[(i<<1)+1]=getRHS(i);
+		copy.m_ipCtrType[i]=m_ipCtrType[i] & (CTR_GUB | CTR_SOS2);
+	}
+	copy.m_ipBeg[m]=nz;
+} // end of CProblem::copyMatrix()
+
+void CProblem::setDecomposition(int threadNum)
+{
+	if (m_pDecomp)
+		delete m_pDecomp;
+	if (!(m_pDecomp = new CDecomposition(threadNum))) {
+		throw new CMemoryException("CProblem::setDecomposition");
+	}
+} // end of CProblem::setDecomposition()
+
+bool CProblem::decompose()
+{
+	CDecomposition* pDecomp=m_pDecomp;
+	int threadNum=1;
+	if (pDecomp->decompose() < 2)
+		return false;
+#ifndef __ONE_THREAD_
+	if (!(threadNum=pDecomp->m_iThreadNum))
+		threadNum=getThreadNum();
+#endif
+	if (pDecomp->solve(threadNum)) {
+		m_bDecompSolved=true;
+		m_pInc->publish(pDecomp->getObjVal(),pDecomp->m_copy.getColNum(),pDecomp->m_dpX,pDecomp->m_ipHd);
+	}
+	return m_bDecompSolved;
+} // end of CProblem::decompose()
+
+void CProblem::loadDecompRecord()
+{
+	CDecomposition* pDecomp=m_pDecomp;
+	pDecomp->m_bRec=false;
+	setInitialRecord(pDecomp->getObjVal(),pDecomp->m_copy.getColNum(),pDecomp->m_dpX,pDecomp->m_ipHd);
+} // end of CProblem::loadDecompRecord()
+
+//////////////////////////////////////////////////////////////
+// R O O T   R A C I N G
+///////////////////////
+void CProblem::setRootRacing(int racerNum)
+{
+	if (racerNum <= 0) {
+#ifndef __ONE_THREAD_
+		racerNum=getThreadNum();
+#else
+		racerNum=1;
+#endif
+	}
+	if (m_pRace)
+		delete m_pRace;
+	if (!(m_pRace = new CRootRace(racerNum))) {
+		throw new CMemoryException("CProblem::setRootRacing");
+	}
+} // end of CProblem::setRootRacing()
+
+void CProblem::race()
+{
+	CRootRace* pRace=m_pRace;
+#ifndef __ONE_THREAD_
+	int winner=pRace->race(getThreadNum());
+#else
+	int winner=pRace->race(1);
+#endif
+	if (winner >= 0)
+		CRootRace::applySettings(*this,winner);
+} // end of CProblem::race()
+
+bool CProblem::loadRaceResults(bool genFlag)
+{
+	CRootRace* pRace=m_pRace;
+	bool flag=false;
+	if (pRace->m_bRec) {
+		pRace->m_bRec=false;
+		setInitialRecord(pRace->m_dRecObj,pRace->m_iRecNum,pRace->m_dpRecX,pRace->m_ipRecHd);
+	}
+	if (genFlag && pRace->m_iCutNum) {
+		int n0=pRace->m_copy.getColNum(), sz, col, *ipCol, *ipHdToCol;
+		double *dpVal;
+		if (!(dpVal = new double[n0+n0+(n0+1)/2+1])) {
+			throw new CMemoryException("CProblem::loadRaceResults");
+		}
+		ipCol=reinterpret_cast<int*>(dpVal+n0);
+		ipHdToCol=ipCol+n0;
+		for (int j=0; j < n0; ++j) {
+			ipHdToCol[j]=NIL;
+		}
+		for (int j=0; j < n0; ++j) {
+			if (m_ipColHd[j] >= 0 && m_ipColHd[j] < n0)
+				ipHdToCol[m_ipColHd[j]]=j;
+		}
+		for (int k, i=0; i < pRace->m_iCutNum; ++i) {
+			sz=0;
+			for (k=pRace->m_ipCutBeg[i]; k < pRace->m_ipCutBeg[i+1]; ++k) {
+				if ((col=ipHdToCol[pRace->m_ipCutHd[k]]) == NIL)
+					break;
+				ipCol[sz]=col;
+				dpVal[sz++]=pRace->m_dpCutVal[k];
+			}
+			if (m_pCutPool)
+				m_pCutPool->add(pRace->m_dpCutB[i<<1],pRace->m_dpCutB[(i<<1)+1],pRace->m_ipCutBeg[i+1]-pRace->m_ipCutBeg[i],
+					pRace->m_dpCutVal+pRace->m_ipCutBeg[i],pRace->m_ipCutHd+pRace->m_ipCutBeg[i]);
+			if (k == pRace->m_ipCutBeg[i+1]) {
+				addCut(-2,0,pRace->m_dpCutB[i<<1],pRace->m_dpCutB[(i<<1)+1],sz,dpVal,ipCol,false,NOT_SCALED,n0);
+				flag=true;
+			}
+		}
+		pRace->m_iCutNum=0;
+		delete[] dpVal;
+	}
+	return flag;
+} // end of CProblem::loadRaceResults()
+
+//////////////////////////////////////////////////////////////
+// F E A S I B I L I T Y   P U M P
+///////////////////////
+void CProblem::setFeasibilityPump(int maxIterNum, bool background)
+{
+	if (m_pFeasPump)
+		delete m_pFeasPump;
+	if (!(m_pFeasPump = new CFeasPump(maxIterNum,background))) {
+		throw new CMemoryException("CProblem::setFeasibilityPump");
+	}
+} // end of CProblem::setFeasibilityPump()
+
+void CProblem::loadPumpRecord()
+{
+	CFeasPump* pPump=m_pFeasPump;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&pPump->m_mutex)
+#endif
+	pPump->m_bRec=false;
+	try {
+		setInitialRecord(pPump->m_dRecObj,pPump->m_iRecNum,pPump->m_dpRecX,pPump->m_ipRecHd);
+	}
+	catch(CException* pe) {
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&pPump->m_mutex)
+#endif
+		throw pe;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&pPump->m_mutex)
+#endif
+} // end of CProblem::loadPumpRecord()
+
+//////////////////////////////////////////////////////////////
+// L A R G E   N E I G H B O U R H O O D   S E A R C H
+///////////////////////
+void CProblem::setLnsHeuristics(int nodeLimit, int timeLimit, double minFixRate, int radius)
+{
+	if (m_pLns)
+		delete m_pLns;
+	if (!(m_pLns = new CLns(nodeLimit,timeLimit,minFixRate,radius))) {
+		throw new CMemoryException("CProblem::setLnsHeuristics");
+	}
+} // end of CProblem::setLnsHeuristics()
+
+void CProblem::loadLnsRecord()
+{
+	CLns* pLns=m_pLns;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&pLns->m_mutex)
+#endif
+	pLns->m_bRec=false;
+	try {
+		setInitialRecord(pLns->m_dRecObj,pLns->m_iRecNum,pLns->m_dpRecX,pLns->m_ipRecHd);
+	}
+	catch(CException* pe) {
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&pLns->m_mutex)
+#endif
+		throw pe;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&pLns->m_mutex)
+#endif
+} // end of CProblem::loadLnsRecord()
+
+//////////////////////////////////////////////////////////////
+// D I V I N G
+///////////////////////
+void CProblem::setDivingPortfolio(int threadNum)
+{
+	if (m_pDiving)
+		delete m_pDiving;
+	if (!(m_pDiving = new CDiving(threadNum))) {
+		throw new CMemoryException("CProblem::setDivingPortfolio");
+	}
+} // end of CProblem::setDivingPortfolio()
+
+void CProblem::setSymmetryBreaking(int maxGenNum, int timeLimit)
+{
+	if (m_pSymmetry)
+		delete m_pSymmetry;
+	if (!(m_pSymmetry = new CSymmetry(maxGenNum,timeLimit))) {
+		throw new CMemoryException("CProblem::setSymmetryBreaking");
+	}
+} // end of CProblem::setSymmetryBreaking()
+
+void CProblem::setRootRestart(double minFixRate, int maxRestartNum)
+{
+	if (m_pRestart)
+		delete m_pRestart;
+	if (!(m_pRestart = new CRestart(minFixRate,maxRestartNum))) {
+		throw new CMemoryException("CProblem::setRootRestart");
+	}
+} // end of CProblem::setRootRestart()
+
+void CProblem::checkRestart()
+{
+	CRestart* pRestart=m_pRestart;
+	int j, hd, intNum=0, fixNum=0;
+	pRestart->m_bChecked=true;
+	for (j=0; j < getVarNum(); ++j) {
+		if ((hd=m_ipColHd[j]) >= 0 && hd < pRestart->m_iColNum && isVarIntegral(j)) {
+			double lo=getVarLoBound(j), up=getVarUpBound(j);
+			pRestart->setBounds(hd,lo,up);
+			++intNum;
+			if (lo == up)
+				++fixNum;
+		}
+	}
+	if (fixNum && fixNum >= pRestart->m_dMinFixRate*intNum) {
+		pRestart->m_iFixNum=fixNum;
+		pRestart->m_iVarNum=getVarNum();
+		if (CLP::m_bPreproc) { // root bounds are bounds of preprocessed columns, which need not be the problem variables
+			++pRestart->m_iSkipNum;
+			if (!isSilent()) {
+				sprintf(m_sWarningMsg,"Restart skipped: %d of %d columns fixed in preprocessed problem (see setRootRestart())",
+					fixNum,getVarNum());
+				std::cout << m_sWarningMsg << std::endl;
+			}
+			return;
+		}
+		pRestart->m_bRestart=true; // all nodes are pruned from now on (see startBranching())
+	}
+} // end of CProblem::checkRestart()
+
+void CProblem::restart()
+{
+	CRestart* pRestart=m_pRestart;
+	pRestart->m_bRestart=pRestart->m_bChecked=false;
+	++pRestart->m_iRestartNum;
+	if (m_pInc->isSolution()) {
+		pRestart->m_iRecNum=m_pInc->getSolution(pRestart->m_dRecObj,pRestart->m_iColNum,pRestart->m_dpRecX,pRestart->m_ipRecHd);
+		pRestart->m_bRec=(pRestart->m_iRecNum > 0)? true: false;
+	}
+	if (!isSilent()) {
+		sprintf(m_sWarningMsg,"Restart: %d of %d columns fixed at root node",pRestart->m_iFixNum,pRestart->m_iVarNum);
+		std::cout << m_sWarningMsg << std::endl;
+	}
+	load();
+} // end of CProblem::restart()
+
+void CProblem::loadRestartRecord()
+{
+	CRestart* pRestart=m_pRestart;
+	pRestart->m_bRec=false;
+	CMIP::changeRecord(pRestart->m_dRecObj,pRestart->m_iRecNum,pRestart->m_dpRecX,pRestart->m_ipRecHd);
+	changeObjBound(pRestart->m_dRecObj);
+} // end of CProblem::loadRestartRecord()
+
+void CProblem::setParallelProbing(int threadNum, int maxRoundNum, int timeLimitPerRound, bool replace)
+{
+	if (m_pProbing)
+		delete m_pProbing;
+	if (!(m_pProbing = new CProbing(threadNum,maxRoundNum,timeLimitPerRound,replace))) {
+		throw new CMemoryException("CProblem::setParallelProbing");
+	}
+} // end of CProblem::setParallelProbing()
+
+void CProblem::loadDivingRecord()
+{
+	CDiving* pDiving=m_pDiving;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&pDiving->m_mutex)
+#endif
+	pDiving->m_bRec=false;
+	try {
+		setInitialRecord(pDiving->m_dRecObj,pDiving->m_iRecNum,pDiving->m_dpRecX,pDiving->m_ipRecHd);
+	}
+	catch(CException* pe) {
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&pDiving->m_mutex)
+#endif
+		throw pe;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&pDiving->m_mutex)
+#endif
+} // end of CProblem::loadDivingRecord()
+
+void CProblem::setHeuristicScheduling(double timeFraction, double explore)
+{
+	if (m_pSched)
+		delete m_pSched;
+	if (!(m_pSched = new CHeurScheduler(timeFraction,explore))) {
+		throw new CMemoryException("CProblem::setHeuristicScheduling");
+	}
+} // end of CProblem::setHeuristicScheduling()
+
+//////////////////////////////////////////////////////////////
+// S O L U T I O N   P O O L
+///////////////////////
+void CProblem::setSolutionPool(int maxSolNum, double gap, bool alternative)
+{
+	if (m_pPool)
+		delete m_pPool;
+	if (!(m_pPool = new CSolutionPool(maxSolNum,gap,alternative))) {
+		throw new CMemoryException("CProblem::setSolutionPool");
+	}
+	m_pInc->setPool(m_pPool);
+} // end of CProblem::setSolutionPool()
+
+int CProblem::getRestartNum() const
+{
+	return (m_pRestart)? m_pRestart->m_iRestartNum: 0;
+} // end of CProblem::getRestartNum()
+
+int CProblem::getPoolSolNum() const
+{
+	return (m_pPool)? m_pPool->getSolNum(): 0;
+} // end of CProblem::getPoolSolNum()
+
+double CProblem::getPoolObjective(int k) const
+{
+	return (m_pPool && k >= 0 && k < m_pPool->getSolNum())? m_pPool->getObjVal(k): CLP::INF;
+} // end of CProblem::getPoolObjective()
+
+double CProblem::getPoolValue(int k, CVar& var) const
+{
+	return (m_pPool && k >= 0 && k < m_pPool->getSolNum())? m_pPool->getSolution(k)[var.getHandle()]: CLP::INF;
+} // end of CProblem::getPoolValue()
+
+bool CProblem::isFeasible(int n, const double* dpX, const tagHANDLE* ipColHd)
+{
+	if (!m_pPool)
+		return true;
+	m_pPool->add(n,dpX,ipColHd);
+	return (m_pPool->m_bAlternative)? false: true;
+} // end of CProblem::isFeasible()
+
+bool CProblem::poolBranching(int& brNum)
+{
+	double x, *dpX, cutoff=m_pPool->getCutoff(), tol=getIntTol();
+	int jBr=-1;
+	if (getNotScaledObjVal(m_dObjVal) < cutoff-SOL_POOL_TOL*(1.0+fabs(cutoff))) { // not changeObjBound(): cuts generated with that bound may cut off pool solutions
+		brNum=0; // the node contains no solution to be inserted into the pool
+		return true;
+	}
+	for (int j=0; j < m_iN; ++j) {
+		if (isVarIntegral(j)) {
+			x=ldexp(getVarValue(j),m_cpColScale[j]); // node LP solution is of scaled columns
+			if (fabs(x-floor(x+0.5)) > tol)
+				return false; // the solver branches on a fractional variable
+			if (jBr < 0 && getVarLoBound(j) < getVarUpBound(j))
+				jBr=j;
+		}
+	}
+	if (!(dpX = new double[m_iN])) {
+		throw new CMemoryException("CProblem::poolBranching");
+	}
+	for (int j=0; j < m_iN; ++j) { // values of fixed columns are sometimes reported out of their bounds
+		x=std::min(std::max(ldexp(getVarValue(j),m_cpColScale[j]),getVarLoBound(j)),getVarUpBound(j));
+		dpX[j]=(isVarIntegral(j))? floor(x+0.5): x;
+	}
+	m_pPool->add(m_iN,dpX,m_ipColHd); // the solver does not pass every integral node LP solution to isFeasible()
+	delete[] dpX;
+	brNum=0;
+	if (jBr >= 0) { // one branch excludes the node LP solution
+		x=floor(ldexp(getVarValue(jBr),m_cpColScale[jBr])+0.5);
+		m_iRelBrCol=jBr;
+		m_dRelBrVal=(x < getVarUpBound(jBr))? x+0.5: x-0.5;
+		brNum=2;
+	}
+	return true;
+} // end of CProblem::poolBranching()
+
+//////////////////////////////////////////////////////////////
+// M I P   S T A R T
+///////////////////////
+void CProblem::setMipStart(int nodeLimit, int timeLimit)
+{
+	if (m_pStart)
+		delete m_pStart;
+	if (!(m_pStart = new CMipStart(nodeLimit,timeLimit))) {
+		throw new CMemoryException("CProblem::setMipStart");
+	}
+} // end of CProblem::setMipStart()
+
+void CProblem::setMipStartValue(CVar& var, double val)
+{
+	if (!m_pStart)
+		setMipStart();
+	m_pStart->setValue(&var,val);
+} // end of CProblem::setMipStartValue()
+
+void CProblem::loadStartRecord()
+{
+	CMipStart* pStart=m_pStart;
+	pStart->m_bRec=false;
+	setInitialRecord(pStart->m_dRecObj,pStart->m_iRecNum,pStart->m_dpRecX,pStart->m_ipRecHd);
+} // end of CProblem::loadStartRecord()
+
 ////////////////////////////////
 // modeling
 ////////////
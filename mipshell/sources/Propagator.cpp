@@ -0,0 +1,509 @@
+// Propagator.cpp: implementation of the CPropagator class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <except.h>
+#include <cmip.h>
+#include "Propagator.h"
+
+#define PROP_TOL 1.0e-6 ///< feasibility and integrality tolerance.
+#define PROP_MIN_CHANGE 1.0e-3 ///< bounds of continuous variables are changed only if they are tightened by at least this relative value.
+
+static inline bool isInf(double v)
+{
+	return (v <= -CLP::INF || v >= CLP::INF)? true: false;
+}
+
+/**
+ * The function replaces contribution `a*vOld` to a row activity with `a*vNew`.
+ * \param[in,out] act finite part of activity;
+ * \param[in,out] inf number of infinite contributions;
+ * \param[in] a coefficient;
+ * \param[in] vOld,vNew old and new bounds.
+ */
+static inline void updateActivity(double& act, int& inf, double a, double vOld, double vNew)
+{
+	if (isInf(vOld))
+		--inf;
+	else
+		act-=a*vOld;
+	if (isInf(vNew))
+		++inf;
+	else
+		act+=a*vNew;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CPropagator::CPropagator(int maxWork)
+{
+	m_iMaxWork=(maxWork > 0)? maxWork: 1;
+	m_ipColBeg=m_ipColRow=0;
+	m_dpColVal=m_dpD=0;
+	m_ipRowType=0;
+	m_iNodeStateNum=0;
+	m_ppNodeState=0;
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+#endif
+	m_iCallNum=m_iPruneNum=0;
+	m_lBdNum=0;
+} // end of CPropagator::CPropagator()
+
+CPropagator::~CPropagator()
+{
+	if (m_ppNodeState) {
+		for (int t=0; t < m_iNodeStateNum; ++t) {
+			if (m_ppNodeState[t]) {
+				freeState(*m_ppNodeState[t]);
+				delete m_ppNodeState[t];
+			}
+		}
+		delete[] m_ppNodeState;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	if (m_ipColBeg)
+		delete[] m_ipColBeg;
+	if (m_dpColVal)
+		delete[] m_dpColVal;
+	if (m_ipRowType)
+		delete[] m_ipRowType;
+	if (m_dpD)
+		delete[] m_dpD;
+} // end of CPropagator::~CPropagator()
+
+//////////////////////////////////////////////////////////////////////
+// Initialization
+//////////////////////////////////////////////////////////////////////
+void CPropagator::init()
+{
+	const double* dpVal;
+	const int* ipCol;
+	int i, j, k, sz, m=m_copy.getRowNum(), n=m_copy.getColNum(), nz=0;
+	for (i=0; i < m; ++i) {
+		nz+=m_copy.getRow(i,dpVal,ipCol);
+	}
+	if (!(m_ipColBeg = new int[(n+1)+nz])) {
+		throw new CMemoryException("CPropagator::init");
+	}
+	m_ipColRow=m_ipColBeg+(n+1);
+	if (!(m_dpColVal = new double[nz])) {
+		throw new CMemoryException("CPropagator::init");
+	}
+	if (!(m_ipRowType = new unsigned[m])) {
+		throw new CMemoryException("CPropagator::init");
+	}
+	if (!(m_dpD = new double[n<<1])) {
+		throw new CMemoryException("CPropagator::init");
+	}
+
+	for (j=0; j < n; ++j) {
+		double lo=m_copy.getLoBound(j), up=m_copy.getUpBound(j);
+		if (m_copy.isInteger(j)) {
+			if (!isInf(lo))
+				lo=ceil(lo-PROP_TOL);
+			if (!isInf(up))
+				up=floor(up+PROP_TOL);
+		}
+		m_dpD[j<<1]=lo;
+		m_dpD[(j<<1)+1]=up;
+	}
+
+// column-wise representation of the matrix
+	memset(m_ipColBeg,0,(n+1)*sizeof(int));
+	for (i=0; i < m; ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		for (k=0; k < sz; ++k) {
+			++m_ipColBeg[ipCol[k]+1];
+		}
+	}
+	for (j=0; j < n; ++j) {
+		m_ipColBeg[j+1]+=m_ipColBeg[j];
+	}
+	for (i=0; i < m; ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		for (k=0; k < sz; ++k) {
+			int p=m_ipColBeg[ipCol[k]]++;
+			m_ipColRow[p]=i;
+			m_dpColVal[p]=dpVal[k];
+		}
+	}
+	for (j=n; j > 0; --j) {
+		m_ipColBeg[j]=m_ipColBeg[j-1];
+	}
+	m_ipColBeg[0]=0;
+
+// rows of binary variables with coefficients `1` or `-1` are processed by the special kernel
+	for (i=0; i < m; ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		int neg=0;
+		for (k=0; k < sz; ++k) {
+			j=ipCol[k];
+			if (!m_copy.isInteger(j) || m_dpD[j<<1] != 0.0 || m_dpD[(j<<1)+1] != 1.0 || fabs(dpVal[k]) != 1.0)
+				break;
+			if (dpVal[k] < 0.0)
+				++neg;
+		}
+		if (k < sz || !sz)
+			m_ipRowType[i]=0;
+		else {
+			double u=m_copy.getRowUpBound(i);
+			m_ipRowType[i]=(!isInf(u) && u+neg <= 1.0+PROP_TOL)? CMIP::CTR_PACKING: CMIP::CTR_CARDINALITY;
+		}
+	}
+} // end of CPropagator::init()
+
+void CPropagator::computeActivities(const double* dpD, double* dpAct, int* ipInf) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	int m=m_copy.getRowNum();
+	for (int i=0; i < m; ++i) {
+		double minAct=0.0, maxAct=0.0;
+		int minInf=0, maxInf=0, sz=m_copy.getRow(i,dpVal,ipCol);
+		for (int k=0; k < sz; ++k) {
+			double a=dpVal[k], lo=dpD[ipCol[k]<<1], up=dpD[(ipCol[k]<<1)+1];
+			if (a < 0.0) {
+				double t=lo;
+				lo=up;
+				up=t;
+			}
+			if (isInf(lo))
+				++minInf;
+			else
+				minAct+=a*lo;
+			if (isInf(up))
+				++maxInf;
+			else
+				maxAct+=a*up;
+		}
+		dpAct[i<<1]=minAct;
+		dpAct[(i<<1)+1]=maxAct;
+		ipInf[i<<1]=minInf;
+		ipInf[(i<<1)+1]=maxInf;
+	}
+} // end of CPropagator::computeActivities()
+
+//////////////////////////////////////////////////////////////////////
+// States
+//////////////////////////////////////////////////////////////////////
+bool CPropagator::allocState(tagState& s) const
+{
+	int m=m_copy.getRowNum(), n=m_copy.getColNum();
+	memset(&s,0,sizeof(tagState));
+	if (!(s.dpD = new double[(n<<2)+(m<<2)]))
+		return false;
+	if (!(s.ipInf = new int[(n<<1)+(m<<3)])) {
+		delete[] s.dpD;
+		s.dpD=0;
+		return false;
+	}
+	s.dpAct=s.dpD+(n<<1);
+	s.dpVarOld=s.dpAct+(m<<1);
+	s.dpRowOld=s.dpVarOld+(n<<1);
+	s.ipVarTrail=s.ipInf+(m<<1);
+	s.ipVarStamp=s.ipVarTrail+n;
+	s.ipRowTrail=s.ipVarStamp+n;
+	s.ipRowInfOld=s.ipRowTrail+m;
+	s.ipRowStamp=s.ipRowInfOld+(m<<1);
+	s.ipQueue=s.ipRowStamp+m;
+	s.ipInQueue=s.ipQueue+m;
+	memset(s.ipVarStamp,0,n*sizeof(int));
+	memset(s.ipRowStamp,0,m*sizeof(int));
+	memset(s.ipInQueue,0,m*sizeof(int));
+	return true;
+} // end of CPropagator::allocState()
+
+void CPropagator::freeState(tagState& s)
+{
+	if (s.dpD)
+		delete[] s.dpD;
+	if (s.ipInf)
+		delete[] s.ipInf;
+	s.dpD=0;
+	s.ipInf=0;
+} // end of CPropagator::freeState()
+
+void CPropagator::resetState(tagState& s, const double* dpD) const
+{
+	memcpy(s.dpD,dpD,(m_copy.getColNum()<<1)*sizeof(double));
+	computeActivities(s.dpD,s.dpAct,s.ipInf);
+	s.varTrailNum=s.rowTrailNum=s.qHead=s.qNum=0;
+} // end of CPropagator::resetState()
+
+CPropagator::tagState* CPropagator::getNodeState(int thread)
+{
+	tagState* pState=0;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if (thread >= m_iNodeStateNum) {
+		int num=thread+1;
+		tagState** ppState;
+		if (!(ppState = new tagState*[num])) {
+#ifndef __ONE_THREAD_
+			_MUTEX_UNLOCK(&m_mutex)
+#endif
+			return 0;
+		}
+		for (int t=0; t < num; ++t) {
+			ppState[t]=(t < m_iNodeStateNum)? m_ppNodeState[t]: 0;
+		}
+		if (m_ppNodeState)
+			delete[] m_ppNodeState;
+		m_ppNodeState=ppState;
+		m_iNodeStateNum=num;
+	}
+	if (!(pState=m_ppNodeState[thread])) {
+		if ((pState = new tagState)) {
+			if (allocState(*pState)) {
+				resetState(*pState,m_dpD);
+				m_ppNodeState[thread]=pState;
+			}
+			else {
+				delete pState;
+				pState=0;
+			}
+		}
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return pState;
+} // end of CPropagator::getNodeState()
+
+//////////////////////////////////////////////////////////////////////
+// Propagation
+//////////////////////////////////////////////////////////////////////
+void CPropagator::startPropagation(tagState& s) const
+{
+	++s.stamp;
+	s.varTrailNum=s.rowTrailNum=s.qHead=s.qNum=0;
+} // end of CPropagator::startPropagation()
+
+void CPropagator::changeBound(tagState& s, int j, double lo, double up) const
+{
+	int m=m_copy.getRowNum();
+	double oldLo=s.dpD[j<<1], oldUp=s.dpD[(j<<1)+1];
+	if (s.ipVarStamp[j] != s.stamp) {
+		s.ipVarStamp[j]=s.stamp;
+		s.dpVarOld[s.varTrailNum<<1]=oldLo;
+		s.dpVarOld[(s.varTrailNum<<1)+1]=oldUp;
+		s.ipVarTrail[s.varTrailNum++]=j;
+	}
+	for (int p=m_ipColBeg[j]; p < m_ipColBeg[j+1]; ++p) {
+		int i=m_ipColRow[p], i2=i<<1;
+		double a=m_dpColVal[p], minOld, minNew, maxOld, maxNew;
+		if (a > 0.0) {
+			minOld=oldLo;
+			minNew=lo;
+			maxOld=oldUp;
+			maxNew=up;
+		}
+		else {
+			minOld=oldUp;
+			minNew=up;
+			maxOld=oldLo;
+			maxNew=lo;
+		}
+		if (minOld == minNew && maxOld == maxNew)
+			continue;
+		if (s.ipRowStamp[i] != s.stamp) {
+			s.ipRowStamp[i]=s.stamp;
+			int r=s.rowTrailNum++;
+			s.ipRowTrail[r]=i;
+			s.dpRowOld[r<<1]=s.dpAct[i2];
+			s.dpRowOld[(r<<1)+1]=s.dpAct[i2+1];
+			s.ipRowInfOld[r<<1]=s.ipInf[i2];
+			s.ipRowInfOld[(r<<1)+1]=s.ipInf[i2+1];
+		}
+		if (minOld != minNew)
+			updateActivity(s.dpAct[i2],s.ipInf[i2],a,minOld,minNew);
+		if (maxOld != maxNew)
+			updateActivity(s.dpAct[i2+1],s.ipInf[i2+1],a,maxOld,maxNew);
+	// only a greater minimum activity (with finite `u_i`) or a smaller maximum activity (with finite `l_i`) can imply something
+		if (s.ipInQueue[i] != s.stamp &&
+				((a*(minNew-minOld) > 0.0 && !isInf(m_copy.getRowUpBound(i))) ||
+				 (a*(maxNew-maxOld) < 0.0 && !isInf(m_copy.getRowLoBound(i))))) {
+			s.ipInQueue[i]=s.stamp;
+			s.ipQueue[(s.qHead+s.qNum++)%m]=i;
+		}
+	}
+	s.dpD[j<<1]=lo;
+	s.dpD[(j<<1)+1]=up;
+} // end of CPropagator::changeBound()
+
+bool CPropagator::propagateCardinality(tagState& s, int i) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	int i2=i<<1;
+	double L=m_copy.getRowLoBound(i), U=m_copy.getRowUpBound(i);
+	bool atMin=(!isInf(U) && U-s.dpAct[i2] < 1.0-PROP_TOL)? true: false; // free variables take values giving the minimum activity
+	bool atMax=(!isInf(L) && s.dpAct[i2+1]-L < 1.0-PROP_TOL)? true: false;
+	++s.cardRowNum;
+	if (!atMin && !atMax)
+		return true;
+	int sz=m_copy.getRow(i,dpVal,ipCol), stamp=s.ipInQueue[i];
+	s.ipInQueue[i]=s.stamp; // fixings below cannot imply anything more for this row
+	for (int k=0; k < sz; ++k) {
+		int j=ipCol[k];
+		if (s.dpD[j<<1] == s.dpD[(j<<1)+1])
+			continue;
+		if (atMin && atMax) {
+			s.ipInQueue[i]=stamp;
+			return false;
+		}
+		double v=((dpVal[k] > 0.0) == atMin)? 0.0: 1.0;
+		changeBound(s,j,v,v);
+	}
+	s.ipInQueue[i]=stamp;
+	return true;
+} // end of CPropagator::propagateCardinality()
+
+bool CPropagator::propagateRow(tagState& s, int i) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	int i2=i<<1, sz=m_copy.getRow(i,dpVal,ipCol);
+	double L=m_copy.getRowLoBound(i), U=m_copy.getRowUpBound(i);
+	++s.rowNum;
+	for (int k=0; k < sz; ++k) {
+		int j=ipCol[k];
+		double a=dpVal[k], lo=s.dpD[j<<1], up=s.dpD[(j<<1)+1], nlo=lo, nup=up, r, v;
+	// `U` bounds `a*x_j` from above by `U` minus minimum activity of other entries
+		if (!isInf(U) && s.ipInf[i2] <= 1) {
+			v=(a > 0.0)? lo: up;
+			if (isInf(v))
+				r=(s.ipInf[i2] == 1)? s.dpAct[i2]: CLP::INF;
+			else
+				r=(s.ipInf[i2])? CLP::INF: s.dpAct[i2]-a*v;
+			if (r < CLP::INF) {
+				if (a > 0.0)
+					nup=std::min(nup,(U-r)/a);
+				else
+					nlo=std::max(nlo,(U-r)/a);
+			}
+		}
+	// `L` bounds `a*x_j` from below by `L` minus maximum activity of other entries
+		if (!isInf(L) && s.ipInf[i2+1] <= 1) {
+			v=(a > 0.0)? up: lo;
+			if (isInf(v))
+				r=(s.ipInf[i2+1] == 1)? s.dpAct[i2+1]: CLP::INF;
+			else
+				r=(s.ipInf[i2+1])? CLP::INF: s.dpAct[i2+1]-a*v;
+			if (r < CLP::INF) {
+				if (a > 0.0)
+					nlo=std::max(nlo,(L-r)/a);
+				else
+					nup=std::min(nup,(L-r)/a);
+			}
+		}
+		if (nlo == lo && nup == up)
+			continue;
+		if (m_copy.isInteger(j)) {
+			if (nlo > lo)
+				nlo=ceil(nlo-PROP_TOL);
+			if (nup < up)
+				nup=floor(nup+PROP_TOL);
+			if (nlo > nup+PROP_TOL)
+				return false;
+			if (nlo < lo+0.5)
+				nlo=lo;
+			if (nup > up-0.5)
+				nup=up;
+		}
+		else {
+			if (nlo > nup+PROP_TOL*(1.0+fabs(nup)))
+				return false;
+			if (!isInf(lo) && nlo < lo+PROP_MIN_CHANGE*std::max(1.0,fabs(lo)))
+				nlo=lo;
+			if (!isInf(up) && nup > up-PROP_MIN_CHANGE*std::max(1.0,fabs(up)))
+				nup=up;
+			if (nlo > nup)
+				nlo=nup=0.5*(nlo+nup);
+		}
+		if (nlo != lo || nup != up)
+			changeBound(s,j,nlo,nup);
+	}
+	return true;
+} // end of CPropagator::propagateRow()
+
+bool CPropagator::propagate(tagState& s, int maxWork) const
+{
+	const double* dpVal;
+	const int* ipCol;
+	int m=m_copy.getRowNum(), work=0;
+	while (s.qNum) {
+		int i=s.ipQueue[s.qHead], i2=i<<1;
+		s.qHead=(s.qHead+1)%m;
+		--s.qNum;
+		s.ipInQueue[i]=0;
+		double L=m_copy.getRowLoBound(i), U=m_copy.getRowUpBound(i);
+		if (!isInf(U) && !s.ipInf[i2] && s.dpAct[i2] > U+PROP_TOL*(1.0+fabs(U)))
+			return false;
+		if (!isInf(L) && !s.ipInf[i2+1] && s.dpAct[i2+1] < L-PROP_TOL*(1.0+fabs(L)))
+			return false;
+		if ((isInf(U) || s.ipInf[i2] > 1) && (isInf(L) || s.ipInf[i2+1] > 1))
+			continue;
+		if ((work+=m_copy.getRow(i,dpVal,ipCol)) > maxWork) { // give up, the bounds derived so far are valid
+			for (; s.qNum; --s.qNum) {
+				s.ipInQueue[s.ipQueue[s.qHead]]=0;
+				s.qHead=(s.qHead+1)%m;
+			}
+			break;
+		}
+		if (!((m_ipRowType[i])? propagateCardinality(s,i): propagateRow(s,i)))
+			return false;
+	}
+	return true;
+} // end of CPropagator::propagate()
+
+void CPropagator::undo(tagState& s) const
+{
+	int m=m_copy.getRowNum(), k;
+	for (k=s.varTrailNum; k--; ) {
+		int j=s.ipVarTrail[k];
+		s.dpD[j<<1]=s.dpVarOld[k<<1];
+		s.dpD[(j<<1)+1]=s.dpVarOld[(k<<1)+1];
+	}
+	for (k=0; k < s.rowTrailNum; ++k) {
+		int i2=s.ipRowTrail[k]<<1;
+		s.dpAct[i2]=s.dpRowOld[k<<1];
+		s.dpAct[i2+1]=s.dpRowOld[(k<<1)+1];
+		s.ipInf[i2]=s.ipRowInfOld[k<<1];
+		s.ipInf[i2+1]=s.ipRowInfOld[(k<<1)+1];
+	}
+	for (; s.qNum; --s.qNum) {
+		s.ipInQueue[s.ipQueue[s.qHead]]=0;
+		s.qHead=(s.qHead+1)%m;
+	}
+	s.varTrailNum=s.rowTrailNum=s.qHead=0;
+} // end of CPropagator::undo()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CPropagator::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	long long rowNum=0, cardRowNum=0;
+	for (int t=0; t < m_iNodeStateNum; ++t) {
+		if (m_ppNodeState[t]) {
+			rowNum+=m_ppNodeState[t]->rowNum;
+			cardRowNum+=m_ppNodeState[t]->cardRowNum;
+		}
+	}
+	out << "Activity propagation\n";
+	out << "===== Nodes ==== Pruned ===== Bounds ==== General rows == Card. rows\n";
+	sprintf(str,"%11d %10d %10lld %17lld %12lld\n",static_cast<int>(m_iCallNum),static_cast<int>(m_iPruneNum),
+		static_cast<long long>(m_lBdNum),rowNum,cardRowNum);
+	out << str;
+	out << std::endl;
+} // end of CPropagator::printStatistics()
@@ -0,0 +1,503 @@
+// RelBranching.cpp: implementation of the CRelBranching class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cmath>
+#include <except.h>
+#include <lp.h>
+#include <Sort.h>
+#include "CutAging.h"
+#include "RelBranching.h"
+
+#define SB_EPS 1.0e-6 ///< objective decreases less than `SB_EPS` are rounded up to `SB_EPS` when computing scores.
+
+/**
+ * \param[in] d,u objective decreases in down and up branches.
+ * \return score of branching candidate.
+ */
+static inline double getScore(double d, double u)
+{
+	return ((d > SB_EPS)? d: SB_EPS)*((u > SB_EPS)? u: SB_EPS);
+}
+
+/**
+ * \param[in] h key value;
+ * \param[in] v value to be mixed into `h`.
+ * \return new key value.
+ */
+static inline unsigned long long mixKey(unsigned long long h, unsigned long long v)
+{
+	return h ^ (v+0x9e3779b97f4a7c15ull+(h << 6)+(h >> 2));
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CRelBranching::CRelBranching(int threshold, int maxCandNum, int threadNum)
+{
+	m_bOwner=true;
+	m_iRelThreshold=threshold;
+	m_iMaxCandNum=maxCandNum;
+	m_iThreadNum=threadNum;
+	m_iHdNum=0;
+	m_dpPcSum=0;
+	m_ipPcNum=0;
+	if (!(m_dpPcTotal = new double[4])) {
+		throw new CMemoryException("CRelBranching::CRelBranching");
+	}
+	memset(m_dpPcTotal,0,4*sizeof(double));
+#ifndef __ONE_THREAD_
+	if (!(m_rwPcLock = new _RWLOCK)) {
+		throw new CMemoryException("CRelBranching::CRelBranching");
+	}
+	_RWLOCK_INIT(*m_rwPcLock)
+	_MUTEX_INIT(m_candMutex)
+#endif
+	m_iM=m_iN=m_iMaxM=m_iMaxN=m_iMaxNZ=0;
+	m_dpC=m_dpD=m_dpB=m_dpVal=0;
+	m_ipBeg=m_ipCol=0;
+	m_iCandNum=m_iMaxCandMem=m_iSbCandNum=m_iNextCand=0;
+	m_ipCandCol=m_ipCandHd=m_ipSbCand=m_ipCandExp=0;
+	m_dpCandX=m_dpCandScore=m_dpCandGain=0;
+	m_dNodeObj=0.0;
+	for (int b=0; b < RELBR_MEM_SIZE; ++b) {
+		m_pBr[b].hd=-1;
+	}
+	m_iBrNext=0;
+	m_iMaxLpNum=m_iNextLp=0;
+	m_ppLp=0;
+	m_ulpLpKey=0;
+	m_ulRowKey=0;
+} // end of CRelBranching::CRelBranching()
+
+CRelBranching::CRelBranching(const CRelBranching &other)
+{
+	m_bOwner=false;
+	m_iRelThreshold=other.m_iRelThreshold;
+	m_iMaxCandNum=other.m_iMaxCandNum;
+	m_iThreadNum=other.m_iThreadNum;
+	m_iHdNum=other.m_iHdNum;
+	m_dpPcSum=other.m_dpPcSum;
+	m_ipPcNum=other.m_ipPcNum;
+	m_dpPcTotal=other.m_dpPcTotal;
+#ifndef __ONE_THREAD_
+	m_rwPcLock=other.m_rwPcLock;
+	_MUTEX_INIT(m_candMutex)
+#endif
+	m_iM=m_iN=m_iMaxM=m_iMaxN=m_iMaxNZ=0;
+	m_dpC=m_dpD=m_dpB=m_dpVal=0;
+	m_ipBeg=m_ipCol=0;
+	m_iCandNum=m_iMaxCandMem=m_iSbCandNum=m_iNextCand=0;
+	m_ipCandCol=m_ipCandHd=m_ipSbCand=m_ipCandExp=0;
+	m_dpCandX=m_dpCandScore=m_dpCandGain=0;
+	m_dNodeObj=0.0;
+	for (int b=0; b < RELBR_MEM_SIZE; ++b) {
+		m_pBr[b].hd=-1;
+	}
+	m_iBrNext=0;
+	m_iMaxLpNum=m_iNextLp=0;
+	m_ppLp=0;
+	m_ulpLpKey=0;
+	m_ulRowKey=0;
+} // end of CRelBranching::CRelBranching(const CRelBranching &other)
+
+CRelBranching::~CRelBranching()
+{
+	if (m_bOwner) {
+		if (m_dpPcSum)
+			delete[] m_dpPcSum;
+		if (m_ipPcNum)
+			delete[] m_ipPcNum;
+		delete[] m_dpPcTotal;
+#ifndef __ONE_THREAD_
+		_RWLOCK_DESTROY(*m_rwPcLock)
+		delete m_rwPcLock;
+#endif
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_candMutex)
+#endif
+	if (m_dpC) {
+		delete[] m_dpC;
+		delete[] m_dpB;
+		delete[] m_dpVal;
+		delete[] m_ipBeg;
+	}
+	if (m_ipCandCol) {
+		delete[] m_ipCandCol;
+		delete[] m_dpCandX;
+	}
+	if (m_ppLp) {
+		for (int t=0; t < m_iMaxLpNum; ++t) {
+			if (m_ppLp[t])
+				delete m_ppLp[t];
+		}
+		delete[] m_ppLp;
+		delete[] m_ulpLpKey;
+	}
+} // end of CRelBranching::~CRelBranching()
+
+void CRelBranching::allocMemForPseudocosts(int hdNum)
+{
+	if (m_dpPcSum)
+		delete[] m_dpPcSum;
+	if (m_ipPcNum)
+		delete[] m_ipPcNum;
+	m_iHdNum=hdNum;
+	if (!(m_dpPcSum = new double[hdNum<<1]) || !(m_ipPcNum = new int[hdNum<<1])) {
+		throw new CMemoryException("CRelBranching::allocMemForPseudocosts");
+	}
+	memset(m_dpPcSum,0,(hdNum<<1)*sizeof(double));
+	memset(m_ipPcNum,0,(hdNum<<1)*sizeof(int));
+	memset(m_dpPcTotal,0,4*sizeof(double));
+} // end of CRelBranching::allocMemForPseudocosts()
+
+void CRelBranching::allocMemForNodeLp(int m, int n, int nz)
+{
+	if (m > m_iMaxM || n > m_iMaxN || nz > m_iMaxNZ) {
+		if (m_dpC) {
+			delete[] m_dpC;
+			delete[] m_dpB;
+			delete[] m_dpVal;
+			delete[] m_ipBeg;
+		}
+		if (m > m_iMaxM)
+			m_iMaxM=m+(m>>2);
+		if (n > m_iMaxN)
+			m_iMaxN=n+(n>>2);
+		if (nz > m_iMaxNZ)
+			m_iMaxNZ=nz+(nz>>2);
+		if (!(m_dpC = new double[3*m_iMaxN]) || !(m_dpB = new double[m_iMaxM<<1]) ||
+			!(m_dpVal = new double[m_iMaxNZ+m_iMaxNZ/2+1]) || !(m_ipBeg = new int[m_iMaxM+1])) {
+			throw new CMemoryException("CRelBranching::allocMemForNodeLp");
+		}
+		m_dpD=m_dpC+m_iMaxN;
+		m_ipCol=reinterpret_cast<int*>(m_dpVal+m_iMaxNZ);
+	}
+	m_iM=m;
+	m_iN=n;
+} // end of CRelBranching::allocMemForNodeLp()
+
+void CRelBranching::allocMemForCands(int n)
+{
+	if (n > m_iMaxCandMem) {
+		if (m_ipCandCol) {
+			delete[] m_ipCandCol;
+			delete[] m_dpCandX;
+		}
+		m_iMaxCandMem=n;
+		if (!(m_ipCandCol = new int[4*n]) || !(m_dpCandX = new double[4*n])) {
+			throw new CMemoryException("CRelBranching::allocMemForCands");
+		}
+		m_ipCandHd=m_ipCandCol+n;
+		m_ipSbCand=m_ipCandHd+n;
+		m_ipCandExp=m_ipSbCand+n;
+		m_dpCandScore=m_dpCandX+n;
+		m_dpCandGain=m_dpCandScore+n;
+	}
+	m_iCandNum=0;
+} // end of CRelBranching::allocMemForCands()
+
+void CRelBranching::allocMemForLps(int lpNum)
+{
+	if (lpNum > m_iMaxLpNum) {
+		CLP **ppLp;
+		unsigned long long *ulpKey;
+		if (!(ppLp = new CLP*[lpNum]) || !(ulpKey = new unsigned long long[lpNum])) {
+			throw new CMemoryException("CRelBranching::allocMemForLps");
+		}
+		for (int t=0; t < lpNum; ++t) {
+			ppLp[t]=(t < m_iMaxLpNum)? m_ppLp[t]: 0;
+			ulpKey[t]=(t < m_iMaxLpNum)? m_ulpLpKey[t]: 0;
+		}
+		if (m_ppLp) {
+			delete[] m_ppLp;
+			delete[] m_ulpLpKey;
+		}
+		m_ppLp=ppLp;
+		m_ulpLpKey=ulpKey;
+		m_iMaxLpNum=lpNum;
+	}
+} // end of CRelBranching::allocMemForLps()
+
+///////////////////////////////////////////////////////////
+// Pseudocosts
+///////////////////////////////////////////////////////////
+double CRelBranching::getPseudocost(int hd, int dir) const
+{
+	int k=(hd<<1)+dir;
+	if (m_ipPcNum[k])
+		return m_dpPcSum[k]/m_ipPcNum[k];
+	if (m_dpPcTotal[dir+2] > 0.5)
+		return m_dpPcTotal[dir]/m_dpPcTotal[dir+2];
+	return 1.0;
+} // end of CRelBranching::getPseudocost()
+
+void CRelBranching::updatePseudocost(int hd, int dir, double gain)
+{
+	int k=(hd<<1)+dir;
+	m_dpPcSum[k]+=gain;
+	++m_ipPcNum[k];
+	m_dpPcTotal[dir]+=gain;
+	m_dpPcTotal[dir+2]+=1.0;
+} // end of CRelBranching::updatePseudocost()
+
+void CRelBranching::storeBranching(int k, int height)
+{
+	tagBranching& br=m_pBr[m_iBrNext];
+	br.hd=m_ipCandHd[k];
+	br.col=m_ipCandCol[k];
+	br.height=height;
+	br.observed=0;
+	br.x=m_dpCandX[k];
+	br.obj=m_dNodeObj;
+	if (++m_iBrNext == RELBR_MEM_SIZE)
+		m_iBrNext=0;
+} // end of CRelBranching::storeBranching()
+
+void CRelBranching::observeChild(int b, int dir, double objVal)
+{
+	tagBranching& br=m_pBr[b];
+	double f=br.x-floor(br.x), gain=br.obj-objVal;
+	if (gain < 0.0)
+		gain=0.0;
+	_RWLOCK_SAFE_WRLOCK(m_rwPcLock)
+	updatePseudocost(br.hd,dir,(dir)? gain/(1.0-f): gain/f);
+	_RWLOCK_SAFE_UNLOCK_WRLOCK(m_rwPcLock)
+	if ((br.observed|= (1 << dir)) == 3)
+		br.hd=-1; // both children have been observed
+} // end of CRelBranching::observeChild()
+
+void CRelBranching::storePseudocosts(double* dpMem)
+{
+	int n=m_iHdNum<<1;
+	_RWLOCK_SAFE_RDLOCK(m_rwPcLock)
+	memcpy(dpMem,m_dpPcSum,n*sizeof(double));
+	for (int i=0; i < n; ++i) {
+		dpMem[n+i]=m_ipPcNum[i];
+	}
+	memcpy(dpMem+(n<<1),m_dpPcTotal,4*sizeof(double));
+	_RWLOCK_SAFE_UNLOCK_RDLOCK(m_rwPcLock)
+} // end of CRelBranching::storePseudocosts()
+
+void CRelBranching::restorePseudocosts(const double* dpMem)
+{
+	int n=m_iHdNum<<1;
+	_RWLOCK_SAFE_WRLOCK(m_rwPcLock)
+	memcpy(m_dpPcSum,dpMem,n*sizeof(double));
+	for (int i=0; i < n; ++i) {
+		m_ipPcNum[i]=static_cast<int>(dpMem[n+i]);
+	}
+	memcpy(m_dpPcTotal,dpMem+(n<<1),4*sizeof(double));
+	_RWLOCK_SAFE_UNLOCK_WRLOCK(m_rwPcLock)
+} // end of CRelBranching::restorePseudocosts()
+
+///////////////////////////////////////////////////////////
+// Strong branching
+///////////////////////////////////////////////////////////
+void CRelBranching::setRowKey()
+{
+	unsigned long long h=static_cast<unsigned long long>(m_iN);
+	h=mixKey(h,static_cast<unsigned long long>(m_iM));
+	for (int i=0; i < m_iM; ++i) {
+		h=mixKey(h,CCutAging::hashRow(m_ipBeg[i+1]-m_ipBeg[i],m_dpVal+m_ipBeg[i],m_ipCol+m_ipBeg[i],0.0,0.0));
+	}
+	m_ulRowKey=(h)? h: 1;
+} // end of CRelBranching::setRowKey()
+
+CLP* CRelBranching::loadNodeLp(int t)
+{
+	CLP *pLp=m_ppLp[t];
+	if (pLp && m_ulpLpKey[t] == m_ulRowKey) {
+		for (int j=0; j < m_iN; ++j) {
+			pLp->setObjCoeff(j,m_dpC[j]);
+			pLp->setVarBounds(j,m_dpD[j<<1],m_dpD[(j<<1)+1]);
+		}
+		for (int i=0; i < m_iM; ++i) {
+			pLp->setCtrBounds(i,m_dpB[i<<1],m_dpB[(i<<1)+1]);
+		}
+		return pLp;
+	}
+	if (pLp) {
+		delete pLp;
+		m_ppLp[t]=0;
+	}
+
+	int *ipCol, nz=m_ipBeg[m_iM];
+	double *dpVal;
+	if (!(dpVal = new double[m_iN+(m_iN+1)/2+1])) {
+		throw new CMemoryException("CRelBranching::loadNodeLp");
+	}
+	ipCol=reinterpret_cast<int*>(dpVal+m_iN);
+	try {
+		if (!(pLp = m_ppLp[t] = new CLP("SB"))) {
+			throw new CMemoryException("CRelBranching::loadNodeLp");
+		}
+		pLp->beSilent();
+		pLp->preprocOff();
+		pLp->setScaling(CLP::SCL_NO);
+		pLp->openMatrix(m_iM,m_iN,nz,false,false,m_iM,m_iN,nz);
+		for (int j=0; j < m_iN; ++j) {
+			pLp->addVar(j,0,m_dpC[j],m_dpD[j<<1],m_dpD[(j<<1)+1]);
+		}
+		for (int sz, i=0; i < m_iM; ++i) {
+			sz=m_ipBeg[i+1]-m_ipBeg[i];
+			memcpy(dpVal,m_dpVal+m_ipBeg[i],sz*sizeof(double));
+			memcpy(ipCol,m_ipCol+m_ipBeg[i],sz*sizeof(int));
+			pLp->addRow(i,0,m_dpB[i<<1],m_dpB[(i<<1)+1],sz,dpVal,ipCol);
+		}
+		pLp->closeMatrix();
+	}
+	catch(CException*) {
+		delete[] dpVal;
+		throw;
+	}
+	delete[] dpVal;
+	m_ulpLpKey[t]=m_ulRowKey;
+	return pLp;
+} // end of CRelBranching::loadNodeLp()
+
+void CRelBranching::evalCands()
+{
+	int t;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_candMutex)
+#endif
+	t=m_iNextLp++;
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_candMutex)
+#endif
+	try {
+		CLP *pLp=loadNodeLp(t);
+		for (int j, k;;) {
+#ifndef __ONE_THREAD_
+			_MUTEX_LOCK(&m_candMutex)
+#endif
+			k=(m_iNextCand < m_iSbCandNum)? m_ipSbCand[m_iNextCand++]: -1;
+#ifndef __ONE_THREAD_
+			_MUTEX_UNLOCK(&m_candMutex)
+#endif
+			if (k < 0)
+				break;
+			j=m_ipCandCol[k];
+			pLp->setVarBounds(j,m_dpD[j<<1],ldexp(floor(m_dpCandX[k]),-m_ipCandExp[k]));
+			pLp->optimize();
+			m_dpCandGain[k<<1]=(pLp->isSolution())? m_dNodeObj-pLp->getObjVal(): CLP::INF;
+			pLp->setVarBounds(j,ldexp(ceil(m_dpCandX[k]),-m_ipCandExp[k]),m_dpD[(j<<1)+1]);
+			pLp->optimize();
+			m_dpCandGain[(k<<1)+1]=(pLp->isSolution())? m_dNodeObj-pLp->getObjVal(): CLP::INF;
+			pLp->setVarBounds(j,m_dpD[j<<1],m_dpD[(j<<1)+1]);
+		}
+	}
+	catch(CException* pe) {
+		delete pe; // not evaluated candidates are scored by their pseudocosts
+		if (m_ppLp[t]) { // the LP may be left in an inconsistent state
+			delete m_ppLp[t];
+			m_ppLp[t]=0;
+		}
+	}
+} // end of CRelBranching::evalCands()
+
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CRelBranching::startThread(void* param)
+#else
+void* CRelBranching::startThread(void* param)
+#endif
+{
+	static_cast<CRelBranching*>(param)->evalCands();
+	return 0;
+} // end of CRelBranching::startThread()
+#endif
+
+void CRelBranching::strongBranching(int threadNum)
+{
+	m_iNextCand=m_iNextLp=0;
+	setRowKey();
+#ifndef __ONE_THREAD_
+	if (threadNum > m_iSbCandNum)
+		threadNum=m_iSbCandNum;
+	allocMemForLps((threadNum > 1)? threadNum: 1);
+	if (threadNum > 1) {
+		_THREAD* pThreads;
+		if (!(pThreads = new _THREAD[--threadNum])) {
+			throw new CMemoryException("CRelBranching::strongBranching");
+		}
+		for (int t=0; t < threadNum; ++t) {
+			_THREAD_CREATE(pThreads[t],startThread,this)
+		}
+		evalCands();
+		for (int t=0; t < threadNum; ++t) {
+			_THREAD_JOIN(pThreads[t])
+			_THREAD_CLOSE(pThreads[t])
+		}
+		delete[] pThreads;
+		return;
+	}
+#else
+	allocMemForLps(1);
+#endif
+	evalCands();
+} // end of CRelBranching::strongBranching()
+
+int CRelBranching::select(int threadNum)
+{
+	int k, hd, best=-1;
+	double f, d, u, score, bestScore=-1.0;
+
+	m_iSbCandNum=0;
+	_RWLOCK_SAFE_RDLOCK(m_rwPcLock)
+	for (k=0; k < m_iCandNum; ++k) {
+		hd=m_ipCandHd[k];
+		f=m_dpCandX[k]-floor(m_dpCandX[k]);
+		m_dpCandScore[k]=getScore(getPseudocost(hd,0)*f,getPseudocost(hd,1)*(1.0-f));
+		if (!isReliable(hd,0) || !isReliable(hd,1))
+			m_ipSbCand[m_iSbCandNum++]=k;
+	}
+	_RWLOCK_SAFE_UNLOCK_RDLOCK(m_rwPcLock)
+
+	if (m_iCandNum > 1 && m_iSbCandNum) {
+		if (m_iSbCandNum > m_iMaxCandNum) {
+			SORT::decSortDouble(m_iSbCandNum,m_ipSbCand,m_dpCandScore);
+			m_iSbCandNum=m_iMaxCandNum;
+		}
+		for (int i=0; i < m_iSbCandNum; ++i) {
+			k=m_ipSbCand[i];
+			m_dpCandGain[k<<1]=m_dpCandGain[(k<<1)+1]=-1.0;
+		}
+		strongBranching(threadNum);
+
+		_RWLOCK_SAFE_WRLOCK(m_rwPcLock)
+		for (int i=0; i < m_iSbCandNum; ++i) {
+			k=m_ipSbCand[i];
+			d=m_dpCandGain[k<<1];
+			u=m_dpCandGain[(k<<1)+1];
+			if (d < -0.5 || u < -0.5)
+				continue; // not evaluated
+			if (d >= CLP::INF || u >= CLP::INF) {
+				best=k; // one of the branches is infeasible
+				bestScore=CLP::INF;
+				continue;
+			}
+			if (d < 0.0)
+				d=0.0;
+			if (u < 0.0)
+				u=0.0;
+			hd=m_ipCandHd[k];
+			f=m_dpCandX[k]-floor(m_dpCandX[k]);
+			updatePseudocost(hd,0,d/f);
+			updatePseudocost(hd,1,u/(1.0-f));
+			m_dpCandScore[k]=getScore(d,u);
+		}
+		_RWLOCK_SAFE_UNLOCK_WRLOCK(m_rwPcLock)
+	}
+	if (best < 0) {
+		for (k=0; k < m_iCandNum; ++k) {
+			if ((score=m_dpCandScore[k]) > bestScore) {
+				bestScore=score;
+				best=k;
+			}
+		}
+	}
+	return best;
+} // end of CRelBranching::select()
@@ -0,0 +1,73 @@
+// Restart.cpp: implementation of the CRestart class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <except.h>
+#include "Restart.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CRestart::CRestart(double minFixRate, int maxRestartNum)
+{
+	m_dMinFixRate=(minFixRate > 0.0)? minFixRate: 0.0;
+	m_iMaxRestartNum=(maxRestartNum > 0)? maxRestartNum: 1;
+	m_iColNum=0;
+	m_dpD=m_dpRecX=0;
+	m_cpBd=0;
+	m_ipRecHd=0;
+	m_bChecked=m_bRestart=m_bRec=false;
+	m_dRecObj=0.0;
+	m_iRecNum=0;
+	m_iRestartNum=m_iSkipNum=m_iFixNum=m_iVarNum=0;
+} // end of CRestart::CRestart()
+
+CRestart::~CRestart()
+{
+	if (m_dpD)
+		delete[] m_dpD;
+	if (m_cpBd)
+		delete[] m_cpBd;
+	if (m_dpRecX)
+		delete[] m_dpRecX;
+	if (m_ipRecHd)
+		delete[] m_ipRecHd;
+} // end of CRestart::~CRestart()
+
+void CRestart::init(int n)
+{
+	if (m_dpD) {
+		delete[] m_dpD;
+		delete[] m_cpBd;
+		delete[] m_dpRecX;
+		delete[] m_ipRecHd;
+	}
+	m_iColNum=n;
+	if (!(m_dpD = new double[n<<1])) {
+		throw new CMemoryException("CRestart::init");
+	}
+	if (!(m_cpBd = new char[n])) {
+		throw new CMemoryException("CRestart::init");
+	}
+	memset(m_cpBd,0,n);
+	if (!(m_dpRecX = new double[n])) {
+		throw new CMemoryException("CRestart::init");
+	}
+	if (!(m_ipRecHd = new int[n])) {
+		throw new CMemoryException("CRestart::init");
+	}
+} // end of CRestart::init()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CRestart::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	out << "Root restarts\n";
+	out << "=== Restarts ==== Skipped ===== Fixed ==== Columns\n";
+	sprintf(str,"%12d %11d %11d %11d\n",m_iRestartNum,m_iSkipNum,m_iFixNum,m_iVarNum);
+	out << str;
+	out << std::endl;
+} // end of CRestart::printStatistics()
@@ -0,0 +1,328 @@
+// RootRace.cpp: implementation of the CRootRace class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <except.h>
+#include <cmip.h>
+#include "RootRace.h"
+
+/**
+ * `CRootRacer` is a solver which processes only the root node, and reports its results to `CRootRace`.
+ */
+class CRootRacer: public CMIP
+{
+	CRootRace* m_pRace; ///< race in which this racer participates.
+	int m_iRacer; ///< racer index.
+public:
+	/**
+	 * The constructor builds a copy of the original problem stored in `pRace`.
+	 * \param[in] pRace race in which this racer participates;
+	 * \param[in] k racer index.
+	 * \throws CMemoryException lack of memory.
+	 */
+	CRootRacer(CRootRace* pRace, int k);
+
+	/**
+	 * The function overloads `CMIP::changeRecord()` to report new solutions to `m_pRace`.
+	 * \param[in]  objVal objective value;
+	 * \param[in] n number of variables;
+	 * \param[in] dpX,ipHd solution, `dpX[j]` is value of variable with handle `ipHd[j]`, `j=1,...,n`.
+	 */
+	void changeRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd);
+
+protected:
+	/**
+	 * This function is called only once, after the root node has been processed.
+	 * The function reports the root bound and all global cuts to `m_pRace`,
+	 * and then stops the solver by creating one branch which is always infeasible.
+	 * \param[in] nodeHeight height of the root node.
+	 * \return always `1`.
+	 */
+	int startBranching(int nodeHeight);
+
+	bool updateBranch(int /*i*/)
+		{return false;} ///< The only branch created by `startBranching()` is infeasible.
+};
+
+CRootRacer::CRootRacer(CRootRace* pRace, int k): CMIP("racer")
+{
+	m_pRace=pRace;
+	m_iRacer=k;
+	beSilent(); // before loading, since the problem is preprocessed when it is loaded
+	pRace->m_copy.load(*this);
+} // end of CRootRacer::CRootRacer()
+
+void CRootRacer::changeRecord(double objVal, int n, const double* dpX, const tagHANDLE* ipHd)
+{
+	CMIP::changeRecord(objVal,n,dpX,ipHd);
+	m_pRace->setRecord(objVal,n,dpX,ipHd);
+} // end of CRootRacer::changeRecord()
+
+int CRootRacer::startBranching(int /*nodeHeight*/)
+{
+	int sz, hd, k, *ipCol;
+	double *dpVal;
+	m_pRace->m_dpRootBound[m_iRacer]=getObjBound();
+	if (!(dpVal = new double[m_iN+(m_iN+1)/2+1])) {
+		throw new CMemoryException("CRootRacer::startBranching");
+	}
+	ipCol=reinterpret_cast<int*>(dpVal+m_iN);
+	for (int i=m_iM0; i < m_iM; ++i) {
+		if (!isCtrGlobal(i))
+			continue;
+		sz=getRow(i,dpVal,ipCol,false);
+		for (k=0; k < sz; ++k) {
+			if ((hd=m_ipColHd[ipCol[k]]) < 0 || hd >= m_pRace->m_copy.getColNum())
+				break;
+			ipCol[k]=hd;
+		}
+		if (k == sz)
+			m_pRace->addCut(getLHS(i),getRHS(i),sz,dpVal,ipCol);
+	}
+	delete[] dpVal;
+	return 1;
+} // end of CRootRacer::startBranching()
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CRootRace::CRootRace(int racerNum)
+{
+	m_iRacerNum=racerNum;
+	m_iNextRacer=0;
+	m_iWinner=-1;
+	if (!(m_dpRootBound = new double[racerNum])) {
+		throw new CMemoryException("CRootRace::CRootRace");
+	}
+	m_bRec=false;
+	m_dRecObj=0.0;
+	m_iRecNum=0;
+	m_dpRecX=0;
+	m_ipRecHd=0;
+	m_iCutNum=m_iMaxCutNum=m_iMaxCutNz=0;
+	m_dpCutB=m_dpCutVal=0;
+	m_ipCutBeg=m_ipCutHd=0;
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+#endif
+} // end of CRootRace::CRootRace()
+
+CRootRace::~CRootRace()
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	delete[] m_dpRootBound;
+	if (m_dpRecX) {
+		delete[] m_dpRecX;
+		delete[] m_ipRecHd;
+	}
+	if (m_dpCutB) {
+		delete[] m_dpCutB;
+		delete[] m_ipCutBeg;
+		delete[] m_dpCutVal;
+		delete[] m_ipCutHd;
+	}
+} // end of CRootRace::~CRootRace()
+
+void CRootRace::allocMemForCuts(int cutNum, int nz)
+{
+	if (cutNum > m_iMaxCutNum) {
+		double *dpCutB;
+		int *ipCutBeg;
+		if (cutNum < 2*m_iMaxCutNum)
+			cutNum=2*m_iMaxCutNum;
+		if (!(dpCutB = new double[2*cutNum]) || !(ipCutBeg = new int[cutNum+1])) {
+			throw new CMemoryException("CRootRace::allocMemForCuts");
+		}
+		if (m_dpCutB) {
+			memcpy(dpCutB,m_dpCutB,2*m_iCutNum*sizeof(double));
+			memcpy(ipCutBeg,m_ipCutBeg,(m_iCutNum+1)*sizeof(int));
+			delete[] m_dpCutB;
+			delete[] m_ipCutBeg;
+		}
+		else
+			ipCutBeg[0]=0;
+		m_dpCutB=dpCutB;
+		m_ipCutBeg=ipCutBeg;
+		m_iMaxCutNum=cutNum;
+	}
+	if (nz > m_iMaxCutNz) {
+		double *dpCutVal;
+		int *ipCutHd;
+		if (nz < 2*m_iMaxCutNz)
+			nz=2*m_iMaxCutNz;
+		if (!(dpCutVal = new double[nz]) || !(ipCutHd = new int[nz])) {
+			throw new CMemoryException("CRootRace::allocMemForCuts");
+		}
+		if (m_dpCutVal) {
+			memcpy(dpCutVal,m_dpCutVal,m_ipCutBeg[m_iCutNum]*sizeof(double));
+			memcpy(ipCutHd,m_ipCutHd,m_ipCutBeg[m_iCutNum]*sizeof(int));
+			delete[] m_dpCutVal;
+			delete[] m_ipCutHd;
+		}
+		m_dpCutVal=dpCutVal;
+		m_ipCutHd=ipCutHd;
+		m_iMaxCutNz=nz;
+	}
+} // end of CRootRace::allocMemForCuts()
+
+//////////////////////////////////////////////////////////////////////
+// Collecting results
+//////////////////////////////////////////////////////////////////////
+void CRootRace::setRecord(double objVal, int n, const double* dpX, const int* ipHd)
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	if (!m_bRec || ((m_copy.getSense())? objVal > m_dRecObj: objVal < m_dRecObj)) {
+		if (n > m_iRecNum || !m_dpRecX) {
+			if (m_dpRecX) {
+				delete[] m_dpRecX;
+				delete[] m_ipRecHd;
+			}
+			if (!(m_dpRecX = new double[n]) || !(m_ipRecHd = new int[n])) {
+#ifndef __ONE_THREAD_
+				_MUTEX_UNLOCK(&m_mutex)
+#endif
+				throw new CMemoryException("CRootRace::setRecord");
+			}
+		}
+		m_dRecObj=objVal;
+		m_iRecNum=n;
+		memcpy(m_dpRecX,dpX,n*sizeof(double));
+		memcpy(m_ipRecHd,ipHd,n*sizeof(int));
+		m_bRec=true;
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+} // end of CRootRace::setRecord()
+
+void CRootRace::addCut(double b1, double b2, int sz, const double* dpVal, const int* ipHd)
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	try {
+		allocMemForCuts(m_iCutNum+1,(m_iCutNum? m_ipCutBeg[m_iCutNum]: 0)+sz);
+	}
+	catch(CMemoryException* pe) {
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+		throw pe;
+	}
+	int beg=m_ipCutBeg[m_iCutNum];
+	memcpy(m_dpCutVal+beg,dpVal,sz*sizeof(double));
+	memcpy(m_ipCutHd+beg,ipHd,sz*sizeof(int));
+	m_dpCutB[m_iCutNum<<1]=b1;
+	m_dpCutB[(m_iCutNum<<1)+1]=b2;
+	m_ipCutBeg[++m_iCutNum]=beg+sz;
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+} // end of CRootRace::addCut()
+
+//////////////////////////////////////////////////////////////////////
+// Racing
+//////////////////////////////////////////////////////////////////////
+void CRootRace::applySettings(CMIP& mip, int k)
+{
+	int depth=mip.getProbingDepth();
+	switch (k&3) {
+		case 1: // deeper probing
+			mip.setProbingDepth(2*depth+k/4+1);
+			break;
+		case 2: // no Gomory cuts, more rounds of combinatorial cuts
+			mip.setCutTypePattern(CMIP::_SPARSE_GOMORY,0,-1);
+			mip.setCutTypePattern(CMIP::_DENSE_GOMORY,0,-1);
+			mip.setMinCutRounds(2+k/4,1);
+			break;
+		case 3: // no probing, different LP separation rule
+			mip.setProbingDepth(0);
+			mip.setLpSepRule((k&4)? CLP::SEP_PARTIAL: CLP::SEP_MOST_VIOLATED);
+			break;
+		default: // default settings
+			if (k >= 4)
+				mip.setProbingDepth(depth+k/4);
+	}
+} // end of CRootRace::applySettings()
+
+void CRootRace::runRacers()
+{
+	for (int k;;) {
+#ifndef __ONE_THREAD_
+		_MUTEX_LOCK(&m_mutex)
+#endif
+		k=(m_iNextRacer < m_iRacerNum)? m_iNextRacer++: -1;
+#ifndef __ONE_THREAD_
+		_MUTEX_UNLOCK(&m_mutex)
+#endif
+		if (k < 0)
+			break;
+		try {
+			CRootRacer racer(this,k);
+#ifndef __ONE_THREAD_
+			racer.setThreadNum(1);
+#endif
+			applySettings(racer,k);
+			racer.optimize();
+			if (m_dpRootBound[k] == CLP::INF && racer.isSolution())
+				m_dpRootBound[k]=racer.getObjVal(); // problem solved at root node
+		}
+		catch(CException* pe) {
+			delete pe; // racer `k` drops out of the race
+			m_dpRootBound[k]=CLP::INF;
+		}
+	}
+} // end of CRootRace::runRacers()
+
+#ifndef __ONE_THREAD_
+#ifdef _WIN32
+unsigned int __stdcall CRootRace::startThread(void* param)
+#else
+void* CRootRace::startThread(void* param)
+#endif
+{
+	static_cast<CRootRace*>(param)->runRacers();
+	return 0;
+} // end of CRootRace::startThread()
+#endif
+
+int CRootRace::race(int threadNum)
+{
+	for (int k=0; k < m_iRacerNum; ++k) {
+		m_dpRootBound[k]=CLP::INF;
+	}
+	m_iNextRacer=0;
+#ifndef __ONE_THREAD_
+	if (threadNum > m_iRacerNum)
+		threadNum=m_iRacerNum;
+	if (threadNum > 1) {
+		_THREAD* pThreads;
+		if (!(pThreads = new _THREAD[--threadNum])) {
+			throw new CMemoryException("CRootRace::race");
+		}
+		for (int t=0; t < threadNum; ++t) {
+			_THREAD_CREATE(pThreads[t],startThread,this)
+		}
+		runRacers();
+		for (int t=0; t < threadNum; ++t) {
+			_THREAD_JOIN(pThreads[t])
+			_THREAD_CLOSE(pThreads[t])
+		}
+		delete[] pThreads;
+	}
+	else
+#endif
+	runRacers();
+
+	m_iWinner=-1;
+	for (int k=0; k < m_iRacerNum; ++k) {
+		if (m_dpRootBound[k] < CLP::INF && (m_iWinner < 0 ||
+				((m_copy.getSense())? m_dpRootBound[k] < m_dpRootBound[m_iWinner]: m_dpRootBound[k] > m_dpRootBound[m_iWinner])))
+			m_iWinner=k;
+	}
+	return m_iWinner;
+} // end of CRootRace::race()
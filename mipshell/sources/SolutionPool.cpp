@@ -0,0 +1,296 @@
+// SolutionPool.cpp: implementation of the CSolutionPool class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <except.h>
+#include <lp.h>
+#include "SolutionPool.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CSolutionPool::CSolutionPool(int maxSolNum, double gap, bool alternative)
+{
+	m_iMaxSolNum=(maxSolNum > 0)? maxSolNum: 1;
+	m_dGap=(gap > 0.0)? gap: 0.0;
+	m_bAlternative=alternative;
+	m_bSense=true;
+	m_iColNum=m_iSolNum=0;
+	m_dBestObj=-CLP::INF;
+	m_dObjStep=0.0;
+	m_dpC=m_dpObj=m_dpX=m_dpTmp=0;
+	m_ipHeap=m_ipRank=0;
+	m_iOfferNum=m_iDupNum=m_iInfeasNum=m_iInsertNum=0;
+#ifndef __ONE_THREAD_
+	_MUTEX_INIT(m_mutex)
+#endif
+} // end of CSolutionPool::CSolutionPool()
+
+CSolutionPool::~CSolutionPool()
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_DESTROY(m_mutex)
+#endif
+	if (m_dpC) {
+		delete[] m_dpC;
+		delete[] m_dpObj;
+		delete[] m_dpX;
+		delete[] m_ipHeap;
+	}
+} // end of CSolutionPool::~CSolutionPool()
+
+void CSolutionPool::init()
+{
+	int n=m_copy.getColNum();
+	if (m_dpC) {
+		delete[] m_dpC;
+		delete[] m_dpObj;
+		delete[] m_dpX;
+		delete[] m_ipHeap;
+	}
+	m_bSense=m_copy.getSense();
+	m_iColNum=n;
+	m_iSolNum=0;
+	m_dBestObj=-CLP::INF;
+	if (!(m_dpC = new double[n<<1])) {
+		throw new CMemoryException("CSolutionPool::init");
+	}
+	m_dpTmp=m_dpC+n;
+	long long a, b, step=0;
+	for (int j=0; j < n; ++j) {
+		m_dpC[j]=(m_bSense)? m_copy.getObjCoeff(j): -m_copy.getObjCoeff(j);
+		if (m_dpC[j] != 0.0 && step >= 0) { // step is set to -1 if the objective is not integral
+			if (!m_copy.isInteger(j) || fabs(m_dpC[j]) > 1.0e9 || m_dpC[j] != floor(m_dpC[j]))
+				step=-1;
+			else {
+				for (a=static_cast<long long>(fabs(m_dpC[j])), b=step; b; ) {
+					long long r=a%b;
+					a=b;
+					b=r;
+				}
+				step=a;
+			}
+		}
+	}
+	m_dObjStep=(step > 0)? static_cast<double>(step): 0.0;
+	if (!(m_dpObj = new double[m_iMaxSolNum])) {
+		throw new CMemoryException("CSolutionPool::init");
+	}
+	if (!(m_dpX = new double[(size_t)m_iMaxSolNum*n])) {
+		throw new CMemoryException("CSolutionPool::init");
+	}
+	if (!(m_ipHeap = new int[m_iMaxSolNum<<1])) {
+		throw new CMemoryException("CSolutionPool::init");
+	}
+	m_ipRank=m_ipHeap+m_iMaxSolNum;
+} // end of CSolutionPool::init()
+
+//////////////////////////////////////////////////////////////////////
+// Heap of solutions
+//////////////////////////////////////////////////////////////////////
+void CSolutionPool::siftUp(int k)
+{
+	int s=m_ipHeap[k];
+	double obj=m_dpObj[s];
+	while (k) {
+		int p=(k-1)>>1;
+		if (m_dpObj[m_ipHeap[p]] <= obj)
+			break;
+		m_ipHeap[k]=m_ipHeap[p];
+		k=p;
+	}
+	m_ipHeap[k]=s;
+} // end of CSolutionPool::siftUp()
+
+void CSolutionPool::siftDown(int k)
+{
+	int s=m_ipHeap[k], c;
+	double obj=m_dpObj[s];
+	while ((c=(k<<1)+1) < m_iSolNum) {
+		if (c+1 < m_iSolNum && m_dpObj[m_ipHeap[c+1]] < m_dpObj[m_ipHeap[c]])
+			++c;
+		if (obj <= m_dpObj[m_ipHeap[c]])
+			break;
+		m_ipHeap[k]=m_ipHeap[c];
+		k=c;
+	}
+	m_ipHeap[k]=s;
+} // end of CSolutionPool::siftDown()
+
+int CSolutionPool::pop()
+{
+	int s=m_ipHeap[0];
+	if (--m_iSolNum > 0) {
+		m_ipHeap[0]=m_ipHeap[m_iSolNum];
+		siftDown(0);
+	}
+	m_ipHeap[m_iSolNum]=s;
+	return s;
+} // end of CSolutionPool::pop()
+
+//////////////////////////////////////////////////////////////////////
+// Adding solutions
+//////////////////////////////////////////////////////////////////////
+bool CSolutionPool::isFeasible() const
+{
+	const double* dpVal;
+	const int* ipCol;
+	double s, b, x;
+	int sz;
+	for (int j=0; j < m_iColNum; ++j) {
+		x=m_dpTmp[j];
+		if (x < m_copy.getLoBound(j)-SOL_POOL_TOL || x > m_copy.getUpBound(j)+SOL_POOL_TOL)
+			return false;
+		if (m_copy.isInteger(j) && fabs(x-floor(x+0.5)) > SOL_POOL_TOL)
+			return false;
+	}
+	for (int i=0; i < m_copy.getRowNum(); ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		for (s=0.0, --sz; sz >= 0; --sz) {
+			s+=dpVal[sz]*m_dpTmp[ipCol[sz]];
+		}
+		if ((b=m_copy.getRowLoBound(i)) > -CLP::INF && s < b-SOL_POOL_TOL*(1.0+fabs(b)))
+			return false;
+		if ((b=m_copy.getRowUpBound(i)) < CLP::INF && s > b+SOL_POOL_TOL*(1.0+fabs(b)))
+			return false;
+	}
+	return true;
+} // end of CSolutionPool::isFeasible()
+
+bool CSolutionPool::isDuplicate(double obj) const
+{
+	double tol=SOL_POOL_TOL*(1.0+fabs(obj));
+	for (int k=0; k < m_iSolNum; ++k) {
+		int s=m_ipHeap[k];
+		if (fabs(m_dpObj[s]-obj) > tol)
+			continue;
+		const double *dpX=m_dpX+s*m_iColNum;
+		int j=0;
+		for (; j < m_iColNum; ++j) {
+			if (fabs(dpX[j]-m_dpTmp[j]) > SOL_POOL_TOL*(1.0+fabs(m_dpTmp[j])))
+				break;
+		}
+		if (j == m_iColNum)
+			return true;
+	}
+	return false;
+} // end of CSolutionPool::isDuplicate()
+
+bool CSolutionPool::add(int n, const double* dpX, const int* ipHd)
+{
+	if (!m_dpC)
+		return false;
+	bool bInserted=false;
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	++m_iOfferNum;
+	double obj=0.0;
+	if (ipHd) {
+		memset(m_dpTmp,0,m_iColNum*sizeof(double));
+		for (int i=0; i < n; ++i) {
+			int hd=ipHd[i];
+			if (hd >= 0 && hd < m_iColNum)
+				m_dpTmp[hd]=dpX[i];
+		}
+	}
+	else {
+		if (n > m_iColNum)
+			n=m_iColNum;
+		memcpy(m_dpTmp,dpX,n*sizeof(double));
+		if (n < m_iColNum)
+			memset(m_dpTmp+n,0,(m_iColNum-n)*sizeof(double));
+	}
+	for (int j=0; j < m_iColNum; ++j)
+		obj+=m_dpC[j]*m_dpTmp[j];
+	if (obj >= computeCutoff()) {
+		if (!isFeasible())
+			++m_iInfeasNum;
+		else if (isDuplicate(obj))
+			++m_iDupNum;
+		else {
+			int s=(m_iSolNum < m_iMaxSolNum)? m_iSolNum: pop();
+			m_dpObj[s]=obj;
+			memcpy(m_dpX+s*m_iColNum,m_dpTmp,m_iColNum*sizeof(double));
+			m_ipHeap[m_iSolNum]=s;
+			siftUp(m_iSolNum++);
+			++m_iInsertNum;
+			bInserted=true;
+			if (obj > m_dBestObj) {
+				m_dBestObj=obj;
+				double bd=obj-m_dGap*((fabs(obj) > 1.0)? fabs(obj): 1.0);
+				while (m_iSolNum > 1 && m_dpObj[m_ipHeap[0]] < bd)
+					pop();
+			}
+		}
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return bInserted;
+} // end of CSolutionPool::add()
+
+double CSolutionPool::getCutoff()
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	double cutoff=computeCutoff();
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+	return cutoff;
+} // end of CSolutionPool::getCutoff()
+
+double CSolutionPool::computeCutoff() const
+{
+	double cutoff=-CLP::INF;
+	if (m_dBestObj > -CLP::INF && m_dGap < CLP::INF)
+		cutoff=m_dBestObj-m_dGap*((fabs(m_dBestObj) > 1.0)? fabs(m_dBestObj): 1.0);
+	if (m_iSolNum == m_iMaxSolNum) { // only solutions better than the worst one are inserted
+		double worst=m_dpObj[m_ipHeap[0]], tol=SOL_POOL_TOL*(1.0+fabs(worst));
+		worst+=(m_dObjStep > 0.0)? m_dObjStep-tol: tol;
+		if (worst > cutoff)
+			cutoff=worst;
+	}
+	return cutoff;
+} // end of CSolutionPool::computeCutoff()
+
+//////////////////////////////////////////////////////////////////////
+// Retrieving solutions
+//////////////////////////////////////////////////////////////////////
+void CSolutionPool::sort()
+{
+#ifndef __ONE_THREAD_
+	_MUTEX_LOCK(&m_mutex)
+#endif
+	int solNum=m_iSolNum;
+	for (int k=solNum-1; k >= 0; --k)
+		m_ipRank[k]=pop();
+	m_iSolNum=solNum;
+	for (int k=0; k < solNum; ++k) {
+		m_ipHeap[k]=m_ipRank[solNum-1-k];
+	}
+#ifndef __ONE_THREAD_
+	_MUTEX_UNLOCK(&m_mutex)
+#endif
+} // end of CSolutionPool::sort()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CSolutionPool::printStatistics(std::ostream &out)
+{
+	char str[128];
+	sort();
+	out << "Solution pool\n";
+	out << "==== Offered ===== Duplicates === Infeasible === Inserted ====== Kept ========= Best ======== Worst\n";
+	if (m_iSolNum)
+		sprintf(str,"%12d %14d %14d %11d %10d %14g %12g\n",m_iOfferNum,m_iDupNum,m_iInfeasNum,m_iInsertNum,m_iSolNum,getObjVal(0),getObjVal(m_iSolNum-1));
+	else
+		sprintf(str,"%12d %14d %14d %11d %10d %14s %12s\n",m_iOfferNum,m_iDupNum,m_iInfeasNum,m_iInsertNum,m_iSolNum,"-","-");
+	out << str;
+	out << std::endl;
+} // end of CSolutionPool::printStatistics()
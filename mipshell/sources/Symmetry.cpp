@@ -0,0 +1,482 @@
+// Symmetry.cpp: implementation of the CSymmetry class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <except.h>
+#include "Symmetry.h"
+
+#define SYM_MIN_GEN_MEM 8 ///< initial number of generators for which memory is allocated.
+
+/// Bijective mixing of 64-bit words (the finalizer of splitmix64).
+static inline unsigned long long mixHash(unsigned long long x)
+{
+	x^=x >> 30;
+	x*=0xbf58476d1ce4e5b9ULL;
+	x^=x >> 27;
+	x*=0x94d049bb133111ebULL;
+	x^=x >> 31;
+	return x;
+} // end of mixHash()
+
+/// Orders vertices by colors, and then by hashes of their neighbourhoods.
+struct CColorHashLess {
+	const int* ipColor; ///< colors.
+	const unsigned long long* lpHash; ///< hashes.
+	bool operator()(int u, int v) const
+	{
+		if (ipColor[u] != ipColor[v])
+			return ipColor[u] < ipColor[v];
+		return lpHash[u] < lpHash[v];
+	}
+};
+
+/// Orders vertices by attributes of the columns and rows they represent.
+struct CVertexLess {
+	const CMatrixCopy* pCopy; ///< problem.
+	int n; ///< number of columns.
+	bool operator()(int u, int v) const
+	{
+		if ((u < n) != (v < n))
+			return u < n;
+		if (u < n) {
+			if (pCopy->getVarType(u) != pCopy->getVarType(v))
+				return pCopy->getVarType(u) < pCopy->getVarType(v);
+			if (pCopy->getObjCoeff(u) != pCopy->getObjCoeff(v))
+				return pCopy->getObjCoeff(u) < pCopy->getObjCoeff(v);
+			if (pCopy->getLoBound(u) != pCopy->getLoBound(v))
+				return pCopy->getLoBound(u) < pCopy->getLoBound(v);
+			return pCopy->getUpBound(u) < pCopy->getUpBound(v);
+		}
+		u-=n;
+		v-=n;
+		if (pCopy->getCtrType(u) != pCopy->getCtrType(v))
+			return pCopy->getCtrType(u) < pCopy->getCtrType(v);
+		if (pCopy->getRowLoBound(u) != pCopy->getRowLoBound(v))
+			return pCopy->getRowLoBound(u) < pCopy->getRowLoBound(v);
+		return pCopy->getRowUpBound(u) < pCopy->getRowUpBound(v);
+	}
+};
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CSymmetry::CSymmetry(int maxGenNum, int timeLimit)
+{
+	m_iMaxGenNum=(maxGenNum > 0)? maxGenNum: 1;
+	m_iTimeLimit=(timeLimit > 0)? timeLimit: 1;
+	m_iMaxCutNum=0;
+	m_iColNum=m_iVertNum=0;
+	m_ipAdjBeg=m_ipAdj=0;
+	m_lpEdgeColor=m_lpHash=0;
+	m_ipColor=m_ipColor1=m_ipColor2=m_ipOrder=m_ipCount=m_ipPerm=m_ipParent=0;
+	m_dpW=0;
+	m_iGenNum=m_iBaseNum=m_iCutNum=0;
+	m_ipGen=m_ipGenLevel=m_ipBase=m_ipCut=0;
+	m_iOrbitNum=m_iOrbitColNum=0;
+	m_bTimeOut=false;
+	m_dTime=0.0;
+} // end of CSymmetry::CSymmetry()
+
+CSymmetry::~CSymmetry()
+{
+	if (m_ipAdjBeg)
+		delete[] m_ipAdjBeg;
+	if (m_lpEdgeColor)
+		delete[] m_lpEdgeColor;
+	if (m_ipColor)
+		delete[] m_ipColor;
+	if (m_lpHash)
+		delete[] m_lpHash;
+	if (m_dpW)
+		delete[] m_dpW;
+	if (m_ipGen)
+		delete[] m_ipGen;
+	if (m_ipGenLevel)
+		delete[] m_ipGenLevel;
+	if (m_ipBase)
+		delete[] m_ipBase;
+	if (m_ipCut)
+		delete[] m_ipCut;
+} // end of CSymmetry::~CSymmetry()
+
+//////////////////////////////////////////////////////////////////////
+// Initialization
+//////////////////////////////////////////////////////////////////////
+void CSymmetry::initGraph()
+{
+	const double* dpVal;
+	const int* ipCol;
+	int i, j, k, sz, m=m_copy.getRowNum(), n=m_copy.getColNum(), nz=0, N;
+	for (i=0; i < m; ++i) {
+		nz+=m_copy.getRow(i,dpVal,ipCol);
+	}
+	m_iColNum=n;
+	m_iVertNum=N=n+m;
+	if (!(m_ipAdjBeg = new int[(N+1)+(nz<<1)])) {
+		throw new CMemoryException("CSymmetry::initGraph");
+	}
+	m_ipAdj=m_ipAdjBeg+(N+1);
+	if (!(m_lpEdgeColor = new unsigned long long[nz<<1])) {
+		throw new CMemoryException("CSymmetry::initGraph");
+	}
+	if (!(m_ipColor = new int[8*N+n])) {
+		throw new CMemoryException("CSymmetry::initGraph");
+	}
+	m_ipColor1=m_ipColor+N;
+	m_ipColor2=m_ipColor1+N;
+	m_ipOrder=m_ipColor2+N;
+	m_ipCount=m_ipOrder+N; // two arrays, one for each copy of coloring
+	m_ipPerm=m_ipCount+(N<<1);
+	m_ipParent=m_ipPerm+N;
+	if (!(m_lpHash = new unsigned long long[N])) {
+		throw new CMemoryException("CSymmetry::initGraph");
+	}
+	if (!(m_dpW = new double[n])) {
+		throw new CMemoryException("CSymmetry::initGraph");
+	}
+	memset(m_dpW,0,n*sizeof(double));
+
+// a row vertex is adjacent to its columns, and a column vertex to its rows
+	memset(m_ipAdjBeg,0,(N+1)*sizeof(int));
+	for (i=0; i < m; ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		m_ipAdjBeg[n+i+1]=sz;
+		for (k=0; k < sz; ++k) {
+			++m_ipAdjBeg[ipCol[k]+1];
+		}
+	}
+	for (j=0; j < N; ++j) {
+		m_ipAdjBeg[j+1]+=m_ipAdjBeg[j];
+	}
+	for (i=0; i < m; ++i) {
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		int r=m_ipAdjBeg[n+i];
+		for (k=0; k < sz; ++k) {
+			double a=(dpVal[k] == 0.0)? 0.0: dpVal[k]; // -0.0 and 0.0 get the same color
+			unsigned long long h;
+			memcpy(&h,&a,sizeof(h));
+			h=mixHash(h);
+			int p=m_ipAdjBeg[j=ipCol[k]]++;
+			m_ipAdj[p]=n+i;
+			m_lpEdgeColor[p]=h;
+			m_ipAdj[r]=j;
+			m_lpEdgeColor[r++]=h;
+		}
+	}
+	for (j=n; j > 0; --j) {
+		m_ipAdjBeg[j]=m_ipAdjBeg[j-1];
+	}
+	m_ipAdjBeg[0]=0;
+} // end of CSymmetry::initGraph()
+
+int CSymmetry::initColors(int* ipColor)
+{
+	int N=m_iVertNum, colorNum=0;
+	CVertexLess less;
+	less.pCopy=&m_copy;
+	less.n=m_iColNum;
+	for (int v=0; v < N; ++v) {
+		m_ipOrder[v]=v;
+	}
+	std::sort(m_ipOrder,m_ipOrder+N,less);
+	for (int k=0; k < N; ++k) {
+		if (k && less(m_ipOrder[k-1],m_ipOrder[k]))
+			++colorNum;
+		ipColor[m_ipOrder[k]]=colorNum;
+	}
+	return (N)? colorNum+1: 0;
+} // end of CSymmetry::initColors()
+
+//////////////////////////////////////////////////////////////////////
+// Partition refinement
+//////////////////////////////////////////////////////////////////////
+int CSymmetry::refine(int* ipColor, int colorNum)
+{
+	int N=m_iVertNum;
+	CColorHashLess less;
+	less.ipColor=ipColor;
+	less.lpHash=m_lpHash;
+	for (;;) {
+		for (int v=0; v < N; ++v) {
+			unsigned long long h=0;
+			for (int e=m_ipAdjBeg[v]; e < m_ipAdjBeg[v+1]; ++e) {
+				h+=mixHash(m_lpEdgeColor[e]+0x9e3779b97f4a7c15ULL*(unsigned long long)(ipColor[m_ipAdj[e]]+1));
+			}
+			m_lpHash[v]=h;
+			m_ipOrder[v]=v;
+		}
+		std::sort(m_ipOrder,m_ipOrder+N,less);
+		int num=0;
+		for (int k=1; k < N; ++k) {
+			int u=m_ipOrder[k-1], v=m_ipOrder[k];
+			if (ipColor[u] != ipColor[v] || m_lpHash[u] != m_lpHash[v])
+				++num;
+			m_ipPerm[v]=num; // `m_ipPerm` is used as a buffer for new colors
+		}
+		m_ipPerm[m_ipOrder[0]]=0;
+		if (++num == colorNum)
+			break;
+		memcpy(ipColor,m_ipPerm,N*sizeof(int));
+		colorNum=num;
+	}
+	return colorNum;
+} // end of CSymmetry::refine()
+
+int CSymmetry::individualize(int* ipColor, int colorNum, int v)
+{
+	int c=ipColor[v];
+	for (int u=0; u < m_iVertNum; ++u) {
+		if (ipColor[u] > c)
+			++ipColor[u];
+		else if (ipColor[u] == c && u != v)
+			ipColor[u]=c+1;
+	}
+	return colorNum+1;
+} // end of CSymmetry::individualize()
+
+int CSymmetry::countCells(const int* ipColor, int colorNum, int* ipCount) const
+{
+	int c, first=-1;
+	memset(ipCount,0,colorNum*sizeof(int));
+	for (int v=0; v < m_iVertNum; ++v) {
+		++ipCount[ipColor[v]];
+	}
+	for (int j=0; j < m_iColNum; ++j) {
+		if (ipCount[c=ipColor[j]] > 1 && (first < 0 || c < first))
+			first=c;
+	}
+	return first;
+} // end of CSymmetry::countCells()
+
+//////////////////////////////////////////////////////////////////////
+// Search for automorphisms
+//////////////////////////////////////////////////////////////////////
+bool CSymmetry::findAutomorphism(const int* ipColor, int colorNum, int v, int w)
+{
+	int j, c, x, y, num1, num2, n=m_iColNum, N=m_iVertNum;
+	int *ipCount1=m_ipCount, *ipCount2=m_ipCount+N;
+	memcpy(m_ipColor1,ipColor,N*sizeof(int));
+	memcpy(m_ipColor2,ipColor,N*sizeof(int));
+	x=v;
+	y=w;
+	for (;;) {
+		num1=individualize(m_ipColor1,colorNum,x);
+		num2=individualize(m_ipColor2,colorNum,y);
+		if ((num1=refine(m_ipColor1,num1)) != (num2=refine(m_ipColor2,num2)))
+			return false;
+		colorNum=num1;
+		c=countCells(m_ipColor1,colorNum,ipCount1);
+		countCells(m_ipColor2,colorNum,ipCount2);
+		if (memcmp(ipCount1,ipCount2,colorNum*sizeof(int)))
+			return false;
+		if (c < 0)
+			break;
+		if (timeOut())
+			return false;
+		for (x=0; m_ipColor1[x] != c; ++x);
+		for (y=0; m_ipColor2[y] != c; ++y);
+	}
+
+// columns have different colors, and columns of the same color are matched
+	for (j=0; j < n; ++j) {
+		m_ipOrder[m_ipColor2[j]]=j;
+	}
+	for (j=0; j < n; ++j) {
+		m_ipPerm[j]=m_ipOrder[m_ipColor1[j]];
+	}
+// rows of the same color (identical rows) are matched in the order of their numbers
+	for (c=x=y=0; c < colorNum; ++c) {
+		x+=ipCount1[c];
+		ipCount1[c]=x-ipCount1[c];
+		y+=ipCount2[c];
+		ipCount2[c]=y-ipCount2[c];
+	}
+	for (j=n; j < N; ++j) {
+		m_ipOrder[ipCount1[m_ipColor2[j]]++]=j;
+	}
+	for (j=n; j < N; ++j) {
+		m_ipPerm[j]=m_ipOrder[ipCount2[m_ipColor1[j]]++];
+	}
+	return isAutomorphism();
+} // end of CSymmetry::findAutomorphism()
+
+bool CSymmetry::isAutomorphism()
+{
+	const double *dpVal1, *dpVal2;
+	const int *ipCol1, *ipCol2;
+	int i, j, k, sz, n=m_iColNum, m=m_iVertNum-n;
+	for (j=0; j < n; ++j) {
+		int p=m_ipPerm[j];
+		if (m_copy.getVarType(p) != m_copy.getVarType(j) || m_copy.getObjCoeff(p) != m_copy.getObjCoeff(j) ||
+			m_copy.getLoBound(p) != m_copy.getLoBound(j) || m_copy.getUpBound(p) != m_copy.getUpBound(j))
+			return false;
+	}
+	for (i=0; i < m; ++i) {
+		int r=m_ipPerm[n+i]-n;
+		if (r < 0 || m_copy.getCtrType(r) != m_copy.getCtrType(i) ||
+			m_copy.getRowLoBound(r) != m_copy.getRowLoBound(i) || m_copy.getRowUpBound(r) != m_copy.getRowUpBound(i))
+			return false;
+		if ((sz=m_copy.getRow(i,dpVal1,ipCol1)) != m_copy.getRow(r,dpVal2,ipCol2))
+			return false;
+		for (k=0; k < sz; ++k) {
+			m_dpW[ipCol2[k]]=dpVal2[k];
+		}
+		for (k=0; k < sz; ++k) {
+			if (m_dpW[m_ipPerm[ipCol1[k]]] != dpVal1[k])
+				break;
+		}
+		for (j=0; j < sz; ++j) {
+			m_dpW[ipCol2[j]]=0.0;
+		}
+		if (k < sz)
+			return false;
+	}
+	return true;
+} // end of CSymmetry::isAutomorphism()
+
+int CSymmetry::findRoot(int j)
+{
+	int r=j;
+	while (m_ipParent[r] != r)
+		r=m_ipParent[r];
+	while (m_ipParent[j] != r) { // path compression
+		int p=m_ipParent[j];
+		m_ipParent[j]=r;
+		j=p;
+	}
+	return r;
+} // end of CSymmetry::findRoot()
+
+bool CSymmetry::timeOut()
+{
+	if (!m_bTimeOut) {
+		std::chrono::duration<double> elapsed=std::chrono::steady_clock::now()-m_start;
+		if (elapsed.count() > m_iTimeLimit)
+			m_bTimeOut=true;
+	}
+	return m_bTimeOut;
+} // end of CSymmetry::timeOut()
+
+void CSymmetry::detect()
+{
+	int j, c, b, w, colorNum, n, maxGenNum=0;
+	m_start=std::chrono::steady_clock::now();
+	initGraph();
+	n=m_iColNum;
+	if (!(m_ipBase = new int[n+1])) {
+		throw new CMemoryException("CSymmetry::detect");
+	}
+	colorNum=refine(m_ipColor,initColors(m_ipColor));
+	bool stop=false;
+	while (!stop && (c=countCells(m_ipColor,colorNum,m_ipCount)) >= 0 && !timeOut()) {
+		for (b=0; m_ipColor[b] != c; ++b);
+		for (j=0; j < n; ++j) {
+			m_ipParent[j]=j;
+		}
+		for (w=b+1; w < n; ++w) {
+			if (m_ipColor[w] != c || findRoot(w) == findRoot(b))
+				continue;
+			if (m_iGenNum >= m_iMaxGenNum || timeOut()) {
+				stop=true;
+				break;
+			}
+			if (findAutomorphism(m_ipColor,colorNum,b,w)) {
+				if (m_iGenNum == maxGenNum) {
+					maxGenNum=(maxGenNum)? std::min(maxGenNum<<1,m_iMaxGenNum): std::min(SYM_MIN_GEN_MEM,m_iMaxGenNum);
+					int *ipGen, *ipLevel;
+					if (!(ipGen = new int[maxGenNum*n]) || !(ipLevel = new int[maxGenNum])) {
+						throw new CMemoryException("CSymmetry::detect");
+					}
+					if (m_ipGen) {
+						memcpy(ipGen,m_ipGen,m_iGenNum*n*sizeof(int));
+						memcpy(ipLevel,m_ipGenLevel,m_iGenNum*sizeof(int));
+						delete[] m_ipGen;
+						delete[] m_ipGenLevel;
+					}
+					m_ipGen=ipGen;
+					m_ipGenLevel=ipLevel;
+				}
+				memcpy(m_ipGen+m_iGenNum*n,m_ipPerm,n*sizeof(int));
+				m_ipGenLevel[m_iGenNum++]=m_iBaseNum;
+				for (j=0; j < n; ++j) {
+					int r1=findRoot(j), r2=findRoot(m_ipPerm[j]);
+					if (r1 != r2)
+						m_ipParent[r1]=r2;
+				}
+			}
+		}
+		m_ipBase[m_iBaseNum++]=b;
+		if (!stop)
+			colorNum=refine(m_ipColor,individualize(m_ipColor,colorNum,b));
+	}
+	computeCuts();
+	std::chrono::duration<double> elapsed=std::chrono::steady_clock::now()-m_start;
+	m_dTime=elapsed.count();
+} // end of CSymmetry::detect()
+
+//////////////////////////////////////////////////////////////////////
+// Schreier-Sims cuts
+//////////////////////////////////////////////////////////////////////
+void CSymmetry::computeCuts()
+{
+	int j, k, g, r, n=m_iColNum;
+	int* ipSize=m_ipCount;
+	for (j=0; j < n; ++j) {
+		m_ipParent[j]=j;
+		ipSize[j]=1;
+	}
+	if (m_iMaxCutNum > 0 && m_iGenNum) {
+		if (!(m_ipCut = new int[m_iMaxCutNum<<1])) {
+			throw new CMemoryException("CSymmetry::computeCuts");
+		}
+	}
+// generators found at levels `k, k+1, ...` fix base columns `0,...,k-1`
+	for (g=m_iGenNum-1, k=m_iBaseNum-1; k >= 0; --k) {
+		for (; g >= 0 && m_ipGenLevel[g] >= k; --g) {
+			const int* ipGen=m_ipGen+g*n;
+			for (j=0; j < n; ++j) {
+				int r1=findRoot(j), r2=findRoot(ipGen[j]);
+				if (r1 != r2) {
+					m_ipParent[r1]=r2;
+					ipSize[r2]+=ipSize[r1];
+				}
+			}
+		}
+		int b=m_ipBase[k];
+		if (!m_ipCut || ipSize[r=findRoot(b)] == 1 || !m_copy.isInteger(b) ||
+			m_copy.getLoBound(b) != 0.0 || m_copy.getUpBound(b) != 1.0)
+			continue;
+		for (j=0; j < n && m_iCutNum < m_iMaxCutNum; ++j) {
+			if (j != b && findRoot(j) == r) {
+				m_ipCut[m_iCutNum<<1]=b;
+				m_ipCut[(m_iCutNum<<1)+1]=j;
+				++m_iCutNum;
+			}
+		}
+	}
+
+// orbits of the group generated by all generators
+	for (j=0; j < n; ++j) {
+		if (m_ipParent[j] == j && ipSize[j] > 1) {
+			++m_iOrbitNum;
+			m_iOrbitColNum+=ipSize[j];
+		}
+	}
+} // end of CSymmetry::computeCuts()
+
+//////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////
+void CSymmetry::printStatistics(std::ostream &out) const
+{
+	char str[128];
+	out << "Symmetry\n";
+	out << "= Generators ====== Base ==== Orbits == Orbit vars ====== Cuts ===== Time\n";
+	sprintf(str,"%12d %11d %11d %11d %11d %10.3f\n",m_iGenNum,m_iBaseNum,m_iOrbitNum,m_iOrbitColNum,m_iCutNum,m_dTime);
+	out << str;
+	if (m_bTimeOut)
+		out << "Time limit reached\n";
+	out << std::endl;
+} // end of CSymmetry::printStatistics()
@@ -0,0 +1,275 @@
+// ZeroHalfSep.cpp: implementation of the CZeroHalfSep class.
+//
+//////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <cmath>
+#include <except.h>
+#include <lp.h>
+#include "CutSelector.h"
+#include "ZeroHalfSep.h"
+
+#define ZEROHALF_TOL 1.0e-6 ///< tolerance used to decide whether a variable is at its bound.
+#define ZEROHALF_MAX_WEIGHT 0.999 ///< edges and cycles which weights are not less than `ZEROHALF_MAX_WEIGHT` cannot give violated cuts.
+#define ZEROHALF_MAX_WORK 4000000ll ///< default maximum number of arcs scanned in one call to `separate()`.
+
+static inline bool isOdd(double v)
+{
+	return (static_cast<long long>(floor(v+0.5)) & 1LL)? true: false;
+}
+
+/**
+ * The function inserts an entry into a binary heap (with the least key at the top).
+ * \param[in,out] size heap size;
+ * \param[in,out] dpKey,ipItem heap;
+ * \param[in] key,item new entry.
+ */
+static inline void heapPush(int& size, double* dpKey, int* ipItem, double key, int item)
+{
+	int k=size++, p;
+	for (; k && dpKey[p=(k-1)>>1] > key; k=p) {
+		dpKey[k]=dpKey[p];
+		ipItem[k]=ipItem[p];
+	}
+	dpKey[k]=key;
+	ipItem[k]=item;
+} // end of heapPush()
+
+/**
+ * The function removes the top entry from a binary heap.
+ * \param[in,out] size heap size, must be positive;
+ * \param[in,out] dpKey,ipItem heap;
+ * \param[out] key,item removed entry.
+ */
+static inline void heapPop(int& size, double* dpKey, int* ipItem, double& key, int& item)
+{
+	key=dpKey[0];
+	item=ipItem[0];
+	double lastKey=dpKey[--size];
+	int lastItem=ipItem[size], k=0, c;
+	while ((c=(k<<1)+1) < size) {
+		if (c+1 < size && dpKey[c+1] < dpKey[c])
+			++c;
+		if (dpKey[c] >= lastKey)
+			break;
+		dpKey[k]=dpKey[c];
+		ipItem[k]=ipItem[c];
+		k=c;
+	}
+	dpKey[k]=lastKey;
+	ipItem[k]=lastItem;
+} // end of heapPop()
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+CZeroHalfSep::CZeroHalfSep(int maxCutNum): CMod2Sep(0,maxCutNum)
+{
+	m_lMaxWork=ZEROHALF_MAX_WORK;
+} // end of CZeroHalfSep::CZeroHalfSep()
+
+CZeroHalfSep::~CZeroHalfSep()
+{
+} // end of CZeroHalfSep::~CZeroHalfSep()
+
+//////////////////////////////////////////////////////////////////////
+// Separation
+//////////////////////////////////////////////////////////////////////
+int CZeroHalfSep::separate(int hdNum, const double* dpSol, const int* ipHdToCol, CCutSelector& cuts)
+{
+	const double* dpVal;
+	const int* ipCol;
+	double s, x, lb, ub, w, *dpMem;
+	int i, j, k, c, sz, n=m_copy.getColNum(), R=m_iRowNum, nodeNum=0, edgeNum=0, cutNum=0, *ipMem;
+	long long work=0;
+	char *cpMem;
+	if (hdNum < n || !R)
+		return 0;
+	int N=n+1; // `n` nodes at most, and the special node
+	if (!(dpMem = new double[N+R+(n<<1)+(N<<1)+(R<<2)+1])) {
+		throw new CMemoryException("CZeroHalfSep::separate");
+	}
+	if (!(ipMem = new int[3*n+7*R+(N<<2)+N+2+(R<<2)+1])) {
+		delete[] dpMem;
+		throw new CMemoryException("CZeroHalfSep::separate");
+	}
+	if (!(cpMem = new char[N+(R<<1)+N])) {
+		delete[] ipMem;
+		delete[] dpMem;
+		throw new CMemoryException("CZeroHalfSep::separate");
+	}
+	double *dpBnd=dpMem, *dpW=dpBnd+N, *dpCoeff=dpW+R, *dpX=dpCoeff+n, *dpDist=dpX+n, *dpHeap=dpDist+(N<<1);
+	int *ipColInd=ipMem, *ipInd=ipColInd+n, *ipPos=ipInd+n, *ipU=ipPos+n, *ipV=ipU+R, *ipEdgeRow=ipV+R,
+		*ipList=ipEdgeRow+R, *ipAdj=ipList+(R<<1), *ipPred=ipAdj+(R<<1), *ipTouched=ipPred+(N<<1), *ipAdjBeg=ipTouched+(N<<1),
+		*ipHeap=ipAdjBeg+N+2;
+	char *cpBndPar=cpMem, *cpPar=cpBndPar+N, *cpMark=cpPar+R, *cpUsed=cpMark+R;
+	memset(cpMem,0,N+(R<<1)+N);
+	getValues(dpSol,ipHdToCol,dpX);
+
+// nodes are integer variables that are not at their bounds; `ipColInd[j]` is `-1` (`-2`) if variable `j` is at lower (upper) bound
+	for (j=0; j < n; ++j) {
+		ipPos[j]=-1;
+		ipColInd[j]=-3;
+		if (!m_copy.isInteger(j) || (x=dpX[j]) >= CLP::INF)
+			continue;
+		lb=ceil(m_copy.getLoBound(j)-ZEROHALF_TOL);
+		ub=floor(m_copy.getUpBound(j)+ZEROHALF_TOL);
+		if (lb > -CLP::INF && x <= lb+ZEROHALF_TOL)
+			ipColInd[j]=-1;
+		else if (ub < CLP::INF && x >= ub-ZEROHALF_TOL)
+			ipColInd[j]=-2;
+		else {
+		// the bound used to make the coefficient of `j` even is the one chosen by `buildCut()`
+			if (ub < CLP::INF && (lb <= -CLP::INF || ub-x < x-lb)) {
+				dpBnd[nodeNum]=ub-x;
+				cpBndPar[nodeNum]=(isOdd(ub))? 1: 0;
+			}
+			else if (lb > -CLP::INF) {
+				dpBnd[nodeNum]=x-lb;
+				cpBndPar[nodeNum]=(isOdd(lb))? 1: 0;
+			}
+			else
+				dpBnd[nodeNum]=CLP::INF;
+			ipColInd[j]=nodeNum++;
+		}
+	}
+	int dummy=nodeNum++;
+
+// edges: every row of small slack connects its two odd variables farthest from their bounds;
+// rows with variables removed from the LP are skipped unless these variables are fixed
+	for (int r=0; r < R; ++r) {
+		if ((s=getSlack(dpX,r)) >= ZEROHALF_MAX_WEIGHT)
+			continue;
+		i=m_ipRow[r] >> 1;
+		bool neg=(m_ipRow[r] & 1)? true: false;
+		sz=m_copy.getRow(i,dpVal,ipCol);
+		w=(s > 0.0)? s: 0.0;
+		char par=(isOdd((neg)? m_copy.getRowLoBound(i): m_copy.getRowUpBound(i)))? 1: 0;
+		int e1=-1, e2=-1;
+		for (k=0; k < sz && w < ZEROHALF_MAX_WEIGHT; ++k) {
+			if (!isOdd(dpVal[k]))
+				continue;
+			j=ipCol[k];
+			if ((c=ipColInd[j]) < 0) {
+				if (isOdd((c == -1)? ceil(m_copy.getLoBound(j)-ZEROHALF_TOL): floor(m_copy.getUpBound(j)+ZEROHALF_TOL)))
+					par^=1;
+				continue;
+			}
+			if (e1 < 0 || dpBnd[c] > dpBnd[e1]) {
+				int t=e2;
+				e2=e1;
+				e1=c;
+				c=t;
+			}
+			else if (e2 < 0 || dpBnd[c] > dpBnd[e2]) {
+				int t=e2;
+				e2=c;
+				c=t;
+			}
+			if (c >= 0) { // variable is made even by its bound
+				w+=dpBnd[c];
+				par^=cpBndPar[c];
+			}
+		}
+		if (w >= ZEROHALF_MAX_WEIGHT)
+			continue;
+		ipU[edgeNum]=(e1 >= 0)? e1: dummy;
+		ipV[edgeNum]=(e2 >= 0)? e2: dummy;
+		cpPar[edgeNum]=par;
+		dpW[edgeNum]=w;
+		ipEdgeRow[edgeNum++]=r;
+	}
+
+// adjacency lists
+	memset(ipAdjBeg,0,(nodeNum+1)*sizeof(int));
+	for (int e=0; e < edgeNum; ++e) {
+		++ipAdjBeg[ipU[e]+1];
+		if (ipV[e] != ipU[e])
+			++ipAdjBeg[ipV[e]+1];
+	}
+	for (int v=0; v < nodeNum; ++v) {
+		ipAdjBeg[v+1]+=ipAdjBeg[v];
+	}
+	for (int e=0; e < edgeNum; ++e) {
+		ipAdj[ipAdjBeg[ipU[e]]++]=e;
+		if (ipV[e] != ipU[e])
+			ipAdj[ipAdjBeg[ipV[e]]++]=e;
+	}
+	for (int v=nodeNum; v > 0; --v) {
+		ipAdjBeg[v]=ipAdjBeg[v-1];
+	}
+	ipAdjBeg[0]=0;
+	for (k=0; k < (nodeNum<<1); ++k) {
+		dpDist[k]=CLP::INF;
+	}
+
+// shortest odd cycles: paths from `(v,0)` to `(v,1)` in the doubled graph; the special node goes first
+	try {
+		for (int t=0; t < nodeNum && cutNum < m_iMaxCutNum && work < m_lMaxWork; ++t) {
+			int v=(t)? t-1: dummy;
+			if (cpUsed[v] || ipAdjBeg[v] == ipAdjBeg[v+1])
+				continue;
+			int heapSize=0, touchedNum=1, st, src=v<<1, target=src | 1;
+			double d;
+			dpDist[src]=0.0;
+			ipTouched[0]=src;
+			heapPush(heapSize,dpHeap,ipHeap,0.0,src);
+			while (heapSize) {
+				heapPop(heapSize,dpHeap,ipHeap,d,st);
+				if (d > dpDist[st])
+					continue;
+				if (st == target)
+					break;
+				int u=st >> 1, p=st & 1;
+				work+=ipAdjBeg[u+1]-ipAdjBeg[u];
+				for (k=ipAdjBeg[u]; k < ipAdjBeg[u+1]; ++k) {
+					int e=ipAdj[k];
+					if ((w=d+dpW[e]) >= ZEROHALF_MAX_WEIGHT)
+						continue;
+					int to=(((ipU[e] == u)? ipV[e]: ipU[e]) << 1) | (p ^ cpPar[e]);
+					if (w < dpDist[to]) {
+						if (dpDist[to] >= CLP::INF)
+							ipTouched[touchedNum++]=to;
+						dpDist[to]=w;
+						ipPred[to]=e;
+						heapPush(heapSize,dpHeap,ipHeap,w,to);
+					}
+				}
+			}
+			if (dpDist[target] < ZEROHALF_MAX_WEIGHT) {
+			// edges used an odd number of times are the rows of the cut
+				sz=0;
+				for (st=target, k=0; st != src && k < (nodeNum<<1); ++k) {
+					int e=ipPred[st], u=st >> 1;
+					if (!cpMark[e])
+						ipList[sz++]=e;
+					cpMark[e]^=1;
+					st=(((ipU[e] == u)? ipV[e]: ipU[e]) << 1) | ((st & 1) ^ cpPar[e]);
+				}
+				int rowNum=0;
+				for (k=0; k < sz; ++k) {
+					int e=ipList[k];
+					if (cpMark[e]) {
+						cpMark[e]=0;
+						cpUsed[ipU[e]]=cpUsed[ipV[e]]=1;
+						ipList[rowNum++]=ipEdgeRow[e];
+					}
+				}
+				if (rowNum && buildCut(dpX,ipHdToCol,rowNum,ipList,cuts,dpCoeff,ipInd,ipPos))
+					++cutNum;
+			}
+			for (k=0; k < touchedNum; ++k) {
+				dpDist[ipTouched[k]]=CLP::INF;
+			}
+		}
+	}
+	catch(CMemoryException* pe) {
+		delete[] cpMem;
+		delete[] ipMem;
+		delete[] dpMem;
+		throw pe;
+	}
+	delete[] cpMem;
+	delete[] ipMem;
+	delete[] dpMem;
+	return cutNum;
+} // end of CZeroHalfSep::separate()